@@ -0,0 +1,426 @@
+#include "assets/AssetManager.h"
+#include "config/AppConfig.h"
+#include "config/AppConfigLoader.h"
+#include "input/ActionBuffer.h"
+#include "world/InputRecording.h"
+#include "world/JobScheduler.h"
+#include "world/LegacySimulation.h"
+#include "world/Simd.h"
+#include "world/WorldState.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cinttypes>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::atomic<std::uint64_t> g_allocationCount{0};
+std::atomic<std::uint64_t> g_allocationBytes{0};
+
+void *countedAllocate(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+
+constexpr int kBaseAllies = 250;
+constexpr int kBaseEnemies = 250;
+constexpr int kBaseWalls = 32;
+constexpr float kUnitSpacing = 24.0f;
+
+struct BenchOptions
+{
+    std::filesystem::path configRoot = std::filesystem::path(PROJECT_SOURCE_DIR) / "config";
+    std::filesystem::path assetRoot = std::filesystem::path(PROJECT_SOURCE_DIR) / "assets";
+    std::filesystem::path replayPath;
+    int allies = kBaseAllies;
+    int enemies = kBaseEnemies;
+    int walls = kBaseWalls;
+    int ticks = 600;
+    int warmupTicks = 60;
+    int workers = -1;
+    bool waves = false;
+    world::simd::Level simd = world::simd::supportedLevel();
+};
+
+struct SectionTotals
+{
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+
+    void add(double ms)
+    {
+        totalMs += ms;
+        worstMs = std::max(worstMs, ms);
+    }
+};
+
+struct StepTotals
+{
+    std::array<SectionTotals, world::systems::kSystemStageCount> stages{};
+    std::vector<SectionTotals> systems;
+    SectionTotals legacy;
+    SectionTotals spawn;
+    SectionTotals step;
+    std::uint64_t ticks = 0;
+
+    void add(const world::StepTimings &timings)
+    {
+        systems.resize(timings.systems.size());
+        for (std::size_t stage = 0; stage < stages.size(); ++stage)
+        {
+            stages[stage].add(timings.stages[stage].lastMs());
+        }
+        for (std::size_t i = 0; i < systems.size(); ++i)
+        {
+            systems[i].add(timings.systems[i].series.lastMs());
+        }
+        legacy.add(timings.legacyState.series.lastMs());
+        spawn.add(timings.spawnStage.series.lastMs());
+        step.add(timings.step.lastMs());
+        ++ticks;
+    }
+};
+
+void printRow(const char *label, const SectionTotals &totals, double ticks)
+{
+    std::printf("%-22s %14.0f %14.0f\n", label, totals.totalMs * 1.0e6 / ticks, totals.worstMs * 1.0e6);
+}
+
+void printUsage()
+{
+    std::cout << "Usage: kusozako_bench [options]\n"
+              << "  --allies N      allied units in the scenario (default " << kBaseAllies << ")\n"
+              << "  --enemies N     enemy units in the scenario (default " << kBaseEnemies << ")\n"
+              << "  --walls N       wall segments in the scenario (default " << kBaseWalls << ")\n"
+              << "  --scale K       multiply the default unit and wall counts by K\n"
+              << "  --ticks M       measured ticks at game.fixed_dt (default 600)\n"
+              << "  --warmup M      unmeasured ticks before timing starts (default 60)\n"
+              << "  --workers W     job scheduler workers, 0 for single-threaded (default: hardware)\n"
+              << "  --waves         keep the spawn script running during the measurement\n"
+              << "  --simd LEVEL    cap the batch kernels at scalar, sse2 or avx2 (default: widest supported)\n"
+              << "  --replay FILE   replay an input recording (.kzir) instead of the synthetic scenario\n"
+              << "  --config DIR    config directory (default: <source>/config)\n"
+              << "  --assets DIR    asset directory (default: <source>/assets)\n";
+}
+
+bool parseOptions(int argc, char **argv, BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        auto nextInt = [&](int &out) {
+            if (i + 1 >= argc)
+            {
+                return false;
+            }
+            out = std::max(0, std::atoi(argv[++i]));
+            return true;
+        };
+        if (arg == "--allies" && nextInt(options.allies))
+        {
+            continue;
+        }
+        if (arg == "--enemies" && nextInt(options.enemies))
+        {
+            continue;
+        }
+        if (arg == "--walls" && nextInt(options.walls))
+        {
+            continue;
+        }
+        if (arg == "--ticks" && nextInt(options.ticks))
+        {
+            continue;
+        }
+        if (arg == "--warmup" && nextInt(options.warmupTicks))
+        {
+            continue;
+        }
+        if (arg == "--workers" && nextInt(options.workers))
+        {
+            continue;
+        }
+        int scale = 0;
+        if (arg == "--scale" && nextInt(scale))
+        {
+            options.allies = kBaseAllies * scale;
+            options.enemies = kBaseEnemies * scale;
+            options.walls = kBaseWalls * scale;
+            continue;
+        }
+        if (arg == "--waves")
+        {
+            options.waves = true;
+            continue;
+        }
+        if (arg == "--simd" && i + 1 < argc)
+        {
+            const std::string level = argv[++i];
+            if (level == "scalar")
+            {
+                options.simd = world::simd::Level::Scalar;
+            }
+            else if (level == "sse2")
+            {
+                options.simd = world::simd::Level::Sse2;
+            }
+            else if (level == "avx2")
+            {
+                options.simd = world::simd::Level::Avx2;
+            }
+            else
+            {
+                return false;
+            }
+            continue;
+        }
+        if ((arg == "--config" || arg == "--assets" || arg == "--replay") && i + 1 < argc)
+        {
+            (arg == "--config" ? options.configRoot : arg == "--assets" ? options.assetRoot : options.replayPath) =
+                argv[++i];
+            continue;
+        }
+        return false;
+    }
+    return options.ticks > 0;
+}
+
+// Lays the scenario out on a square arena: allies on a grid around the base, enemies on a grid to their right
+// and a wall line between the two. The arena grows with the unit count so density stays roughly constant.
+void populateScenario(world::WorldState &world, const BenchOptions &options)
+{
+    world::LegacySimulation &sim = world.legacy();
+    const int totalUnits = std::max(options.allies + options.enemies, 1);
+    const float side = std::max(1280.0f, std::sqrt(static_cast<float>(totalUnits) * 2.0f) * kUnitSpacing * 2.0f);
+    world.setWorldBounds(side, side);
+    world.reset();
+    sim.spawnEnabled = options.waves;
+
+    sim.yunas.clear();
+    sim.enemies.clear();
+    sim.walls.clear();
+    sim.wallIndex.clear();
+
+    const int allyColumns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(options.allies))));
+    for (int i = 0; i < options.allies; ++i)
+    {
+        sim.spawnYunaUnit(static_cast<UnitJob>(i % 3), world::LegacySimulation::SpawnOrigin::Natural);
+        world::UnitRef unit = sim.yunas[sim.yunas.size() - 1];
+        unit.pos() = {kUnitSpacing * static_cast<float>(1 + i % allyColumns),
+                    kUnitSpacing * static_cast<float>(1 + i / allyColumns)};
+    }
+
+    const float enemyOriginX = side * 0.5f;
+    const int enemyColumns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(options.enemies))));
+    for (int i = 0; i < options.enemies; ++i)
+    {
+        const Vec2 pos{enemyOriginX + kUnitSpacing * static_cast<float>(i % enemyColumns),
+                       kUnitSpacing * static_cast<float>(1 + i / enemyColumns)};
+        sim.spawnOneEnemy(pos, (i % 8) == 0 ? EnemyArchetype::Wallbreaker : EnemyArchetype::Slime);
+    }
+
+    const float wallSpacing = static_cast<float>(std::max(sim.mapDefs.tile_size, 1));
+    for (int i = 0; i < options.walls; ++i)
+    {
+        WallSegment segment;
+        segment.pos = {side * 0.4f, wallSpacing * static_cast<float>(1 + i) * 0.5f};
+        segment.hp = 1000000.0f;
+        segment.life = 1000000.0f;
+        segment.radius = wallSpacing * 0.5f;
+        sim.addWall(segment);
+    }
+    world.markComponentsDirty();
+}
+
+void printTotals(const StepTotals &totals,
+                 const world::StepTimings &timings,
+                 std::uint64_t allocations,
+                 std::uint64_t allocatedBytes)
+{
+    const double ticks = static_cast<double>(std::max<std::uint64_t>(totals.ticks, 1));
+    std::printf("%-22s %14s %14s\n", "stage", "ns/tick", "worst ns");
+    for (std::size_t stage = 0; stage < totals.stages.size(); ++stage)
+    {
+        printRow(world::systems::systemStageId(static_cast<world::systems::SystemStage>(stage)),
+                 totals.stages[stage], ticks);
+    }
+    printRow("step", totals.step, ticks);
+    std::printf("%-22s %14s %14s\n", "system", "ns/tick", "worst ns");
+    for (std::size_t i = 0; i < totals.systems.size(); ++i)
+    {
+        printRow(timings.systems[i].name.c_str(), totals.systems[i], ticks);
+    }
+    printRow(timings.legacyState.name.c_str(), totals.legacy, ticks);
+    printRow(timings.spawnStage.name.c_str(), totals.spawn, ticks);
+    std::printf("allocations: %.2f/tick, %.0f bytes/tick\n", static_cast<double>(allocations) / ticks,
+                static_cast<double>(allocatedBytes) / ticks);
+}
+
+// Replays a recorded session at full speed. Every recorded step is measured; the exit code is non-zero when the
+// recording was made against different config data or the world checksums diverge.
+int runReplay(world::WorldState &world, const BenchOptions &options, std::uint64_t configHash)
+{
+    const world::InputRecordingLoadResult loaded = world::loadInputRecording(options.replayPath);
+    if (!loaded.success)
+    {
+        std::cerr << "Failed to load " << options.replayPath.string() << ": " << loaded.error << '\n';
+        return 1;
+    }
+    const world::InputRecording &recording = loaded.recording;
+    if (recording.header.configHash != configHash)
+    {
+        std::fprintf(stderr, "Recording was made with different config data (hash %016" PRIx64 ", loaded %016" PRIx64
+                             "); replay would not be deterministic.\n",
+                     recording.header.configHash, configHash);
+        return 1;
+    }
+
+    world::InputReplayer replayer(recording);
+    replayer.prepare(world);
+    StepTotals totals;
+    const std::uint64_t allocationsBefore = g_allocationCount.load();
+    const std::uint64_t bytesBefore = g_allocationBytes.load();
+    while (replayer.advance(world))
+    {
+        if (replayer.lastAdvanceStepped())
+        {
+            totals.add(world.stepTimings());
+        }
+    }
+    const std::uint64_t allocations = g_allocationCount.load() - allocationsBefore;
+    const std::uint64_t allocatedBytes = g_allocationBytes.load() - bytesBefore;
+
+    const world::InputReplayResult &result = replayer.result();
+    const world::LegacySimulation &sim = world.legacy();
+    std::printf("replay: %s frames=%" PRIu64 " steps=%" PRIu64 " dt=%.5f workers=%zu seed=%u%s\n",
+                options.replayPath.filename().string().c_str(), result.frames, result.steps,
+                recording.header.fixedDt, world.workerThreads(), recording.header.seed,
+                recording.header.complete() ? "" : " (incomplete recording)");
+    std::printf("alive after run: allies=%zu enemies=%zu walls=%zu\n", sim.yunas.size(), sim.enemies.size(),
+                sim.walls.size());
+    printTotals(totals, world.stepTimings(), allocations, allocatedBytes);
+    if (result.diverged)
+    {
+        std::printf("checksums: DIVERGED at step %" PRIu64 " (expected %016" PRIx64 ", got %016" PRIx64
+                    ") after %" PRIu64 " matches\n",
+                    result.divergedStep, result.expectedChecksum, result.actualChecksum, result.checksumsVerified);
+        return 3;
+    }
+    std::printf("checksums: %" PRIu64 " verified, bit-identical\n", result.checksumsVerified);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return 2;
+    }
+
+    AssetManager assets;
+    assets.setAssetRoot(options.assetRoot.string());
+    AppConfigLoader loader(options.configRoot);
+    const AppConfigLoadResult configResult = loader.load(assets);
+    if (!configResult.success)
+    {
+        std::cerr << "AppConfig loaded with errors, running with fallback values.\n";
+        for (const AppConfigLoadError &error : configResult.errors)
+        {
+            std::cerr << "  " << error.file << ": " << error.message << '\n';
+        }
+    }
+
+    world::simd::setLevel(options.simd);
+    world::WorldState world;
+    world.setWorkerThreads(options.workers >= 0 ? static_cast<std::size_t>(options.workers)
+                                                : world::JobScheduler::defaultWorkerCount());
+    world.configure(configResult.config);
+    if (!options.replayPath.empty())
+    {
+        return runReplay(world, options, configResult.contentHash);
+    }
+    populateScenario(world, options);
+
+    const float dt = configResult.config.game.fixed_dt > 0.0f ? configResult.config.game.fixed_dt : 1.0f / 60.0f;
+    ActionBuffer actions;
+    for (int tick = 0; tick < options.warmupTicks; ++tick)
+    {
+        world.step(dt, actions);
+    }
+
+    StepTotals totals;
+    const std::uint64_t allocationsBefore = g_allocationCount.load();
+    const std::uint64_t bytesBefore = g_allocationBytes.load();
+    for (int tick = 0; tick < options.ticks; ++tick)
+    {
+        world.step(dt, actions);
+        totals.add(world.stepTimings());
+    }
+    const std::uint64_t allocations = g_allocationCount.load() - allocationsBefore;
+    const std::uint64_t allocatedBytes = g_allocationBytes.load() - bytesBefore;
+
+    const world::LegacySimulation &sim = world.legacy();
+    std::printf("scenario: allies=%d enemies=%d walls=%d ticks=%d dt=%.5f workers=%zu waves=%s simd=%s\n",
+                options.allies, options.enemies, options.walls, options.ticks, dt, world.workerThreads(),
+                options.waves ? "on" : "off", world::simd::levelName(world::simd::activeLevel()));
+    std::printf("alive after run: allies=%zu enemies=%zu walls=%zu\n", sim.yunas.size(), sim.enemies.size(),
+                sim.walls.size());
+    printTotals(totals, world.stepTimings(), allocations, allocatedBytes);
+    return 0;
+}
@@ -7,6 +7,7 @@
 struct RenderStats
 {
     int drawCalls = 0;
+    int batchedQuads = 0;
 };
 
 inline void countedRenderClear(SDL_Renderer *renderer, RenderStats &stats)
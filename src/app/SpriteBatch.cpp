@@ -0,0 +1,112 @@
+#include "app/SpriteBatch.h"
+
+#include "app/RenderUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+constexpr std::size_t kInitialQuadCapacity = 1024;
+constexpr int kMinCircleSegments = 12;
+constexpr int kMaxCircleSegments = 48;
+constexpr float kTwoPi = 6.28318530718f;
+
+} // namespace
+
+SpriteBatch::SpriteBatch(SDL_Renderer *renderer, RenderStats &stats)
+    : m_renderer(renderer), m_stats(stats)
+{
+    m_vertices.reserve(kInitialQuadCapacity * 4);
+    m_indices.reserve(kInitialQuadCapacity * 6);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    flush();
+}
+
+void SpriteBatch::draw(SDL_Texture *texture, const SDL_Rect &src, const SDL_Rect &dst, SDL_Color tint)
+{
+    if (!texture)
+    {
+        return;
+    }
+    bind(texture);
+
+    const float u0 = static_cast<float>(src.x) * m_invWidth;
+    const float v0 = static_cast<float>(src.y) * m_invHeight;
+    const float u1 = static_cast<float>(src.x + src.w) * m_invWidth;
+    const float v1 = static_cast<float>(src.y + src.h) * m_invHeight;
+    const float x0 = static_cast<float>(dst.x);
+    const float y0 = static_cast<float>(dst.y);
+    const float x1 = static_cast<float>(dst.x + dst.w);
+    const float y1 = static_cast<float>(dst.y + dst.h);
+
+    const int base = static_cast<int>(m_vertices.size());
+    m_vertices.push_back({{x0, y0}, tint, {u0, v0}});
+    m_vertices.push_back({{x1, y0}, tint, {u1, v0}});
+    m_vertices.push_back({{x1, y1}, tint, {u1, v1}});
+    m_vertices.push_back({{x0, y1}, tint, {u0, v1}});
+    m_indices.insert(m_indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    ++m_stats.batchedQuads;
+}
+
+void SpriteBatch::fillCircle(const Vec2 &center, float radius, SDL_Color color)
+{
+    if (radius <= 0.0f)
+    {
+        return;
+    }
+    bind(nullptr);
+
+    const int segments = std::clamp(static_cast<int>(radius * 0.5f), kMinCircleSegments, kMaxCircleSegments);
+    const int base = static_cast<int>(m_vertices.size());
+    m_vertices.push_back({{center.x, center.y}, color, {0.0f, 0.0f}});
+    for (int i = 0; i < segments; ++i)
+    {
+        const float angle = kTwoPi * static_cast<float>(i) / static_cast<float>(segments);
+        m_vertices.push_back({{center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius},
+                              color,
+                              {0.0f, 0.0f}});
+    }
+    for (int i = 0; i < segments; ++i)
+    {
+        const int next = (i + 1) % segments;
+        m_indices.insert(m_indices.end(), {base, base + 1 + i, base + 1 + next});
+    }
+}
+
+void SpriteBatch::flush()
+{
+    if (!m_indices.empty())
+    {
+        ++m_stats.drawCalls;
+        SDL_RenderGeometry(m_renderer, m_texture, m_vertices.data(), static_cast<int>(m_vertices.size()),
+                           m_indices.data(), static_cast<int>(m_indices.size()));
+    }
+    m_vertices.clear();
+    m_indices.clear();
+    m_hasRun = false;
+}
+
+void SpriteBatch::bind(SDL_Texture *texture)
+{
+    if (m_hasRun && texture == m_texture)
+    {
+        return;
+    }
+    flush();
+    m_texture = texture;
+    m_hasRun = true;
+    m_invWidth = 1.0f;
+    m_invHeight = 1.0f;
+    int width = 0;
+    int height = 0;
+    if (texture && SDL_QueryTexture(texture, nullptr, nullptr, &width, &height) == 0 && width > 0 && height > 0)
+    {
+        m_invWidth = 1.0f / static_cast<float>(width);
+        m_invHeight = 1.0f / static_cast<float>(height);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "core/Vec2.h"
+
+#include <vector>
+
+struct RenderStats;
+
+// Collects textured quads and solid circles into one vertex buffer and submits each run with a single
+// SDL_RenderGeometry call. A run ends when the texture changes or flush() is called, so draws keep their
+// submission order; callers flush before mixing in immediate-mode primitives. Tints are baked into the vertex
+// colours, which leaves the texture colour/alpha mods untouched.
+class SpriteBatch
+{
+  public:
+    SpriteBatch(SDL_Renderer *renderer, RenderStats &stats);
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch &) = delete;
+    SpriteBatch &operator=(const SpriteBatch &) = delete;
+
+    void draw(SDL_Texture *texture, const SDL_Rect &src, const SDL_Rect &dst,
+              SDL_Color tint = SDL_Color{255, 255, 255, 255});
+    // Untextured fan; blended with the renderer's current draw blend mode at flush time.
+    void fillCircle(const Vec2 &center, float radius, SDL_Color color);
+
+    void flush();
+
+  private:
+    SDL_Renderer *m_renderer = nullptr;
+    RenderStats &m_stats;
+    SDL_Texture *m_texture = nullptr;
+    bool m_hasRun = false;
+    float m_invWidth = 1.0f;
+    float m_invHeight = 1.0f;
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+
+    void bind(SDL_Texture *texture);
+};
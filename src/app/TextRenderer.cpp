@@ -4,8 +4,70 @@
 
 #include <SDL_ttf.h>
 
+#include <algorithm>
 #include <utility>
 
+namespace
+{
+
+constexpr int kAtlasPageSize = 1024;
+constexpr std::size_t kMaxAtlasPages = 4;
+constexpr int kGlyphPadding = 1;
+constexpr std::size_t kLayoutCacheCapacity = 256;
+constexpr std::uint32_t kReplacementCodepoint = 0xFFFD;
+
+std::uint32_t decodeUtf8(const std::string &text, std::size_t &index)
+{
+    const auto byteAt = [&](std::size_t i) { return static_cast<unsigned char>(text[i]); };
+    const unsigned char lead = byteAt(index);
+    int extra = 0;
+    std::uint32_t codepoint = 0;
+    if (lead < 0x80)
+    {
+        ++index;
+        return lead;
+    }
+    if ((lead & 0xE0) == 0xC0)
+    {
+        extra = 1;
+        codepoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        extra = 2;
+        codepoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        extra = 3;
+        codepoint = lead & 0x07;
+    }
+    else
+    {
+        ++index;
+        return kReplacementCodepoint;
+    }
+    if (index + static_cast<std::size_t>(extra) >= text.size())
+    {
+        index = text.size();
+        return kReplacementCodepoint;
+    }
+    for (int i = 1; i <= extra; ++i)
+    {
+        const unsigned char next = byteAt(index + static_cast<std::size_t>(i));
+        if ((next & 0xC0) != 0x80)
+        {
+            index += static_cast<std::size_t>(i);
+            return kReplacementCodepoint;
+        }
+        codepoint = (codepoint << 6) | (next & 0x3F);
+    }
+    index += static_cast<std::size_t>(extra) + 1;
+    return codepoint;
+}
+
+} // namespace
+
 TextRenderer::TextRenderer() = default;
 
 TextRenderer::~TextRenderer()
@@ -27,9 +89,18 @@ TextRenderer &TextRenderer::operator=(TextRenderer &&other) noexcept
         m_font = std::move(other.m_font);
         m_pointSize = other.m_pointSize;
         m_lineHeight = other.m_lineHeight;
+        m_glyphs = std::move(other.m_glyphs);
+        m_glyphLookup = std::move(other.m_glyphLookup);
+        m_pages = std::move(other.m_pages);
+        m_atlasRenderer = other.m_atlasRenderer;
+        m_layouts = std::move(other.m_layouts);
+        m_layoutLookup = std::move(other.m_layoutLookup);
         other.m_assetManager = nullptr;
         other.m_pointSize = 0;
         other.m_lineHeight = 0;
+        other.m_pages.clear();
+        other.m_atlasRenderer = nullptr;
+        other.clearCaches();
     }
     return *this;
 }
@@ -65,6 +136,8 @@ bool TextRenderer::load(AssetManager &assets, const std::string &path, int point
 
 void TextRenderer::unload()
 {
+    resetAtlas();
+    clearCaches();
     m_font.reset();
     m_assetManager = nullptr;
     m_pointSize = 0;
@@ -87,17 +160,11 @@ int TextRenderer::getLineHeight() const
 
 int TextRenderer::measureText(const std::string &text) const
 {
-    if (!isLoaded() || text.empty())
+    if (!isLoaded() || text.empty() || !m_font.getRaw())
     {
         return 0;
     }
-    int width = 0;
-    int height = 0;
-    if (TTF_SizeUTF8(m_font.getRaw(), text.c_str(), &width, &height) == 0)
-    {
-        return width;
-    }
-    return 0;
+    return layoutFor(text).width;
 }
 
 void TextRenderer::drawText(SDL_Renderer *renderer,
@@ -107,39 +174,215 @@ void TextRenderer::drawText(SDL_Renderer *renderer,
                             RenderStats *stats,
                             SDL_Color color) const
 {
-    if (!renderer || !isLoaded() || text.empty())
+    if (!renderer || !isLoaded() || text.empty() || !m_font.getRaw())
     {
         return;
     }
 
-    TTF_Font *font = m_font.getRaw();
-    if (!font)
+    if (renderer != m_atlasRenderer)
     {
-        return;
+        resetAtlas();
+        m_atlasRenderer = renderer;
+    }
+
+    const Layout &layout = layoutFor(text);
+    SDL_Texture *boundTexture = nullptr;
+    for (const PlacedGlyph &placed : layout.glyphs)
+    {
+        Glyph &glyph = m_glyphs[placed.glyph];
+        if (!glyph.resident)
+        {
+            if (!uploadGlyph(renderer, glyph))
+            {
+                continue;
+            }
+            // The upload may have reset the atlas, and a new page can reuse a destroyed texture's address.
+            boundTexture = nullptr;
+        }
+        if (glyph.page < 0)
+        {
+            continue;
+        }
+        SDL_Texture *texture = m_pages[static_cast<std::size_t>(glyph.page)].texture;
+        if (texture != boundTexture)
+        {
+            // Consecutive copies from one texture are merged into a single batch by the renderer.
+            SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+            SDL_SetTextureAlphaMod(texture, color.a);
+            boundTexture = texture;
+            if (stats)
+            {
+                ++stats->drawCalls;
+            }
+        }
+        const SDL_Rect dest{x + placed.x, y, glyph.source.w, glyph.source.h};
+        SDL_RenderCopy(renderer, texture, &glyph.source, &dest);
+    }
+}
+
+const TextRenderer::Layout &TextRenderer::layoutFor(const std::string &text) const
+{
+    const auto found = m_layoutLookup.find(text);
+    if (found != m_layoutLookup.end())
+    {
+        m_layouts.splice(m_layouts.begin(), m_layouts, found->second);
+        return found->second->second;
+    }
+
+    Layout layout;
+    layout.glyphs.reserve(text.size());
+    int pen = 0;
+    for (std::size_t i = 0; i < text.size();)
+    {
+        const std::uint32_t glyphIndex = glyphFor(decodeUtf8(text, i));
+        layout.glyphs.push_back({glyphIndex, pen});
+        pen += m_glyphs[glyphIndex].advance;
+    }
+    layout.width = pen;
+
+    if (m_layouts.size() >= kLayoutCacheCapacity)
+    {
+        m_layoutLookup.erase(m_layouts.back().first);
+        m_layouts.pop_back();
+    }
+    m_layouts.emplace_front(text, std::move(layout));
+    m_layoutLookup.emplace(text, m_layouts.begin());
+    return m_layouts.front().second;
+}
+
+std::uint32_t TextRenderer::glyphFor(std::uint32_t codepoint) const
+{
+    const auto found = m_glyphLookup.find(codepoint);
+    if (found != m_glyphLookup.end())
+    {
+        return found->second;
+    }
+
+    Glyph glyph;
+    glyph.codepoint = codepoint;
+    int minX = 0;
+    int maxX = 0;
+    int minY = 0;
+    int maxY = 0;
+    if (TTF_GlyphMetrics32(m_font.getRaw(), codepoint, &minX, &maxX, &minY, &maxY, &glyph.advance) != 0)
+    {
+        glyph.advance = 0;
     }
+    const std::uint32_t index = static_cast<std::uint32_t>(m_glyphs.size());
+    m_glyphs.push_back(glyph);
+    m_glyphLookup.emplace(codepoint, index);
+    return index;
+}
 
-    SDL_Surface *surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
+bool TextRenderer::uploadGlyph(SDL_Renderer *renderer, Glyph &glyph) const
+{
+    SDL_Surface *rendered = TTF_RenderGlyph32_Blended(m_font.getRaw(), glyph.codepoint, SDL_Color{255, 255, 255, 255});
+    if (!rendered)
+    {
+        return false;
+    }
+    SDL_Surface *surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(rendered);
     if (!surface)
     {
-        return;
+        return false;
+    }
+
+    int page = -1;
+    SDL_Rect rect{0, 0, surface->w, surface->h};
+    if (surface->w <= 0 || surface->h <= 0)
+    {
+        // Whitespace has an advance but nothing to draw; remember that so it is not rasterised again.
+        glyph.resident = true;
+        glyph.page = -1;
+    }
+    else if (reservePageSpace(renderer, surface->w, surface->h, page, rect) &&
+             SDL_UpdateTexture(m_pages[static_cast<std::size_t>(page)].texture, &rect, surface->pixels,
+                               surface->pitch) == 0)
+    {
+        glyph.resident = true;
+        glyph.page = page;
+        glyph.source = rect;
+    }
+    SDL_FreeSurface(surface);
+    return glyph.resident;
+}
+
+bool TextRenderer::reservePageSpace(SDL_Renderer *renderer, int width, int height, int &page, SDL_Rect &rect) const
+{
+    const int paddedWidth = width + kGlyphPadding;
+    const int paddedHeight = height + kGlyphPadding;
+    if (paddedWidth > kAtlasPageSize || paddedHeight > kAtlasPageSize)
+    {
+        return false;
+    }
+
+    if (!m_pages.empty())
+    {
+        AtlasPage &current = m_pages.back();
+        if (current.shelfX + paddedWidth > kAtlasPageSize)
+        {
+            current.shelfY += current.shelfHeight;
+            current.shelfX = 0;
+            current.shelfHeight = 0;
+        }
+        if (current.shelfY + paddedHeight <= kAtlasPageSize)
+        {
+            rect = {current.shelfX, current.shelfY, width, height};
+            current.shelfX += paddedWidth;
+            current.shelfHeight = std::max(current.shelfHeight, paddedHeight);
+            page = static_cast<int>(m_pages.size() - 1);
+            return true;
+        }
+    }
+
+    if (m_pages.size() >= kMaxAtlasPages)
+    {
+        // Every page is full: start over and let the glyphs that are still in use repopulate the atlas.
+        resetAtlas();
     }
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+
+    SDL_Texture *texture = SDL_CreateTexture(renderer,
+                                             SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_STATIC,
+                                             kAtlasPageSize,
+                                             kAtlasPageSize);
     if (!texture)
     {
-        SDL_FreeSurface(surface);
-        return;
+        return false;
     }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    AtlasPage fresh;
+    fresh.texture = texture;
+    fresh.shelfX = paddedWidth;
+    fresh.shelfHeight = paddedHeight;
+    m_pages.push_back(fresh);
+    rect = {0, 0, width, height};
+    page = static_cast<int>(m_pages.size() - 1);
+    return true;
+}
 
-    SDL_Rect dest{x, y, surface->w, surface->h};
-    if (stats)
+void TextRenderer::resetAtlas() const
+{
+    for (AtlasPage &page : m_pages)
     {
-        countedRenderCopy(renderer, texture, nullptr, &dest, *stats);
+        if (page.texture)
+        {
+            SDL_DestroyTexture(page.texture);
+        }
     }
-    else
+    m_pages.clear();
+    for (Glyph &glyph : m_glyphs)
     {
-        SDL_RenderCopy(renderer, texture, nullptr, &dest);
+        glyph.resident = false;
+        glyph.page = -1;
     }
+}
 
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
+void TextRenderer::clearCaches()
+{
+    m_glyphs.clear();
+    m_glyphLookup.clear();
+    m_layouts.clear();
+    m_layoutLookup.clear();
 }
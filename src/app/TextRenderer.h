@@ -4,10 +4,18 @@
 
 #include <SDL.h>
 
+#include <cstdint>
+#include <list>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 struct RenderStats;
 
+// Draws UTF-8 text from a glyph atlas. Each TextRenderer owns one font at one point size; its glyphs are rasterised
+// on first use into atlas pages, so CJK text only pays for the characters that actually appear. Laid-out strings
+// are kept in a small LRU cache so static labels skip decoding and metric lookups.
 class TextRenderer
 {
   public:
@@ -35,8 +43,53 @@ class TextRenderer
                   SDL_Color color = SDL_Color{255, 255, 255, 255}) const;
 
   private:
+    struct Glyph
+    {
+        std::uint32_t codepoint = 0;
+        int advance = 0;
+        bool resident = false;
+        int page = -1;
+        SDL_Rect source{0, 0, 0, 0};
+    };
+
+    struct PlacedGlyph
+    {
+        std::uint32_t glyph = 0;
+        int x = 0;
+    };
+
+    struct Layout
+    {
+        std::vector<PlacedGlyph> glyphs;
+        int width = 0;
+    };
+
+    struct AtlasPage
+    {
+        SDL_Texture *texture = nullptr;
+        int shelfX = 0;
+        int shelfY = 0;
+        int shelfHeight = 0;
+    };
+
+    using LayoutList = std::list<std::pair<std::string, Layout>>;
+
     AssetManager *m_assetManager = nullptr;
     AssetManager::FontReference m_font;
     int m_pointSize = 0;
     int m_lineHeight = 0;
+
+    mutable std::vector<Glyph> m_glyphs;
+    mutable std::unordered_map<std::uint32_t, std::uint32_t> m_glyphLookup;
+    mutable std::vector<AtlasPage> m_pages;
+    mutable SDL_Renderer *m_atlasRenderer = nullptr;
+    mutable LayoutList m_layouts;
+    mutable std::unordered_map<std::string, LayoutList::iterator> m_layoutLookup;
+
+    const Layout &layoutFor(const std::string &text) const;
+    std::uint32_t glyphFor(std::uint32_t codepoint) const;
+    bool uploadGlyph(SDL_Renderer *renderer, Glyph &glyph) const;
+    bool reservePageSpace(SDL_Renderer *renderer, int width, int height, int &page, SDL_Rect &rect) const;
+    void resetAtlas() const;
+    void clearCaches();
 };
@@ -0,0 +1,165 @@
+#include "app/TileChunkCache.h"
+
+#include "app/RenderUtils.h"
+#include "app/SpriteBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+TileChunkCache::~TileChunkCache()
+{
+    clear();
+}
+
+bool TileChunkCache::build(SDL_Renderer *renderer, const Sheet &sheet, const std::vector<Layer> &layers)
+{
+    clear();
+    if (!renderer || !sheet.texture || sheet.mapWidth <= 0 || sheet.mapHeight <= 0 || sheet.tileWidth <= 0 ||
+        sheet.tileHeight <= 0 || !SDL_RenderTargetSupported(renderer))
+    {
+        return false;
+    }
+
+    const int columns = std::max(sheet.columns, 1);
+    m_chunkWidth = kChunkTiles * sheet.tileWidth;
+    m_chunkHeight = kChunkTiles * sheet.tileHeight;
+    m_chunkColumns = (sheet.mapWidth + kChunkTiles - 1) / kChunkTiles;
+    m_chunkRows = (sheet.mapHeight + kChunkTiles - 1) / kChunkTiles;
+    m_chunks.resize(static_cast<std::size_t>(m_chunkColumns) * static_cast<std::size_t>(m_chunkRows));
+
+    SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+    RenderStats bakeStats;
+    bool ok = true;
+    for (int cy = 0; cy < m_chunkRows && ok; ++cy)
+    {
+        for (int cx = 0; cx < m_chunkColumns && ok; ++cx)
+        {
+            const int firstX = cx * kChunkTiles;
+            const int firstY = cy * kChunkTiles;
+            const int tilesX = std::min(kChunkTiles, sheet.mapWidth - firstX);
+            const int tilesY = std::min(kChunkTiles, sheet.mapHeight - firstY);
+
+            bool occupied = false;
+            for (const Layer &layer : layers)
+            {
+                if (!layer.tiles)
+                {
+                    continue;
+                }
+                const int total = static_cast<int>(layer.tiles->size());
+                for (int y = firstY; y < firstY + tilesY && !occupied; ++y)
+                {
+                    for (int x = firstX; x < firstX + tilesX && !occupied; ++x)
+                    {
+                        const int index = y * sheet.mapWidth + x;
+                        occupied = index < total && (*layer.tiles)[index] > 0;
+                    }
+                }
+            }
+            if (!occupied)
+            {
+                continue;
+            }
+
+            Chunk &chunk = m_chunks[static_cast<std::size_t>(cy * m_chunkColumns + cx)];
+            chunk.bounds = {firstX * sheet.tileWidth, firstY * sheet.tileHeight, tilesX * sheet.tileWidth,
+                            tilesY * sheet.tileHeight};
+            chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                              chunk.bounds.w, chunk.bounds.h);
+            if (!chunk.texture || SDL_SetRenderTarget(renderer, chunk.texture) != 0)
+            {
+                ok = false;
+                break;
+            }
+            SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_RenderClear(renderer);
+
+            SpriteBatch batch(renderer, bakeStats);
+            for (const Layer &layer : layers)
+            {
+                if (!layer.tiles)
+                {
+                    continue;
+                }
+                const int total = static_cast<int>(layer.tiles->size());
+                for (int y = firstY; y < firstY + tilesY; ++y)
+                {
+                    for (int x = firstX; x < firstX + tilesX; ++x)
+                    {
+                        const int index = y * sheet.mapWidth + x;
+                        const int gid = index < total ? (*layer.tiles)[index] : 0;
+                        if (gid <= 0)
+                        {
+                            continue;
+                        }
+                        const int tileIndex = gid - 1;
+                        const SDL_Rect src{(tileIndex % columns) * sheet.tileWidth,
+                                           (tileIndex / columns) * sheet.tileHeight, sheet.tileWidth,
+                                           sheet.tileHeight};
+                        const SDL_Rect dst{(x - firstX) * sheet.tileWidth, (y - firstY) * sheet.tileHeight,
+                                           sheet.tileWidth, sheet.tileHeight};
+                        batch.draw(sheet.texture, src, dst, layer.tint);
+                    }
+                }
+            }
+            batch.flush();
+        }
+    }
+    SDL_SetRenderTarget(renderer, previousTarget);
+
+    if (!ok)
+    {
+        clear();
+        return false;
+    }
+    m_built = true;
+    return true;
+}
+
+void TileChunkCache::clear()
+{
+    for (Chunk &chunk : m_chunks)
+    {
+        if (chunk.texture)
+        {
+            SDL_DestroyTexture(chunk.texture);
+        }
+    }
+    m_chunks.clear();
+    m_chunkColumns = 0;
+    m_chunkRows = 0;
+    m_built = false;
+}
+
+bool TileChunkCache::isBuilt() const
+{
+    return m_built;
+}
+
+void TileChunkCache::draw(SpriteBatch &batch, const Vec2 &cameraPosition, int screenW, int screenH) const
+{
+    if (!m_built || m_chunkWidth <= 0 || m_chunkHeight <= 0)
+    {
+        return;
+    }
+    const int minX = std::max(static_cast<int>(std::floor(cameraPosition.x / m_chunkWidth)), 0);
+    const int minY = std::max(static_cast<int>(std::floor(cameraPosition.y / m_chunkHeight)), 0);
+    const int maxX = std::min(static_cast<int>(std::floor((cameraPosition.x + screenW) / m_chunkWidth)), m_chunkColumns - 1);
+    const int maxY = std::min(static_cast<int>(std::floor((cameraPosition.y + screenH) / m_chunkHeight)), m_chunkRows - 1);
+    for (int cy = minY; cy <= maxY; ++cy)
+    {
+        for (int cx = minX; cx <= maxX; ++cx)
+        {
+            const Chunk &chunk = m_chunks[static_cast<std::size_t>(cy * m_chunkColumns + cx)];
+            if (!chunk.texture)
+            {
+                continue;
+            }
+            const SDL_Rect src{0, 0, chunk.bounds.w, chunk.bounds.h};
+            const SDL_Rect dst{static_cast<int>(chunk.bounds.x - cameraPosition.x),
+                               static_cast<int>(chunk.bounds.y - cameraPosition.y), chunk.bounds.w, chunk.bounds.h};
+            batch.draw(chunk.texture, src, dst);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "core/Vec2.h"
+
+#include <vector>
+
+class SpriteBatch;
+
+// Static tile layers pre-rendered into render-target textures, one per kChunkTiles x kChunkTiles block of the
+// map. All layers are composited into the same chunk in order, so drawing the map costs one copy per visible
+// chunk. Chunks without any tiles get no texture. The cache must be rebuilt whenever the map or renderer changes.
+class TileChunkCache
+{
+  public:
+    static constexpr int kChunkTiles = 16;
+
+    struct Sheet
+    {
+        SDL_Texture *texture = nullptr;
+        int mapWidth = 0;
+        int mapHeight = 0;
+        int tileWidth = 0;
+        int tileHeight = 0;
+        int columns = 1;
+    };
+
+    struct Layer
+    {
+        const std::vector<int> *tiles = nullptr;
+        SDL_Color tint{255, 255, 255, 255};
+    };
+
+    TileChunkCache() = default;
+    ~TileChunkCache();
+
+    TileChunkCache(const TileChunkCache &) = delete;
+    TileChunkCache &operator=(const TileChunkCache &) = delete;
+
+    // Returns false (leaving the cache empty) when the renderer cannot draw into textures.
+    bool build(SDL_Renderer *renderer, const Sheet &sheet, const std::vector<Layer> &layers);
+    void clear();
+
+    bool isBuilt() const;
+
+    void draw(SpriteBatch &batch, const Vec2 &cameraPosition, int screenW, int screenH) const;
+
+  private:
+    struct Chunk
+    {
+        SDL_Texture *texture = nullptr;
+        SDL_Rect bounds{0, 0, 0, 0};
+    };
+
+    std::vector<Chunk> m_chunks;
+    int m_chunkColumns = 0;
+    int m_chunkRows = 0;
+    int m_chunkWidth = 0;
+    int m_chunkHeight = 0;
+    bool m_built = false;
+};
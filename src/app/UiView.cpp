@@ -1,6 +1,7 @@
 #include "app/UiView.h"
 
 #include "app/RenderUtils.h"
+#include "telemetry/TraceProfiler.h"
 #ifndef KUSOZAKO_UIVIEW_STUB_TEXT_RENDERER
 #include "app/TextRenderer.h"
 #endif
@@ -145,6 +146,7 @@ std::string UiView::formatMilliseconds(double ms, int precision)
 
 void UiView::render(const DrawContext &context) const
 {
+    KUSOZAKO_TRACE_ZONE("UiView::render");
     if (!m_dependencies.renderer || !m_dependencies.hudFont || !context.simulation || !context.renderStats)
     {
         return;
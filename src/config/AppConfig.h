@@ -177,12 +177,29 @@ struct PerformanceBudgetConfig
     float inputMs = 1.5f;
     float hudMs = 2.0f;
     float toleranceMs = 0.5f;
+    // Per SystemStage budgets inside the update, keyed by stage id (e.g. "combat"). Missing stages are unchecked.
+    std::unordered_map<std::string, float> stageMs;
 };
 
 struct SpawnBudgetConfig
 {
     int maxPerFrame = 8;
     std::string warningText = "Spawn queue delayed";
+    // Seconds a scripted enemy is assumed to stay alive when sizing the enemy pool; 0 assumes none die.
+    float enemyLifetime = 30.0f;
+};
+
+// Caps how many allies run a full AI decision (enemy searches included) per tick. The rest keep steering at the
+// enemies they chose last time. Units near their target or near the commander, whom the camera follows, go first;
+// a round-robin cursor spreads the remaining budget so every unit decides within a bounded number of ticks.
+struct AiSchedulerConfig
+{
+    // 0 lets every unit decide every tick.
+    int maxDecisionsPerTick = 0;
+    // Share of the budget the priority units may take; the round robin always keeps at least one decision.
+    float priorityShare = 0.5f;
+    float priorityEnemyRadiusPx = 96.0f;
+    float priorityViewRadiusPx = 320.0f;
 };
 
 struct GameConfig
@@ -203,6 +220,9 @@ struct GameConfig
     std::string enemy_script = "assets/spawn_level1.json";
     std::string map_path = "assets/maps/level1.tmx";
     int rng_seed = 1337;
+    // Job scheduler workers for the game's world; -1 uses one per spare hardware thread. Other worlds (tests,
+    // bench) start single-threaded and opt in through WorldState::setWorkerThreads.
+    int worker_threads = 0;
     int lod_threshold_entities = 0;
     int lod_skip_draw_every = 1;
     std::string mission_path;
@@ -222,6 +242,7 @@ struct GameConfig
     JobSpawnConfig jobSpawn{};
     PerformanceBudgetConfig performance{};
     SpawnBudgetConfig spawnBudget{};
+    AiSchedulerConfig aiScheduler{};
 };
 
 struct EntityStats
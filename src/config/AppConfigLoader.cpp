@@ -322,6 +322,9 @@ std::optional<GameConfig> parseGameConfig(ParseContext &ctx, const std::string &
             std::string warning = json::getString(*budget, "warning_text", cfg.spawnBudget.warningText);
             warning = json::getString(*budget, "warningText", warning);
             cfg.spawnBudget.warningText = warning;
+
+            cfg.spawnBudget.enemyLifetime =
+                std::max(0.0f, json::getNumber(*budget, "enemy_lifetime_s", cfg.spawnBudget.enemyLifetime));
         }
     }
     if (const json::JsonValue *jobSection = json::getObjectField(jsonRoot, "spawn_config"))
@@ -381,11 +384,23 @@ std::optional<GameConfig> parseGameConfig(ParseContext &ctx, const std::string &
     cfg.enemy_script = json::getString(jsonRoot, "enemy_script", cfg.enemy_script);
     cfg.map_path = json::getString(jsonRoot, "map", cfg.map_path);
     cfg.rng_seed = json::getInt(jsonRoot, "rng_seed", cfg.rng_seed);
+    cfg.worker_threads = std::max(-1, json::getInt(jsonRoot, "worker_threads", cfg.worker_threads));
     if (const json::JsonValue *lod = json::getObjectField(jsonRoot, "lod"))
     {
         cfg.lod_threshold_entities = json::getInt(*lod, "threshold_entities", cfg.lod_threshold_entities);
         cfg.lod_skip_draw_every = std::max(1, json::getInt(*lod, "skip_draw_every", cfg.lod_skip_draw_every));
     }
+    if (const json::JsonValue *scheduler = json::getObjectField(jsonRoot, "ai_scheduler"))
+    {
+        cfg.aiScheduler.maxDecisionsPerTick =
+            std::max(0, json::getInt(*scheduler, "max_decisions_per_tick", cfg.aiScheduler.maxDecisionsPerTick));
+        cfg.aiScheduler.priorityShare =
+            std::clamp(json::getNumber(*scheduler, "priority_share", cfg.aiScheduler.priorityShare), 0.0f, 1.0f);
+        cfg.aiScheduler.priorityEnemyRadiusPx = std::max(
+            0.0f, json::getNumber(*scheduler, "priority_enemy_radius_px", cfg.aiScheduler.priorityEnemyRadiusPx));
+        cfg.aiScheduler.priorityViewRadiusPx = std::max(
+            0.0f, json::getNumber(*scheduler, "priority_view_radius_px", cfg.aiScheduler.priorityViewRadiusPx));
+    }
     cfg.mission_path = json::getString(jsonRoot, "mission", cfg.mission_path);
     cfg.formations_path = json::getString(jsonRoot, "formations_config", cfg.formations_path);
     cfg.morale_path = json::getString(jsonRoot, "morale_config", cfg.morale_path);
@@ -405,6 +420,16 @@ std::optional<GameConfig> parseGameConfig(ParseContext &ctx, const std::string &
         cfg.performance.renderMs = clampBudget(json::getNumber(*limits, "render_ms", cfg.performance.renderMs));
         cfg.performance.inputMs = clampBudget(json::getNumber(*limits, "input_ms", cfg.performance.inputMs));
         cfg.performance.hudMs = clampBudget(json::getNumber(*limits, "hud_ms", cfg.performance.hudMs));
+        if (const json::JsonValue *stages = json::getObjectField(*limits, "stages"))
+        {
+            for (const auto &kv : stages->object)
+            {
+                if (kv.second.type == json::JsonValue::Type::Number)
+                {
+                    cfg.performance.stageMs[kv.first] = clampBudget(static_cast<float>(kv.second.number));
+                }
+            }
+        }
         cfg.performance.toleranceMs = clampBudget(json::getNumber(*performance, "tolerance_ms", cfg.performance.toleranceMs));
     }
     return cfg;
@@ -1945,9 +1970,46 @@ AppConfigLoadResult AppConfigLoader::load(AssetManager &assets)
 
     result.errors = std::move(errors);
     result.success = result.errors.empty();
+    result.contentHash = hashTrackedFiles();
     return result;
 }
 
+std::uint64_t AppConfigLoader::hashTrackedFiles() const
+{
+    constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+    constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+    auto mix = [](std::uint64_t hash, const char *data, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= kFnvPrime;
+        }
+        return hash;
+    };
+
+    std::vector<const std::pair<const std::string, TrackedFile> *> ordered;
+    ordered.reserve(m_trackedFiles.size());
+    for (const auto &kv : m_trackedFiles)
+    {
+        ordered.push_back(&kv);
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto *lhs, const auto *rhs) { return lhs->first < rhs->first; });
+
+    std::uint64_t hash = kFnvOffset;
+    for (const auto *entry : ordered)
+    {
+        hash = mix(hash, entry->first.data(), entry->first.size() + 1);
+        std::ifstream stream(entry->second.path, std::ios::binary);
+        char buffer[4096];
+        while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0)
+        {
+            hash = mix(hash, buffer, static_cast<std::size_t>(stream.gcount()));
+        }
+    }
+    return hash;
+}
+
 std::vector<std::string> AppConfigLoader::detectChangedFiles()
 {
     std::vector<std::string> changed;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <unordered_map>
@@ -25,6 +26,9 @@ struct AppConfigLoadResult
     AppConfig config;
     bool success = false;
     std::vector<AppConfigLoadError> errors;
+    // FNV-1a over the bytes of every tracked config and asset file; identifies the data an input recording was
+    // captured against.
+    std::uint64_t contentHash = 0;
 };
 
 class AppConfigLoader
@@ -48,6 +52,7 @@ class AppConfigLoader
     AppConfig loadFallback() const;
 
     void trackFile(const std::string &logicalName, const std::filesystem::path &path);
+    std::uint64_t hashTrackedFiles() const;
 
     std::filesystem::path m_configRoot;
     std::unordered_map<std::string, TrackedFile> m_trackedFiles;
@@ -281,6 +281,13 @@ void DebugController::handleEvent(const SDL_Event &event)
             nextParameter(shift);
         }
         break;
+    case SDLK_F9:
+        if (ctrl)
+        {
+            m_pendingTraceCapture = true;
+            setToast("Trace capture requested");
+        }
+        break;
     case SDLK_PAGEUP:
         adjustParameter(true, ctrl);
         break;
@@ -304,6 +311,12 @@ void DebugController::handleEvent(const SDL_Event &event)
             setToast("Wave skipped");
         }
         break;
+    case SDLK_BACKSPACE:
+        if (ctrl)
+        {
+            rewindSimulation();
+        }
+        break;
     case SDLK_RETURN:
         if (ctrl)
         {
@@ -365,7 +378,8 @@ void DebugController::gatherDisplay(DisplayState &state) const
     }
 
     state.footer = "PageUp/PageDown: adjust  Ctrl+PageUp/PageDown: coarse  Ctrl+Enter/Home: reset";
-    state.help = "F6/F7/F8: select category  Ctrl+F6: HUD  Ctrl+F7: Telemetry  Ctrl+F8: System";
+    state.help = "F6/F7/F8: select category  Ctrl+F6: HUD  Ctrl+F7: Telemetry  Ctrl+F8: System  Ctrl+F9: Trace  "
+                 "Ctrl+Backspace: Rewind";
 }
 
 bool DebugController::consumeHudToggle()
@@ -388,6 +402,16 @@ bool DebugController::consumeTelemetryToggle()
     return false;
 }
 
+bool DebugController::consumeTraceCaptureToggle()
+{
+    if (m_pendingTraceCapture)
+    {
+        m_pendingTraceCapture = false;
+        return true;
+    }
+    return false;
+}
+
 void DebugController::rebuildBaseValues()
 {
     if (!m_simulation)
@@ -493,9 +517,9 @@ void DebugController::rebuildParameters()
                 const float newHp = m_baseYunaHp * value;
                 if (newHp > 0.0f)
                 {
-                    for (auto &unit : m_simulation->yunas)
+                    for (world::UnitRef unit : m_simulation->yunas)
                     {
-                        unit.hp = newHp;
+                        unit.hp() = newHp;
                     }
                     m_simulation->yunaStats.hp = newHp;
                 }
@@ -633,6 +657,10 @@ void DebugController::rebuildParameters()
             [this]() {
                 if (m_simulation)
                 {
+                    if (m_accessor)
+                    {
+                        m_accessor->beginSimulationEdit();
+                    }
                     m_simulation->commander.alive = true;
                     m_simulation->commander.hp = m_simulation->commanderStats.hp;
                     m_simulation->commanderRespawnTimer = 0.0f;
@@ -646,6 +674,10 @@ void DebugController::rebuildParameters()
             [this]() {
                 if (m_simulation)
                 {
+                    if (m_accessor)
+                    {
+                        m_accessor->beginSimulationEdit();
+                    }
                     m_simulation->yunaSpawnTimer = 0.0f;
                     setToast("Spawn timer reset");
                 }
@@ -660,6 +692,14 @@ void DebugController::rebuildParameters()
                 }
             }));
 
+        category.parameters.push_back(std::make_unique<CommandParameter>(
+            "Rewind",
+            [this]() { rewindSimulation(); },
+            [this]() {
+                const std::size_t count = m_accessor ? m_accessor->rewindSnapshots() : 0;
+                return std::to_string(count) + " saved";
+            }));
+
         return category;
     };
 
@@ -738,6 +778,10 @@ void DebugController::adjustParameter(bool increase, bool largeStep)
         {
             return;
         }
+        if (m_accessor)
+        {
+            m_accessor->beginSimulationEdit();
+        }
         if (increase)
         {
             param->increase(largeStep);
@@ -757,6 +801,10 @@ void DebugController::resetParameter()
 {
     if (auto *param = currentParameter())
     {
+        if (m_accessor)
+        {
+            m_accessor->beginSimulationEdit();
+        }
         param->reset();
         if (m_accessor)
         {
@@ -829,4 +877,15 @@ void DebugController::applyEnemySpawnMultiplier()
     }
 }
 
+void DebugController::rewindSimulation()
+{
+    float restoredTime = 0.0f;
+    if (!m_accessor || !m_accessor->rewind(restoredTime))
+    {
+        setToast("Nothing to rewind to");
+        return;
+    }
+    setToast("Rewound to " + formatSeconds(restoredTime));
+}
+
 } // namespace debug
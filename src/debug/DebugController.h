@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -21,10 +22,15 @@ struct DebugBindings
     {
       public:
         virtual ~SimulationAccessor() = default;
+        // Called before the controller changes simulation state outside the recorded inputs.
+        virtual void beginSimulationEdit() = 0;
         virtual void markComponentsDirty() = 0;
         virtual void setEnemySpawnMultiplier(float multiplier) = 0;
         virtual float enemySpawnMultiplier() const = 0;
         virtual bool skipNextWave() = 0;
+        // Restores the previous rewind snapshot; restoredTime receives its sim time.
+        virtual bool rewind(float &restoredTime) = 0;
+        virtual std::size_t rewindSnapshots() const = 0;
     };
 
     void *simulation = nullptr; // world::LegacySimulation*
@@ -90,6 +96,7 @@ class DebugController
 
     bool consumeHudToggle();
     bool consumeTelemetryToggle();
+    bool consumeTraceCaptureToggle();
 
   private:
     DebugBindings m_bindings;
@@ -103,6 +110,7 @@ class DebugController
 
     bool m_pendingHudToggle = false;
     bool m_pendingTelemetryToggle = false;
+    bool m_pendingTraceCapture = false;
 
     std::string m_toastMessage;
     double m_toastTimer = 0.0;
@@ -134,6 +142,7 @@ class DebugController
 
     void setToast(const std::string &message);
     void applyEnemySpawnMultiplier();
+    void rewindSimulation();
 };
 
 } // namespace debug
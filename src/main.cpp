@@ -7,7 +7,9 @@
 #include "app/RenderUtils.h"
 #include "app/FramePerf.h"
 #include "app/UiView.h"
+#include "app/SpriteBatch.h"
 #include "app/TextRenderer.h"
+#include "app/TileChunkCache.h"
 #include "assets/AssetManager.h"
 #include "config/AppConfig.h"
 #include "config/AppConfigLoader.h"
@@ -22,11 +24,15 @@
 #include "services/ServiceLocator.h"
 #include "telemetry/TelemetrySink.h"
 #include "telemetry/PerformanceBudgetMonitor.h"
+#include "telemetry/TraceProfiler.h"
 #include "world/ComponentPool.h"
 #include "world/FormationUtils.h"
+#include "world/InputRecording.h"
+#include "world/JobScheduler.h"
 #include "world/LegacySimulation.h"
 #include "world/LegacyTypes.h"
 #include "world/MoraleTypes.h"
+#include "world/RewindBuffer.h"
 #include "world/SkillRuntime.h"
 #include "world/WorldState.h"
 #include "world/spawn/Spawner.h"
@@ -65,17 +71,6 @@
 #include <utility>
 #include <vector>
 
-namespace world::systems
-{
-
-class SpawnSystem : public ISystem
-{
-  public:
-    void update(float, SystemContext &) override {}
-};
-
-} // namespace world::systems
-
 struct TileMap
 {
     int width = 0;
@@ -101,31 +96,6 @@ struct Atlas
     }
 };
 
-Vec2 operator+(const Vec2 &a, const Vec2 &b) { return {a.x + b.x, a.y + b.y}; }
-Vec2 operator-(const Vec2 &a, const Vec2 &b) { return {a.x - b.x, a.y - b.y}; }
-Vec2 operator*(const Vec2 &a, float s) { return {a.x * s, a.y * s}; }
-Vec2 operator/(const Vec2 &a, float s) { return {a.x / s, a.y / s}; }
-Vec2 &operator+=(Vec2 &a, const Vec2 &b)
-{
-    a.x += b.x;
-    a.y += b.y;
-    return a;
-}
-
-Vec2 lerp(const Vec2 &a, const Vec2 &b, float t)
-{
-    return a + (b - a) * t;
-}
-
-float dot(const Vec2 &a, const Vec2 &b) { return a.x * b.x + a.y * b.y; }
-float lengthSq(const Vec2 &v) { return dot(v, v); }
-float length(const Vec2 &v) { return std::sqrt(lengthSq(v)); }
-Vec2 normalize(const Vec2 &v)
-{
-    const float len = length(v);
-    return len > 0.0001f ? v / len : Vec2{0.0f, 0.0f};
-}
-
 using namespace json;
 
 std::optional<JsonValue> loadJsonDocument(AssetManager &assets, const std::string &path,
@@ -448,718 +418,54 @@ bool loadTileMap(AssetManager &assets, const std::string &path, TileMap &out)
             else if (lower == "deco" || lower == "decor" || lower == "decoration")
             {
                 out.deco = std::move(tiles);
-            }
-        }
-
-        searchPos = layerClose;
-    }
-
-    const bool dimensionsValid = out.width > 0 && out.height > 0 && out.tileWidth > 0 && out.tileHeight > 0;
-    return dimensionsValid && out.tileset.get();
-}
-const char *temperamentBehaviorName(TemperamentBehavior behavior)
-{
-    switch (behavior)
-    {
-    case TemperamentBehavior::ChargeNearest: return "Charge";
-    case TemperamentBehavior::FleeNearest: return "Flee";
-    case TemperamentBehavior::FollowYuna: return "Follow";
-    case TemperamentBehavior::RaidGate: return "Raid";
-    case TemperamentBehavior::Homebound: return "Home";
-    case TemperamentBehavior::Wander: return "Wander";
-    case TemperamentBehavior::Doze: return "Doze";
-    case TemperamentBehavior::GuardBase: return "Guard";
-    case TemperamentBehavior::TargetTag: return "Target";
-    case TemperamentBehavior::Mimic: return "Mimic";
-    }
-    return "Unknown";
-}
-
-Vec2 tileToWorld(const Vec2 &tile, int tileSize)
-{
-    return {tile.x * tileSize + tileSize * 0.5f, tile.y * tileSize + tileSize * 0.5f};
-}
-
-Vec2 leftmostGateWorld(const MapDefs &defs)
-{
-    Vec2 best{0.0f, 0.0f};
-    float bestX = std::numeric_limits<float>::infinity();
-    for (const auto &kv : defs.gate_tiles)
-    {
-        Vec2 gateWorld = tileToWorld(kv.second, defs.tile_size);
-        if (gateWorld.x < bestX)
-        {
-            bestX = gateWorld.x;
-            best = gateWorld;
-        }
-    }
-    if (std::isinf(bestX))
-    {
-        return tileToWorld(defs.base_tile, defs.tile_size);
-    }
-    return best;
-}
-
-std::vector<Vec2> computeFormationOffsets(Formation formation, std::size_t count)
-{
-    std::vector<Vec2> offsets;
-    offsets.reserve(count);
-    if (count == 0)
-    {
-        return offsets;
-    }
-    if (count == 1)
-    {
-        offsets.push_back({0.0f, 32.0f});
-        return offsets;
-    }
-    constexpr float pi = 3.14159265358979323846f;
-    switch (formation)
-    {
-    case Formation::Swarm:
-    case Formation::Ring:
-    {
-        const float radius = formation == Formation::Ring ? 40.0f : 48.0f;
-        for (std::size_t i = 0; i < count; ++i)
-        {
-            const float angle = (static_cast<float>(i) / static_cast<float>(count)) * 2.0f * pi;
-            offsets.push_back({std::cos(angle) * radius, std::sin(angle) * radius});
-        }
-        break;
-    }
-    case Formation::Line:
-    {
-        for (std::size_t i = 0; i < count; ++i)
-        {
-            const float offsetX = (static_cast<float>(i) - (static_cast<float>(count) - 1.0f) * 0.5f) * 24.0f;
-            offsets.push_back({offsetX, 32.0f});
-        }
-        break;
-    }
-    case Formation::Wedge:
-    {
-        std::size_t produced = 0;
-        int row = 0;
-        while (produced < count)
-        {
-            const int rowCount = row + 1;
-            for (int i = 0; i < rowCount && produced < count; ++i)
-            {
-                const float offsetX = (static_cast<float>(i) - (rowCount - 1) * 0.5f) * 26.0f;
-                const float offsetY = 32.0f + row * 28.0f;
-                offsets.push_back({offsetX, offsetY});
-                ++produced;
-            }
-            ++row;
-        }
-        break;
-    }
-    }
-    return offsets;
-}
-
-const char *stanceLabel(ArmyStance stance)
-{
-    switch (stance)
-    {
-    case ArmyStance::RushNearest: return "Rush Nearest";
-    case ArmyStance::PushForward: return "Push Forward";
-    case ArmyStance::FollowLeader: return "Follow Leader";
-    case ArmyStance::DefendBase: return "Defend Base";
-    }
-    return "Unknown";
-}
-
-using world::LegacySimulation;
-
-namespace world
-{
-
-WorldState::WorldState()
-    : m_sim(std::make_unique<LegacySimulation>()),
-      m_allies(std::make_unique<ComponentPool<Unit>>()),
-      m_enemies(std::make_unique<ComponentPool<EnemyUnit>>()),
-      m_walls(std::make_unique<ComponentPool<WallSegment>>()),
-      m_captureZones(std::make_unique<ComponentPool<CaptureRuntime>>()),
-      m_waveController(std::make_unique<spawn::WaveController>()),
-      m_spawner(std::make_unique<spawn::Spawner>()),
-      m_frameAllocator()
-{
-    m_waveController->setSpawner(m_spawner.get());
-    m_spawner->setGateChecks(
-        [this](const std::string &gate) {
-            return m_sim->disabledGates.find(gate) != m_sim->disabledGates.end();
-        },
-        [this](const std::string &gate) {
-            if (const GateRuntime *runtime = m_sim->findGate(gate))
-            {
-                return runtime->destroyed;
-            }
-            return false;
-        });
-    initializeSystems();
-}
-
-WorldState::WorldState(WorldState &&other) noexcept = default;
-
-WorldState &WorldState::operator=(WorldState &&other) noexcept = default;
-
-WorldState::~WorldState() = default;
-
-LegacySimulation &WorldState::legacy()
-{
-    return *m_sim;
-}
-
-const LegacySimulation &WorldState::legacy() const
-{
-    return *m_sim;
-}
-
-void WorldState::setWorldBounds(float width, float height)
-{
-    m_sim->setWorldBounds(width, height);
-    markComponentsDirty();
-}
-
-void WorldState::configureSkills(const std::vector<SkillDef> &defs)
-{
-    systems::JobAbilitySystem::installDefaultHandlers(defs);
-    m_sim->configureSkills(defs);
-    markComponentsDirty();
-}
-
-void WorldState::reset()
-{
-    m_sim->reset();
-    if (m_spawner)
-    {
-        m_spawner->clear();
-        spawn::SpawnBudget budget;
-        budget.maxPerFrame = m_sim->config.spawnBudget.maxPerFrame;
-        m_spawner->setBudget(budget);
-        m_baseSpawnBudgetMax = budget.maxPerFrame;
-        if (m_enemySpawnMultiplier != 1.0f)
-        {
-            setEnemySpawnMultiplier(m_enemySpawnMultiplier);
-        }
-    }
-    if (m_waveController)
-    {
-        m_waveController->setSpawnScript(m_sim->spawnScript, m_sim->mapDefs);
-    }
-    m_sim->waveScriptComplete = false;
-    m_sim->spawnerIdle = true;
-    if (auto *formation = formationSystem())
-    {
-        formation->reset(*m_sim);
-    }
-    markComponentsDirty();
-}
-
-systems::SystemContext WorldState::makeSystemContext(const ActionBuffer &actions)
-{
-    systems::MissionContext missionContext{
-        m_sim->hasMission,
-        m_sim->missionConfig,
-        m_sim->missionMode,
-        m_sim->missionUI,
-        m_sim->missionFail,
-        m_sim->missionTimer,
-        m_sim->missionVictoryCountdown};
-
-    systems::SystemContext context{
-        *m_sim,
-        m_registry,
-        *m_allies,
-        *m_enemies,
-        *m_walls,
-        *m_captureZones,
-        m_sim->commander,
-        m_sim->hud,
-        m_sim->baseHp,
-        m_sim->orderActive,
-        m_sim->orderTimer,
-        m_sim->waveScriptComplete,
-        m_sim->spawnerIdle,
-        m_sim->timeSinceLastEnemySpawn,
-        m_sim->skills,
-        m_sim->selectedSkill,
-        m_sim->rallyState,
-        m_sim->spawnRateMultiplier,
-        m_sim->spawnSlowMultiplier,
-        m_sim->spawnSlowTimer,
-        m_sim->yunas,
-        m_sim->enemies,
-        m_sim->walls,
-        m_sim->gates,
-        m_sim->yunaRespawns,
-        m_sim->commanderRespawnTimer,
-        m_sim->commanderInvulnTimer,
-        m_frameAllocator,
-        missionContext,
-        actions,
-        m_eventBus,
-        m_telemetry,
-        false};
-    return context;
-}
-
-void WorldState::initializeSystems()
-{
-    clearSystems();
-
-    auto commanderInput = std::make_unique<systems::CommanderInputSystem>();
-    auto formation = std::make_unique<systems::FormationSystem>();
-    formation->reset(*m_sim);
-    if (m_eventBus)
-    {
-        formation->setEventBus(std::weak_ptr<EventBus>(m_eventBus));
-    }
-    if (m_telemetry)
-    {
-        formation->setTelemetrySink(std::weak_ptr<TelemetrySink>(m_telemetry));
-    }
-
-    auto morale = std::make_unique<systems::MoraleSystem>();
-    auto behavior = std::make_unique<systems::BehaviorSystem>();
-    auto movement = std::make_unique<systems::MovementSystem>();
-    auto combat = std::make_unique<systems::CombatSystem>();
-    auto jobAbility = std::make_unique<systems::JobAbilitySystem>();
-    auto spawn = std::make_unique<systems::SpawnSystem>();
-    auto rendering = std::make_unique<systems::RenderingPrepSystem>();
-
-    registerSystem(systems::SystemStage::InputProcessing, std::move(commanderInput));
-    registerSystem(systems::SystemStage::CommandAndMorale, std::move(formation));
-    registerSystem(systems::SystemStage::CommandAndMorale, std::move(morale));
-    registerSystem(systems::SystemStage::AiDecision, std::move(behavior));
-    registerSystem(systems::SystemStage::Movement, std::move(movement));
-    registerSystem(systems::SystemStage::Combat, std::move(combat));
-    registerSystem(systems::SystemStage::StateUpdate, std::move(jobAbility));
-    registerSystem(systems::SystemStage::Spawn, std::move(spawn));
-    registerSystem(systems::SystemStage::RenderingPrep, std::move(rendering));
-}
-
-void WorldState::clearSystems()
-{
-    m_systems.clear();
-    m_systemStageOrder.clear();
-    m_cachedFormationSystem = nullptr;
-    m_cachedJobAbilitySystem = nullptr;
-}
-
-void WorldState::registerSystem(systems::SystemStage stage, std::unique_ptr<systems::ISystem> system)
-{
-    if (!system)
-    {
-        return;
-    }
-    if (!m_systemStageOrder.empty())
-    {
-        const systems::SystemStage lastStage = m_systemStageOrder.back();
-        if (static_cast<std::uint8_t>(stage) < static_cast<std::uint8_t>(lastStage))
-        {
-            throw std::logic_error("WorldState::registerSystem stage order violation");
-        }
-    }
-    if (auto *formation = dynamic_cast<systems::FormationSystem *>(system.get()))
-    {
-        m_cachedFormationSystem = formation;
-    }
-    if (auto *jobAbility = dynamic_cast<systems::JobAbilitySystem *>(system.get()))
-    {
-        m_cachedJobAbilitySystem = jobAbility;
-    }
-    m_systemStageOrder.push_back(stage);
-    m_systems.push_back(std::move(system));
-}
-
-const std::vector<systems::SystemStage> &WorldState::systemStageOrder() const
-{
-    return m_systemStageOrder;
-}
-
-void WorldState::advanceLegacyState(float dt)
-{
-    if (!m_sim)
-    {
-        return;
-    }
-
-    m_sim->simTime += dt;
-    if (m_sim->timeSinceLastEnemySpawn < 10000.0f)
-    {
-        m_sim->timeSinceLastEnemySpawn += dt;
-    }
-    if (m_sim->restartCooldown > 0.0f)
-    {
-        m_sim->restartCooldown = std::max(0.0f, m_sim->restartCooldown - dt);
-    }
-
-    m_sim->updateYunaSpawn(dt);
-    m_sim->updateCommanderRespawn(dt);
-    m_sim->updateWalls(dt);
-    m_sim->updateMission(dt);
-}
-
-void WorldState::runSpawnStage(float dt, systems::SystemContext &context)
-{
-    if (!m_sim)
-    {
-        return;
-    }
-
-    if (m_sim->spawnEnabled)
-    {
-        if (m_waveController)
-        {
-            std::vector<std::string> announcements = m_waveController->advance(m_sim->simTime);
-            for (const std::string &text : announcements)
-            {
-                if (!text.empty())
-                {
-                    m_sim->pushTelemetry(text);
-                }
-            }
-        }
-
-        if (m_spawner)
-        {
-            const float survivalMult = (m_sim->missionMode == MissionMode::Survival && m_sim->survival.spawnMultiplier > 0.0f)
-                                           ? std::max(m_sim->survival.spawnMultiplier, 0.1f)
-                                           : 1.0f;
-            const float debugMult = std::max(m_enemySpawnMultiplier, 0.1f);
-            const float combinedMult = std::max(survivalMult * debugMult, 0.1f);
-            if (std::fabs(combinedMult - 1.0f) > 0.0001f)
-            {
-                m_spawner->setIntervalModifier([combinedMult](float base) {
-                    if (combinedMult <= 0.0f)
-                    {
-                        return base;
-                    }
-                    return base / combinedMult;
-                });
-            }
-            else
-            {
-                m_spawner->setIntervalModifier({});
-            }
-
-            const auto emitResult = m_spawner->emit(dt, [this, &context](const spawn::SpawnPayload &payload) {
-                m_sim->spawnOneEnemy(payload.position, payload.type);
-                context.requestComponentSync();
-            });
-            if (emitResult.deferred > 0)
-            {
-                m_sim->handleSpawnDeferral(emitResult.deferred);
-            }
-        }
-    }
-
-    if (m_waveController)
-    {
-        m_sim->waveScriptComplete = m_waveController->isComplete();
-    }
-    if (m_spawner)
-    {
-        m_sim->spawnerIdle = m_spawner->empty();
-    }
-}
-
-void WorldState::step(float dt, const ActionBuffer &actions)
-{
-    m_frameAllocator.reset();
-    systems::SystemContext context = makeSystemContext(actions);
-
-    for (std::size_t i = 0; i < m_systems.size(); ++i)
-    {
-        if (!m_systems[i])
-        {
-            continue;
-        }
-
-        systems::SystemStage stage = systems::SystemStage::InputProcessing;
-        if (i < m_systemStageOrder.size())
-        {
-            stage = m_systemStageOrder[i];
-        }
-
-        switch (stage)
-        {
-        case systems::SystemStage::StateUpdate:
-            advanceLegacyState(dt);
-            m_systems[i]->update(dt, context);
-            context.componentsDirty = true;
-            break;
-        case systems::SystemStage::Spawn:
-        {
-            m_systems[i]->update(dt, context);
-            runSpawnStage(dt, context);
-            break;
-        }
-        default:
-            m_systems[i]->update(dt, context);
-            break;
-        }
-
-        if (context.componentsDirty)
-        {
-            markComponentsDirty();
-            context.componentsDirty = false;
-        }
-    }
-}
-
-std::size_t WorldState::frameAllocatorCapacity() const
-{
-    return m_frameAllocator.capacity();
-}
-
-std::size_t WorldState::frameAllocatorUsage() const
-{
-    return m_frameAllocator.used();
-}
-
-void WorldState::issueOrder(ArmyStance stance)
-{
-    if (auto *formation = formationSystem())
-    {
-        formation->issueOrder(stance, *m_sim);
-    }
-    markComponentsDirty();
-}
-
-void WorldState::cycleFormation(int direction)
-{
-    if (auto *formation = formationSystem())
-    {
-        formation->cycleFormation(direction, *m_sim);
-    }
-    markComponentsDirty();
-}
-
-void WorldState::selectSkillByHotkey(int hotkey)
-{
-    m_sim->selectSkillByHotkey(hotkey);
-    markComponentsDirty();
-}
-
-void WorldState::activateSelectedSkill(const Vec2 &worldPos)
-{
-    bool dirty = false;
-    if (m_cachedJobAbilitySystem)
-    {
-        ActionBuffer emptyActions;
-        systems::SystemContext context = makeSystemContext(emptyActions);
-        systems::SkillCommand command{m_sim->selectedSkill, worldPos};
-        m_cachedJobAbilitySystem->triggerSkill(context, command);
-        dirty = context.componentsDirty;
-    }
-    if (dirty)
-    {
-        markComponentsDirty();
-    }
-}
-
-void WorldState::setEventBus(std::shared_ptr<EventBus> bus)
-{
-    m_eventBus = std::move(bus);
-    if (m_waveController)
-    {
-        m_waveController->setEventBus(m_eventBus);
-    }
-    if (auto *formation = formationSystem())
-    {
-        formation->setEventBus(std::weak_ptr<EventBus>(m_eventBus));
-    }
-}
-
-void WorldState::setTelemetrySink(std::shared_ptr<TelemetrySink> sink)
-{
-    m_telemetry = std::move(sink);
-    if (m_sim)
-    {
-        m_sim->setTelemetrySink(std::weak_ptr<TelemetrySink>(m_telemetry));
-    }
-    if (m_waveController)
-    {
-        m_waveController->setTelemetrySink(m_telemetry);
-    }
-    if (auto *formation = formationSystem())
-    {
-        formation->setTelemetrySink(std::weak_ptr<TelemetrySink>(m_telemetry));
-    }
-}
-
-LegacySimulation::SpawnHistoryDumpResult WorldState::dumpSpawnHistory() const
-{
-    if (!m_sim || !m_waveController)
-    {
-        return {};
-    }
-    return m_sim->dumpSpawnHistory(*m_waveController);
-}
-
-bool WorldState::canRestart() const
-{
-    return m_sim->canRestart();
-}
-
-ComponentPool<Unit> &WorldState::allies()
-{
-    syncComponents();
-    return *m_allies;
-}
-
-const ComponentPool<Unit> &WorldState::allies() const
-{
-    return const_cast<WorldState *>(this)->allies();
-}
-
-ComponentPool<EnemyUnit> &WorldState::enemies()
-{
-    syncComponents();
-    return *m_enemies;
-}
-
-const ComponentPool<EnemyUnit> &WorldState::enemies() const
-{
-    return const_cast<WorldState *>(this)->enemies();
-}
-
-ComponentPool<WallSegment> &WorldState::walls()
-{
-    syncComponents();
-    return *m_walls;
-}
-
-const ComponentPool<WallSegment> &WorldState::walls() const
-{
-    return const_cast<WorldState *>(this)->walls();
-}
-
-ComponentPool<CaptureRuntime> &WorldState::missionZones()
-{
-    syncComponents();
-    return *m_captureZones;
-}
-
-const ComponentPool<CaptureRuntime> &WorldState::missionZones() const
-{
-    return const_cast<WorldState *>(this)->missionZones();
-}
-
-void WorldState::markComponentsDirty()
-{
-    m_componentsDirty = true;
-}
-
-void WorldState::setEnemySpawnMultiplier(float multiplier)
-{
-    const float clamped = std::clamp(multiplier, 0.1f, 5.0f);
-    m_enemySpawnMultiplier = clamped;
-    if (m_spawner)
-    {
-        const int baseBudget = m_baseSpawnBudgetMax > 0 ? m_baseSpawnBudgetMax : m_sim->config.spawnBudget.maxPerFrame;
-        const float effective = std::max(clamped, 0.1f);
-        const int adjustedBudget = std::max(1, static_cast<int>(std::round(static_cast<float>(baseBudget) * effective)));
-        spawn::SpawnBudget budget;
-        budget.maxPerFrame = adjustedBudget;
-        m_spawner->setBudget(budget);
-    }
-    markComponentsDirty();
-}
-
-float WorldState::enemySpawnMultiplier() const
-{
-    return m_enemySpawnMultiplier;
-}
-
-bool WorldState::skipNextWave()
-{
-    if (!m_waveController)
-    {
-        return false;
-    }
-    std::vector<std::string> announcements;
-    const bool triggered = m_waveController->triggerNextWave(m_sim->simTime, announcements);
-    if (!triggered)
-    {
-        return false;
-    }
-    for (const std::string &text : announcements)
-    {
-        if (!text.empty())
-        {
-            m_sim->pushTelemetry(text);
-        }
-    }
-    markComponentsDirty();
-    return true;
-}
-
-void WorldState::rebuildMissionComponents() const
-{
-    m_captureZones->clear(m_registry);
-    for (const CaptureRuntime &zone : m_sim->captureZones)
-    {
-        m_captureZones->create(m_registry, zone);
-    }
-}
-
-void WorldState::syncComponents() const
-{
-    if (!m_componentsDirty)
-    {
-        return;
-    }
+            }
+        }
 
-    if (!m_allies)
-    {
-        m_allies = std::make_unique<ComponentPool<Unit>>();
-    }
-    if (!m_enemies)
-    {
-        m_enemies = std::make_unique<ComponentPool<EnemyUnit>>();
-    }
-    if (!m_walls)
-    {
-        m_walls = std::make_unique<ComponentPool<WallSegment>>();
-    }
-    if (!m_captureZones)
-    {
-        m_captureZones = std::make_unique<ComponentPool<CaptureRuntime>>();
+        searchPos = layerClose;
     }
 
-    m_allies->clear(m_registry);
-    for (const Unit &unit : m_sim->yunas)
+    const bool dimensionsValid = out.width > 0 && out.height > 0 && out.tileWidth > 0 && out.tileHeight > 0;
+    return dimensionsValid && out.tileset.get();
+}
+const char *temperamentBehaviorName(TemperamentBehavior behavior)
+{
+    switch (behavior)
     {
-        m_allies->create(m_registry, unit);
+    case TemperamentBehavior::ChargeNearest: return "Charge";
+    case TemperamentBehavior::FleeNearest: return "Flee";
+    case TemperamentBehavior::FollowYuna: return "Follow";
+    case TemperamentBehavior::RaidGate: return "Raid";
+    case TemperamentBehavior::Homebound: return "Home";
+    case TemperamentBehavior::Wander: return "Wander";
+    case TemperamentBehavior::Doze: return "Doze";
+    case TemperamentBehavior::GuardBase: return "Guard";
+    case TemperamentBehavior::TargetTag: return "Target";
+    case TemperamentBehavior::Mimic: return "Mimic";
     }
+    return "Unknown";
+}
 
-    m_enemies->clear(m_registry);
-    for (const EnemyUnit &enemy : m_sim->enemies)
+Vec2 leftmostGateWorld(const MapDefs &defs)
+{
+    Vec2 best{0.0f, 0.0f};
+    float bestX = std::numeric_limits<float>::infinity();
+    for (const auto &kv : defs.gate_tiles)
     {
-        m_enemies->create(m_registry, enemy);
+        Vec2 gateWorld = tileToWorld(kv.second, defs.tile_size);
+        if (gateWorld.x < bestX)
+        {
+            bestX = gateWorld.x;
+            best = gateWorld;
+        }
     }
-
-    m_walls->clear(m_registry);
-    for (const WallSegment &wall : m_sim->walls)
+    if (std::isinf(bestX))
     {
-        m_walls->create(m_registry, wall);
+        return tileToWorld(defs.base_tile, defs.tile_size);
     }
-
-    rebuildMissionComponents();
-
-    m_componentsDirty = false;
-}
-
-systems::FormationSystem *WorldState::formationSystem() const
-{
-    return m_cachedFormationSystem;
+    return best;
 }
 
-} // namespace world
+using world::LegacySimulation;
 
 struct Camera
 {
@@ -1172,26 +478,43 @@ Vec2 worldToScreen(const Vec2 &world, const Camera &camera)
     return {world.x - camera.position.x, world.y - camera.position.y};
 }
 
-Vec2 screenToWorld(int screenX, int screenY, const Camera &camera)
+constexpr SDL_Color kBlockLayerTint{190, 190, 200, 255};
+
+bool bakeTileChunks(SDL_Renderer *renderer, const TileMap &map, TileChunkCache &cache)
 {
-    return {static_cast<float>(screenX) + camera.position.x, static_cast<float>(screenY) + camera.position.y};
+    TileChunkCache::Sheet sheet;
+    sheet.texture = map.tileset.getRaw();
+    sheet.mapWidth = map.width;
+    sheet.mapHeight = map.height;
+    sheet.tileWidth = map.tileWidth;
+    sheet.tileHeight = map.tileHeight;
+    sheet.columns = map.tilesetColumns;
+    const std::vector<TileChunkCache::Layer> layers{
+        {&map.floor, SDL_Color{255, 255, 255, 255}},
+        {&map.block, kBlockLayerTint},
+        {&map.deco, SDL_Color{255, 255, 255, 255}}};
+    return cache.build(renderer, sheet, layers);
 }
 
-void drawTileLayer(SDL_Renderer *renderer, const TileMap &map, const std::vector<int> &tiles, const Camera &camera, int screenW,
-                   int screenH, RenderStats &stats)
+void drawTileLayer(SpriteBatch &batch, const TileMap &map, const std::vector<int> &tiles, const Camera &camera, int screenW,
+                   int screenH, SDL_Color tint = SDL_Color{255, 255, 255, 255})
 {
     if (!map.tileset.get())
     {
         return;
     }
     const int totalTiles = static_cast<int>(tiles.size());
-    if (totalTiles == 0)
+    if (totalTiles == 0 || map.tileWidth <= 0 || map.tileHeight <= 0)
     {
         return;
     }
-    for (int y = 0; y < map.height; ++y)
+    const int minX = std::max(static_cast<int>(std::floor(camera.position.x / map.tileWidth)), 0);
+    const int minY = std::max(static_cast<int>(std::floor(camera.position.y / map.tileHeight)), 0);
+    const int maxX = std::min(static_cast<int>(std::floor((camera.position.x + screenW) / map.tileWidth)), map.width - 1);
+    const int maxY = std::min(static_cast<int>(std::floor((camera.position.y + screenH) / map.tileHeight)), map.height - 1);
+    for (int y = minY; y <= maxY; ++y)
     {
-        for (int x = 0; x < map.width; ++x)
+        for (int x = minX; x <= maxX; ++x)
         {
             const int index = y * map.width + x;
             if (index < 0 || index >= totalTiles)
@@ -1216,16 +539,17 @@ void drawTileLayer(SDL_Renderer *renderer, const TileMap &map, const std::vector
             {
                 continue;
             }
-            countedRenderCopy(renderer, map.tileset.getRaw(), &src, &dst, stats);
+            batch.draw(map.tileset.getRaw(), src, dst, tint);
         }
     }
 }
 
 void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const FormationHudStatus *formationHud,
                  const MoraleHudStatus *moraleHud, const JobHudStatus *jobHud, const Camera &camera,
-                 const TextRenderer &font, const TextRenderer &debugFont, const TileMap &map,
+                 const TextRenderer &font, const TextRenderer &debugFont, const TileMap &map, const TileChunkCache &tileChunks,
                  const Atlas &atlas, int screenW, int screenH, RenderStats &stats)
 {
+    KUSOZAKO_TRACE_ZONE("renderWorld");
     (void)formationHud;
     (void)jobHud;
 
@@ -1233,6 +557,7 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
     const bool skipActors = queue.skipActors;
     const int lineHeight = std::max(font.getLineHeight(), 18);
     const int debugLineHeight = std::max(debugFont.isLoaded() ? debugFont.getLineHeight() : lineHeight, 14);
+    SpriteBatch batch(renderer, stats);
 
     auto measureWorldText = [](const TextRenderer &renderer, const std::string &text, int approxHeight) {
         const int measured = renderer.measureText(text);
@@ -1276,10 +601,7 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
         Vec2 screen = worldToScreen(worldPos, camera);
         const float iconRadius = std::max(4.0f, radius * 0.5f);
         Vec2 iconCenter{screen.x, screen.y - radius - iconRadius - 4.0f};
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-        drawFilledCircle(renderer, iconCenter, iconRadius, stats);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        batch.fillCircle(iconCenter, iconRadius, color);
     };
 
     auto temperamentColorForBehavior = [](TemperamentBehavior behavior) -> SDL_Color {
@@ -1361,14 +683,16 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
     SDL_SetRenderDrawColor(renderer, 26, 32, 38, 255);
     countedRenderClear(renderer, stats);
 
-    drawTileLayer(renderer, map, map.floor, camera, screenW, screenH, stats);
-    if (map.tileset.get())
+    if (tileChunks.isBuilt())
     {
-        SDL_SetTextureColorMod(map.tileset.getRaw(), 190, 190, 200);
-        drawTileLayer(renderer, map, map.block, camera, screenW, screenH, stats);
-        SDL_SetTextureColorMod(map.tileset.getRaw(), 255, 255, 255);
+        tileChunks.draw(batch, camera.position, screenW, screenH);
+    }
+    else
+    {
+        drawTileLayer(batch, map, map.floor, camera, screenW, screenH);
+        drawTileLayer(batch, map, map.block, camera, screenW, screenH, kBlockLayerTint);
+        drawTileLayer(batch, map, map.deco, camera, screenW, screenH);
     }
-    drawTileLayer(renderer, map, map.deco, camera, screenW, screenH, stats);
 
     // Draw base
     const Vec2 baseScreen = worldToScreen(sim.basePos, camera);
@@ -1382,10 +706,11 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
                 static_cast<int>(baseScreen.y - baseFrame->h * 0.5f),
                 baseFrame->w,
                 baseFrame->h};
-            countedRenderCopy(renderer, atlas.texture.getRaw(), baseFrame, &dest, stats);
+            batch.draw(atlas.texture.getRaw(), *baseFrame, dest);
         }
         else
         {
+            batch.flush();
             SDL_FRect baseRect{baseScreen.x - sim.config.base_aabb.x * 0.5f, baseScreen.y - sim.config.base_aabb.y * 0.5f, sim.config.base_aabb.x, sim.config.base_aabb.y};
             SDL_SetRenderDrawColor(renderer, 130, 90, 50, 255);
             countedRenderFillRectF(renderer, &baseRect, stats);
@@ -1393,10 +718,12 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
     }
     else
     {
+        batch.flush();
         SDL_FRect baseRect{baseScreen.x - sim.config.base_aabb.x * 0.5f, baseScreen.y - sim.config.base_aabb.y * 0.5f, sim.config.base_aabb.x, sim.config.base_aabb.y};
         SDL_SetRenderDrawColor(renderer, 130, 90, 50, 255);
         countedRenderFillRectF(renderer, &baseRect, stats);
     }
+    batch.flush();
 
     if (sim.missionMode == MissionMode::Capture)
     {
@@ -1488,115 +815,115 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
     const SDL_Rect *friendRing = atlas.getFrame("ring_friend");
     const SDL_Rect *enemyRing = atlas.getFrame("ring_enemy");
 
-    if (atlas.texture.get())
+    SDL_Texture *atlasTexture = atlas.texture.getRaw();
+    if (!atlasTexture)
     {
-        for (const LegacySimulation::RenderQueue::AllySprite &ally : queue.allies)
-        {
-            if (skipActors && !ally.commander)
-            {
-                continue;
-            }
+        commanderFrame = nullptr;
+        yunaFrame = nullptr;
+        enemyFrame = nullptr;
+        wallbreakerFrame = nullptr;
+        friendRing = nullptr;
+        enemyRing = nullptr;
+    }
 
-            Vec2 screenPos = worldToScreen(ally.position, camera);
-            if (ally.commander)
-            {
-                if (commanderFrame)
-                {
-                    SDL_Rect dest{
-                        static_cast<int>(screenPos.x - commanderFrame->w * 0.5f),
-                        static_cast<int>(screenPos.y - commanderFrame->h * 0.5f),
-                        commanderFrame->w,
-                        commanderFrame->h};
-                    countedRenderCopy(renderer, atlas.texture.getRaw(), commanderFrame, &dest, stats);
-                    if (friendRing)
-                    {
-                        SDL_Rect ringDest{
-                            dest.x + (dest.w - friendRing->w) / 2,
-                            dest.y + dest.h - friendRing->h,
-                            friendRing->w,
-                            friendRing->h};
-                        countedRenderCopy(renderer, atlas.texture.getRaw(), friendRing, &ringDest, stats);
-                    }
-                }
-                else
-                {
-                    SDL_SetRenderDrawColor(renderer, 200, 220, 255, 255);
-                    drawFilledCircle(renderer, screenPos, ally.radius, stats);
-                }
-                drawMoraleIcon(ally.position, ally.radius, commanderMorale);
-                continue;
-            }
+    auto centeredRect = [](const Vec2 &screenPos, const SDL_Rect &frame) {
+        return SDL_Rect{
+            static_cast<int>(screenPos.x - frame.w * 0.5f),
+            static_cast<int>(screenPos.y - frame.h * 0.5f),
+            frame.w,
+            frame.h};
+    };
 
-            if (yunaFrame)
+    auto ringRect = [](const SDL_Rect &dest, const SDL_Rect &ring) {
+        return SDL_Rect{dest.x + (dest.w - ring.w) / 2, dest.y + dest.h - ring.h, ring.w, ring.h};
+    };
+
+    // Actors are batched: every sprite, ring and solid circle below goes through SpriteBatch, and labels are
+    // drawn in a second pass so they do not split the batch. Opaque circles look the same with blending on.
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (const LegacySimulation::RenderQueue::AllySprite &ally : queue.allies)
+    {
+        if (skipActors && !ally.commander)
+        {
+            continue;
+        }
+
+        Vec2 screenPos = worldToScreen(ally.position, camera);
+        if (ally.commander)
+        {
+            if (commanderFrame)
             {
-                SDL_SetTextureAlphaMod(atlas.texture.getRaw(), ally.alpha);
-                SDL_Rect dest{
-                    static_cast<int>(screenPos.x - yunaFrame->w * 0.5f),
-                    static_cast<int>(screenPos.y - yunaFrame->h * 0.5f),
-                    yunaFrame->w,
-                    yunaFrame->h};
-                countedRenderCopy(renderer, atlas.texture.getRaw(), yunaFrame, &dest, stats);
-                SDL_SetTextureAlphaMod(atlas.texture.getRaw(), 255);
+                const SDL_Rect dest = centeredRect(screenPos, *commanderFrame);
+                batch.draw(atlasTexture, *commanderFrame, dest);
                 if (friendRing)
                 {
-                    SDL_Color ringColor = unitRingColor(ally.job);
-                    SDL_SetTextureColorMod(atlas.texture.getRaw(), ringColor.r, ringColor.g, ringColor.b);
-                    SDL_Rect ringDest{
-                        dest.x + (dest.w - friendRing->w) / 2,
-                        dest.y + dest.h - friendRing->h,
-                        friendRing->w,
-                        friendRing->h};
-                    countedRenderCopy(renderer, atlas.texture.getRaw(), friendRing, &ringDest, stats);
-                    SDL_SetTextureColorMod(atlas.texture.getRaw(), 255, 255, 255);
+                    batch.draw(atlasTexture, *friendRing, ringRect(dest, *friendRing));
                 }
-                drawTemperamentLabel(ally, static_cast<float>(dest.y), static_cast<float>(dest.x + dest.w * 0.5f));
             }
             else
             {
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_Color unitColor = unitRingColor(ally.job);
-                SDL_SetRenderDrawColor(renderer, unitColor.r, unitColor.g, unitColor.b, ally.alpha);
-                drawFilledCircle(renderer, screenPos, ally.radius, stats);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-                drawTemperamentLabel(ally, screenPos.y - ally.radius, screenPos.x);
+                batch.fillCircle(screenPos, ally.radius, SDL_Color{200, 220, 255, 255});
             }
+            continue;
+        }
 
-            MoraleState state = (ally.hasUnitIndex && ally.unitIndex < moraleStates.size()) ? moraleStates[ally.unitIndex]
-                                                                                            : ally.morale;
-            drawMoraleIcon(ally.position, ally.radius, state);
+        if (yunaFrame)
+        {
+            const SDL_Rect dest = centeredRect(screenPos, *yunaFrame);
+            batch.draw(atlasTexture, *yunaFrame, dest, SDL_Color{255, 255, 255, ally.alpha});
+            if (friendRing)
+            {
+                SDL_Color ringColor = unitRingColor(ally.job);
+                batch.draw(atlasTexture, *friendRing, ringRect(dest, *friendRing), ringColor);
+            }
+        }
+        else
+        {
+            SDL_Color unitColor = unitRingColor(ally.job);
+            unitColor.a = ally.alpha;
+            batch.fillCircle(screenPos, ally.radius, unitColor);
         }
-        SDL_SetTextureAlphaMod(atlas.texture.getRaw(), 255);
     }
-    else
+
+    for (const LegacySimulation::RenderQueue::AllySprite &ally : queue.allies)
+    {
+        if (skipActors && !ally.commander)
+        {
+            continue;
+        }
+        if (ally.commander)
+        {
+            drawMoraleIcon(ally.position, ally.radius, commanderMorale);
+            continue;
+        }
+        MoraleState state = (ally.hasUnitIndex && ally.unitIndex < moraleStates.size()) ? moraleStates[ally.unitIndex]
+                                                                                        : ally.morale;
+        drawMoraleIcon(ally.position, ally.radius, state);
+    }
+    batch.flush();
+
+    if (debugFont.isLoaded())
     {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
         for (const LegacySimulation::RenderQueue::AllySprite &ally : queue.allies)
         {
-            if (skipActors && !ally.commander)
+            if (skipActors || ally.commander)
             {
                 continue;
             }
             Vec2 screenPos = worldToScreen(ally.position, camera);
-            if (ally.commander)
+            if (yunaFrame)
             {
-                SDL_SetRenderDrawColor(renderer, 200, 220, 255, 255);
-                drawFilledCircle(renderer, screenPos, ally.radius, stats);
-                drawMoraleIcon(ally.position, ally.radius, commanderMorale);
-                continue;
+                const SDL_Rect dest = centeredRect(screenPos, *yunaFrame);
+                drawTemperamentLabel(ally, static_cast<float>(dest.y), static_cast<float>(dest.x + dest.w * 0.5f));
+            }
+            else
+            {
+                drawTemperamentLabel(ally, screenPos.y - ally.radius, screenPos.x);
             }
-
-            SDL_Color unitColor = unitRingColor(ally.job);
-            SDL_SetRenderDrawColor(renderer, unitColor.r, unitColor.g, unitColor.b, ally.alpha);
-            drawFilledCircle(renderer, screenPos, ally.radius, stats);
-            drawTemperamentLabel(ally, screenPos.y - ally.radius, screenPos.x);
-            MoraleState state = (ally.hasUnitIndex && ally.unitIndex < moraleStates.size()) ? moraleStates[ally.unitIndex]
-                                                                                            : ally.morale;
-            drawMoraleIcon(ally.position, ally.radius, state);
         }
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     }
 
-    SDL_SetRenderDrawColor(renderer, 120, 150, 200, 255);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     for (const LegacySimulation::RenderQueue::WallSprite &wall : queue.walls)
     {
         if (skipActors)
@@ -1604,125 +931,79 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
             continue;
         }
         Vec2 screenPos = worldToScreen(wall.position, camera);
-        drawFilledCircle(renderer, screenPos, wall.radius, stats);
+        batch.fillCircle(screenPos, wall.radius, SDL_Color{120, 150, 200, 255});
     }
 
-    if (atlas.texture.get())
+    for (const LegacySimulation::RenderQueue::EnemySprite &enemy : queue.enemies)
     {
-        for (const LegacySimulation::RenderQueue::EnemySprite &enemy : queue.enemies)
+        if (skipActors && enemy.type != EnemyArchetype::Boss)
         {
-            if (skipActors && enemy.type != EnemyArchetype::Boss)
-            {
-                continue;
-            }
-            const SDL_Rect *frame = enemy.type == EnemyArchetype::Wallbreaker ? wallbreakerFrame : enemyFrame;
-            Vec2 screenPos = worldToScreen(enemy.position, camera);
-            if (enemy.type == EnemyArchetype::Boss)
-            {
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 255, 80, 160, 110);
-                drawFilledCircle(renderer, screenPos, enemy.radius + 26.0f, stats);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-            }
-
-            SDL_Rect spriteRect{};
-            bool hasSpriteRect = false;
-            if (frame)
-            {
-                SDL_Rect dest{
-                    static_cast<int>(screenPos.x - frame->w * 0.5f),
-                    static_cast<int>(screenPos.y - frame->h * 0.5f),
-                    frame->w,
-                    frame->h};
-                countedRenderCopy(renderer, atlas.texture.getRaw(), frame, &dest, stats);
-                if (enemyRing)
-                {
-                    SDL_Rect ringDest{
-                        dest.x + (dest.w - enemyRing->w) / 2,
-                        dest.y + dest.h - enemyRing->h,
-                        enemyRing->w,
-                        enemyRing->h};
-                    countedRenderCopy(renderer, atlas.texture.getRaw(), enemyRing, &ringDest, stats);
-                }
-                spriteRect = dest;
-                hasSpriteRect = true;
-            }
-            else
-            {
-                SDL_SetRenderDrawColor(renderer, enemy.type == EnemyArchetype::Wallbreaker ? 200 : 80,
-                                       enemy.type == EnemyArchetype::Wallbreaker ? 80 : 160,
-                                       enemy.type == EnemyArchetype::Wallbreaker ? 80 : 220, 255);
-                drawFilledCircle(renderer, screenPos, enemy.radius, stats);
-            }
+            continue;
+        }
+        const SDL_Rect *frame = enemy.type == EnemyArchetype::Wallbreaker ? wallbreakerFrame : enemyFrame;
+        Vec2 screenPos = worldToScreen(enemy.position, camera);
+        if (enemy.type == EnemyArchetype::Boss)
+        {
+            batch.fillCircle(screenPos, enemy.radius + 26.0f, SDL_Color{255, 80, 160, 110});
+        }
 
-            if (enemy.type == EnemyArchetype::Boss && debugFont.isLoaded())
+        if (frame)
+        {
+            const SDL_Rect dest = centeredRect(screenPos, *frame);
+            batch.draw(atlasTexture, *frame, dest);
+            if (enemyRing)
             {
-                const std::string bossText = "BOSS";
-                const int textWidth = measureWorldText(debugFont, bossText, debugLineHeight);
-                const int padX = 6;
-                const int padY = 3;
-                const float spriteTop = hasSpriteRect ? static_cast<float>(spriteRect.y) : screenPos.y - enemy.radius;
-                const float centerX = hasSpriteRect ? static_cast<float>(spriteRect.x + spriteRect.w * 0.5f) : screenPos.x;
-                SDL_Rect labelBg{
-                    static_cast<int>(std::round(centerX)) - textWidth / 2 - padX,
-                    static_cast<int>(std::round(spriteTop)) - (debugLineHeight + padY * 2) - 8,
-                    textWidth + padX * 2,
-                    debugLineHeight + padY * 2
-                };
-                if (labelBg.x < 4) labelBg.x = 4;
-                if (labelBg.x + labelBg.w > screenW - 4) labelBg.x = screenW - labelBg.w - 4;
-                if (labelBg.y < 4) labelBg.y = 4;
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 70, 0, 80, 200);
-                countedRenderFillRect(renderer, &labelBg, stats);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-                debugFont.drawText(renderer, bossText, labelBg.x + padX, labelBg.y + padY, &stats,
-                                   SDL_Color{255, 180, 255, 255});
+                batch.draw(atlasTexture, *enemyRing, ringRect(dest, *enemyRing));
             }
         }
+        else
+        {
+            const bool wallbreaker = enemy.type == EnemyArchetype::Wallbreaker;
+            batch.fillCircle(screenPos, enemy.radius,
+                             SDL_Color{static_cast<Uint8>(wallbreaker ? 200 : 80), static_cast<Uint8>(wallbreaker ? 80 : 160),
+                                       static_cast<Uint8>(wallbreaker ? 80 : 220), 255});
+        }
     }
-    else
+    batch.flush();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    if (debugFont.isLoaded())
     {
         for (const LegacySimulation::RenderQueue::EnemySprite &enemy : queue.enemies)
         {
-            if (skipActors && enemy.type != EnemyArchetype::Boss)
+            if (enemy.type != EnemyArchetype::Boss)
             {
                 continue;
             }
+            const SDL_Rect *frame = enemyFrame;
             Vec2 screenPos = worldToScreen(enemy.position, camera);
-            if (enemy.type == EnemyArchetype::Boss)
-            {
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 255, 80, 160, 110);
-                drawFilledCircle(renderer, screenPos, enemy.radius + 26.0f, stats);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-            }
-            SDL_SetRenderDrawColor(renderer, enemy.type == EnemyArchetype::Wallbreaker ? 200 : 80,
-                                   enemy.type == EnemyArchetype::Wallbreaker ? 80 : 160,
-                                   enemy.type == EnemyArchetype::Wallbreaker ? 80 : 220, 255);
-            drawFilledCircle(renderer, screenPos, enemy.radius, stats);
-            if (enemy.type == EnemyArchetype::Boss && debugFont.isLoaded())
+            const std::string bossText = "BOSS";
+            const int textWidth = measureWorldText(debugFont, bossText, debugLineHeight);
+            const int padX = 6;
+            const int padY = 3;
+            float spriteTop = screenPos.y - enemy.radius;
+            float centerX = screenPos.x;
+            if (frame)
             {
-                const std::string bossText = "BOSS";
-                const int textWidth = measureWorldText(debugFont, bossText, debugLineHeight);
-                const int padX = 6;
-                const int padY = 3;
-                SDL_Rect labelBg{
-                    static_cast<int>(std::round(screenPos.x)) - textWidth / 2 - padX,
-                    static_cast<int>(std::round(screenPos.y - enemy.radius)) - (debugLineHeight + padY * 2) - 8,
-                    textWidth + padX * 2,
-                    debugLineHeight + padY * 2
-                };
-                if (labelBg.x < 4) labelBg.x = 4;
-                if (labelBg.x + labelBg.w > screenW - 4) labelBg.x = screenW - labelBg.w - 4;
-                if (labelBg.y < 4) labelBg.y = 4;
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 70, 0, 80, 200);
-                countedRenderFillRect(renderer, &labelBg, stats);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-                debugFont.drawText(renderer, bossText, labelBg.x + padX, labelBg.y + padY, &stats,
-                                   SDL_Color{255, 180, 255, 255});
+                const SDL_Rect spriteRect = centeredRect(screenPos, *frame);
+                spriteTop = static_cast<float>(spriteRect.y);
+                centerX = static_cast<float>(spriteRect.x + spriteRect.w * 0.5f);
             }
+            SDL_Rect labelBg{
+                static_cast<int>(std::round(centerX)) - textWidth / 2 - padX,
+                static_cast<int>(std::round(spriteTop)) - (debugLineHeight + padY * 2) - 8,
+                textWidth + padX * 2,
+                debugLineHeight + padY * 2
+            };
+            if (labelBg.x < 4) labelBg.x = 4;
+            if (labelBg.x + labelBg.w > screenW - 4) labelBg.x = screenW - labelBg.w - 4;
+            if (labelBg.y < 4) labelBg.y = 4;
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, 70, 0, 80, 200);
+            countedRenderFillRect(renderer, &labelBg, stats);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            debugFont.drawText(renderer, bossText, labelBg.x + padX, labelBg.y + padY, &stats,
+                               SDL_Color{255, 180, 255, 255});
         }
     }
 
@@ -1738,7 +1019,8 @@ void renderWorld(SDL_Renderer *renderer, const LegacySimulation &sim, const Form
 class BattleScene : public Scene
 {
   public:
-    BattleScene();
+    // A non-empty path records every handled input frame of the session there (see world::InputRecorder).
+    explicit BattleScene(std::filesystem::path inputRecordingPath = {});
 
     void onEnter(GameApplication &app, SceneStack &stack) override;
     void onExit(GameApplication &app, SceneStack &stack) override;
@@ -1751,6 +1033,8 @@ class BattleScene : public Scene
     void handleActionFrame(const ActionBuffer::Frame &frame, GameApplication &app);
     void applyAppConfig(GameApplication &app);
     void showTelemetryMessage(const std::string &message);
+    void startInputRecording(const AppConfigLoadResult &configResult);
+    void finishInputRecording(const char *reason);
     void evaluatePerformanceBudgets(GameApplication &app);
     void raisePerformanceWarning(const telemetry::BudgetViolation &violation, GameApplication &app);
 
@@ -1759,10 +1043,13 @@ class BattleScene : public Scene
       public:
         explicit DebugSimulationAccessor(BattleScene &scene) : m_scene(scene) {}
 
+        void beginSimulationEdit() override;
         void markComponentsDirty() override;
         void setEnemySpawnMultiplier(float multiplier) override;
         float enemySpawnMultiplier() const override;
         bool skipNextWave() override;
+        bool rewind(float &restoredTime) override;
+        std::size_t rewindSnapshots() const override;
 
       private:
         BattleScene &m_scene;
@@ -1771,6 +1058,7 @@ class BattleScene : public Scene
     bool m_initialized = false;
     world::WorldState m_world;
     TileMap m_tileMap;
+    TileChunkCache m_tileChunks;
     Atlas m_atlas;
     TextRenderer m_hudFont;
     TextRenderer m_debugFont;
@@ -1808,6 +1096,9 @@ class BattleScene : public Scene
     std::uint64_t m_inputSequence = 0;
     std::uint64_t m_lastProcessedSequence = 0;
     bool m_haveProcessedSequence = false;
+    std::filesystem::path m_inputRecordingPath;
+    world::InputRecorder m_inputRecorder;
+    world::RewindBuffer m_rewindBuffer;
     bool m_pendingBudgetCheck = false;
     struct StageTimings
     {
@@ -1820,6 +1111,7 @@ class BattleScene : public Scene
     telemetry::PerformanceBudgetMonitor m_budgetMonitor{};
     Uint64 m_lastBudgetWarningTick = 0;
     static constexpr Uint64 BudgetWarningCooldownMs = 1000;
+    static constexpr std::size_t TraceCaptureFrames = 30;
     void initializeDebugBindings(GameApplication &app);
     void updateDebugToggles();
     debug::DebugController m_debugController;
@@ -1830,7 +1122,10 @@ class BattleScene : public Scene
     int m_cursorRestoreState = SDL_QUERY;
 };
 
-BattleScene::BattleScene() : m_debugAccessor(*this) {}
+BattleScene::BattleScene(std::filesystem::path inputRecordingPath)
+    : m_inputRecordingPath(std::move(inputRecordingPath)), m_debugAccessor(*this)
+{
+}
 
 void BattleScene::onEnter(GameApplication &app, SceneStack &stack)
 {
@@ -1881,6 +1176,7 @@ void BattleScene::onExit(GameApplication &app, SceneStack &stack)
     (void)app;
     (void)stack;
 
+    finishInputRecording("scene_exit");
     if (m_debugController.active())
     {
         if (m_cursorRestoreState != SDL_QUERY)
@@ -1898,6 +1194,7 @@ void BattleScene::onExit(GameApplication &app, SceneStack &stack)
     m_ui.setEventBus(nullptr);
     m_ui.setTelemetrySink(nullptr);
     m_atlas.texture.reset();
+    m_tileChunks.clear();
     m_tileMap.tileset.reset();
     m_hudFont.unload();
     m_debugFont.unload();
@@ -1931,20 +1228,10 @@ void BattleScene::handleActionFrame(const ActionBuffer::Frame &frame, GameApplic
     }
     m_haveProcessedSequence = true;
     m_lastProcessedSequence = frame.sequence;
+    m_inputRecorder.beginFrame(frame);
 
     LegacySimulation &sim = m_world.legacy();
 
-    auto handleSkillSelect = [this](ActionId id) {
-        const int baseIndex = static_cast<int>(ActionId::SelectSkill1);
-        const int actionIndex = static_cast<int>(id);
-        const int skillOffset = actionIndex - baseIndex;
-        if (skillOffset >= 0)
-        {
-            const int hotkey = skillOffset + 1;
-            m_world.selectSkillByHotkey(hotkey);
-        }
-    };
-
     for (const ActionEvent &evt : frame.events)
     {
         if (!evt.pressed && evt.id != ActionId::ActivateSkill)
@@ -1980,24 +1267,6 @@ void BattleScene::handleActionFrame(const ActionBuffer::Frame &frame, GameApplic
 
         switch (evt.id)
         {
-        case ActionId::CommanderOrderRushNearest:
-            m_world.issueOrder(ArmyStance::RushNearest);
-            break;
-        case ActionId::CommanderOrderPushForward:
-            m_world.issueOrder(ArmyStance::PushForward);
-            break;
-        case ActionId::CommanderOrderFollowLeader:
-            m_world.issueOrder(ArmyStance::FollowLeader);
-            break;
-        case ActionId::CommanderOrderDefendBase:
-            m_world.issueOrder(ArmyStance::DefendBase);
-            break;
-        case ActionId::CycleFormationPrevious:
-            m_world.cycleFormation(-1);
-            break;
-        case ActionId::CycleFormationNext:
-            m_world.cycleFormation(1);
-            break;
         case ActionId::ToggleDebugHud:
             m_showDebugHud = !m_showDebugHud;
             break;
@@ -2045,29 +1314,6 @@ void BattleScene::handleActionFrame(const ActionBuffer::Frame &frame, GameApplic
         }
 #endif
             break;
-        case ActionId::RestartScenario:
-            if (sim.result != GameResult::Playing && m_world.canRestart())
-            {
-                m_world.reset();
-                m_baseCameraTarget = {sim.basePos.x - m_screenWidth * 0.5f, sim.basePos.y - m_screenHeight * 0.5f};
-                m_introFocus = leftmostGateWorld(sim.mapDefs);
-                m_introCameraTarget = {m_introFocus.x - m_screenWidth * 0.5f,
-                                       m_introFocus.y - m_screenHeight * 0.5f};
-                m_camera.position = m_introCameraTarget;
-                m_introTimer = m_introDuration;
-                m_introActive = true;
-            }
-            break;
-        case ActionId::SelectSkill1:
-        case ActionId::SelectSkill2:
-        case ActionId::SelectSkill3:
-        case ActionId::SelectSkill4:
-        case ActionId::SelectSkill5:
-        case ActionId::SelectSkill6:
-        case ActionId::SelectSkill7:
-        case ActionId::SelectSkill8:
-            handleSkillSelect(evt.id);
-            break;
         case ActionId::FocusCommander:
             m_camera.position = {sim.commander.pos.x - m_screenWidth * 0.5f,
                                  sim.commander.pos.y - m_screenHeight * 0.5f};
@@ -2079,17 +1325,21 @@ void BattleScene::handleActionFrame(const ActionBuffer::Frame &frame, GameApplic
             m_introActive = false;
             m_introTimer = 0.0f;
             break;
-        case ActionId::ActivateSkill:
-            if (evt.pointer && evt.pointer->pressed)
-            {
-                Vec2 worldPos = screenToWorld(evt.pointer->x, evt.pointer->y, m_camera);
-                m_world.activateSelectedSkill(worldPos);
-            }
-            break;
         case ActionId::QuitGame:
             app.requestQuit();
             break;
         default:
+            m_inputRecorder.recordEvent(evt, m_camera.position);
+            if (m_world.applyAction(evt, m_camera.position))
+            {
+                m_baseCameraTarget = {sim.basePos.x - m_screenWidth * 0.5f, sim.basePos.y - m_screenHeight * 0.5f};
+                m_introFocus = leftmostGateWorld(sim.mapDefs);
+                m_introCameraTarget = {m_introFocus.x - m_screenWidth * 0.5f,
+                                       m_introFocus.y - m_screenHeight * 0.5f};
+                m_camera.position = m_introCameraTarget;
+                m_introTimer = m_introDuration;
+                m_introActive = true;
+            }
             break;
         }
     }
@@ -2104,6 +1354,15 @@ void BattleScene::update(double deltaSeconds, GameApplication &app, SceneStack &
         return;
     }
 
+    // Frame captures, whether from the debug toggle or a budget violation, also record a timeline trace.
+    telemetry::TraceProfiler &profiler = telemetry::TraceProfiler::instance();
+    if (m_telemetry && m_telemetry->frameCaptureRequested())
+    {
+        profiler.requestCapture(TraceCaptureFrames);
+    }
+    profiler.markFrame(m_telemetry.get());
+    KUSOZAKO_TRACE_ZONE("BattleScene::update");
+
     m_debugController.update(deltaSeconds);
     updateDebugToggles();
 
@@ -2153,6 +1412,8 @@ void BattleScene::update(double deltaSeconds, GameApplication &app, SceneStack &
             inputMsAccum += (inputEnd - inputStart) * tickToMs;
         }
         m_world.step(dt, m_actionBuffer);
+        m_inputRecorder.recordStep(m_world);
+        m_rewindBuffer.capture(m_world);
         m_accumulator -= dt;
         ++stepIndex;
         producedFrame = true;
@@ -2226,6 +1487,10 @@ void BattleScene::updateDebugToggles()
     {
         m_showTelemetryOverlay = !m_showTelemetryOverlay;
     }
+    if (m_debugController.consumeTraceCaptureToggle() && m_telemetry)
+    {
+        m_telemetry->requestFrameCapture();
+    }
 }
 
 void BattleScene::initializeDebugBindings(GameApplication &app)
@@ -2238,6 +1503,12 @@ void BattleScene::initializeDebugBindings(GameApplication &app)
     m_debugController.onConfigReloaded();
 }
 
+void BattleScene::DebugSimulationAccessor::beginSimulationEdit()
+{
+    // Debug edits are not part of the recorded inputs, so replaying past them would diverge.
+    m_scene.finishInputRecording("debug_edit");
+}
+
 void BattleScene::DebugSimulationAccessor::markComponentsDirty()
 {
     m_scene.m_world.markComponentsDirty();
@@ -2245,6 +1516,7 @@ void BattleScene::DebugSimulationAccessor::markComponentsDirty()
 
 void BattleScene::DebugSimulationAccessor::setEnemySpawnMultiplier(float multiplier)
 {
+    beginSimulationEdit();
     m_scene.m_world.setEnemySpawnMultiplier(multiplier);
 }
 
@@ -2255,9 +1527,33 @@ float BattleScene::DebugSimulationAccessor::enemySpawnMultiplier() const
 
 bool BattleScene::DebugSimulationAccessor::skipNextWave()
 {
+    beginSimulationEdit();
     return m_scene.m_world.skipNextWave();
 }
 
+bool BattleScene::DebugSimulationAccessor::rewind(float &restoredTime)
+{
+    // Inputs recorded so far no longer lead to the restored state, so the recording ends here.
+    m_scene.finishInputRecording("rewind");
+    std::string error;
+    if (!m_scene.m_rewindBuffer.rewind(m_scene.m_world, error))
+    {
+        if (m_scene.m_telemetry)
+        {
+            m_scene.m_telemetry->recordEvent("world.rewind.error", {{"error", error}});
+        }
+        return false;
+    }
+    restoredTime = m_scene.m_world.legacy().simTime;
+    m_scene.m_accumulator = 0.0;
+    return true;
+}
+
+std::size_t BattleScene::DebugSimulationAccessor::rewindSnapshots() const
+{
+    return m_scene.m_rewindBuffer.size();
+}
+
 void BattleScene::render(SDL_Renderer *renderer, GameApplication &app)
 {
     (void)app;
@@ -2306,6 +1602,7 @@ void BattleScene::render(SDL_Renderer *renderer, GameApplication &app)
                 m_hudFont,
                 m_debugFont,
                 m_tileMap,
+                m_tileChunks,
                 m_atlas,
                 m_screenWidth,
                 m_screenHeight,
@@ -2446,6 +1743,21 @@ void BattleScene::evaluatePerformanceBudgets(GameApplication &app)
     sample.inputMs = m_lastStageTimings.inputMs;
     sample.hudMs = m_lastStageTimings.hudMs;
 
+    const world::StepTimings &stepTimings = m_world.stepTimings();
+    for (std::size_t stage = 0; stage < world::systems::kSystemStageCount; ++stage)
+    {
+        const auto stageId = static_cast<world::systems::SystemStage>(stage);
+        telemetry::SystemStageSample stageSample;
+        stageSample.stage = world::systems::systemStageId(stageId);
+        stageSample.ms = stepTimings.stages[stage].lastMs();
+        if (const world::SystemTiming *slowest = stepTimings.slowestIn(stageId))
+        {
+            stageSample.slowestSystem = slowest->name;
+            stageSample.slowestSystemMs = slowest->series.lastMs();
+        }
+        sample.systemStages.push_back(std::move(stageSample));
+    }
+
     if (auto violation = m_budgetMonitor.evaluate(sample))
     {
         raisePerformanceWarning(*violation, app);
@@ -2465,8 +1777,12 @@ void BattleScene::raisePerformanceWarning(const telemetry::BudgetViolation &viol
         return oss.str();
     };
 
-    const std::string warningText = "Performance spike: " + stageLabel + ' ' + formatMs(violation.sampleMs) +
-                                    "ms (budget " + formatMs(violation.budgetMs) + "ms)";
+    std::string warningText = "Performance spike: " + stageLabel + ' ' + formatMs(violation.sampleMs) +
+                              "ms (budget " + formatMs(violation.budgetMs) + "ms)";
+    if (!violation.system.empty())
+    {
+        warningText += " in " + violation.system + ' ' + formatMs(violation.systemMs) + "ms";
+    }
 
     m_framePerf.budgetExceeded = true;
     m_framePerf.budgetStage = stageLabel;
@@ -2486,6 +1802,11 @@ void BattleScene::raisePerformanceWarning(const telemetry::BudgetViolation &viol
         payload.emplace("sample_ms", formatMs(violation.sampleMs));
         payload.emplace("budget_ms", formatMs(violation.budgetMs));
         payload.emplace("tolerance_ms", formatMs(m_performanceBudget.toleranceMs));
+        if (!violation.system.empty())
+        {
+            payload.emplace("system", violation.system);
+            payload.emplace("system_ms", formatMs(violation.systemMs));
+        }
         m_telemetry->recordEvent("battle.performance.budget_exceeded", payload);
 
         const Uint64 now = SDL_GetTicks64();
@@ -2503,6 +1824,7 @@ void BattleScene::raisePerformanceWarning(const telemetry::BudgetViolation &viol
 int main(int argc, char **argv)
 {
     std::optional<std::filesystem::path> telemetryDir;
+    std::filesystem::path inputRecordingPath;
     constexpr std::string_view kTelemetryPrefix{"--telemetry-dir="};
     for (int i = 1; i < argc; ++i)
     {
@@ -2515,6 +1837,10 @@ int main(int argc, char **argv)
         {
             telemetryDir = std::filesystem::path(std::string(arg.substr(kTelemetryPrefix.size())));
         }
+        else if (arg == "--record-input" && i + 1 < argc)
+        {
+            inputRecordingPath = std::filesystem::path(argv[++i]);
+        }
     }
 
     auto configLoader = std::make_shared<AppConfigLoader>(std::filesystem::absolute("config"));
@@ -2523,7 +1849,7 @@ int main(int argc, char **argv)
     {
         app.setTelemetryOutputDirectory(*telemetryDir);
     }
-    app.sceneStack().push(std::make_unique<BattleScene>());
+    app.sceneStack().push(std::make_unique<BattleScene>(std::move(inputRecordingPath)));
     return app.run();
 }
 #endif
@@ -2556,12 +1882,18 @@ void BattleScene::applyAppConfig(GameApplication &app)
         telemetryNotify("app_config_errors", std::to_string(configResult.errors.size()));
     }
 
+    m_tileChunks.clear();
     m_tileMap = {};
     if (!loadTileMap(assets, appConfig.game.map_path, m_tileMap))
     {
         std::cerr << "Continuing without tilemap visuals.\n";
         telemetryNotify("tilemap_missing", appConfig.game.map_path);
     }
+    else
+    {
+        // Without render-target support the cache stays empty and renderWorld draws tiles one by one.
+        bakeTileChunks(app.renderer(), m_tileMap, m_tileChunks);
+    }
 
     m_atlas = {};
     if (!loadAtlas(assets, appConfig.atlasPath, m_atlas))
@@ -2570,28 +1902,11 @@ void BattleScene::applyAppConfig(GameApplication &app)
         telemetryNotify("atlas_missing", appConfig.atlasPath);
     }
 
+    // The recording only reproduces against the config it started with, so a reload ends it.
+    finishInputRecording("config_reloaded");
+
+    m_world.configure(appConfig);
     LegacySimulation &sim = m_world.legacy();
-    sim = {};
-    sim.config = appConfig.game;
-    sim.temperamentConfig = appConfig.temperament;
-    sim.yunaStats = appConfig.entityCatalog.yuna;
-    sim.slimeStats = appConfig.entityCatalog.slime;
-    sim.wallbreakerStats = appConfig.entityCatalog.wallbreaker;
-    sim.commanderStats = appConfig.entityCatalog.commander;
-    sim.mapDefs = appConfig.mapDefs;
-    sim.spawnScript = appConfig.spawnScript;
-    sim.formationDefaults = appConfig.game.formationDefaults;
-    sim.formationAlignTimer = 0.0f;
-    sim.formationDefenseMul = 1.0f;
-    if (appConfig.mission && appConfig.mission->mode != MissionMode::None)
-    {
-        sim.hasMission = true;
-        sim.missionConfig = *appConfig.mission;
-    }
-    else
-    {
-        sim.hasMission = false;
-    }
 
     m_world.setTelemetrySink(m_telemetry);
     m_world.setEventBus(m_eventBus);
@@ -2609,15 +1924,18 @@ void BattleScene::applyAppConfig(GameApplication &app)
         m_world.setWorldBounds(static_cast<float>(m_screenWidth), static_cast<float>(m_screenHeight));
     }
 
-    std::vector<SkillDef> skillDefs = appConfig.skills.empty() ? buildDefaultSkills() : appConfig.skills;
-    m_world.configureSkills(skillDefs);
+    const int workers = appConfig.game.worker_threads;
+    m_world.setWorkerThreads(workers < 0 ? world::JobScheduler::defaultWorkerCount()
+                                         : static_cast<std::size_t>(workers));
     m_world.reset();
+    m_rewindBuffer.clear();
 
     m_actionBuffer.clear();
     m_actionBuffer.setCapacity(static_cast<std::size_t>(std::max(1, appConfig.input.bufferFrames)));
     m_inputSequence = 0;
     m_haveProcessedSequence = false;
     m_lastProcessedSequence = 0;
+    startInputRecording(configResult);
 
     if (!m_hudFont.load(assets, "assets/ui/NotoSansJP-Regular.ttf", 22))
     {
@@ -2684,6 +2002,46 @@ void BattleScene::onConfigReloaded(GameApplication &app, SceneStack &stack)
     applyAppConfig(app);
 }
 
+void BattleScene::startInputRecording(const AppConfigLoadResult &configResult)
+{
+    if (m_inputRecordingPath.empty())
+    {
+        return;
+    }
+    const LegacySimulation &sim = m_world.legacy();
+    world::InputRecordingHeader header;
+    header.seed = static_cast<std::uint32_t>(sim.config.rng_seed);
+    header.configHash = configResult.contentHash;
+    header.fixedDt = sim.config.fixed_dt;
+    header.worldWidth = sim.worldMax.x;
+    header.worldHeight = sim.worldMax.y;
+    const std::filesystem::path path = std::exchange(m_inputRecordingPath, {});
+    if (!m_inputRecorder.open(path, header))
+    {
+        std::cerr << "Failed to open input recording " << path.string() << '\n';
+        if (m_telemetry)
+        {
+            m_telemetry->recordEvent("input.recording.error", {{"path", path.string()}});
+        }
+        return;
+    }
+    showTelemetryMessage("Recording input: " + path.filename().string());
+}
+
+void BattleScene::finishInputRecording(const char *reason)
+{
+    if (!m_inputRecorder.recording())
+    {
+        return;
+    }
+    const bool saved = m_inputRecorder.finish(m_world);
+    if (m_telemetry)
+    {
+        m_telemetry->recordEvent(saved ? "input.recording.saved" : "input.recording.error",
+                                 {{"path", m_inputRecorder.path().string()}, {"reason", reason}});
+    }
+}
+
 void BattleScene::showTelemetryMessage(const std::string &message)
 {
     if (message.empty())
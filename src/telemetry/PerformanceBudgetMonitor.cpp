@@ -24,6 +24,26 @@ std::optional<BudgetViolation> PerformanceBudgetMonitor::evaluate(const StageTim
 {
     const float tolerance = std::max(0.0f, m_budget.toleranceMs);
     const double toleranceMs = static_cast<double>(tolerance);
+
+    for (const SystemStageSample &stage : sample.systemStages)
+    {
+        auto budget = m_budget.stageMs.find(stage.stage);
+        if (budget == m_budget.stageMs.end() || !(budget->second > 0.0f) || !std::isfinite(stage.ms))
+        {
+            continue;
+        }
+        if (stage.ms > static_cast<double>(budget->second) + toleranceMs)
+        {
+            BudgetViolation violation;
+            violation.stage = stage.stage;
+            violation.sampleMs = stage.ms;
+            violation.budgetMs = static_cast<double>(budget->second);
+            violation.system = stage.slowestSystem;
+            violation.systemMs = stage.slowestSystemMs;
+            return violation;
+        }
+    }
+
     struct StageInfo
     {
         std::string_view id;
@@ -2,18 +2,29 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "config/AppConfig.h"
 
 namespace telemetry
 {
 
+struct SystemStageSample
+{
+    std::string stage;
+    double ms = 0.0;
+    std::string slowestSystem;
+    double slowestSystemMs = 0.0;
+};
+
 struct StageTimingSample
 {
     double updateMs = 0.0;
     double renderMs = 0.0;
     double inputMs = 0.0;
     double hudMs = 0.0;
+    // Breakdown of the simulation step, checked against PerformanceBudgetConfig::stageMs before the coarse stages.
+    std::vector<SystemStageSample> systemStages;
 };
 
 struct BudgetViolation
@@ -21,6 +32,9 @@ struct BudgetViolation
     std::string stage;
     double sampleMs = 0.0;
     double budgetMs = 0.0;
+    // Set when a simulation stage ran over: the system that took the largest share of it.
+    std::string system;
+    double systemMs = 0.0;
 };
 
 class PerformanceBudgetMonitor
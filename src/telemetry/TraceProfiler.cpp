@@ -0,0 +1,192 @@
+#include "telemetry/TraceProfiler.h"
+
+#include "telemetry/TelemetrySink.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace telemetry
+{
+
+namespace
+{
+
+std::string escapeName(std::string_view value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char ch : value)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            escaped.push_back('\\');
+        }
+        if (static_cast<unsigned char>(ch) >= 0x20)
+        {
+            escaped.push_back(ch);
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+TraceProfiler &TraceProfiler::instance()
+{
+    static TraceProfiler profiler;
+    return profiler;
+}
+
+std::uint64_t TraceProfiler::nowNs()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+void TraceProfiler::requestCapture(std::size_t frames)
+{
+    if (frames == 0 || capturing() || m_requestedFrames > 0)
+    {
+        return;
+    }
+    m_requestedFrames = frames;
+}
+
+void TraceProfiler::markFrame(TelemetrySink *sink)
+{
+    if (capturing())
+    {
+        if (m_framesRemaining > 0)
+        {
+            --m_framesRemaining;
+        }
+        if (m_framesRemaining == 0)
+        {
+            m_capturing.store(false, std::memory_order_relaxed);
+            writeTrace(sink);
+        }
+        return;
+    }
+    if (m_requestedFrames == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        for (const std::unique_ptr<ThreadBuffer> &buffer : m_buffers)
+        {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+    m_framesRemaining = m_requestedFrames;
+    m_requestedFrames = 0;
+    m_capturing.store(true, std::memory_order_relaxed);
+}
+
+void TraceProfiler::record(const char *name, std::uint64_t beginNs, std::uint64_t endNs)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    const std::size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index >= buffer.events.size())
+    {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events[index] = Event{name, beginNs, endNs};
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+TraceProfiler::ThreadBuffer &TraceProfiler::threadBuffer()
+{
+    // Buffers are owned by the profiler and outlive their threads, so a cached pointer never dangles.
+    thread_local ThreadBuffer *cached = nullptr;
+    if (!cached)
+    {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->events.resize(kEventsPerThread);
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        buffer->threadId = static_cast<std::uint32_t>(m_buffers.size() + 1);
+        cached = buffer.get();
+        m_buffers.push_back(std::move(buffer));
+    }
+    return *cached;
+}
+
+void TraceProfiler::writeTrace(TelemetrySink *sink)
+{
+    namespace fs = std::filesystem;
+
+    fs::path directory = sink ? sink->outputDirectory() : fs::path{};
+    if (directory.empty())
+    {
+        directory = fs::path("build") / "debug_dumps";
+    }
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+
+    ++m_captureIndex;
+    std::ostringstream filename;
+    filename << "trace_" << std::setw(6) << std::setfill('0') << m_captureIndex << ".json";
+    const fs::path path = directory / filename.str();
+
+    std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (ec || !stream.is_open())
+    {
+        if (sink)
+        {
+            TelemetrySink::Payload payload;
+            payload.emplace("path", path.lexically_normal().string());
+            payload.emplace("error", ec ? ec.message() : std::string("open_failed"));
+            sink->recordEvent("telemetry.trace.error", payload);
+        }
+        return;
+    }
+
+    std::size_t eventCount = 0;
+    std::size_t droppedCount = 0;
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    for (const std::unique_ptr<ThreadBuffer> &buffer : m_buffers)
+    {
+        const std::size_t count = buffer->count.load(std::memory_order_acquire);
+        droppedCount += buffer->dropped.load(std::memory_order_relaxed);
+        if (count == 0)
+        {
+            continue;
+        }
+        stream << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+               << buffer->threadId << ",\"args\":{\"name\":\"thread " << buffer->threadId << "\"}}";
+        first = false;
+        stream << std::fixed << std::setprecision(3);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Event &event = buffer->events[i];
+            stream << ",{\"name\":\"" << escapeName(event.name ? event.name : "") << "\",\"cat\":\"kusozako\","
+                   << "\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                   << ",\"ts\":" << static_cast<double>(event.beginNs) / 1000.0
+                   << ",\"dur\":" << static_cast<double>(event.endNs - event.beginNs) / 1000.0 << '}';
+        }
+        eventCount += count;
+    }
+    stream << "]}\n";
+    stream.close();
+    m_lastTracePath = path;
+
+    if (sink)
+    {
+        TelemetrySink::Payload payload;
+        payload.emplace("path", path.lexically_normal().string());
+        payload.emplace("events", std::to_string(eventCount));
+        payload.emplace("dropped", std::to_string(droppedCount));
+        sink->recordEvent("telemetry.trace.saved", payload);
+    }
+}
+
+} // namespace telemetry
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TelemetrySink;
+
+namespace telemetry
+{
+
+// Scoped-zone profiler that writes Chrome trace-event JSON (chrome://tracing, Perfetto). Zones are only recorded
+// while a capture is running. Each thread appends to its own fixed-size buffer without locking; the buffers are
+// read and reset from markFrame(), which must run on the main thread between simulation steps.
+class TraceProfiler
+{
+  public:
+    static constexpr std::size_t kEventsPerThread = 1u << 15;
+
+    static TraceProfiler &instance();
+
+    static std::uint64_t nowNs();
+
+    // Records the next `frames` frames. Ignored while a capture is already pending or running.
+    void requestCapture(std::size_t frames);
+
+    bool capturing() const
+    {
+        return m_capturing.load(std::memory_order_relaxed);
+    }
+
+    // Frame boundary: starts a requested capture, or ends the running one and writes trace_XXXXXX.json into the
+    // sink's output directory.
+    void markFrame(TelemetrySink *sink);
+
+    void record(const char *name, std::uint64_t beginNs, std::uint64_t endNs);
+
+    const std::filesystem::path &lastTracePath() const
+    {
+        return m_lastTracePath;
+    }
+
+  private:
+    struct Event
+    {
+        const char *name = nullptr;
+        std::uint64_t beginNs = 0;
+        std::uint64_t endNs = 0;
+    };
+
+    struct ThreadBuffer
+    {
+        std::uint32_t threadId = 0;
+        std::vector<Event> events;
+        std::atomic<std::size_t> count{0};
+        std::atomic<std::size_t> dropped{0};
+    };
+
+    TraceProfiler() = default;
+
+    ThreadBuffer &threadBuffer();
+    void writeTrace(TelemetrySink *sink);
+
+    std::mutex m_registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::atomic<bool> m_capturing{false};
+    std::size_t m_requestedFrames = 0;
+    std::size_t m_framesRemaining = 0;
+    std::uint64_t m_captureIndex = 0;
+    std::filesystem::path m_lastTracePath;
+};
+
+class TraceZone
+{
+  public:
+    explicit TraceZone(const char *name)
+        : m_name(name), m_beginNs(TraceProfiler::instance().capturing() ? TraceProfiler::nowNs() : 0)
+    {
+    }
+
+    ~TraceZone()
+    {
+        if (m_beginNs != 0)
+        {
+            TraceProfiler::instance().record(m_name, m_beginNs, TraceProfiler::nowNs());
+        }
+    }
+
+    TraceZone(const TraceZone &) = delete;
+    TraceZone &operator=(const TraceZone &) = delete;
+
+  private:
+    const char *m_name;
+    std::uint64_t m_beginNs;
+};
+
+} // namespace telemetry
+
+// Zone names must outlive the capture; pass string literals or other static strings.
+#if defined(KUSOZAKO_DISABLE_PROFILER)
+#define KUSOZAKO_TRACE_ZONE(name) static_cast<void>(name)
+#else
+#define KUSOZAKO_TRACE_CONCAT_INNER(a, b) a##b
+#define KUSOZAKO_TRACE_CONCAT(a, b) KUSOZAKO_TRACE_CONCAT_INNER(a, b)
+#define KUSOZAKO_TRACE_ZONE(name) ::telemetry::TraceZone KUSOZAKO_TRACE_CONCAT(traceZone, __LINE__)(name)
+#endif
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace world
+{
+
+// Little-endian byte encoding shared by the binary recording and snapshot formats. Varints are LEB128; zigzag
+// maps signed values onto them. A reader that runs past the end or meets a malformed varint latches !ok() and
+// returns zeroes from then on, so decoders can check once per record.
+class ByteWriter
+{
+  public:
+    explicit ByteWriter(std::vector<std::uint8_t> &out) : m_out(out) {}
+
+    void u8(std::uint8_t value) { m_out.push_back(value); }
+
+    template <typename T>
+    void little(T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+        {
+            m_out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void f32(float value)
+    {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        little(bits);
+    }
+
+    void f64(double value)
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        little(bits);
+    }
+
+    void varint(std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            m_out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void zigzag(std::int64_t value)
+    {
+        varint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+    }
+
+    void str(std::string_view value)
+    {
+        varint(value.size());
+        m_out.insert(m_out.end(), value.begin(), value.end());
+    }
+
+  private:
+    std::vector<std::uint8_t> &m_out;
+};
+
+class ByteReader
+{
+  public:
+    ByteReader(const std::vector<std::uint8_t> &data, std::size_t offset) : m_data(data), m_offset(offset) {}
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_offset >= m_data.size(); }
+    std::size_t offset() const { return m_offset; }
+
+    std::uint8_t u8()
+    {
+        if (!require(1))
+        {
+            return 0;
+        }
+        return m_data[m_offset++];
+    }
+
+    template <typename T>
+    T little()
+    {
+        if (!require(sizeof(T)))
+        {
+            return T{};
+        }
+        T value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+        {
+            value |= static_cast<T>(static_cast<T>(m_data[m_offset++]) << (8 * i));
+        }
+        return value;
+    }
+
+    float f32()
+    {
+        const std::uint32_t bits = little<std::uint32_t>();
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    double f64()
+    {
+        const std::uint64_t bits = little<std::uint64_t>();
+        double value = 0.0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::uint64_t varint()
+    {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            const std::uint8_t byte = u8();
+            if (!m_ok)
+            {
+                return 0;
+            }
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    std::int64_t zigzag()
+    {
+        const std::uint64_t raw = varint();
+        return static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+    }
+
+    std::string str()
+    {
+        const std::uint64_t size = varint();
+        if (!m_ok || size > m_data.size() - m_offset)
+        {
+            m_ok = false;
+            return {};
+        }
+        std::string value(reinterpret_cast<const char *>(m_data.data() + m_offset), static_cast<std::size_t>(size));
+        m_offset += static_cast<std::size_t>(size);
+        return value;
+    }
+
+  private:
+    bool require(std::size_t bytes)
+    {
+        if (!m_ok || m_data.size() - m_offset < bytes)
+        {
+            m_ok = false;
+            return false;
+        }
+        return true;
+    }
+
+    const std::vector<std::uint8_t> &m_data;
+    std::size_t m_offset;
+    bool m_ok = true;
+};
+
+} // namespace world
@@ -3,33 +3,129 @@
 #include "Entity.h"
 
 #include <cstddef>
+#include <initializer_list>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace world
 {
 
+// Contiguous array-of-structs storage used by ComponentPool unless ComponentStorage<T> selects another layout.
 template <typename T>
+class VectorStorage
+{
+  public:
+    using value_type = T;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    std::size_t size() const { return m_values.size(); }
+
+    void reserve(std::size_t count) { m_values.reserve(count); }
+
+    iterator begin() { return m_values.begin(); }
+    iterator end() { return m_values.end(); }
+    const_iterator begin() const { return m_values.begin(); }
+    const_iterator end() const { return m_values.end(); }
+
+    reference operator[](std::size_t index) { return m_values[index]; }
+    const_reference operator[](std::size_t index) const { return m_values[index]; }
+
+    template <typename... Args>
+    reference emplace_back(Args &&...args)
+    {
+        return m_values.emplace_back(std::forward<Args>(args)...);
+    }
+
+    void moveElement(std::size_t from, std::size_t to) { m_values[to] = std::move(m_values[from]); }
+
+    void eraseRange(std::size_t from, std::size_t to)
+    {
+        m_values.erase(m_values.begin() + static_cast<std::ptrdiff_t>(from),
+                       m_values.begin() + static_cast<std::ptrdiff_t>(to));
+    }
+
+    void clear() { m_values.clear(); }
+
+  private:
+    std::vector<T> m_values;
+};
+
+template <typename T>
+struct ComponentStorage
+{
+    using type = VectorStorage<T>;
+};
+
+// Dense component storage that owns its entity handles. The vector-style members (push_back, erase, eraseIf,
+// resize, clear) keep insertion order so legacy code can index the pool like a std::vector; remove/removeAt are
+// the unordered swap-and-pop variants. Reordering elements through iterators (std::sort, std::remove_if) would
+// detach components from their entities, so use eraseIf for filtering. Removal can also be deferred:
+// markForRemoval tombstones a component without moving anything, so dense indices stay valid until sweep() drops
+// every tombstoned component in one eraseIf pass.
+template <typename T, typename Storage = typename ComponentStorage<T>::type>
 class ComponentPool
 {
   public:
+    using value_type = T;
+    using storage_type = Storage;
+    using reference = typename Storage::reference;
+    using const_reference = typename Storage::const_reference;
+    using iterator = typename Storage::iterator;
+    using const_iterator = typename Storage::const_iterator;
+
     ComponentPool() = default;
 
-    std::size_t size() const { return m_components.size(); }
+    ComponentPool(std::initializer_list<T> init)
+    {
+        assign(init);
+    }
+
+    ComponentPool &operator=(std::initializer_list<T> init)
+    {
+        clear();
+        assign(init);
+        return *this;
+    }
 
-    bool empty() const { return m_components.empty(); }
+    std::size_t size() const { return m_storage.size(); }
 
+    bool empty() const { return m_storage.size() == 0; }
+
+    // Sizes the components and the handle tables for count live entries, so creates and removals up to that many
+    // never reallocate.
     void reserve(std::size_t count)
     {
-        m_components.reserve(count);
+        m_storage.reserve(count);
         m_entities.reserve(count);
+        m_registry.reserve(count);
+        m_sparse.reserve(count);
+        m_tombstones.reserve(count);
     }
 
-    bool has(const EntityRegistry &registry, EntityId entity) const
+    Storage &storage() { return m_storage; }
+    const Storage &storage() const { return m_storage; }
+
+    const EntityRegistry &registry() const { return m_registry; }
+
+    iterator begin() { return m_storage.begin(); }
+    iterator end() { return m_storage.end(); }
+    const_iterator begin() const { return m_storage.begin(); }
+    const_iterator end() const { return m_storage.end(); }
+
+    reference front() { return m_storage[0]; }
+    const_reference front() const { return m_storage[0]; }
+    reference back() { return m_storage[size() - 1]; }
+    const_reference back() const { return m_storage[size() - 1]; }
+
+    bool has(EntityId entity) const
     {
-        if (!registry.isAlive(entity))
+        if (!m_registry.isAlive(entity))
         {
             return false;
         }
@@ -39,18 +135,18 @@ class ComponentPool
             return false;
         }
         const std::uint32_t denseIndex = m_sparse[idx];
-        return denseIndex != Invalid && denseIndex < m_components.size() &&
+        return denseIndex != Invalid && denseIndex < m_entities.size() &&
                m_entities[denseIndex].generation == entity.generation;
     }
 
-    T &get(const EntityRegistry &registry, EntityId entity)
+    reference get(EntityId entity)
     {
-        return m_components.at(indexOf(registry, entity));
+        return m_storage[indexOf(entity)];
     }
 
-    const T &get(const EntityRegistry &registry, EntityId entity) const
+    const_reference get(EntityId entity) const
     {
-        return m_components.at(indexOf(registry, entity));
+        return m_storage[indexOf(entity)];
     }
 
     EntityId entityAt(std::size_t denseIndex) const
@@ -58,107 +154,277 @@ class ComponentPool
         return m_entities.at(denseIndex);
     }
 
-    T &operator[](std::size_t denseIndex)
+    std::size_t indexOf(EntityId entity) const
+    {
+        if (!has(entity))
+        {
+            throw std::out_of_range("ComponentPool::indexOf invalid entity");
+        }
+        return m_sparse[entity.index];
+    }
+
+    reference operator[](std::size_t denseIndex)
     {
-        return m_components[denseIndex];
+        return m_storage[denseIndex];
     }
 
-    const T &operator[](std::size_t denseIndex) const
+    const_reference operator[](std::size_t denseIndex) const
     {
-        return m_components[denseIndex];
+        return m_storage[denseIndex];
     }
 
     template <typename... Args>
-    std::pair<EntityId, T &> create(EntityRegistry &registry, Args &&...args)
+    std::pair<EntityId, reference> create(Args &&...args)
     {
-        EntityId id = registry.create();
-        ensureSparse(registry.capacity());
-        const std::size_t denseIndex = m_components.size();
-        m_components.emplace_back(std::forward<Args>(args)...);
+        EntityId id = m_registry.create();
+        ensureSparse(m_registry.capacity());
+        const std::size_t denseIndex = m_entities.size();
         m_entities.push_back(id);
         m_sparse[id.index] = static_cast<std::uint32_t>(denseIndex);
-        return {id, m_components.back()};
+        return {id, m_storage.emplace_back(std::forward<Args>(args)...)};
     }
 
-    void attach(EntityRegistry &registry, EntityId entity, const T &component)
+    template <typename... Args>
+    reference emplace_back(Args &&...args)
     {
-        ensureSparse(registry.capacity());
-        if (has(registry, entity))
-        {
-            m_components[m_sparse[entity.index]] = component;
-            return;
-        }
-        const std::size_t denseIndex = m_components.size();
-        m_components.push_back(component);
-        m_entities.push_back(entity);
-        m_sparse[entity.index] = static_cast<std::uint32_t>(denseIndex);
+        return create(std::forward<Args>(args)...).second;
+    }
+
+    void push_back(const T &component)
+    {
+        create(component);
+    }
+
+    void push_back(T &&component)
+    {
+        create(std::move(component));
     }
 
-    void remove(EntityRegistry &registry, EntityId entity)
+    void remove(EntityId entity)
     {
-        if (!has(registry, entity))
+        if (!has(entity))
         {
             return;
         }
         const std::uint32_t denseIndex = m_sparse[entity.index];
-        const std::uint32_t lastIndex = static_cast<std::uint32_t>(m_components.size() - 1);
+        const std::uint32_t lastIndex = static_cast<std::uint32_t>(m_entities.size() - 1);
         if (denseIndex != lastIndex)
         {
-            m_components[denseIndex] = std::move(m_components[lastIndex]);
+            m_storage.moveElement(lastIndex, denseIndex);
             m_entities[denseIndex] = m_entities[lastIndex];
             m_sparse[m_entities[denseIndex].index] = denseIndex;
         }
-        m_components.pop_back();
+        m_storage.eraseRange(lastIndex, lastIndex + 1);
         m_entities.pop_back();
         m_sparse[entity.index] = Invalid;
-        registry.destroy(entity);
+        forgetTombstone(entity.index);
+        m_registry.destroy(entity);
+    }
+
+    void removeAt(std::size_t denseIndex)
+    {
+        if (denseIndex >= m_entities.size())
+        {
+            return;
+        }
+        remove(m_entities[denseIndex]);
     }
 
-    void removeAt(EntityRegistry &registry, std::size_t denseIndex)
+    iterator erase(const_iterator position)
     {
-        if (denseIndex >= m_components.size())
+        return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const const_iterator origin = static_cast<const Storage &>(m_storage).begin();
+        const std::size_t from = static_cast<std::size_t>(first - origin);
+        const std::size_t to = static_cast<std::size_t>(last - origin);
+        if (from < to)
+        {
+            for (std::size_t i = from; i < to; ++i)
+            {
+                m_sparse[m_entities[i].index] = Invalid;
+                forgetTombstone(m_entities[i].index);
+                m_registry.destroy(m_entities[i]);
+            }
+            m_entities.erase(m_entities.begin() + static_cast<std::ptrdiff_t>(from),
+                             m_entities.begin() + static_cast<std::ptrdiff_t>(to));
+            m_storage.eraseRange(from, to);
+            reindexFrom(from);
+        }
+        return m_storage.begin() + static_cast<std::ptrdiff_t>(from);
+    }
+
+    // Visits every component once in order and drops those for which pred returns true, keeping the survivors
+    // in their original order. pred is called as pred(component) or, when it accepts them, pred(entity, component);
+    // it may mutate the component it is given.
+    template <typename Pred>
+    std::size_t eraseIf(Pred &&pred)
+    {
+        std::size_t write = 0;
+        const std::size_t count = m_entities.size();
+        for (std::size_t read = 0; read < count; ++read)
+        {
+            bool erase = false;
+            if constexpr (std::is_invocable_v<Pred &, EntityId, reference>)
+            {
+                erase = pred(m_entities[read], m_storage[read]);
+            }
+            else
+            {
+                erase = pred(m_storage[read]);
+            }
+            if (erase)
+            {
+                m_sparse[m_entities[read].index] = Invalid;
+                forgetTombstone(m_entities[read].index);
+                m_registry.destroy(m_entities[read]);
+                continue;
+            }
+            if (write != read)
+            {
+                m_storage.moveElement(read, write);
+                m_entities[write] = m_entities[read];
+            }
+            m_sparse[m_entities[write].index] = static_cast<std::uint32_t>(write);
+            ++write;
+        }
+        m_storage.eraseRange(write, count);
+        m_entities.erase(m_entities.begin() + static_cast<std::ptrdiff_t>(write), m_entities.end());
+        return count - write;
+    }
+
+    // Tombstones the component at denseIndex. Returns false when it already was.
+    bool markForRemoval(std::size_t denseIndex)
+    {
+        const std::uint32_t idx = m_entities.at(denseIndex).index;
+        if (m_tombstones.size() < m_sparse.size())
+        {
+            m_tombstones.resize(m_sparse.size(), 0);
+        }
+        if (m_tombstones[idx] != 0)
         {
+            return false;
+        }
+        m_tombstones[idx] = 1;
+        ++m_tombstoneCount;
+        return true;
+    }
+
+    bool markedForRemoval(std::size_t denseIndex) const
+    {
+        if (m_tombstoneCount == 0)
+        {
+            return false;
+        }
+        const std::uint32_t idx = m_entities[denseIndex].index;
+        return idx < m_tombstones.size() && m_tombstones[idx] != 0;
+    }
+
+    std::size_t pendingRemovals() const { return m_tombstoneCount; }
+
+    // Drops every tombstoned component, keeping the survivors in order. Returns how many were dropped.
+    std::size_t sweep()
+    {
+        if (m_tombstoneCount == 0)
+        {
+            return 0;
+        }
+        std::size_t read = 0;
+        return eraseIf([&](const_reference) { return m_tombstones[m_entities[read++].index] != 0; });
+    }
+
+    void resize(std::size_t count)
+    {
+        if (count < size())
+        {
+            erase(begin() + static_cast<std::ptrdiff_t>(count), end());
             return;
         }
-        const EntityId entity = m_entities[denseIndex];
-        remove(registry, entity);
+        reserve(count);
+        while (size() < count)
+        {
+            create();
+        }
     }
 
-    void clear(EntityRegistry &registry)
+    void clear()
     {
         for (EntityId entity : m_entities)
         {
-            registry.destroy(entity);
+            m_sparse[entity.index] = Invalid;
+            m_registry.destroy(entity);
+        }
+        m_storage.clear();
+        m_entities.clear();
+        m_tombstones.clear();
+        m_tombstoneCount = 0;
+    }
+
+    // Replaces the contents with saved components under their saved handles. registry must be the registry those
+    // handles were issued from, so later creates hand out the same handles the saved pool would have.
+    void restore(EntityRegistry registry, const std::vector<EntityId> &entities, const std::vector<T> &components)
+    {
+        if (entities.size() != components.size())
+        {
+            throw std::invalid_argument("ComponentPool::restore entity/component count mismatch");
         }
-        m_components.clear();
+        m_storage.clear();
         m_entities.clear();
-        m_sparse.clear();
+        m_tombstones.clear();
+        m_tombstoneCount = 0;
+        m_sparse.assign(registry.capacity(), Invalid);
+        m_registry = std::move(registry);
+        reserve(entities.size());
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            if (!m_registry.isAlive(entities[i]) || m_sparse[entities[i].index] != Invalid)
+            {
+                throw std::invalid_argument("ComponentPool::restore invalid entity");
+            }
+            m_sparse[entities[i].index] = static_cast<std::uint32_t>(i);
+            m_entities.push_back(entities[i]);
+            m_storage.emplace_back(components[i]);
+        }
     }
 
     template <typename Fn>
     void forEach(Fn &&fn)
     {
-        for (std::size_t i = 0; i < m_components.size(); ++i)
+        for (std::size_t i = 0; i < m_entities.size(); ++i)
         {
-            fn(m_entities[i], m_components[i]);
+            fn(m_entities[i], m_storage[i]);
         }
     }
 
     template <typename Fn>
     void forEach(Fn &&fn) const
     {
-        for (std::size_t i = 0; i < m_components.size(); ++i)
+        for (std::size_t i = 0; i < m_entities.size(); ++i)
         {
-            fn(m_entities[i], m_components[i]);
+            fn(m_entities[i], m_storage[i]);
         }
     }
 
   private:
     static constexpr std::uint32_t Invalid = std::numeric_limits<std::uint32_t>::max();
 
-    std::vector<T> m_components;
+    EntityRegistry m_registry;
+    Storage m_storage;
     std::vector<EntityId> m_entities;
     std::vector<std::uint32_t> m_sparse;
+    std::vector<std::uint8_t> m_tombstones;
+    std::size_t m_tombstoneCount = 0;
+
+    void assign(std::initializer_list<T> init)
+    {
+        reserve(init.size());
+        for (const T &value : init)
+        {
+            push_back(value);
+        }
+    }
 
     void ensureSparse(std::size_t capacity)
     {
@@ -168,15 +434,23 @@ class ComponentPool
         }
     }
 
-    std::size_t indexOf(const EntityRegistry &registry, EntityId entity) const
+    void forgetTombstone(std::uint32_t entityIndex)
     {
-        if (!has(registry, entity))
+        if (m_tombstoneCount != 0 && entityIndex < m_tombstones.size() && m_tombstones[entityIndex] != 0)
         {
-            throw std::out_of_range("ComponentPool::indexOf invalid entity");
+            m_tombstones[entityIndex] = 0;
+            --m_tombstoneCount;
         }
-        return m_sparse[entity.index];
     }
+
+    void reindexFrom(std::size_t denseIndex)
+    {
+        for (std::size_t i = denseIndex; i < m_entities.size(); ++i)
+        {
+            m_sparse[m_entities[i].index] = static_cast<std::uint32_t>(i);
+        }
+    }
+
 };
 
 } // namespace world
-
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "world/SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace world
+{
+
+// Per-cell population of a set of points, bucketed into a SpatialGrid whose cells are one neighbour radius wide.
+// Neighbour counts only look at the 3x3 block of cells around a point. sample() blends the four nearest cell
+// counts, so callers get a smooth "units per cell" value anywhere in the world.
+class DensityField
+{
+  public:
+    template <typename PositionFn>
+    void build(const Vec2 &min, const Vec2 &max, float cellSize, std::size_t count, PositionFn &&positionOf)
+    {
+        m_grid.configure(min, max, cellSize);
+        m_positions.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_positions[i] = positionOf(i);
+        }
+        m_grid.build(SpatialGrid::Layer::Units, count, [&](std::size_t i) {
+            return SpatialGrid::Bounds{m_positions[i], 0.0f};
+        });
+    }
+
+    std::size_t size() const
+    {
+        return m_positions.size();
+    }
+
+    // Number of other points within radius of point `index`, stopping once `cap` is reached.
+    std::uint32_t countNeighbors(std::size_t index, float radius, std::uint32_t cap) const
+    {
+        const Vec2 &pos = m_positions[index];
+        const float radiusSq = radius * radius;
+        const SpatialGrid::CellRect rect = m_grid.queryRect(pos, radius);
+        std::uint32_t neighbors = 0;
+        for (std::uint32_t y = rect.minY; y <= rect.maxY; ++y)
+        {
+            for (std::uint32_t other : m_grid.rowSpan(SpatialGrid::Layer::Units, rect, y))
+            {
+                if (other == index)
+                {
+                    continue;
+                }
+                const float dx = m_positions[other].x - pos.x;
+                const float dy = m_positions[other].y - pos.y;
+                if (dx * dx + dy * dy <= radiusSq && ++neighbors >= cap)
+                {
+                    return neighbors;
+                }
+            }
+        }
+        return neighbors;
+    }
+
+    std::uint32_t cellCount(const Vec2 &pos) const
+    {
+        if (m_positions.empty())
+        {
+            return 0;
+        }
+        const SpatialGrid::CellRect rect = m_grid.queryRect(pos, 0.0f);
+        return cellCountAt(rect.minX, rect.minY);
+    }
+
+    // Bilinear blend of the counts of the four cells whose centres surround pos.
+    float sample(const Vec2 &pos) const
+    {
+        if (m_positions.empty())
+        {
+            return 0.0f;
+        }
+        const float cellSize = m_grid.cellSize();
+        const float gx = std::clamp((pos.x - m_grid.origin().x) / cellSize - 0.5f, 0.0f,
+                                    static_cast<float>(m_grid.columns() - 1));
+        const float gy = std::clamp((pos.y - m_grid.origin().y) / cellSize - 0.5f, 0.0f,
+                                    static_cast<float>(m_grid.rows() - 1));
+        const std::uint32_t x0 = static_cast<std::uint32_t>(gx);
+        const std::uint32_t y0 = static_cast<std::uint32_t>(gy);
+        const std::uint32_t x1 = std::min(x0 + 1, m_grid.columns() - 1);
+        const std::uint32_t y1 = std::min(y0 + 1, m_grid.rows() - 1);
+        const float tx = gx - static_cast<float>(x0);
+        const float ty = gy - static_cast<float>(y0);
+        const float top = static_cast<float>(cellCountAt(x0, y0)) * (1.0f - tx) +
+                          static_cast<float>(cellCountAt(x1, y0)) * tx;
+        const float bottom = static_cast<float>(cellCountAt(x0, y1)) * (1.0f - tx) +
+                             static_cast<float>(cellCountAt(x1, y1)) * tx;
+        return top * (1.0f - ty) + bottom * ty;
+    }
+
+    float cellSize() const
+    {
+        return m_grid.cellSize();
+    }
+
+    const std::vector<Vec2> &positions() const
+    {
+        return m_positions;
+    }
+
+  private:
+    SpatialGrid m_grid;
+    std::vector<Vec2> m_positions;
+
+    std::uint32_t cellCountAt(std::uint32_t x, std::uint32_t y) const
+    {
+        const std::size_t cell = static_cast<std::size_t>(y) * m_grid.columns() + x;
+        return static_cast<std::uint32_t>(m_grid.cell(SpatialGrid::Layer::Units, cell).size());
+    }
+};
+
+} // namespace world
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace world
@@ -56,11 +58,36 @@ class EntityRegistry
         return id.index < m_generations.size() && m_generations[id.index] == id.generation;
     }
 
+    // Room for count live handles before create() has to grow the slot table; freed slots are recycled first.
+    void reserve(std::size_t count)
+    {
+        m_generations.reserve(count);
+        m_freeList.reserve(count);
+    }
+
     std::uint32_t capacity() const
     {
         return static_cast<std::uint32_t>(m_generations.size());
     }
 
+    const std::vector<std::uint32_t> &generations() const
+    {
+        return m_generations;
+    }
+
+    const std::vector<std::uint32_t> &freeList() const
+    {
+        return m_freeList;
+    }
+
+    // Reinstates a saved slot table; handles issued before the save stay valid and create() continues from the
+    // saved free list.
+    void restore(std::vector<std::uint32_t> generations, std::vector<std::uint32_t> freeList)
+    {
+        m_generations = std::move(generations);
+        m_freeList = std::move(freeList);
+    }
+
   private:
     std::vector<std::uint32_t> m_generations;
     std::vector<std::uint32_t> m_freeList;
@@ -0,0 +1,196 @@
+#include "world/FlowField.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace world
+{
+
+namespace
+{
+
+constexpr float kDiagonalStep = 1.41421356f;
+
+// Same arithmetic as normalize(to - from), so open cells steer bit-for-bit like the straight-line chase.
+Vec2 headingTo(const Vec2 &from, const Vec2 &to)
+{
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float len = std::sqrt(dx * dx + dy * dy);
+    return len > 0.0001f ? Vec2{dx / len, dy / len} : Vec2{0.0f, 0.0f};
+}
+
+} // namespace
+
+Vec2 FlowField::direction(const Vec2 &pos)
+{
+    const std::size_t cell = cellOf(pos);
+    if (cell >= m_next.size() || m_next[cell] == kDirect)
+    {
+        return headingTo(pos, m_goal);
+    }
+    if (m_sight[cell] == Sight::Unknown)
+    {
+        m_sight[cell] = lineOfSight(static_cast<std::uint32_t>(cell)) ? Sight::Clear : Sight::Blocked;
+    }
+    if (m_sight[cell] == Sight::Clear)
+    {
+        return headingTo(pos, m_goal);
+    }
+    return headingTo(pos, cellCentre(m_next[cell]));
+}
+
+bool FlowField::rebuildIfChanged()
+{
+    // Only reached when the wall generation, goal cell or grid moved; a reload that re-inserts the same walls still
+    // keeps the current field.
+    std::sort(m_scratchCells.begin(), m_scratchCells.end());
+    m_scratchCells.erase(std::unique(m_scratchCells.begin(), m_scratchCells.end()), m_scratchCells.end());
+
+    const std::uint32_t goal = goalCell();
+    if (gridMatches() && goal == m_goalCell && m_scratchCells == m_wallCells && !m_next.empty())
+    {
+        return false;
+    }
+
+    m_columns = m_grid.columns();
+    m_rows = m_grid.rows();
+    m_cellSize = m_grid.cellSize();
+    m_origin = m_grid.origin();
+    m_goalCell = goal;
+    m_wallCells.swap(m_scratchCells);
+    rebuild();
+    ++m_rebuilds;
+    return true;
+}
+
+void FlowField::rebuild()
+{
+    const std::size_t cellCount = static_cast<std::size_t>(m_columns) * m_rows;
+    m_isWall.assign(cellCount, 0);
+    for (std::uint32_t cell : m_wallCells)
+    {
+        m_isWall[cell] = 1;
+    }
+    m_cost.assign(cellCount, std::numeric_limits<float>::infinity());
+    m_next.assign(cellCount, kDirect);
+    m_sight.assign(cellCount, Sight::Unknown);
+    if (cellCount == 0)
+    {
+        return;
+    }
+
+    // Min-heap on (cost, cell); ties resolve by cell index so the field is the same on every platform.
+    auto later = [](const QueueEntry &a, const QueueEntry &b) {
+        return a.cost != b.cost ? a.cost > b.cost : a.cell > b.cell;
+    };
+    m_queue.clear();
+    m_cost[m_goalCell] = 0.0f;
+    m_queue.push_back({0.0f, m_goalCell});
+    while (!m_queue.empty())
+    {
+        std::pop_heap(m_queue.begin(), m_queue.end(), later);
+        const QueueEntry entry = m_queue.back();
+        m_queue.pop_back();
+        if (entry.cost > m_cost[entry.cell])
+        {
+            continue;
+        }
+        const int cx = static_cast<int>(entry.cell % m_columns);
+        const int cy = static_cast<int>(entry.cell / m_columns);
+        // Agents on a neighbour step into this cell, so its wall cost applies to every edge relaxed from it.
+        const float enterCost = m_isWall[entry.cell] ? kWallCellCost : 1.0f;
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                if (dx == 0 && dy == 0)
+                {
+                    continue;
+                }
+                const int nx = cx + dx;
+                const int ny = cy + dy;
+                if (nx < 0 || ny < 0 || nx >= static_cast<int>(m_columns) || ny >= static_cast<int>(m_rows))
+                {
+                    continue;
+                }
+                const bool diagonal = dx != 0 && dy != 0;
+                if (diagonal && (m_isWall[static_cast<std::size_t>(cy) * m_columns + nx] ||
+                                 m_isWall[static_cast<std::size_t>(ny) * m_columns + cx]))
+                {
+                    continue;
+                }
+                const std::uint32_t neighbour = static_cast<std::uint32_t>(ny) * m_columns + nx;
+                const float cost = entry.cost + (diagonal ? kDiagonalStep : 1.0f) * enterCost;
+                if (cost < m_cost[neighbour])
+                {
+                    m_cost[neighbour] = cost;
+                    m_next[neighbour] = entry.cell;
+                    m_queue.push_back({cost, neighbour});
+                    std::push_heap(m_queue.begin(), m_queue.end(), later);
+                }
+            }
+        }
+    }
+
+    // Line of sight is resolved per cell by direction(), so a rebuild costs one Dijkstra pass rather than a ray
+    // walk from every cell. With no walls every cell sees the goal.
+    if (m_wallCells.empty())
+    {
+        std::fill(m_next.begin(), m_next.end(), kDirect);
+    }
+}
+
+// Walks the cells crossed by the segment from the centre of `from` to the goal (Amanatides-Woo) and reports
+// whether none of them, other than `from` itself, is a wall cell.
+bool FlowField::lineOfSight(std::uint32_t from) const
+{
+    int x = static_cast<int>(from % m_columns);
+    int y = static_cast<int>(from / m_columns);
+    const int goalX = static_cast<int>(m_goalCell % m_columns);
+    const int goalY = static_cast<int>(m_goalCell / m_columns);
+
+    // Work in cell units, with the goal clamped into its cell so a goal outside the grid still ends the walk.
+    const float startX = static_cast<float>(x) + 0.5f;
+    const float startY = static_cast<float>(y) + 0.5f;
+    const float endX = std::clamp((m_goal.x - m_origin.x) / m_cellSize, static_cast<float>(goalX),
+                                  static_cast<float>(goalX) + 0.999f);
+    const float endY = std::clamp((m_goal.y - m_origin.y) / m_cellSize, static_cast<float>(goalY),
+                                  static_cast<float>(goalY) + 0.999f);
+    const float dirX = endX - startX;
+    const float dirY = endY - startY;
+    const int stepX = dirX > 0.0f ? 1 : -1;
+    const int stepY = dirY > 0.0f ? 1 : -1;
+    const float infinity = std::numeric_limits<float>::infinity();
+    const float deltaX = dirX != 0.0f ? std::abs(1.0f / dirX) : infinity;
+    const float deltaY = dirY != 0.0f ? std::abs(1.0f / dirY) : infinity;
+    float nextX = dirX != 0.0f ? deltaX * 0.5f : infinity;
+    float nextY = dirY != 0.0f ? deltaY * 0.5f : infinity;
+
+    // Each step crosses one cell boundary, so the walk never takes more than the Manhattan distance.
+    const int steps = std::abs(goalX - x) + std::abs(goalY - y);
+    for (int i = 0; i < steps; ++i)
+    {
+        if (nextX < nextY)
+        {
+            x += stepX;
+            nextX += deltaX;
+        }
+        else
+        {
+            y += stepY;
+            nextY += deltaY;
+        }
+        if (x < 0 || y < 0 || x >= static_cast<int>(m_columns) || y >= static_cast<int>(m_rows))
+        {
+            return false;
+        }
+        if (m_isWall[static_cast<std::size_t>(y) * m_columns + x])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace world
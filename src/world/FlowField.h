@@ -0,0 +1,137 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "world/SpatialGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace world
+{
+
+// Shared navigation toward one goal over a tile-sized grid. A Dijkstra pass from the goal cell gives every cell
+// its path cost and the next cell on a cheapest path. Wall cells stay passable but cost kWallCellCost steps to
+// enter, so enemies detour around short walls and still push through long ones. The field is only recomputed
+// when the goal cell or the set of wall cells changes, and whether a cell can see the goal is worked out the first
+// time an agent in it asks, then cached until the next rebuild; direction() is O(1) per query after that.
+class FlowField
+{
+  public:
+    static constexpr float kWallCellCost = 8.0f;
+
+    void configure(const Vec2 &min, const Vec2 &max, float cellSize)
+    {
+        m_grid.configure(min, max, cellSize);
+    }
+
+    // Marks the cells covered by walls [0, count) and recomputes the field if the goal cell or those cells
+    // changed since the last call. wallGeneration is the wall set's change counter (WallIndex::generation()):
+    // while it, the goal cell and the grid stay the same the walls are not rescanned at all. bounds(i) returns
+    // wall i's Bounds. Returns true when it recomputed.
+    template <typename BoundsFn>
+    bool update(const Vec2 &goal, std::uint64_t wallGeneration, std::size_t count, BoundsFn &&bounds)
+    {
+        m_goal = goal;
+        if (!m_next.empty() && wallGeneration == m_wallGeneration && gridMatches() && goalCell() == m_goalCell)
+        {
+            return false;
+        }
+        m_wallGeneration = wallGeneration;
+        m_scratchCells.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const SpatialGrid::Bounds wall = bounds(i);
+            const SpatialGrid::CellRect rect = m_grid.queryRect(wall.pos, wall.radius);
+            for (std::uint32_t y = rect.minY; y <= rect.maxY; ++y)
+            {
+                for (std::uint32_t x = rect.minX; x <= rect.maxX; ++x)
+                {
+                    m_scratchCells.push_back(y * m_grid.columns() + x);
+                }
+            }
+        }
+        return rebuildIfChanged();
+    }
+
+    // Unit steering vector for an agent at pos. Cells with a clear line of sight to the goal head straight for it,
+    // exactly as normalize(goal - pos); the rest head for the centre of their next cell. Not const: the first
+    // query from a cell after a rebuild walks its line of sight and caches the answer.
+    Vec2 direction(const Vec2 &pos);
+
+    // Path cost from pos's cell to the goal, in cells; infinity before the first update().
+    float cost(const Vec2 &pos) const
+    {
+        const std::size_t cell = cellOf(pos);
+        return cell < m_cost.size() ? m_cost[cell] : std::numeric_limits<float>::infinity();
+    }
+
+    std::size_t rebuildCount() const
+    {
+        return m_rebuilds;
+    }
+
+  private:
+    static constexpr std::uint32_t kDirect = std::numeric_limits<std::uint32_t>::max();
+    enum class Sight : std::uint8_t
+    {
+        Unknown,
+        Clear,
+        Blocked,
+    };
+
+    SpatialGrid m_grid;
+    Vec2 m_goal{0.0f, 0.0f};
+    std::uint32_t m_goalCell = kDirect;
+    std::uint32_t m_columns = 0;
+    std::uint32_t m_rows = 0;
+    float m_cellSize = 0.0f;
+    Vec2 m_origin{0.0f, 0.0f};
+    std::uint64_t m_wallGeneration = 0;
+    std::vector<std::uint32_t> m_wallCells;
+    std::vector<std::uint32_t> m_scratchCells;
+    std::vector<std::uint8_t> m_isWall;
+    std::vector<float> m_cost;
+    std::vector<std::uint32_t> m_next;
+    std::vector<Sight> m_sight;
+    struct QueueEntry
+    {
+        float cost = 0.0f;
+        std::uint32_t cell = 0;
+    };
+    std::vector<QueueEntry> m_queue;
+    std::size_t m_rebuilds = 0;
+
+    bool rebuildIfChanged();
+    void rebuild();
+    bool lineOfSight(std::uint32_t from) const;
+
+    bool gridMatches() const
+    {
+        return m_columns == m_grid.columns() && m_rows == m_grid.rows() && m_cellSize == m_grid.cellSize() &&
+               m_origin.x == m_grid.origin().x && m_origin.y == m_grid.origin().y;
+    }
+
+    std::uint32_t goalCell() const
+    {
+        const SpatialGrid::CellRect rect = m_grid.queryRect(m_goal, 0.0f);
+        return rect.minY * m_grid.columns() + rect.minX;
+    }
+
+    std::size_t cellOf(const Vec2 &pos) const
+    {
+        const SpatialGrid::CellRect rect = m_grid.queryRect(pos, 0.0f);
+        return static_cast<std::size_t>(rect.minY) * m_columns + rect.minX;
+    }
+
+    Vec2 cellCentre(std::uint32_t cell) const
+    {
+        const float size = m_grid.cellSize();
+        const Vec2 &origin = m_grid.origin();
+        return {origin.x + (static_cast<float>(cell % m_columns) + 0.5f) * size,
+                origin.y + (static_cast<float>(cell / m_columns) + 0.5f) * size};
+    }
+};
+
+} // namespace world
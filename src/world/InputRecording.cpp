@@ -0,0 +1,575 @@
+#include "world/InputRecording.h"
+
+#include "world/ByteStream.h"
+#include "world/LegacySimulation.h"
+#include "world/WorldState.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <utility>
+
+namespace world
+{
+
+namespace
+{
+
+constexpr std::array<char, 4> kMagic{'K', 'Z', 'I', 'R'};
+constexpr std::uint16_t kFormatVersion = 1;
+// magic, version, seed, config hash, fixed dt, world width/height; the counts written by finish() follow.
+constexpr std::size_t kCountsOffset = 4 + 2 + 4 + 8 + 4 + 4 + 4;
+constexpr std::size_t kHeaderSize = kCountsOffset + 8 + 8 + 8;
+constexpr std::size_t kFlushThreshold = 64 * 1024;
+
+enum FrameFlags : std::uint8_t
+{
+    kFrameStepped = 1u << 0,
+    kFrameAxes = 1u << 1,
+    kFrameEvents = 1u << 2,
+    kFramePointer = 1u << 3,
+    kFrameTimestamp = 1u << 4,
+    kFrameSequence = 1u << 5,
+    kFrameChecksum = 1u << 6,
+};
+
+enum EventFlags : std::uint8_t
+{
+    kEventPressed = 1u << 0,
+    kEventReleased = 1u << 1,
+    kEventValue = 1u << 2,
+    kEventPointer = 1u << 3,
+    kEventPointerPressed = 1u << 4,
+    kEventPointerReleased = 1u << 5,
+};
+
+enum PointerFlags : std::uint8_t
+{
+    kPointerHasPosition = 1u << 0,
+    kPointerLeft = 1u << 1,
+    kPointerRight = 1u << 2,
+    kPointerMiddle = 1u << 3,
+};
+
+template <typename T>
+bool sameBits(const T &lhs, const T &rhs)
+{
+    return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+bool samePointer(const PointerState &lhs, const PointerState &rhs)
+{
+    return lhs.hasPosition == rhs.hasPosition && lhs.x == rhs.x && lhs.y == rhs.y && lhs.left == rhs.left &&
+           lhs.right == rhs.right && lhs.middle == rhs.middle;
+}
+
+double nextTimestamp(double previousMs, float fixedDt)
+{
+    return previousMs + static_cast<double>(fixedDt) * 1000.0;
+}
+
+void writeCounts(ByteWriter &writer, const InputRecordingHeader &header)
+{
+    writer.little(header.frames);
+    writer.little(header.steps);
+    writer.little(header.finalChecksum);
+}
+
+class ChecksumBuilder
+{
+  public:
+    template <typename T>
+    void add(const T &value)
+    {
+        const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+        {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ull;
+        }
+    }
+
+    void add(const Vec2 &value)
+    {
+        add(value.x);
+        add(value.y);
+    }
+
+    std::uint64_t value() const { return m_hash; }
+
+  private:
+    std::uint64_t m_hash = 14695981039346656037ull;
+};
+
+} // namespace
+
+std::uint64_t worldChecksum(const WorldState &world)
+{
+    const LegacySimulation &sim = world.legacy();
+    ChecksumBuilder hash;
+    hash.add(sim.commander.pos);
+    hash.add(sim.commander.hp);
+    hash.add(static_cast<std::uint8_t>(sim.commander.alive));
+    hash.add(static_cast<std::uint64_t>(sim.yunas.size()));
+    for (const auto &unit : sim.yunas)
+    {
+        hash.add(unit.pos());
+        hash.add(unit.hp());
+    }
+    hash.add(static_cast<std::uint64_t>(sim.enemies.size()));
+    for (const EnemyUnit &enemy : sim.enemies)
+    {
+        hash.add(enemy.pos);
+        hash.add(enemy.hp);
+        hash.add(static_cast<std::uint8_t>(enemy.type));
+    }
+    hash.add(static_cast<std::uint64_t>(sim.walls.size()));
+    for (const WallSegment &wall : sim.walls)
+    {
+        hash.add(wall.pos);
+        hash.add(wall.hp);
+    }
+    hash.add(sim.baseHp);
+    hash.add(sim.simTime);
+    hash.add(static_cast<std::uint8_t>(sim.result));
+    // Draw from a copy so the checksum captures the generator position without advancing the simulation.
+    std::mt19937 rng = sim.rng;
+    hash.add(static_cast<std::uint32_t>(rng()));
+    return hash.value();
+}
+
+InputRecorder::~InputRecorder()
+{
+    if (recording())
+    {
+        flushPending();
+        flushBuffer();
+    }
+}
+
+bool InputRecorder::open(const std::filesystem::path &path, const InputRecordingHeader &header)
+{
+    if (recording())
+    {
+        return false;
+    }
+    std::error_code ec;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+    m_stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_stream.is_open())
+    {
+        return false;
+    }
+    m_path = path;
+    m_header = header;
+    m_header.frames = 0;
+    m_header.steps = 0;
+    m_header.finalChecksum = 0;
+    m_hasPending = false;
+    m_hasPrevious = false;
+    m_previous = {};
+
+    m_buffer.clear();
+    ByteWriter writer(m_buffer);
+    for (char ch : kMagic)
+    {
+        writer.u8(static_cast<std::uint8_t>(ch));
+    }
+    writer.little(kFormatVersion);
+    writer.little(m_header.seed);
+    writer.little(m_header.configHash);
+    writer.f32(m_header.fixedDt);
+    writer.f32(m_header.worldWidth);
+    writer.f32(m_header.worldHeight);
+    writeCounts(writer, m_header);
+    flushBuffer();
+    return true;
+}
+
+void InputRecorder::beginFrame(const ActionBuffer::Frame &frame)
+{
+    if (!recording())
+    {
+        return;
+    }
+    flushPending();
+    m_pending.frame.sequence = frame.sequence;
+    m_pending.frame.deviceTimestampMs = frame.deviceTimestampMs;
+    m_pending.frame.axes = frame.axes;
+    m_pending.frame.pointer = frame.pointer;
+    m_pending.frame.events.clear();
+    m_pending.cameraOffsets.clear();
+    m_pending.stepped = false;
+    m_pending.hasChecksum = false;
+    m_hasPending = true;
+}
+
+void InputRecorder::recordEvent(const ActionEvent &event, const Vec2 &cameraOffset)
+{
+    if (!m_hasPending)
+    {
+        return;
+    }
+    m_pending.frame.events.push_back(event);
+    m_pending.cameraOffsets.push_back(cameraOffset);
+}
+
+void InputRecorder::recordStep(const WorldState &world)
+{
+    if (!m_hasPending)
+    {
+        return;
+    }
+    m_pending.stepped = true;
+    ++m_header.steps;
+    if (m_header.steps % kChecksumInterval == 0)
+    {
+        m_pending.hasChecksum = true;
+        m_pending.checksum = worldChecksum(world);
+    }
+}
+
+bool InputRecorder::finish(const WorldState &world)
+{
+    if (!recording())
+    {
+        return false;
+    }
+    flushPending();
+    flushBuffer();
+    m_header.finalChecksum = worldChecksum(world);
+
+    ByteWriter writer(m_buffer);
+    writeCounts(writer, m_header);
+    m_stream.seekp(static_cast<std::streamoff>(kCountsOffset));
+    flushBuffer();
+    const bool ok = m_stream.good();
+    m_stream.close();
+    return ok;
+}
+
+void InputRecorder::flushPending()
+{
+    if (!m_hasPending)
+    {
+        return;
+    }
+    m_hasPending = false;
+    const ActionBuffer::Frame &frame = m_pending.frame;
+
+    std::uint8_t flags = 0;
+    const std::uint64_t expectedSequence = m_hasPrevious ? m_previous.sequence + 1 : 0;
+    if (frame.sequence != expectedSequence)
+    {
+        flags |= kFrameSequence;
+    }
+    if (!m_hasPrevious ||
+        !sameBits(frame.deviceTimestampMs, nextTimestamp(m_previous.deviceTimestampMs, m_header.fixedDt)))
+    {
+        flags |= kFrameTimestamp;
+    }
+    if (!sameBits(frame.axes, m_previous.axes))
+    {
+        flags |= kFrameAxes;
+    }
+    if (!samePointer(frame.pointer, m_previous.pointer))
+    {
+        flags |= kFramePointer;
+    }
+    if (!frame.events.empty())
+    {
+        flags |= kFrameEvents;
+    }
+    if (m_pending.stepped)
+    {
+        flags |= kFrameStepped;
+    }
+    if (m_pending.hasChecksum)
+    {
+        flags |= kFrameChecksum;
+    }
+
+    ByteWriter writer(m_buffer);
+    writer.u8(flags);
+    if (flags & kFrameSequence)
+    {
+        writer.varint(frame.sequence);
+    }
+    if (flags & kFrameTimestamp)
+    {
+        writer.f64(frame.deviceTimestampMs);
+    }
+    if (flags & kFrameAxes)
+    {
+        for (float axis : frame.axes)
+        {
+            writer.f32(axis);
+        }
+    }
+    if (flags & kFramePointer)
+    {
+        const PointerState &pointer = frame.pointer;
+        writer.u8(static_cast<std::uint8_t>((pointer.hasPosition ? kPointerHasPosition : 0) |
+                                            (pointer.left ? kPointerLeft : 0) | (pointer.right ? kPointerRight : 0) |
+                                            (pointer.middle ? kPointerMiddle : 0)));
+        writer.zigzag(pointer.x);
+        writer.zigzag(pointer.y);
+    }
+    if (flags & kFrameEvents)
+    {
+        writer.varint(frame.events.size());
+        for (std::size_t i = 0; i < frame.events.size(); ++i)
+        {
+            const ActionEvent &event = frame.events[i];
+            std::uint8_t eventFlags = (event.pressed ? kEventPressed : 0) | (event.released ? kEventReleased : 0);
+            if (event.value != 0.0f)
+            {
+                eventFlags |= kEventValue;
+            }
+            if (event.pointer)
+            {
+                eventFlags |= kEventPointer | (event.pointer->pressed ? kEventPointerPressed : 0) |
+                              (event.pointer->released ? kEventPointerReleased : 0);
+            }
+            writer.varint(static_cast<std::uint64_t>(event.id));
+            writer.u8(eventFlags);
+            if (eventFlags & kEventValue)
+            {
+                writer.f32(event.value);
+            }
+            if (event.pointer)
+            {
+                writer.zigzag(event.pointer->x);
+                writer.zigzag(event.pointer->y);
+                writer.f32(m_pending.cameraOffsets[i].x);
+                writer.f32(m_pending.cameraOffsets[i].y);
+            }
+        }
+    }
+    if (flags & kFrameChecksum)
+    {
+        writer.little(m_pending.checksum);
+    }
+
+    m_previous.sequence = frame.sequence;
+    m_previous.deviceTimestampMs = frame.deviceTimestampMs;
+    m_previous.axes = frame.axes;
+    m_previous.pointer = frame.pointer;
+    m_hasPrevious = true;
+    ++m_header.frames;
+    if (m_buffer.size() >= kFlushThreshold)
+    {
+        flushBuffer();
+    }
+}
+
+void InputRecorder::flushBuffer()
+{
+    if (!m_buffer.empty())
+    {
+        m_stream.write(reinterpret_cast<const char *>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+}
+
+InputRecordingLoadResult loadInputRecording(const std::filesystem::path &path)
+{
+    InputRecordingLoadResult result;
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open())
+    {
+        result.error = "open_failed";
+        return result;
+    }
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    if (data.size() < kHeaderSize || !std::equal(kMagic.begin(), kMagic.end(), data.begin()))
+    {
+        result.error = "not an input recording";
+        return result;
+    }
+
+    ByteReader reader(data, kMagic.size());
+    if (reader.little<std::uint16_t>() != kFormatVersion)
+    {
+        result.error = "unsupported version";
+        return result;
+    }
+    InputRecordingHeader &header = result.recording.header;
+    header.seed = reader.little<std::uint32_t>();
+    header.configHash = reader.little<std::uint64_t>();
+    header.fixedDt = reader.f32();
+    header.worldWidth = reader.f32();
+    header.worldHeight = reader.f32();
+    header.frames = reader.little<std::uint64_t>();
+    header.steps = reader.little<std::uint64_t>();
+    header.finalChecksum = reader.little<std::uint64_t>();
+
+    std::vector<RecordedFrame> &frames = result.recording.frames;
+    frames.reserve(static_cast<std::size_t>(header.frames));
+    ActionBuffer::Frame previous;
+    while (!reader.atEnd())
+    {
+        const std::size_t recordOffset = reader.offset();
+        RecordedFrame record;
+        ActionBuffer::Frame &frame = record.frame;
+        const std::uint8_t flags = reader.u8();
+        frame.sequence = (flags & kFrameSequence) ? reader.varint() : (frames.empty() ? 0 : previous.sequence + 1);
+        frame.deviceTimestampMs = (flags & kFrameTimestamp) ? reader.f64()
+                                                            : nextTimestamp(previous.deviceTimestampMs, header.fixedDt);
+        frame.axes = previous.axes;
+        if (flags & kFrameAxes)
+        {
+            for (float &axis : frame.axes)
+            {
+                axis = reader.f32();
+            }
+        }
+        frame.pointer = previous.pointer;
+        if (flags & kFramePointer)
+        {
+            const std::uint8_t pointerFlags = reader.u8();
+            frame.pointer.hasPosition = (pointerFlags & kPointerHasPosition) != 0;
+            frame.pointer.left = (pointerFlags & kPointerLeft) != 0;
+            frame.pointer.right = (pointerFlags & kPointerRight) != 0;
+            frame.pointer.middle = (pointerFlags & kPointerMiddle) != 0;
+            frame.pointer.x = static_cast<int>(reader.zigzag());
+            frame.pointer.y = static_cast<int>(reader.zigzag());
+        }
+        if (flags & kFrameEvents)
+        {
+            const std::uint64_t count = reader.varint();
+            for (std::uint64_t i = 0; i < count && reader.ok(); ++i)
+            {
+                ActionEvent event;
+                const std::uint64_t id = reader.varint();
+                if (id >= static_cast<std::uint64_t>(ActionId::Count))
+                {
+                    result.error = "invalid action id at byte " + std::to_string(recordOffset);
+                    return result;
+                }
+                event.id = static_cast<ActionId>(id);
+                const std::uint8_t eventFlags = reader.u8();
+                event.pressed = (eventFlags & kEventPressed) != 0;
+                event.released = (eventFlags & kEventReleased) != 0;
+                if (eventFlags & kEventValue)
+                {
+                    event.value = reader.f32();
+                }
+                Vec2 cameraOffset{0.0f, 0.0f};
+                if (eventFlags & kEventPointer)
+                {
+                    PointerPayload pointer;
+                    pointer.x = static_cast<int>(reader.zigzag());
+                    pointer.y = static_cast<int>(reader.zigzag());
+                    pointer.pressed = (eventFlags & kEventPointerPressed) != 0;
+                    pointer.released = (eventFlags & kEventPointerReleased) != 0;
+                    event.pointer = pointer;
+                    cameraOffset.x = reader.f32();
+                    cameraOffset.y = reader.f32();
+                }
+                frame.events.push_back(event);
+                record.cameraOffsets.push_back(cameraOffset);
+            }
+        }
+        record.stepped = (flags & kFrameStepped) != 0;
+        if (flags & kFrameChecksum)
+        {
+            record.hasChecksum = true;
+            record.checksum = reader.little<std::uint64_t>();
+        }
+        if (!reader.ok())
+        {
+            // A session that was cut short may end mid-record; keep everything before it.
+            if (header.complete())
+            {
+                result.error = "truncated record at byte " + std::to_string(recordOffset);
+                return result;
+            }
+            break;
+        }
+        previous.sequence = frame.sequence;
+        previous.deviceTimestampMs = frame.deviceTimestampMs;
+        previous.axes = frame.axes;
+        previous.pointer = frame.pointer;
+        frames.push_back(std::move(record));
+    }
+    if (header.complete() && frames.size() != header.frames)
+    {
+        result.error = "frame count mismatch";
+        return result;
+    }
+    result.success = true;
+    return result;
+}
+
+InputReplayer::InputReplayer(const InputRecording &recording) : m_recording(recording)
+{
+}
+
+void InputReplayer::prepare(WorldState &world) const
+{
+    const InputRecordingHeader &header = m_recording.header;
+    LegacySimulation &sim = world.legacy();
+    sim.config.rng_seed = static_cast<int>(header.seed);
+    sim.config.fixed_dt = header.fixedDt;
+    world.setWorldBounds(header.worldWidth, header.worldHeight);
+    world.reset();
+}
+
+bool InputReplayer::advance(WorldState &world)
+{
+    m_lastStepped = false;
+    if (finished())
+    {
+        return false;
+    }
+    const RecordedFrame &record = m_recording.frames[m_next++];
+    const ActionBuffer::Frame &frame = record.frame;
+    m_actions.pushFrame(frame.sequence, frame.deviceTimestampMs, frame.axes, frame.events, frame.pointer);
+    for (std::size_t i = 0; i < frame.events.size(); ++i)
+    {
+        world.applyAction(frame.events[i], record.cameraOffsets[i]);
+    }
+    ++m_result.frames;
+
+    if (record.stepped)
+    {
+        world.step(m_recording.header.fixedDt, m_actions);
+        ++m_result.steps;
+        m_lastStepped = true;
+        if (record.hasChecksum)
+        {
+            verify(record.checksum, world);
+        }
+    }
+    if (finished() && m_recording.header.complete())
+    {
+        verify(m_recording.header.finalChecksum, world);
+    }
+    return true;
+}
+
+void InputReplayer::verify(std::uint64_t expected, const WorldState &world)
+{
+    if (m_result.diverged)
+    {
+        return;
+    }
+    const std::uint64_t actual = worldChecksum(world);
+    if (actual == expected)
+    {
+        ++m_result.checksumsVerified;
+        return;
+    }
+    m_result.diverged = true;
+    m_result.divergedStep = m_result.steps;
+    m_result.expectedChecksum = expected;
+    m_result.actualChecksum = actual;
+}
+
+} // namespace world
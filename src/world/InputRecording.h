@@ -0,0 +1,141 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "input/ActionBuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace world
+{
+
+class WorldState;
+
+// Hash of the simulation state that replays compare against: commander, units, walls, base, clock and RNG.
+std::uint64_t worldChecksum(const WorldState &world);
+
+struct InputRecordingHeader
+{
+    std::uint32_t seed = 0;
+    std::uint64_t configHash = 0;
+    float fixedDt = 1.0f / 60.0f;
+    float worldWidth = 0.0f;
+    float worldHeight = 0.0f;
+    // Filled in by InputRecorder::finish(); zero when the recording was cut short.
+    std::uint64_t frames = 0;
+    std::uint64_t steps = 0;
+    std::uint64_t finalChecksum = 0;
+
+    bool complete() const { return frames > 0; }
+};
+
+struct RecordedFrame
+{
+    // Only the events that reached WorldState::applyAction; UI-only events are dropped at record time.
+    ActionBuffer::Frame frame;
+    // Camera position each event was applied with, parallel to frame.events.
+    std::vector<Vec2> cameraOffsets;
+    bool stepped = false;
+    bool hasChecksum = false;
+    std::uint64_t checksum = 0;
+};
+
+struct InputRecording
+{
+    InputRecordingHeader header;
+    std::vector<RecordedFrame> frames;
+};
+
+struct InputRecordingLoadResult
+{
+    bool success = false;
+    std::string error;
+    InputRecording recording;
+};
+
+InputRecordingLoadResult loadInputRecording(const std::filesystem::path &path);
+
+// Writes the handled ActionBuffer::Frame stream of a session as a compact binary file (.kzir). Per frame the
+// recorder stores only what changed since the previous frame: axes, pointer state, the applied events, a
+// sequence/timestamp only when they do not follow the fixed step, and a world checksum every kChecksumInterval
+// steps so a replay can report where it diverged.
+class InputRecorder
+{
+  public:
+    static constexpr std::uint64_t kChecksumInterval = 60;
+
+    InputRecorder() = default;
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder &) = delete;
+    InputRecorder &operator=(const InputRecorder &) = delete;
+
+    bool open(const std::filesystem::path &path, const InputRecordingHeader &header);
+    bool recording() const { return m_stream.is_open(); }
+    const std::filesystem::path &path() const { return m_path; }
+
+    // Call order per handled frame: beginFrame, recordEvent for every event passed to WorldState::applyAction,
+    // then recordStep if the world stepped with this frame.
+    void beginFrame(const ActionBuffer::Frame &frame);
+    void recordEvent(const ActionEvent &event, const Vec2 &cameraOffset);
+    void recordStep(const WorldState &world);
+
+    // Flushes the last frame, stores the frame/step counts and the final checksum in the header and closes.
+    bool finish(const WorldState &world);
+
+  private:
+    void flushPending();
+    void flushBuffer();
+
+    std::filesystem::path m_path;
+    std::ofstream m_stream;
+    std::vector<std::uint8_t> m_buffer;
+    InputRecordingHeader m_header;
+    RecordedFrame m_pending;
+    bool m_hasPending = false;
+    ActionBuffer::Frame m_previous;
+    bool m_hasPrevious = false;
+};
+
+struct InputReplayResult
+{
+    std::uint64_t frames = 0;
+    std::uint64_t steps = 0;
+    std::uint64_t checksumsVerified = 0;
+    bool diverged = false;
+    std::uint64_t divergedStep = 0;
+    std::uint64_t expectedChecksum = 0;
+    std::uint64_t actualChecksum = 0;
+};
+
+// Drives a WorldState from a recording as fast as it will step. The world must already be configured from the
+// same AppConfig the session used; prepare() then applies the recorded seed and bounds and resets it.
+class InputReplayer
+{
+  public:
+    explicit InputReplayer(const InputRecording &recording);
+
+    void prepare(WorldState &world) const;
+
+    // Applies the next recorded frame and steps the world when the session did. Returns false once every frame
+    // has been replayed.
+    bool advance(WorldState &world);
+    bool lastAdvanceStepped() const { return m_lastStepped; }
+    bool finished() const { return m_next >= m_recording.frames.size(); }
+    const InputReplayResult &result() const { return m_result; }
+
+  private:
+    void verify(std::uint64_t expected, const WorldState &world);
+
+    const InputRecording &m_recording;
+    std::size_t m_next = 0;
+    ActionBuffer m_actions;
+    InputReplayResult m_result;
+    bool m_lastStepped = false;
+};
+
+} // namespace world
@@ -0,0 +1,158 @@
+#include "world/JobScheduler.h"
+
+namespace world
+{
+
+thread_local bool JobScheduler::tls_insideTask = false;
+
+std::size_t JobScheduler::defaultWorkerCount()
+{
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? static_cast<std::size_t>(hardware - 1) : 0;
+}
+
+JobScheduler::JobScheduler(std::size_t workerCount)
+{
+    m_queues.reserve(workerCount + 1);
+    for (std::size_t i = 0; i <= workerCount; ++i)
+    {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    m_workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobScheduler::~JobScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void JobScheduler::run(std::vector<Task> &tasks)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::defer_lock);
+    if (m_workers.empty() || tasks.size() == 1 || tls_insideTask || !runLock.try_lock())
+    {
+        for (Task &task : tasks)
+        {
+            task();
+        }
+        return;
+    }
+
+    Batch batch;
+    batch.remaining.store(tasks.size(), std::memory_order_relaxed);
+    // Count the jobs before publishing them: a thread may take one as soon as it is queued, and its decrement
+    // must never run ahead of this increment or the unsigned counter wraps and sleeping workers spin.
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_pending.fetch_add(tasks.size(), std::memory_order_release);
+    }
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        Queue &queue = *m_queues[i % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(Job{&tasks[i], &batch});
+    }
+    m_wake.notify_all();
+
+    const std::size_t callerQueue = m_queues.size() - 1;
+    Job job;
+    while (batch.remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (tryTake(callerQueue, job))
+        {
+            execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (batch.error)
+    {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+void JobScheduler::workerLoop(std::size_t index)
+{
+    Job job;
+    while (true)
+    {
+        if (tryTake(index, job))
+        {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return m_stopping || m_pending.load(std::memory_order_acquire) > 0; });
+        if (m_stopping)
+        {
+            return;
+        }
+    }
+}
+
+bool JobScheduler::tryTake(std::size_t index, Job &job)
+{
+    const std::size_t queueCount = m_queues.size();
+    for (std::size_t offset = 0; offset < queueCount; ++offset)
+    {
+        Queue &queue = *m_queues[(index + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+        {
+            continue;
+        }
+        if (offset == 0)
+        {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+        }
+        else
+        {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+        }
+        m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+    return false;
+}
+
+void JobScheduler::execute(const Job &job)
+{
+    tls_insideTask = true;
+    try
+    {
+        (*job.task)();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(job.batch->errorMutex);
+        if (!job.batch->error)
+        {
+            job.batch->error = std::current_exception();
+        }
+    }
+    tls_insideTask = false;
+    job.batch->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace world
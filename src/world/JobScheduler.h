@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace world
+{
+
+// Work-stealing thread pool for the simulation step. run() deals tasks round-robin onto per-thread deques; every
+// thread pops its own deque from the front and steals from the back of the others. The calling thread takes part
+// until its batch is done. Nested calls from inside a task run inline, so tasks may use parallelFor freely.
+class JobScheduler
+{
+  public:
+    using Task = std::function<void()>;
+
+    // One worker per spare hardware thread, leaving the caller's thread to the caller.
+    static std::size_t defaultWorkerCount();
+
+    explicit JobScheduler(std::size_t workerCount = defaultWorkerCount());
+    ~JobScheduler();
+
+    JobScheduler(const JobScheduler &) = delete;
+    JobScheduler &operator=(const JobScheduler &) = delete;
+
+    std::size_t workerCount() const
+    {
+        return m_workers.size();
+    }
+
+    // Runs every task and returns once all of them have finished. The first exception thrown is rethrown here.
+    void run(std::vector<Task> &tasks);
+
+    // Calls fn(begin, end) over [0, count) in chunks of `grain` items. Chunk boundaries do not depend on the
+    // number of threads, so per-item work that only touches its own item gives the same result as a serial loop.
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t grain, Fn &&fn)
+    {
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (count + grain - 1) / grain;
+        if (chunks <= 1 || m_workers.empty() || tls_insideTask)
+        {
+            for (std::size_t begin = 0; begin < count; begin += grain)
+            {
+                fn(begin, std::min(begin + grain, count));
+            }
+            return;
+        }
+        std::vector<Task> tasks;
+        tasks.reserve(chunks);
+        for (std::size_t begin = 0; begin < count; begin += grain)
+        {
+            const std::size_t end = std::min(begin + grain, count);
+            tasks.emplace_back([&fn, begin, end]() { fn(begin, end); });
+        }
+        run(tasks);
+    }
+
+  private:
+    struct Batch
+    {
+        std::atomic<std::size_t> remaining{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Job
+    {
+        Task *task = nullptr;
+        Batch *batch = nullptr;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // One queue per worker plus a final one owned by the thread calling run().
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_runMutex;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<std::size_t> m_pending{0};
+    bool m_stopping = false;
+
+    static thread_local bool tls_insideTask;
+
+    void workerLoop(std::size_t index);
+    bool tryTake(std::size_t index, Job &job);
+    void execute(const Job &job);
+};
+
+} // namespace world
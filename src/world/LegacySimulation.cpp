@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cctype>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -12,8 +13,109 @@
 #include <utility>
 
 #include "telemetry/TelemetrySink.h"
+#include "world/StateArchive.h"
 #include "world/spawn/WaveController.h"
 
+Vec2 operator+(const Vec2 &a, const Vec2 &b) { return {a.x + b.x, a.y + b.y}; }
+Vec2 operator-(const Vec2 &a, const Vec2 &b) { return {a.x - b.x, a.y - b.y}; }
+Vec2 operator*(const Vec2 &a, float s) { return {a.x * s, a.y * s}; }
+Vec2 operator/(const Vec2 &a, float s) { return {a.x / s, a.y / s}; }
+Vec2 &operator+=(Vec2 &a, const Vec2 &b)
+{
+    a.x += b.x;
+    a.y += b.y;
+    return a;
+}
+
+Vec2 lerp(const Vec2 &a, const Vec2 &b, float t)
+{
+    return a + (b - a) * t;
+}
+
+float dot(const Vec2 &a, const Vec2 &b) { return a.x * b.x + a.y * b.y; }
+float lengthSq(const Vec2 &v) { return dot(v, v); }
+float length(const Vec2 &v) { return std::sqrt(lengthSq(v)); }
+Vec2 normalize(const Vec2 &v)
+{
+    const float len = length(v);
+    return len > 0.0001f ? v / len : Vec2{0.0f, 0.0f};
+}
+
+Vec2 tileToWorld(const Vec2 &tile, int tileSize)
+{
+    return {tile.x * tileSize + tileSize * 0.5f, tile.y * tileSize + tileSize * 0.5f};
+}
+
+std::vector<Vec2> computeFormationOffsets(Formation formation, std::size_t count)
+{
+    std::vector<Vec2> offsets;
+    offsets.reserve(count);
+    if (count == 0)
+    {
+        return offsets;
+    }
+    if (count == 1)
+    {
+        offsets.push_back({0.0f, 32.0f});
+        return offsets;
+    }
+    constexpr float pi = 3.14159265358979323846f;
+    switch (formation)
+    {
+    case Formation::Swarm:
+    case Formation::Ring:
+    {
+        const float radius = formation == Formation::Ring ? 40.0f : 48.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float angle = (static_cast<float>(i) / static_cast<float>(count)) * 2.0f * pi;
+            offsets.push_back({std::cos(angle) * radius, std::sin(angle) * radius});
+        }
+        break;
+    }
+    case Formation::Line:
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float offsetX = (static_cast<float>(i) - (static_cast<float>(count) - 1.0f) * 0.5f) * 24.0f;
+            offsets.push_back({offsetX, 32.0f});
+        }
+        break;
+    }
+    case Formation::Wedge:
+    {
+        std::size_t produced = 0;
+        int row = 0;
+        while (produced < count)
+        {
+            const int rowCount = row + 1;
+            for (int i = 0; i < rowCount && produced < count; ++i)
+            {
+                const float offsetX = (static_cast<float>(i) - (rowCount - 1) * 0.5f) * 26.0f;
+                const float offsetY = 32.0f + row * 28.0f;
+                offsets.push_back({offsetX, offsetY});
+                ++produced;
+            }
+            ++row;
+        }
+        break;
+    }
+    }
+    return offsets;
+}
+
+const char *stanceLabel(ArmyStance stance)
+{
+    switch (stance)
+    {
+    case ArmyStance::RushNearest: return "Rush Nearest";
+    case ArmyStance::PushForward: return "Push Forward";
+    case ArmyStance::FollowLeader: return "Follow Leader";
+    case ArmyStance::DefendBase: return "Defend Base";
+    }
+    return "Unknown";
+}
+
 namespace
 {
 std::string_view enemyTypeLabel(EnemyArchetype type)
@@ -34,11 +136,6 @@ std::string formatFloat(float value, int precision = 3)
     return oss.str();
 }
 
-std::string boolString(bool value)
-{
-    return value ? "true" : "false";
-}
-
 std::string sanitizeForTsv(std::string value)
 {
     for (char &ch : value)
@@ -144,116 +241,42 @@ void LegacySimulation::captureFrameSnapshot(TelemetrySink &sink)
 
     std::ostringstream filename;
     filename << "frame_capture_" << std::setw(6) << std::setfill('0') << frameCaptureBatch << '_' << std::setw(2)
-             << std::setfill('0') << frameCaptureIndex << ".json";
-    const fs::path filePath = baseDir / filename.str();
-
-    std::ofstream stream(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
-    if (!stream.is_open())
-    {
-        TelemetrySink::Payload payload;
-        payload.emplace("path", filePath.lexically_normal().string());
-        payload.emplace("error", "open_failed");
-        sink.recordEvent("world.frame_capture.error", payload);
-        return;
-    }
-
-    stream << "{\n";
-    stream << "  \"batch\": " << frameCaptureBatch << ",\n";
-    stream << "  \"index\": " << frameCaptureIndex << ",\n";
-    stream << "  \"frame\": " << frameCounter << ",\n";
-    stream << "  \"sim_time\": " << formatFloat(simTime) << ",\n";
-    stream << "  \"commander\": {\n";
-    stream << "    \"alive\": " << boolString(commander.alive) << ",\n";
-    stream << "    \"hp\": " << formatFloat(commander.hp) << ",\n";
-    stream << "    \"pos\": {\"x\": " << formatFloat(commander.pos.x) << ", \"y\": " << formatFloat(commander.pos.y)
-           << "}\n";
-    stream << "  },\n";
+             << std::setfill('0') << frameCaptureIndex << ".kzs";
 
-    stream << "  \"yunas\": [\n";
-    for (std::size_t i = 0; i < yunas.size(); ++i)
-    {
-        const Unit &yuna = yunas[i];
-        if (i > 0)
-        {
-            stream << ",\n";
-        }
-        stream << "    {\"index\": " << i << ", \"job\": \"" << unitJobToString(yuna.job.job) << "\", \"hp\": "
-               << formatFloat(yuna.hp) << ", \"morale\": \"" << moraleStateLabel(yuna.moraleState)
-               << "\", \"pos\": {\"x\": " << formatFloat(yuna.pos.x) << ", \"y\": " << formatFloat(yuna.pos.y)
-               << "}, \"follow_skill\": " << boolString(yuna.followBySkill) << ", \"follow_stance\": "
-               << boolString(yuna.followByStance) << "}";
-    }
-    if (!yunas.empty())
+    // Only the copy happens here; encoding and the file write run on the writer thread and are reported by
+    // reportFrameCaptures() on a later step.
+    if (!snapshotWriter)
     {
-        stream << '\n';
+        snapshotWriter = std::make_shared<SnapshotWriter>();
     }
-    stream << "  ],\n";
+    snapshotWriter->submit(baseDir / filename.str(), captureWorldSnapshot(*this));
+}
 
-    stream << "  \"enemies\": [\n";
-    for (std::size_t i = 0; i < enemies.size(); ++i)
-    {
-        const EnemyUnit &enemy = enemies[i];
-        if (i > 0)
-        {
-            stream << ",\n";
-        }
-        stream << "    {\"index\": " << i << ", \"type\": \"" << enemyTypeLabel(enemy.type)
-               << "\", \"hp\": " << formatFloat(enemy.hp) << ", \"pos\": {\"x\": "
-               << formatFloat(enemy.pos.x) << ", \"y\": " << formatFloat(enemy.pos.y)
-               << "}, \"radius\": " << formatFloat(enemy.radius) << "}";
-    }
-    if (!enemies.empty())
+void LegacySimulation::reportFrameCaptures(TelemetrySink &sink)
+{
+    if (!snapshotWriter)
     {
-        stream << '\n';
+        return;
     }
-    stream << "  ],\n";
-
-    stream << "  \"walls\": [\n";
-    for (std::size_t i = 0; i < walls.size(); ++i)
+    for (const SnapshotWriter::Result &result : snapshotWriter->drainResults())
     {
-        const WallSegment &wall = walls[i];
-        if (i > 0)
+        TelemetrySink::Payload payload;
+        if (!result.success)
         {
-            stream << ",\n";
+            payload.emplace("path", result.path.lexically_normal().string());
+            payload.emplace("error", result.error);
+            sink.recordEvent("world.frame_capture.error", payload);
+            continue;
         }
-        stream << "    {\"index\": " << i << ", \"hp\": " << formatFloat(wall.hp) << ", \"life\": "
-               << formatFloat(wall.life) << ", \"pos\": {\"x\": " << formatFloat(wall.pos.x) << ", \"y\": "
-               << formatFloat(wall.pos.y) << "}, \"radius\": " << formatFloat(wall.radius) << "}";
-    }
-    if (!walls.empty())
-    {
-        stream << '\n';
+        payload.emplace("file", result.path.lexically_normal().string());
+        payload.emplace("frame", std::to_string(result.frame));
+        payload.emplace("batch", std::to_string(result.batch));
+        payload.emplace("index", std::to_string(result.index));
+        payload.emplace("yunas", std::to_string(result.yunas));
+        payload.emplace("enemies", std::to_string(result.enemies));
+        payload.emplace("bytes", std::to_string(result.bytes));
+        sink.recordEvent("world.frame_capture.saved", payload);
     }
-    stream << "  ]\n";
-    stream << "}\n";
-
-    stream.flush();
-    if (!stream.good())
-    {
-        TelemetrySink::Payload payload;
-        payload.emplace("path", filePath.lexically_normal().string());
-        payload.emplace("error", "write_failed");
-        sink.recordEvent("world.frame_capture.error", payload);
-        return;
-    }
-
-    stream.close();
-
-    std::error_code sizeEc;
-    const auto size = fs::file_size(filePath, sizeEc);
-
-    TelemetrySink::Payload payload;
-    payload.emplace("file", filePath.lexically_normal().string());
-    payload.emplace("frame", std::to_string(frameCounter));
-    payload.emplace("batch", std::to_string(frameCaptureBatch));
-    payload.emplace("index", std::to_string(frameCaptureIndex));
-    payload.emplace("yunas", std::to_string(yunas.size()));
-    payload.emplace("enemies", std::to_string(enemies.size()));
-    if (!sizeEc)
-    {
-        payload.emplace("bytes", std::to_string(size));
-    }
-    sink.recordEvent("world.frame_capture.saved", payload);
 }
 
 void LegacySimulation::handleSpawnDeferral(int deferredCount)
@@ -303,6 +326,78 @@ void LegacySimulation::handleSpawnDeferral(int deferredCount)
     }
 }
 
+void LegacySimulation::reserveEnemyPool(std::size_t scriptedPeak)
+{
+    std::size_t missionEnemies = 0;
+    if (missionMode == MissionMode::Boss)
+    {
+        missionEnemies = 1;
+    }
+    else if (missionMode == MissionMode::Survival)
+    {
+        missionEnemies = missionConfig.survival.elites.size();
+    }
+    enemyPool.reserved = std::max(scriptedPeak + missionEnemies, enemyPool.previousPeak);
+    enemies.reserve(enemyPool.reserved);
+}
+
+void LegacySimulation::noteEnemySpawned()
+{
+    if (enemies.size() <= enemyPool.peak)
+    {
+        return;
+    }
+    enemyPool.peak = enemies.size();
+    if (enemyPool.peak <= enemyPool.reserved || enemyPool.overflowReported)
+    {
+        return;
+    }
+    enemyPool.overflowReported = true;
+    if (auto sink = telemetry.lock())
+    {
+        TelemetrySink::Payload payload;
+        payload.emplace("reserved", std::to_string(enemyPool.reserved));
+        payload.emplace("count", std::to_string(enemyPool.peak));
+        payload.emplace("frame", std::to_string(frameCounter));
+        sink->recordEvent("world.enemy_pool.exceeded", payload);
+    }
+}
+
+void LegacySimulation::recordEnemyPoolPeak()
+{
+    if (enemyPool.peak == 0)
+    {
+        return;
+    }
+    if (auto sink = telemetry.lock())
+    {
+        TelemetrySink::Payload payload;
+        payload.emplace("reserved", std::to_string(enemyPool.reserved));
+        payload.emplace("peak", std::to_string(enemyPool.peak));
+        sink->recordEvent("world.enemy_pool.peak", payload);
+    }
+    enemyPool.previousPeak = std::max(enemyPool.previousPeak, enemyPool.peak);
+    enemyPool.peak = 0;
+    enemyPool.overflowReported = false;
+}
+
+void LegacySimulation::syncWallIndex()
+{
+    const int tileSize = mapDefs.tile_size > 0 ? mapDefs.tile_size : 16;
+    // Cells at least as wide as the preference radius keep a lookup within a 3x3 block.
+    const float cellSize = std::max(static_cast<float>(tileSize), wallbreakerStats.preferWallRadiusPx);
+    if (wallIndex.configure(worldMin, worldMax, cellSize) || wallIndex.size() != walls.size())
+    {
+        rebuildWallIndex();
+    }
+}
+
+void LegacySimulation::rebuildWallIndex()
+{
+    wallIndex.clear();
+    walls.forEach([&](EntityId id, const WallSegment &wall) { wallIndex.insert(id, wall.pos); });
+}
+
 LegacySimulation::SpawnHistoryDumpResult LegacySimulation::dumpSpawnHistory(const spawn::WaveController &controller) const
 {
     SpawnHistoryDumpResult result;
@@ -386,5 +481,356 @@ LegacySimulation::SpawnHistoryDumpResult LegacySimulation::dumpSpawnHistory(cons
     return result;
 }
 
+namespace
+{
+
+template <typename Archive, typename Temperament>
+void transferTemperament(Archive &archive, Temperament &temperament, const TemperamentConfig &config)
+{
+    std::size_t definition = 0;
+    if constexpr (!Archive::kLoading)
+    {
+        if (temperament.definition)
+        {
+            definition = static_cast<std::size_t>(temperament.definition - config.definitions.data()) + 1;
+        }
+    }
+    archive.field(definition);
+    if constexpr (Archive::kLoading)
+    {
+        if (definition > config.definitions.size())
+        {
+            archive.fail("temperament_invalid");
+            definition = 0;
+        }
+        temperament.definition = definition > 0 ? &config.definitions[definition - 1] : nullptr;
+    }
+    archive.field(temperament.currentBehavior);
+    archive.field(temperament.lastBehavior);
+    archive.field(temperament.mimicActive);
+    archive.field(temperament.mimicBehavior);
+    archive.field(temperament.mimicCooldown);
+    archive.field(temperament.mimicDuration);
+    archive.field(temperament.wanderDirection);
+    archive.field(temperament.wanderTimer);
+    archive.field(temperament.sleepTimer);
+    archive.field(temperament.sleepRemaining);
+    archive.field(temperament.sleeping);
+    archive.field(temperament.catchupTimer);
+    archive.field(temperament.cryTimer);
+    archive.field(temperament.cryPauseTimer);
+    archive.field(temperament.crying);
+    archive.field(temperament.panicTimer);
+    archive.field(temperament.chargeDashTimer);
+}
+
+template <typename Archive, typename Job>
+void transferJob(Archive &archive, Job &job)
+{
+    archive.field(job.job);
+    archive.field(job.cooldown);
+    archive.field(job.endlag);
+    archive.field(job.warrior.stumbleTimer);
+    archive.field(job.archer.focusReady);
+    archive.field(job.archer.holdTimer);
+    archive.field(job.shield.tauntTimer);
+    archive.field(job.shield.selfSlowTimer);
+}
+
+template <typename Archive, typename Hud>
+void transferHud(Archive &archive, Hud &hud)
+{
+    archive.field(hud.telemetryText);
+    archive.field(hud.telemetryTimer);
+    archive.field(hud.resultText);
+    archive.field(hud.resultTimer);
+    archive.field(hud.unconsumedEvents);
+    archive.field(hud.alignment.active);
+    archive.field(hud.alignment.label);
+    archive.field(hud.alignment.secondsRemaining);
+    archive.field(hud.alignment.progress);
+    archive.field(hud.alignment.followers);
+    archive.field(hud.morale.commanderState);
+    archive.field(hud.morale.leaderDownTimer);
+    archive.field(hud.morale.commanderBarrierTimer);
+    archive.field(hud.morale.panicCount);
+    archive.field(hud.morale.mesomesoCount);
+    for (auto &entry : hud.jobs.entries)
+    {
+        archive.field(entry.job);
+        archive.field(entry.total);
+        archive.field(entry.ready);
+        archive.field(entry.maxCooldown);
+        archive.field(entry.maxEndlag);
+        archive.field(entry.specialActive);
+        archive.field(entry.specialTimer);
+    }
+    archive.sequence(hud.jobs.skills, [&](auto &skill) {
+        archive.field(skill.id);
+        archive.field(skill.label);
+        archive.field(skill.cooldownRemaining);
+        archive.field(skill.activeTimer);
+        archive.field(skill.toggled);
+    });
+    archive.field(hud.performance.active);
+    archive.field(hud.performance.message);
+    archive.field(hud.performance.timer);
+    archive.field(hud.spawnBudget.active);
+    archive.field(hud.spawnBudget.message);
+    archive.field(hud.spawnBudget.timer);
+    archive.field(hud.spawnBudget.lastDeferred);
+    archive.field(hud.spawnBudget.totalDeferred);
+}
+
+template <typename Distribution>
+void transferDistribution(StateWriter &archive, const Distribution &distribution)
+{
+    archive.field(distribution.a());
+    archive.field(distribution.b());
+}
+
+template <typename Distribution>
+void transferDistribution(StateReader &archive, Distribution &distribution)
+{
+    float a = 0.0f;
+    float b = 0.0f;
+    archive.field(a);
+    archive.field(b);
+    distribution = Distribution(a, b);
+}
+
+template <typename Archive>
+void transferUnit(Archive &archive, Unit &unit, const TemperamentConfig &temperamentConfig)
+{
+#define KUSOZAKO_UNIT_TRANSFER(FieldType, name, init)                                                                  \
+    if constexpr (std::is_same_v<FieldType, TemperamentState>)                                                         \
+    {                                                                                                                  \
+        transferTemperament(archive, unit.name, temperamentConfig);                                                    \
+    }                                                                                                                  \
+    else if constexpr (std::is_same_v<FieldType, JobRuntimeState>)                                                     \
+    {                                                                                                                  \
+        transferJob(archive, unit.name);                                                                               \
+    }                                                                                                                  \
+    else                                                                                                               \
+    {                                                                                                                  \
+        archive.field(unit.name);                                                                                      \
+    }
+    KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_TRANSFER)
+#undef KUSOZAKO_UNIT_TRANSFER
+}
+
+template <typename Archive, typename Sim>
+void transferRuntimeState(Archive &archive, Sim &sim)
+{
+    archive.field(sim.commander.pos);
+    archive.field(sim.commander.hp);
+    archive.field(sim.commander.radius);
+    archive.field(sim.commander.alive);
+    archive.field(sim.commander.moveIntent);
+    archive.field(sim.commander.hasMoveIntent);
+
+    archive.pool(sim.yunas, [&](auto &&stored) {
+        // Saving walks the columns through a ConstUnitRef and loading fills a Unit; both go through the Unit form.
+        if constexpr (std::is_same_v<std::decay_t<decltype(stored)>, Unit>)
+        {
+            transferUnit(archive, stored, sim.temperamentConfig);
+        }
+        else
+        {
+            Unit unit = stored;
+            transferUnit(archive, unit, sim.temperamentConfig);
+        }
+    });
+    archive.sequence(sim.jobHistory);
+    archive.field(sim.jobHistoryLimit);
+    archive.sequence(sim.yunaRespawns, [&](auto &pending) {
+        archive.field(pending.timer);
+        archive.field(pending.job);
+    });
+    archive.sequence(sim.reinforcementJobs);
+    archive.sequence(sim.spawnTelemetryWindow);
+    for (auto &total : sim.spawnTelemetryTotals)
+    {
+        archive.field(total);
+    }
+    archive.field(sim.spawnTelemetryTotal);
+
+    archive.pool(sim.enemies, [&](auto &enemy) {
+        archive.field(enemy.pos);
+        archive.field(enemy.hp);
+        archive.field(enemy.radius);
+        archive.field(enemy.type);
+        archive.field(enemy.speedPx);
+        archive.field(enemy.dpsUnit);
+        archive.field(enemy.dpsBase);
+        archive.field(enemy.dpsWall);
+        archive.field(enemy.noOverlap);
+        archive.field(enemy.tauntTarget);
+        archive.field(enemy.tauntSource.index);
+        archive.field(enemy.tauntSource.generation);
+        archive.field(enemy.tauntTimer);
+    });
+    archive.pool(sim.walls, [&](auto &wall) {
+        archive.field(wall.pos);
+        archive.field(wall.hp);
+        archive.field(wall.life);
+        archive.field(wall.radius);
+    });
+    archive.sequence(sim.gates, [&](auto &gate) {
+        archive.field(gate.id);
+        archive.field(gate.pos);
+        archive.field(gate.radius);
+        archive.field(gate.hp);
+        archive.field(gate.maxHp);
+        archive.field(gate.destroyed);
+    });
+
+    std::size_t skillCount = sim.skills.size();
+    archive.field(skillCount);
+    if (skillCount != sim.skills.size())
+    {
+        archive.fail("skills_mismatch");
+        return;
+    }
+    for (auto &skill : sim.skills)
+    {
+        std::string id = skill.def.id;
+        archive.field(id);
+        if (id != skill.def.id)
+        {
+            archive.fail("skills_mismatch");
+        }
+        archive.field(skill.cooldownRemaining);
+        archive.field(skill.activeTimer);
+    }
+
+    archive.field(sim.spawnTimer);
+    archive.field(sim.yunaSpawnTimer);
+    archive.field(sim.simTime);
+    archive.field(sim.timeSinceLastEnemySpawn);
+    archive.field(sim.restartCooldown);
+    archive.field(sim.baseHp);
+    archive.field(sim.spawnEnabled);
+    archive.field(sim.result);
+    transferHud(archive, sim.hud);
+    archive.field(sim.rng);
+    transferDistribution(archive, sim.scatterY);
+    transferDistribution(archive, sim.gateJitter);
+
+    archive.field(sim.missionMode);
+    archive.field(sim.missionTimer);
+    archive.field(sim.missionVictoryCountdown);
+    archive.field(sim.boss.active);
+    archive.field(sim.boss.hp);
+    archive.field(sim.boss.maxHp);
+    archive.field(sim.boss.speedPx);
+    archive.field(sim.boss.radius);
+    archive.field(sim.boss.cycleTimer);
+    archive.field(sim.boss.windupTimer);
+    archive.field(sim.boss.inWindup);
+
+    // Zone definitions come from the mission config; only their progress is runtime state.
+    std::size_t zoneCount = sim.captureZones.size();
+    archive.field(zoneCount);
+    if (zoneCount != sim.captureZones.size())
+    {
+        archive.fail("capture_zones_mismatch");
+        return;
+    }
+    for (auto &zone : sim.captureZones)
+    {
+        std::string id = zone.config.id;
+        archive.field(id);
+        if (id != zone.config.id)
+        {
+            archive.fail("capture_zones_mismatch");
+        }
+        archive.field(zone.worldPos);
+        archive.field(zone.progress);
+        archive.field(zone.captured);
+    }
+    if constexpr (Archive::kLoading)
+    {
+        sim.captureZonesRebuilt = true;
+    }
+    archive.field(sim.capturedZones);
+    archive.field(sim.captureGoal);
+
+    archive.field(sim.renderQueue.lodActive);
+    archive.field(sim.renderQueue.skipActors);
+    archive.field(sim.renderQueue.lodFrameCounter);
+    archive.field(sim.renderQueue.telemetryText);
+    archive.field(sim.renderQueue.telemetryTimer);
+    archive.field(sim.renderQueue.performanceWarningText);
+    archive.field(sim.renderQueue.performanceWarningTimer);
+    archive.field(sim.renderQueue.spawnWarningText);
+    archive.field(sim.renderQueue.spawnWarningTimer);
+    archive.field(sim.spawnBudgetState.totalDeferred);
+
+    archive.field(sim.survival.elapsed);
+    archive.field(sim.survival.duration);
+    archive.field(sim.survival.pacingTimer);
+    archive.field(sim.survival.spawnMultiplier);
+    archive.field(sim.survival.nextElite);
+    archive.stringSet(sim.disabledGates);
+
+    archive.field(sim.stance);
+    archive.field(sim.defaultStance);
+    archive.field(sim.orderActive);
+    archive.field(sim.orderTimer);
+    archive.field(sim.orderDuration);
+    archive.field(sim.formation);
+    archive.field(sim.formationAlignTimer);
+    archive.field(sim.formationDefenseMul);
+    archive.field(sim.selectedSkill);
+    archive.field(sim.rallyState);
+    archive.field(sim.spawnRateMultiplier);
+    archive.field(sim.moraleSpawnMultiplier);
+    archive.field(sim.spawnSlowMultiplier);
+    archive.field(sim.spawnSlowTimer);
+    archive.field(sim.moraleSummary.averageSpeedMul);
+    archive.field(sim.moraleSummary.averageAccuracyMul);
+    archive.field(sim.moraleSummary.averageDefenseMul);
+    archive.field(sim.moraleSummary.panicCount);
+    archive.field(sim.moraleSummary.mesomesoCount);
+    archive.field(sim.moraleSummary.commanderState);
+    archive.field(sim.moraleSummary.rallySuppressed);
+    archive.field(sim.commanderRespawnTimer);
+    archive.field(sim.commanderInvulnTimer);
+    archive.field(sim.waveScriptComplete);
+    archive.field(sim.spawnerIdle);
+    archive.field(sim.basePos);
+    archive.field(sim.yunaSpawnPos);
+    archive.field(sim.frameCounter);
+}
+
+} // namespace
+
+void LegacySimulation::saveState(StateWriter &out) const
+{
+    transferRuntimeState(out, *this);
+    // Last frame's crowding is sampled before RenderingPrepSystem rebuilds it, so it is part of the state.
+    out.field(allyDensity.cellSize());
+    out.sequence(allyDensity.positions());
+}
+
+void LegacySimulation::loadState(StateReader &in)
+{
+    transferRuntimeState(in, *this);
+    float densityCellSize = 0.0f;
+    std::vector<Vec2> densityPositions;
+    in.field(densityCellSize);
+    in.sequence(densityPositions);
+    allyDensity = {};
+    if (!densityPositions.empty() && densityCellSize > 0.0f)
+    {
+        allyDensity.build(worldMin, worldMax, densityCellSize, densityPositions.size(),
+                          [&](std::size_t i) { return densityPositions[i]; });
+    }
+    wallIndex.clear();
+    syncWallIndex();
+    frameCapturePending = 0;
+}
+
 } // namespace world
 
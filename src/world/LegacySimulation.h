@@ -3,9 +3,15 @@
 #include "config/AppConfig.h"
 #include "core/Vec2.h"
 #include "telemetry/TelemetrySink.h"
+#include "world/ComponentPool.h"
+#include "world/DensityField.h"
 #include "world/LegacyTypes.h"
 #include "world/MoraleTypes.h"
+#include "world/ProximityIndex.h"
 #include "world/SkillRuntime.h"
+#include "world/Unit.h"
+#include "world/WallIndex.h"
+#include "world/WorldSnapshot.h"
 
 #include <algorithm>
 #include <array>
@@ -47,96 +53,6 @@ namespace world::spawn
 class WaveController;
 }
 
-struct TemperamentState
-{
-    const TemperamentDefinition *definition = nullptr;
-    TemperamentBehavior currentBehavior = TemperamentBehavior::Wander;
-    TemperamentBehavior lastBehavior = TemperamentBehavior::Wander;
-    bool mimicActive = false;
-    TemperamentBehavior mimicBehavior = TemperamentBehavior::Wander;
-    float mimicCooldown = 0.0f;
-    float mimicDuration = 0.0f;
-    Vec2 wanderDirection{1.0f, 0.0f};
-    float wanderTimer = 0.0f;
-    float sleepTimer = 0.0f;
-    float sleepRemaining = 0.0f;
-    bool sleeping = false;
-    float catchupTimer = 0.0f;
-    float cryTimer = 0.0f;
-    float cryPauseTimer = 0.0f;
-    bool crying = false;
-    float panicTimer = 0.0f;
-    float chargeDashTimer = 0.0f;
-};
-
-struct WarriorJobRuntime
-{
-    float stumbleTimer = 0.0f;
-};
-
-struct ArcherJobRuntime
-{
-    bool focusReady = false;
-    float holdTimer = 0.0f;
-};
-
-struct ShieldJobRuntime
-{
-    float tauntTimer = 0.0f;
-    float selfSlowTimer = 0.0f;
-};
-
-struct JobRuntimeState
-{
-    UnitJob job = UnitJob::Warrior;
-    float cooldown = 0.0f;
-    float endlag = 0.0f;
-    WarriorJobRuntime warrior{};
-    ArcherJobRuntime archer{};
-    ShieldJobRuntime shield{};
-};
-
-struct Unit
-{
-    Vec2 pos;
-    float hp = 0.0f;
-    float radius = 4.0f;
-    bool followBySkill = false;
-    bool followByStance = false;
-    bool effectiveFollower = false;
-    Vec2 formationOffset{0.0f, 0.0f};
-    Vec2 desiredVelocity{0.0f, 0.0f};
-    bool hasDesiredVelocity = false;
-    TemperamentState temperament;
-    MoraleState moraleState = MoraleState::Stable;
-    float moraleTimer = 0.0f;
-    float moraleImmunityTimer = 0.0f;
-    bool moraleComfortShield = false;
-    bool moraleBarrierActive = false;
-    float moraleSpeedMultiplier = 1.0f;
-    float moraleAccuracyMultiplier = 1.0f;
-    float moraleDefenseMultiplier = 1.0f;
-    float moraleAttackIntervalMultiplier = 1.0f;
-    float moraleIgnoreOrdersChance = 0.0f;
-    float moraleDetectionRadiusMultiplier = 1.0f;
-    float moraleSpawnDelayMultiplier = 1.0f;
-    float moraleRetargetCooldownMultiplier = 1.0f;
-    float moraleCommandObeyBonus = 0.0f;
-    bool moraleRetreatActive = false;
-    float moraleRetreatTimer = 0.0f;
-    float moraleRetreatSpeedMultiplier = 1.0f;
-    float moraleRetreatHomewardBias = 1.0f;
-    float moraleRetreatDuration = 0.0f;
-    float moraleRetreatCheckInterval = 0.0f;
-    float moraleRetreatCheckChance = 0.0f;
-    float moraleRetreatCheckTimer = 0.0f;
-    float moraleBarrierLingerTimer = 0.0f;
-    float moraleIgnoreOrdersTimer = 0.0f;
-    bool moraleIgnoringOrders = false;
-    bool moraleLightMesomesoPending = false;
-    JobRuntimeState job{};
-};
-
 struct CommanderUnit
 {
     Vec2 pos;
@@ -159,6 +75,7 @@ struct EnemyUnit
     float dpsWall = 0.0f;
     bool noOverlap = false;
     Vec2 tauntTarget{0.0f, 0.0f};
+    world::EntityId tauntSource{};
     float tauntTimer = 0.0f;
 };
 
@@ -183,6 +100,9 @@ struct GateRuntime
 namespace world
 {
 
+class StateReader;
+class StateWriter;
+
 std::string normalizeTelemetry(const std::string &text);
 
 struct LegacySimulation
@@ -200,6 +120,13 @@ struct LegacySimulation
         UnitJob job = UnitJob::Warrior;
     };
 
+    struct YunaDeath
+    {
+        UnitJob job = UnitJob::Warrior;
+        Vec2 pos{0.0f, 0.0f};
+        float overkillRatio = 0.0f;
+    };
+
     GameConfig config;
     TemperamentConfig temperamentConfig;
     EntityStats yunaStats;
@@ -209,17 +136,22 @@ struct LegacySimulation
     CommanderUnit commander;
     MapDefs mapDefs;
     SpawnScript spawnScript;
-    std::vector<Unit> yunas;
+    ComponentPool<Unit> yunas;
     std::deque<UnitJob> jobHistory;
     std::size_t jobHistoryLimit = 32;
     std::vector<PendingRespawn> yunaRespawns;
+    // Allies tombstoned this tick, in the order they died; reapYunas() reports them and turns them into respawns.
+    std::vector<YunaDeath> yunaDeaths;
     std::deque<UnitJob> reinforcementJobs;
     std::deque<UnitJob> spawnTelemetryWindow;
     std::array<std::uint64_t, UnitJobCount> spawnTelemetryTotals{};
     std::uint64_t spawnTelemetryTotal = 0;
     std::weak_ptr<TelemetrySink> telemetry;
-    std::vector<EnemyUnit> enemies;
-    std::vector<WallSegment> walls;
+    ComponentPool<EnemyUnit> enemies;
+    ComponentPool<WallSegment> walls;
+    // Live walls by centre cell for the Wallbreaker preference. addWall() and eraseWallsIf() keep it in step with
+    // walls; syncWallIndex() re-inserts everything when the layout changes or the pool was edited directly.
+    WallIndex wallIndex;
     std::vector<GateRuntime> gates;
     std::vector<RuntimeSkill> skills;
     Vec2 worldMin{0.0f, 0.0f};
@@ -266,6 +198,11 @@ struct LegacySimulation
         bool captured = false;
     };
     std::vector<CaptureRuntime> captureZones;
+    // What changed since WorldState last mirrored captureZones into missionZones(): the zones whose progress
+    // moved (each listed once, flagged in captureZoneChanged) and whether the list itself was rebuilt.
+    std::vector<std::uint32_t> changedCaptureZones;
+    std::vector<std::uint8_t> captureZoneChanged;
+    bool captureZonesRebuilt = true;
     int capturedZones = 0;
     int captureGoal = 0;
 
@@ -348,12 +285,26 @@ struct LegacySimulation
             moraleIcons.clear();
         }
     } renderQueue;
+    // Ally crowding, rebuilt by RenderingPrepSystem at the end of every frame. Systems earlier in the next frame
+    // may sample it as last frame's density.
+    DensityField allyDensity;
 
     struct SpawnBudgetState
     {
         std::size_t totalDeferred = 0;
     } spawnBudgetState;
 
+    // Enemy pool sizing. reserveEnemyPool() reserves the predicted peak before a run so spawns and deaths reuse
+    // pool slots instead of reallocating mid-fight. A run that outgrows the reservation reports it once, and every
+    // run's peak raises the reservation for the next one.
+    struct EnemyPoolState
+    {
+        std::size_t reserved = 0;
+        std::size_t peak = 0;
+        std::size_t previousPeak = 0;
+        bool overflowReported = false;
+    } enemyPool;
+
     struct SurvivalRuntime
     {
         float elapsed = 0.0f;
@@ -404,8 +355,11 @@ struct LegacySimulation
     std::size_t frameCapturePending = 0;
     std::uint64_t frameCaptureBatch = 0;
     std::size_t frameCaptureIndex = 0;
+    // Shared so LegacySimulation stays copyable; the writer thread is started by the first capture.
+    std::shared_ptr<SnapshotWriter> snapshotWriter;
 
     void captureFrameSnapshot(TelemetrySink &sink);
+    void reportFrameCaptures(TelemetrySink &sink);
     std::filesystem::path telemetryDebugDirectory(const TelemetrySink &sink) const;
 
     struct SpawnHistoryDumpResult
@@ -417,6 +371,11 @@ struct LegacySimulation
 
     SpawnHistoryDumpResult dumpSpawnHistory(const spawn::WaveController &controller) const;
 
+    // Runtime state only. Configuration (config, stats, map, spawn script, mission config, skill definitions) is
+    // left untouched and must match what the state was saved with; temperaments are stored as definition indices.
+    void saveState(StateWriter &out) const;
+    void loadState(StateReader &in);
+
     void setWorldBounds(float width, float height)
     {
         if (width <= 0.0f || height <= 0.0f)
@@ -478,13 +437,16 @@ struct LegacySimulation
         const int desiredHistory = std::max(config.jobSpawn.historyLimit, config.jobSpawn.pity.repeatLimit);
         jobHistoryLimit = desiredHistory > 0 ? static_cast<std::size_t>(desiredHistory) : 1;
         yunaRespawns.clear();
+        yunaDeaths.clear();
         reinforcementJobs.clear();
         spawnTelemetryWindow.clear();
         spawnTelemetryTotals.fill(0);
         spawnTelemetryTotal = 0;
         spawnBudgetState = {};
+        recordEnemyPoolPeak();
         enemies.clear();
         walls.clear();
+        wallIndex.clear();
         spawnEnabled = true;
         result = GameResult::Playing;
         baseHp = static_cast<float>(config.base_hp);
@@ -559,6 +521,50 @@ struct LegacySimulation
         yunaRespawns.push_back(pending);
     }
 
+    // Tombstones ally index as dead. It stays in the pool, skipped by later passes, until reapYunas(). Returns
+    // false when it was already tombstoned.
+    bool markYunaDead(std::size_t index, float overkillRatio)
+    {
+        if (!yunas.markForRemoval(index))
+        {
+            return false;
+        }
+        ConstUnitRef yuna = yunas[index];
+        yunaDeaths.push_back({yuna.job().job, yuna.pos(), overkillRatio});
+        return true;
+    }
+
+    std::size_t liveYunaCount() const
+    {
+        return yunas.size() - yunas.pendingRemovals();
+    }
+
+    // The single compaction point for allies killed or converted during a tick: queues their respawns and emits
+    // one world.yuna.death event each, in the order they died, then sweeps the tombstones out of the pool in one
+    // pass.
+    void reapYunas()
+    {
+        std::shared_ptr<TelemetrySink> sink = telemetry.lock();
+        const std::size_t survivors = liveYunaCount();
+        for (const YunaDeath &death : yunaDeaths)
+        {
+            enqueueYunaRespawn(death.overkillRatio);
+            if (sink)
+            {
+                TelemetrySink::Payload payload;
+                payload.emplace("job", unitJobToString(death.job));
+                payload.emplace("x", std::to_string(death.pos.x));
+                payload.emplace("y", std::to_string(death.pos.y));
+                payload.emplace("overkill_ratio", std::to_string(death.overkillRatio));
+                payload.emplace("respawn_s", std::to_string(yunaRespawns.back().timer));
+                payload.emplace("alive", std::to_string(survivors));
+                sink->recordEvent("world.yuna.death", payload);
+            }
+        }
+        yunaDeaths.clear();
+        yunas.sweep();
+    }
+
     void updateSkillTimers(float dt)
     {
         for (RuntimeSkill &skill : skills)
@@ -621,10 +627,7 @@ struct LegacySimulation
                 wall.life = std::max(0.0f, wall.life - dt);
             }
         }
-        walls.erase(std::remove_if(walls.begin(), walls.end(), [](const WallSegment &wall) {
-                        return wall.life <= 0.0f || wall.hp <= 0.0f;
-                    }),
-                    walls.end());
+        eraseWallsIf([](const WallSegment &wall) { return wall.life <= 0.0f || wall.hp <= 0.0f; });
     }
 
     Vec2 randomUnitVector()
@@ -674,16 +677,16 @@ struct LegacySimulation
         return &temperamentConfig.definitions[index];
     }
 
-    void assignTemperament(Unit &yuna)
+    void assignTemperament(UnitRef yuna)
     {
-        yuna.temperament = {};
+        yuna.temperament() = {};
         const TemperamentDefinition *def = selectTemperamentDefinition();
-        yuna.temperament.definition = def;
+        yuna.temperament().definition = def;
         if (!def)
         {
             return;
         }
-        TemperamentState &state = yuna.temperament;
+        TemperamentState &state = yuna.temperament();
         if (def->behavior == TemperamentBehavior::Mimic)
         {
             state.currentBehavior = def->mimicDefault;
@@ -710,46 +713,46 @@ struct LegacySimulation
         state.chargeDashTimer = state.currentBehavior == TemperamentBehavior::ChargeNearest ? temperamentConfig.chargeDash.duration : 0.0f;
     }
 
-    void resetUnitMorale(Unit &unit)
-    {
-        unit.moraleState = MoraleState::Stable;
-        unit.moraleTimer = 0.0f;
-        unit.moraleImmunityTimer = 0.0f;
-        unit.moraleComfortShield = false;
-        unit.moraleBarrierActive = false;
-        unit.moraleBarrierLingerTimer = 0.0f;
-        unit.moraleSpeedMultiplier = std::max(config.morale.stable.speed, 0.01f);
-        unit.moraleAccuracyMultiplier = std::max(config.morale.stable.accuracy, 0.01f);
-        unit.moraleDefenseMultiplier = std::max(config.morale.stable.defense, 0.01f);
-        unit.moraleAttackIntervalMultiplier = std::max(config.morale.stable.attackInterval, 0.01f);
-        unit.moraleIgnoreOrdersChance = std::clamp(config.morale.stableBehavior.ignoreOrdersChance, 0.0f, 1.0f);
-        unit.moraleDetectionRadiusMultiplier =
+    void resetUnitMorale(UnitRef unit)
+    {
+        unit.moraleState() = MoraleState::Stable;
+        unit.moraleTimer() = 0.0f;
+        unit.moraleImmunityTimer() = 0.0f;
+        unit.moraleComfortShield() = false;
+        unit.moraleBarrierActive() = false;
+        unit.moraleBarrierLingerTimer() = 0.0f;
+        unit.moraleSpeedMultiplier() = std::max(config.morale.stable.speed, 0.01f);
+        unit.moraleAccuracyMultiplier() = std::max(config.morale.stable.accuracy, 0.01f);
+        unit.moraleDefenseMultiplier() = std::max(config.morale.stable.defense, 0.01f);
+        unit.moraleAttackIntervalMultiplier() = std::max(config.morale.stable.attackInterval, 0.01f);
+        unit.moraleIgnoreOrdersChance() = std::clamp(config.morale.stableBehavior.ignoreOrdersChance, 0.0f, 1.0f);
+        unit.moraleDetectionRadiusMultiplier() =
             std::max(config.morale.stableBehavior.detectionRadiusMultiplier, 0.0f);
-        unit.moraleSpawnDelayMultiplier =
+        unit.moraleSpawnDelayMultiplier() =
             std::max(config.morale.stableBehavior.spawnDelayMultiplier, 1.0f);
-        unit.moraleRetargetCooldownMultiplier =
+        unit.moraleRetargetCooldownMultiplier() =
             std::max(config.morale.stableBehavior.retargetCooldownMultiplier, 0.01f);
-        unit.moraleCommandObeyBonus =
+        unit.moraleCommandObeyBonus() =
             std::clamp(config.morale.stableBehavior.commandObeyBonus, 0.0f, 1.0f);
-        unit.moraleRetreatActive = false;
-        unit.moraleRetreatTimer = 0.0f;
-        unit.moraleRetreatSpeedMultiplier = std::max(config.morale.stableBehavior.retreat.speedMultiplier, 0.0f);
-        unit.moraleRetreatHomewardBias = std::clamp(config.morale.stableBehavior.retreat.homewardBias, 0.0f, 1.0f);
-        unit.moraleRetreatDuration = config.morale.stableBehavior.retreat.enabled
+        unit.moraleRetreatActive() = false;
+        unit.moraleRetreatTimer() = 0.0f;
+        unit.moraleRetreatSpeedMultiplier() = std::max(config.morale.stableBehavior.retreat.speedMultiplier, 0.0f);
+        unit.moraleRetreatHomewardBias() = std::clamp(config.morale.stableBehavior.retreat.homewardBias, 0.0f, 1.0f);
+        unit.moraleRetreatDuration() = config.morale.stableBehavior.retreat.enabled
                                           ? std::max(config.morale.stableBehavior.retreat.duration, 0.0f)
                                           : 0.0f;
-        unit.moraleRetreatCheckInterval = 0.0f;
-        unit.moraleRetreatCheckChance = 0.0f;
-        unit.moraleRetreatCheckTimer = 0.0f;
-        unit.moraleIgnoreOrdersTimer = 0.0f;
-        unit.moraleIgnoringOrders = false;
-        unit.moraleLightMesomesoPending = false;
+        unit.moraleRetreatCheckInterval() = 0.0f;
+        unit.moraleRetreatCheckChance() = 0.0f;
+        unit.moraleRetreatCheckTimer() = 0.0f;
+        unit.moraleIgnoreOrdersTimer() = 0.0f;
+        unit.moraleIgnoringOrders() = false;
+        unit.moraleLightMesomesoPending() = false;
     }
 
-    void initializeJobState(Unit &unit, UnitJob job)
+    void initializeJobState(UnitRef unit, UnitJob job)
     {
-        unit.job = {};
-        unit.job.job = job;
+        unit.job() = {};
+        unit.job().job = job;
         float baseCooldown = 0.0f;
         switch (job)
         {
@@ -766,13 +769,13 @@ struct LegacySimulation
         if (baseCooldown > 0.0f)
         {
             std::uniform_real_distribution<float> roll(0.0f, baseCooldown);
-            unit.job.cooldown = roll(rng);
+            unit.job().cooldown = roll(rng);
         }
         else
         {
-            unit.job.cooldown = 0.0f;
+            unit.job().cooldown = 0.0f;
         }
-        unit.job.endlag = 0.0f;
+        unit.job().endlag = 0.0f;
     }
 
     void recordSpawnSelection(UnitJob job)
@@ -965,18 +968,18 @@ struct LegacySimulation
 
     void spawnYunaUnit(UnitJob job, SpawnOrigin origin)
     {
-        Unit yuna;
-        yuna.pos = yunaSpawnPos;
-        yuna.pos.y += scatterY(rng);
-        yuna.hp = yunaStats.hp;
-        yuna.radius = yunaStats.radius;
+        Unit spawned;
+        spawned.pos = yunaSpawnPos;
+        spawned.pos.y += scatterY(rng);
+        spawned.hp = yunaStats.hp;
+        spawned.radius = yunaStats.radius;
+        UnitRef yuna = yunas.emplace_back(spawned);
         resetUnitMorale(yuna);
-        yuna.moraleLightMesomesoPending = !commander.alive &&
+        yuna.moraleLightMesomesoPending() = !commander.alive &&
                                          config.morale.spawnWhileLeaderDown.applyLightMesomeso;
         initializeJobState(yuna, job);
-        yunas.push_back(yuna);
-        assignTemperament(yunas.back());
-        clampToWorld(yunas.back().pos, yunas.back().radius);
+        assignTemperament(yuna);
+        clampToWorld(yuna.pos(), yuna.radius());
         recordSpawnTelemetry(job, origin);
     }
 
@@ -1079,6 +1082,7 @@ struct LegacySimulation
         missionVictoryCountdown = -1.0f;
         boss = {};
         captureZones.clear();
+        captureZonesRebuilt = true;
         capturedZones = 0;
         captureGoal = 0;
         survival = {};
@@ -1141,6 +1145,7 @@ struct LegacySimulation
         bossUnit.dpsWall = slimeStats.dps;
         bossUnit.noOverlap = missionConfig.boss.noOverlap;
         enemies.push_back(bossUnit);
+        noteEnemySpawned();
         boss.active = true;
         boss.hp = bossUnit.hp;
         boss.maxHp = bossUnit.hp;
@@ -1181,35 +1186,27 @@ struct LegacySimulation
             hitSomething = true;
         }
 
-        if (!yunas.empty())
+        for (std::size_t i = 0; i < yunas.size(); ++i)
         {
-            std::vector<Unit> survivors;
-            survivors.reserve(yunas.size());
-            for (Unit &yuna : yunas)
+            UnitRef yuna = yunas[i];
+            if (yunas.markedForRemoval(i) || lengthSq(yuna.pos() - bossEnemy.pos) > radiusSq)
             {
-                if (lengthSq(yuna.pos - bossEnemy.pos) <= radiusSq)
-                {
-                    Vec2 push = normalize(yuna.pos - bossEnemy.pos) * 40.0f;
-                    if (lengthSq(push) > 0.0f)
-                    {
-                        yuna.pos += push;
-                        clampToWorld(yuna.pos, yuna.radius);
-                    }
-                    const float hpBefore = yuna.hp;
-                    yuna.hp -= boss.mechanic.damage;
-                    if (yuna.hp <= 0.0f)
-                    {
-                        const float overkill = std::max(0.0f, boss.mechanic.damage - std::max(hpBefore, 0.0f));
-                        const float ratio = clampOverkillRatio(overkill, yunaStats.hp);
-                        enqueueYunaRespawn(ratio);
-                        hitSomething = true;
-                        continue;
-                    }
-                    hitSomething = true;
-                }
-                survivors.push_back(yuna);
+                continue;
+            }
+            Vec2 push = normalize(yuna.pos() - bossEnemy.pos) * 40.0f;
+            if (lengthSq(push) > 0.0f)
+            {
+                yuna.pos() += push;
+                clampToWorld(yuna.pos(), yuna.radius());
+            }
+            const float hpBefore = yuna.hp();
+            yuna.hp() -= boss.mechanic.damage;
+            hitSomething = true;
+            if (yuna.hp() <= 0.0f)
+            {
+                const float overkill = std::max(0.0f, boss.mechanic.damage - std::max(hpBefore, 0.0f));
+                markYunaDead(i, clampOverkillRatio(overkill, yunaStats.hp));
             }
-            yunas.swap(survivors);
         }
 
         if (hitSomething)
@@ -1301,19 +1298,34 @@ struct LegacySimulation
         }
     }
 
+    void noteCaptureZoneChanged(std::size_t index)
+    {
+        if (captureZoneChanged.size() < captureZones.size())
+        {
+            captureZoneChanged.resize(captureZones.size(), 0);
+        }
+        if (!captureZoneChanged[index])
+        {
+            captureZoneChanged[index] = 1;
+            changedCaptureZones.push_back(static_cast<std::uint32_t>(index));
+        }
+    }
+
     void updateCaptureMission(float dt)
     {
-        for (CaptureRuntime &zone : captureZones)
+        for (std::size_t zoneIndex = 0; zoneIndex < captureZones.size(); ++zoneIndex)
         {
+            CaptureRuntime &zone = captureZones[zoneIndex];
             if (zone.captured)
             {
                 continue;
             }
+            const float progressBefore = zone.progress;
             const float radiusSq = zone.config.radius_px * zone.config.radius_px;
             int allies = 0;
-            for (const Unit &yuna : yunas)
+            for (std::size_t i = 0; i < yunas.size(); ++i)
             {
-                if (lengthSq(yuna.pos - zone.worldPos) <= radiusSq)
+                if (!yunas.markedForRemoval(i) && lengthSq(yunas[i].pos() - zone.worldPos) <= radiusSq)
                 {
                     ++allies;
                 }
@@ -1359,6 +1371,10 @@ struct LegacySimulation
                     pushTelemetry(zone.config.onCapture.telemetry);
                 }
             }
+            if (zone.captured || zone.progress != progressBefore)
+            {
+                noteCaptureZoneChanged(zoneIndex);
+            }
         }
         if (captureGoal > 0 && capturedZones >= captureGoal && missionVictoryCountdown < 0.0f)
         {
@@ -1440,11 +1456,11 @@ struct LegacySimulation
             }
         }
         rallyState = false;
-        for (Unit &yuna : yunas)
+        for (UnitRef yuna : yunas)
         {
-            yuna.followBySkill = false;
-            yuna.followByStance = false;
-            yuna.effectiveFollower = false;
+            yuna.followBySkill() = false;
+            yuna.followByStance() = false;
+            yuna.effectiveFollower() = false;
         }
         hud.resultText = "Commander Down";
         hud.resultTimer = config.telemetry_duration;
@@ -1470,14 +1486,19 @@ struct LegacySimulation
             segmentPositions.push_back(start + direction * (spacing * static_cast<float>(i)));
         }
 
-        if (yunas.empty())
+        if (liveYunaCount() == 0)
         {
             pushTelemetry("Need chibi allies for wall");
             return;
         }
 
-        const int maxSegments = std::min(static_cast<int>(segmentPositions.size()), static_cast<int>(yunas.size()));
+        const int maxSegments =
+            std::min(static_cast<int>(segmentPositions.size()), static_cast<int>(liveYunaCount()));
         std::vector<char> taken(yunas.size(), 0);
+        for (std::size_t idx = 0; idx < yunas.size(); ++idx)
+        {
+            taken[idx] = yunas.markedForRemoval(idx) ? 1 : 0;
+        }
         std::vector<std::size_t> convertIndices;
         std::vector<Vec2> chosenPositions;
         convertIndices.reserve(maxSegments);
@@ -1493,7 +1514,7 @@ struct LegacySimulation
                 {
                     continue;
                 }
-                const float dist = lengthSq(yunas[idx].pos - segmentPositions[static_cast<std::size_t>(i)]);
+                const float dist = lengthSq(yunas[idx].pos() - segmentPositions[static_cast<std::size_t>(i)]);
                 if (dist < bestDist)
                 {
                     bestDist = dist;
@@ -1515,11 +1536,9 @@ struct LegacySimulation
             return;
         }
 
-        std::sort(convertIndices.begin(), convertIndices.end(), std::greater<>());
-        for (std::size_t idx : convertIndices)
+        for (std::size_t index : convertIndices)
         {
-            enqueueYunaRespawn(0.0f);
-            yunas.erase(yunas.begin() + static_cast<std::ptrdiff_t>(idx));
+            markYunaDead(index, 0.0f);
         }
 
         for (const Vec2 &segmentPos : chosenPositions)
@@ -1529,7 +1548,7 @@ struct LegacySimulation
             segment.hp = def.hpPerSegment;
             segment.life = def.duration;
             segment.radius = spacing * 0.5f;
-            walls.push_back(segment);
+            addWall(segment);
         }
         pushTelemetry("Wall deployed");
     }
@@ -1571,20 +1590,20 @@ struct LegacySimulation
         if (enabled)
         {
             const float radiusSq = def.radius * def.radius;
-            for (Unit &yuna : yunas)
+            for (UnitRef yuna : yunas)
             {
-                if (lengthSq(yuna.pos - worldTarget) <= radiusSq)
+                if (lengthSq(yuna.pos() - worldTarget) <= radiusSq)
                 {
-                    yuna.followBySkill = true;
+                    yuna.followBySkill() = true;
                 }
             }
             pushTelemetry("Rally!");
         }
         else
         {
-            for (Unit &yuna : yunas)
+            for (UnitRef yuna : yunas)
             {
-                yuna.followBySkill = false;
+                yuna.followBySkill() = false;
             }
             pushTelemetry("Rally dismissed");
         }
@@ -1608,20 +1627,20 @@ struct LegacySimulation
             if (rallyState)
             {
                 const float radiusSq = skill.def.radius * skill.def.radius;
-                for (Unit &yuna : yunas)
+                for (UnitRef yuna : yunas)
                 {
-                    if (lengthSq(yuna.pos - worldTarget) <= radiusSq)
+                    if (lengthSq(yuna.pos() - worldTarget) <= radiusSq)
                     {
-                        yuna.followBySkill = true;
+                        yuna.followBySkill() = true;
                     }
                 }
                 pushTelemetry("Rally!");
             }
             else
             {
-                for (Unit &yuna : yunas)
+                for (UnitRef yuna : yunas)
                 {
-                    yuna.followBySkill = false;
+                    yuna.followBySkill() = false;
                 }
                 pushTelemetry("Rally dismissed");
             }
@@ -1675,6 +1694,35 @@ struct LegacySimulation
 
     void handleSpawnDeferral(int deferredCount);
 
+    // scriptedPeak is the spawn script's estimate (spawn::estimatePeakEnemies); mission enemies are added here.
+    void reserveEnemyPool(std::size_t scriptedPeak);
+    void noteEnemySpawned();
+    void recordEnemyPoolPeak();
+
+    void addWall(const WallSegment &segment)
+    {
+        const EntityId id = walls.create(segment).first;
+        wallIndex.insert(id, segment.pos);
+    }
+
+    template <typename Pred>
+    std::size_t eraseWallsIf(Pred &&pred)
+    {
+        return walls.eraseIf([&](EntityId id, WallSegment &wall) {
+            if (!pred(wall))
+            {
+                return false;
+            }
+            wallIndex.erase(id);
+            return true;
+        });
+    }
+
+    // Sizes the wall index for the current world and Wallbreaker radius. O(1) unless that changed or walls were
+    // added or removed without going through addWall()/eraseWallsIf().
+    void syncWallIndex();
+    void rebuildWallIndex();
+
     void setResult(GameResult r, const std::string &text)
     {
         if (result != GameResult::Playing)
@@ -1688,16 +1736,39 @@ struct LegacySimulation
         restartCooldown = config.restart_delay;
     }
 
-    void update(float dt)
+    // Starts a five-frame snapshot batch when the sink asks for one, queues the next pending snapshot and reports
+    // the ones the writer thread has finished.
+    void serviceFrameCapture()
     {
         auto sink = telemetry.lock();
+        if (sink)
+        {
+            reportFrameCaptures(*sink);
+        }
         if (sink && sink->consumeFrameCaptureRequest())
         {
             frameCapturePending = 5;
             ++frameCaptureBatch;
             frameCaptureIndex = 0;
         }
+        if (frameCapturePending == 0)
+        {
+            return;
+        }
+        if (!sink)
+        {
+            frameCapturePending = 0;
+            return;
+        }
+        captureFrameSnapshot(*sink);
+        if (frameCapturePending > 0)
+        {
+            --frameCapturePending;
+        }
+    }
 
+    void update(float dt)
+    {
         ++frameCounter;
         simTime += dt;
         if (timeSinceLastEnemySpawn < 10000.0f)
@@ -1714,26 +1785,8 @@ struct LegacySimulation
         updateCommanderRespawn(dt);
         updateWalls(dt);
         updateMission(dt);
-
-        if (frameCapturePending > 0)
-        {
-            if (!sink)
-            {
-                sink = telemetry.lock();
-            }
-            if (sink)
-            {
-                captureFrameSnapshot(*sink);
-                if (frameCapturePending > 0)
-                {
-                    --frameCapturePending;
-                }
-            }
-            else
-            {
-                frameCapturePending = 0;
-            }
-        }
+        reapYunas();
+        serviceFrameCapture();
     }
 
     void spawnOneEnemy(Vec2 gatePos, EnemyArchetype type)
@@ -1772,6 +1825,7 @@ struct LegacySimulation
             enemy.dpsWall = slimeStats.dps;
         }
         enemies.push_back(enemy);
+        noteEnemySpawned();
         timeSinceLastEnemySpawn = 0.0f;
     }
 
@@ -1788,7 +1842,7 @@ struct LegacySimulation
         const float spawnInterval = std::max(minInterval, (config.yuna_interval / rateMultiplier) * slowMultiplier);
         while (yunaSpawnTimer <= 0.0f)
         {
-            if (static_cast<int>(yunas.size()) < config.yuna_max)
+            if (static_cast<int>(liveYunaCount()) < config.yuna_max)
             {
                 spawnYunaUnit(chooseSpawnJob(), SpawnOrigin::Natural);
                 yunaSpawnTimer += spawnInterval;
@@ -1809,7 +1863,7 @@ struct LegacySimulation
         remainingRespawns.reserve(yunaRespawns.size());
         for (PendingRespawn &pending : yunaRespawns)
         {
-            if (pending.timer <= 0.0f && static_cast<int>(yunas.size()) < config.yuna_max)
+            if (pending.timer <= 0.0f && static_cast<int>(liveYunaCount()) < config.yuna_max)
             {
                 spawnYunaUnit(pending.job, SpawnOrigin::Respawn);
             }
@@ -1824,7 +1878,7 @@ struct LegacySimulation
         }
         yunaRespawns.swap(remainingRespawns);
 
-        while (!reinforcementJobs.empty() && static_cast<int>(yunas.size()) < config.yuna_max)
+        while (!reinforcementJobs.empty() && static_cast<int>(liveYunaCount()) < config.yuna_max)
         {
             UnitJob job = reinforcementJobs.front();
             reinforcementJobs.pop_front();
@@ -1889,60 +1943,33 @@ struct LegacySimulation
         return targets;
     }
 
-    EnemyUnit *findTargetByTags(const Vec2 &from, const std::vector<std::string> &tags)
+    EnemyUnit *findTargetByTags(const Vec2 &from, const std::vector<std::string> &tags,
+                                const ProximityIndex &enemyIndex)
     {
         for (const std::string &tag : tags)
         {
-            EnemyUnit *best = nullptr;
-            float bestDist = std::numeric_limits<float>::max();
+            std::uint32_t best = ProximityIndex::None;
             if (tag == "boss")
             {
-                for (EnemyUnit &enemy : enemies)
-                {
-                    if (enemy.hp > 0.0f && enemy.type == EnemyArchetype::Boss)
-                    {
-                        const float distSq = lengthSq(enemy.pos - from);
-                        if (distSq < bestDist)
-                        {
-                            bestDist = distSq;
-                            best = &enemy;
-                        }
-                    }
-                }
+                best = enemyIndex.nearest(from, [&](std::uint32_t index) {
+                    return enemies[index].hp > 0.0f && enemies[index].type == EnemyArchetype::Boss;
+                });
             }
             else if (tag == "elite")
             {
-                for (EnemyUnit &enemy : enemies)
-                {
-                    if (enemy.hp > 0.0f && enemy.type == EnemyArchetype::Wallbreaker)
-                    {
-                        const float distSq = lengthSq(enemy.pos - from);
-                        if (distSq < bestDist)
-                        {
-                            bestDist = distSq;
-                            best = &enemy;
-                        }
-                    }
-                }
+                best = enemyIndex.nearest(from, [&](std::uint32_t index) {
+                    return enemies[index].hp > 0.0f && enemies[index].type == EnemyArchetype::Wallbreaker;
+                });
             }
             else if (tag == "enemy" || tag == "any")
             {
-                for (EnemyUnit &enemy : enemies)
-                {
-                    if (enemy.hp > 0.0f && enemy.type != EnemyArchetype::Boss)
-                    {
-                        const float distSq = lengthSq(enemy.pos - from);
-                        if (distSq < bestDist)
-                        {
-                            bestDist = distSq;
-                            best = &enemy;
-                        }
-                    }
-                }
+                best = enemyIndex.nearest(from, [&](std::uint32_t index) {
+                    return enemies[index].hp > 0.0f && enemies[index].type != EnemyArchetype::Boss;
+                });
             }
-            if (best)
+            if (best != ProximityIndex::None)
             {
-                return best;
+                return &enemies[best];
             }
         }
         return nullptr;
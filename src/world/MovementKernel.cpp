@@ -0,0 +1,262 @@
+#include "world/MovementKernel.h"
+
+#include "world/Unit.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(KUSOZAKO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+namespace world::movement
+{
+namespace
+{
+
+static_assert(sizeof(Vec2) == 2 * sizeof(float), "kernels treat Vec2 arrays as packed x/y floats");
+static_assert(sizeof(BoolColumnSlot) == 1, "kernels read movement flags as bytes");
+
+float *floats(Vec2 *values)
+{
+    return reinterpret_cast<float *>(values);
+}
+
+const float *floats(const Vec2 *values)
+{
+    return reinterpret_cast<const float *>(values);
+}
+
+unsigned char *bytes(BoolColumnSlot *flags)
+{
+    return reinterpret_cast<unsigned char *>(flags);
+}
+
+// std::clamp's comparison order, so the vector paths can match it lane for lane (including signed zeros).
+float clampAxis(float value, float lo, float hi)
+{
+    if (!(lo <= hi))
+    {
+        return value;
+    }
+    return value < lo ? lo : (hi < value ? hi : value);
+}
+
+bool integrateAndClampScalar(Vec2 *positions, Vec2 *velocities, BoolColumnSlot *moving, const float *radii,
+                             std::size_t begin, std::size_t count, float dt, const Vec2 &worldMin,
+                             const Vec2 &worldMax)
+{
+    bool moved = false;
+    for (std::size_t i = begin; i < count; ++i)
+    {
+        if (moving[i])
+        {
+            Vec2 &pos = positions[i];
+            pos.x = pos.x + velocities[i].x * dt;
+            pos.y = pos.y + velocities[i].y * dt;
+            pos.x = clampAxis(pos.x, worldMin.x + radii[i], worldMax.x - radii[i]);
+            pos.y = clampAxis(pos.y, worldMin.y + radii[i], worldMax.y - radii[i]);
+            moved = true;
+        }
+        velocities[i] = {0.0f, 0.0f};
+        moving[i] = false;
+    }
+    return moved;
+}
+
+void integrateScalar(float *positions, const float *velocities, std::size_t begin, std::size_t count, float dt)
+{
+    for (std::size_t i = begin; i < count; ++i)
+    {
+        positions[i] = positions[i] + velocities[i] * dt;
+    }
+}
+
+#if defined(KUSOZAKO_SIMD_X86)
+
+__m128 selectSse2(__m128 mask, __m128 whenSet, __m128 whenClear)
+{
+    return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, whenClear));
+}
+
+// Two units per register: lanes are x0 y0 x1 y1, and r/moving hold each unit's value twice.
+__m128 stepSse2(__m128 pos, __m128 vel, __m128 dt, __m128 radius, __m128 moving, __m128 worldMin, __m128 worldMax)
+{
+    const __m128 moved = _mm_add_ps(pos, _mm_mul_ps(vel, dt));
+    const __m128 lo = _mm_add_ps(worldMin, radius);
+    const __m128 hi = _mm_sub_ps(worldMax, radius);
+    const __m128 clamped =
+        selectSse2(_mm_cmplt_ps(moved, lo), lo, selectSse2(_mm_cmplt_ps(hi, moved), hi, moved));
+    const __m128 result = selectSse2(_mm_cmple_ps(lo, hi), clamped, moved);
+    return selectSse2(moving, result, pos);
+}
+
+std::size_t integrateAndClampSse2(Vec2 *positions, Vec2 *velocities, BoolColumnSlot *moving, const float *radii,
+                                  std::size_t count, float dt, const Vec2 &worldMin, const Vec2 &worldMax,
+                                  bool &anyMoved)
+{
+    const __m128 dtv = _mm_set1_ps(dt);
+    const __m128 minv = _mm_setr_ps(worldMin.x, worldMin.y, worldMin.x, worldMin.y);
+    const __m128 maxv = _mm_setr_ps(worldMax.x, worldMax.y, worldMax.x, worldMax.y);
+    const __m128i zero = _mm_setzero_si128();
+    float *pos = floats(positions);
+    float *vel = floats(velocities);
+    unsigned char *flags = bytes(moving);
+    std::uint32_t any = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        std::uint32_t packed = 0;
+        std::memcpy(&packed, flags + i, sizeof(packed));
+        any |= packed;
+        __m128i lanes = _mm_cvtsi32_si128(static_cast<int>(packed));
+        lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(lanes, zero), zero);
+        const __m128i mask = _mm_cmpgt_epi32(lanes, zero);
+        const __m128 radius = _mm_loadu_ps(radii + i);
+
+        float *p = pos + 2 * i;
+        float *v = vel + 2 * i;
+        _mm_storeu_ps(p, stepSse2(_mm_loadu_ps(p), _mm_loadu_ps(v), dtv, _mm_unpacklo_ps(radius, radius),
+                                  _mm_castsi128_ps(_mm_unpacklo_epi32(mask, mask)), minv, maxv));
+        _mm_storeu_ps(p + 4, stepSse2(_mm_loadu_ps(p + 4), _mm_loadu_ps(v + 4), dtv, _mm_unpackhi_ps(radius, radius),
+                                      _mm_castsi128_ps(_mm_unpackhi_epi32(mask, mask)), minv, maxv));
+        _mm_storeu_ps(v, _mm_setzero_ps());
+        _mm_storeu_ps(v + 4, _mm_setzero_ps());
+        std::memset(flags + i, 0, 4);
+    }
+    anyMoved = any != 0;
+    return i;
+}
+
+std::size_t integrateSse2(float *positions, const float *velocities, std::size_t count, float dt)
+{
+    const __m128 dtv = _mm_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 moved = _mm_add_ps(_mm_loadu_ps(positions + i), _mm_mul_ps(_mm_loadu_ps(velocities + i), dtv));
+        _mm_storeu_ps(positions + i, moved);
+    }
+    return i;
+}
+
+KUSOZAKO_TARGET_AVX2 __m256 stepAvx2(__m256 pos, __m256 vel, __m256 dt, __m256 radius, __m256 moving,
+                                     __m256 worldMin, __m256 worldMax)
+{
+    const __m256 moved = _mm256_add_ps(pos, _mm256_mul_ps(vel, dt));
+    const __m256 lo = _mm256_add_ps(worldMin, radius);
+    const __m256 hi = _mm256_sub_ps(worldMax, radius);
+    __m256 clamped = _mm256_blendv_ps(moved, hi, _mm256_cmp_ps(hi, moved, _CMP_LT_OQ));
+    clamped = _mm256_blendv_ps(clamped, lo, _mm256_cmp_ps(moved, lo, _CMP_LT_OQ));
+    const __m256 result = _mm256_blendv_ps(moved, clamped, _mm256_cmp_ps(lo, hi, _CMP_LE_OQ));
+    return _mm256_blendv_ps(pos, result, moving);
+}
+
+// Eight units per iteration; lane duplication of flags and radii goes through a cross-lane permute.
+KUSOZAKO_TARGET_AVX2 std::size_t integrateAndClampAvx2(Vec2 *positions, Vec2 *velocities, BoolColumnSlot *moving,
+                                                       const float *radii, std::size_t count, float dt,
+                                                       const Vec2 &worldMin, const Vec2 &worldMax, bool &anyMoved)
+{
+    const __m256 dtv = _mm256_set1_ps(dt);
+    const __m256 minv = _mm256_setr_ps(worldMin.x, worldMin.y, worldMin.x, worldMin.y, worldMin.x, worldMin.y,
+                                       worldMin.x, worldMin.y);
+    const __m256 maxv = _mm256_setr_ps(worldMax.x, worldMax.y, worldMax.x, worldMax.y, worldMax.x, worldMax.y,
+                                       worldMax.x, worldMax.y);
+    const __m256i firstHalf = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i secondHalf = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    const __m256i zero = _mm256_setzero_si256();
+    float *pos = floats(positions);
+    float *vel = floats(velocities);
+    unsigned char *flags = bytes(moving);
+    std::uint64_t any = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        std::uint64_t packed = 0;
+        std::memcpy(&packed, flags + i, sizeof(packed));
+        any |= packed;
+        const __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(flags + i)));
+        const __m256i mask = _mm256_cmpgt_epi32(lanes, zero);
+        const __m256 radius = _mm256_loadu_ps(radii + i);
+
+        float *p = pos + 2 * i;
+        float *v = vel + 2 * i;
+        _mm256_storeu_ps(p, stepAvx2(_mm256_loadu_ps(p), _mm256_loadu_ps(v), dtv,
+                                     _mm256_permutevar8x32_ps(radius, firstHalf),
+                                     _mm256_castsi256_ps(_mm256_permutevar8x32_epi32(mask, firstHalf)), minv, maxv));
+        _mm256_storeu_ps(p + 8, stepAvx2(_mm256_loadu_ps(p + 8), _mm256_loadu_ps(v + 8), dtv,
+                                         _mm256_permutevar8x32_ps(radius, secondHalf),
+                                         _mm256_castsi256_ps(_mm256_permutevar8x32_epi32(mask, secondHalf)), minv,
+                                         maxv));
+        _mm256_storeu_ps(v, _mm256_setzero_ps());
+        _mm256_storeu_ps(v + 8, _mm256_setzero_ps());
+        std::memset(flags + i, 0, 8);
+    }
+    anyMoved = any != 0;
+    return i;
+}
+
+KUSOZAKO_TARGET_AVX2 std::size_t integrateAvx2(float *positions, const float *velocities, std::size_t count,
+                                               float dt)
+{
+    const __m256 dtv = _mm256_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 moved =
+            _mm256_add_ps(_mm256_loadu_ps(positions + i), _mm256_mul_ps(_mm256_loadu_ps(velocities + i), dtv));
+        _mm256_storeu_ps(positions + i, moved);
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
+bool integrateAndClamp(Vec2 *positions, Vec2 *velocities, BoolColumnSlot *moving, const float *radii,
+                       std::size_t count, float dt, const Vec2 &worldMin, const Vec2 &worldMax)
+{
+    std::size_t done = 0;
+    bool moved = false;
+#if defined(KUSOZAKO_SIMD_X86)
+    switch (simd::activeLevel())
+    {
+    case simd::Level::Avx2:
+        done = integrateAndClampAvx2(positions, velocities, moving, radii, count, dt, worldMin, worldMax, moved);
+        break;
+    case simd::Level::Sse2:
+        done = integrateAndClampSse2(positions, velocities, moving, radii, count, dt, worldMin, worldMax, moved);
+        break;
+    case simd::Level::Scalar:
+        break;
+    }
+#endif
+    const bool tailMoved =
+        integrateAndClampScalar(positions, velocities, moving, radii, done, count, dt, worldMin, worldMax);
+    return moved || tailMoved;
+}
+
+void integrate(Vec2 *positions, const Vec2 *velocities, std::size_t count, float dt)
+{
+    float *pos = floats(positions);
+    const float *vel = floats(velocities);
+    const std::size_t total = 2 * count;
+    std::size_t done = 0;
+#if defined(KUSOZAKO_SIMD_X86)
+    switch (simd::activeLevel())
+    {
+    case simd::Level::Avx2:
+        done = integrateAvx2(pos, vel, total, dt);
+        break;
+    case simd::Level::Sse2:
+        done = integrateSse2(pos, vel, total, dt);
+        break;
+    case simd::Level::Scalar:
+        break;
+    }
+#endif
+    integrateScalar(pos, vel, done, total, dt);
+}
+
+} // namespace world::movement
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "world/Simd.h"
+
+#include <cstddef>
+
+namespace world
+{
+
+struct BoolColumnSlot;
+
+// Batch position integration shared by MovementSystem and the enemy advance in CombatSystem, with scalar, SSE2 and
+// AVX2 paths chosen through world::simd.
+namespace movement
+{
+
+// For every entry with moving[i] set: positions[i] += velocities[i] * dt, then clamp it inside [worldMin, worldMax]
+// shrunk by radii[i] on each axis where that range is not empty (LegacySimulation::clampToWorld). Entries without
+// the flag keep their position. Every velocity is zeroed and every flag cleared afterwards. Returns true when any
+// entry moved.
+bool integrateAndClamp(Vec2 *positions, Vec2 *velocities, BoolColumnSlot *moving, const float *radii,
+                       std::size_t count, float dt, const Vec2 &worldMin, const Vec2 &worldMax);
+
+// positions[i] += velocities[i] * dt for every entry, without bounds.
+void integrate(Vec2 *positions, const Vec2 *velocities, std::size_t count, float dt);
+
+} // namespace movement
+} // namespace world
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "world/SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace world
+{
+
+// Point index for target acquisition. Items are bucketed by centre into a SpatialGrid whose cell size adapts to
+// the item count, and queries grow a square of cells ring by ring until nothing outside it can beat the current
+// answer. Results match a linear scan that keeps the lowest index on distance ties. Positions are captured by
+// build(); callers rebuild whenever the indexed items move.
+class ProximityIndex
+{
+  public:
+    static constexpr std::uint32_t None = std::numeric_limits<std::uint32_t>::max();
+
+    // positionOf(i) returns the centre of item i for i in [0, count).
+    template <typename PositionFn>
+    void build(const Vec2 &min, const Vec2 &max, std::size_t count, PositionFn &&positionOf)
+    {
+        const float width = std::max(max.x - min.x, 1.0f);
+        const float height = std::max(max.y - min.y, 1.0f);
+        const float cellArea = width * height * kItemsPerCell / static_cast<float>(std::max<std::size_t>(count, 1));
+        m_grid.configure(min, max, std::max(std::sqrt(cellArea), kMinCellSize));
+
+        m_positions.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_positions[i] = positionOf(i);
+        }
+        m_grid.build(SpatialGrid::Layer::Units, count, [&](std::size_t i) {
+            return SpatialGrid::Bounds{m_positions[i], 0.0f};
+        });
+    }
+
+    std::size_t size() const
+    {
+        return m_positions.size();
+    }
+
+    // Closest item within maxRadius (inclusive) for which accept(index) holds, or None.
+    template <typename Accept>
+    std::uint32_t nearest(const Vec2 &from, float maxRadius, Accept &&accept) const
+    {
+        const float maxRadiusSq = maxRadius * maxRadius;
+        std::uint32_t best = None;
+        float bestDistSq = std::numeric_limits<float>::max();
+        expand(
+            from, maxRadius,
+            [&](std::uint32_t index) {
+                const float distSq = distanceSq(m_positions[index], from);
+                if (distSq > maxRadiusSq || distSq > bestDistSq || (distSq == bestDistSq && index > best))
+                {
+                    return;
+                }
+                if (accept(index))
+                {
+                    best = index;
+                    bestDistSq = distSq;
+                }
+            },
+            [&](float boundSq) { return best != None && bestDistSq < boundSq; });
+        return best;
+    }
+
+    template <typename Accept>
+    std::uint32_t nearest(const Vec2 &from, Accept &&accept) const
+    {
+        return nearest(from, std::numeric_limits<float>::infinity(), std::forward<Accept>(accept));
+    }
+
+    // Up to k accepted items within maxRadius, closest first (ties by index).
+    template <typename Accept>
+    void kNearest(const Vec2 &from, std::size_t k, float maxRadius, Accept &&accept,
+                  std::vector<std::uint32_t> &out) const
+    {
+        out.clear();
+        m_candidates.clear();
+        if (k == 0)
+        {
+            return;
+        }
+        const float maxRadiusSq = maxRadius * maxRadius;
+        auto closer = [](const Candidate &a, const Candidate &b) {
+            return a.distSq < b.distSq || (a.distSq == b.distSq && a.index < b.index);
+        };
+        expand(
+            from, maxRadius,
+            [&](std::uint32_t index) {
+                const Candidate candidate{distanceSq(m_positions[index], from), index};
+                if (candidate.distSq > maxRadiusSq ||
+                    (m_candidates.size() == k && !closer(candidate, m_candidates.back())))
+                {
+                    return;
+                }
+                if (!accept(index))
+                {
+                    return;
+                }
+                if (m_candidates.size() == k)
+                {
+                    m_candidates.pop_back();
+                }
+                m_candidates.insert(std::upper_bound(m_candidates.begin(), m_candidates.end(), candidate, closer),
+                                    candidate);
+            },
+            [&](float boundSq) { return m_candidates.size() == k && m_candidates.back().distSq < boundSq; });
+        for (const Candidate &candidate : m_candidates)
+        {
+            out.push_back(candidate.index);
+        }
+    }
+
+    // Every accepted item within radius (inclusive), in ascending index order.
+    template <typename Accept>
+    void withinRadius(const Vec2 &from, float radius, Accept &&accept, std::vector<std::uint32_t> &out) const
+    {
+        out.clear();
+        expandRows(
+            from, radius,
+            [&](const SpatialGrid::CellRect &rect, std::uint32_t y) {
+                const range::Candidates row = m_grid.packedRowSpan(SpatialGrid::Layer::Units, rect, y);
+                m_hits.resize(std::max(m_hits.size(), row.count));
+                const std::size_t hits = range::within(row, from, radius, m_hits.data());
+                for (std::size_t i = 0; i < hits; ++i)
+                {
+                    if (accept(m_hits[i]))
+                    {
+                        out.push_back(m_hits[i]);
+                    }
+                }
+            },
+            [](float) { return false; });
+        std::sort(out.begin(), out.end());
+    }
+
+  private:
+    static constexpr float kItemsPerCell = 2.0f;
+    static constexpr float kMinCellSize = 16.0f;
+
+    struct Candidate
+    {
+        float distSq = 0.0f;
+        std::uint32_t index = 0;
+    };
+
+    SpatialGrid m_grid;
+    std::vector<Vec2> m_positions;
+    mutable std::vector<Candidate> m_candidates;
+    mutable std::vector<std::uint32_t> m_hits;
+
+    // Visits every item in a growing square of cells around from. After each ring, done(boundSq) is asked
+    // whether the answer is final, where boundSq is the squared distance from `from` to the nearest unvisited
+    // cell. Items outside the grid are bucketed into edge cells, so grid edges never bound the search.
+    template <typename Visit, typename Done>
+    void expand(const Vec2 &from, float maxRadius, Visit &&visit, Done &&done) const
+    {
+        expandRows(
+            from, maxRadius,
+            [&](const SpatialGrid::CellRect &rect, std::uint32_t y) {
+                for (std::uint32_t index : m_grid.rowSpan(SpatialGrid::Layer::Units, rect, y))
+                {
+                    visit(index);
+                }
+            },
+            std::forward<Done>(done));
+    }
+
+    // expand() one row span at a time: visitRow(rect, y) covers cells [rect.minX, rect.maxX] of row y.
+    template <typename VisitRow, typename Done>
+    void expandRows(const Vec2 &from, float maxRadius, VisitRow &&visitRow, Done &&done) const
+    {
+        if (m_positions.empty() || !(maxRadius >= 0.0f))
+        {
+            return;
+        }
+        const std::uint32_t lastCol = m_grid.columns() - 1;
+        const std::uint32_t lastRow = m_grid.rows() - 1;
+        const float cellSize = m_grid.cellSize();
+        const Vec2 &origin = m_grid.origin();
+        const SpatialGrid::CellRect start = m_grid.queryRect(from, 0.0f);
+        SpatialGrid::CellRect visited = start;
+        SpatialGrid::CellRect previous{1, 0, 1, 0};
+
+        while (true)
+        {
+            for (std::uint32_t y = visited.minY; y <= visited.maxY; ++y)
+            {
+                if (y < previous.minY || y > previous.maxY)
+                {
+                    visitRow(visited, y);
+                    continue;
+                }
+                if (visited.minX < previous.minX)
+                {
+                    visitRow(SpatialGrid::CellRect{visited.minX, previous.minX - 1, y, y}, y);
+                }
+                if (visited.maxX > previous.maxX)
+                {
+                    visitRow(SpatialGrid::CellRect{previous.maxX + 1, visited.maxX, y, y}, y);
+                }
+            }
+
+            float bound = std::numeric_limits<float>::infinity();
+            if (visited.minX > 0)
+            {
+                bound = std::min(bound, from.x - (origin.x + static_cast<float>(visited.minX) * cellSize));
+            }
+            if (visited.maxX < lastCol)
+            {
+                bound = std::min(bound, origin.x + static_cast<float>(visited.maxX + 1) * cellSize - from.x);
+            }
+            if (visited.minY > 0)
+            {
+                bound = std::min(bound, from.y - (origin.y + static_cast<float>(visited.minY) * cellSize));
+            }
+            if (visited.maxY < lastRow)
+            {
+                bound = std::min(bound, origin.y + static_cast<float>(visited.maxY + 1) * cellSize - from.y);
+            }
+            if (bound == std::numeric_limits<float>::infinity())
+            {
+                return;
+            }
+            // Cell assignment and the edge positions above round differently; a small margin keeps ties exact.
+            bound = std::max(bound - cellSize * kBoundSlack, 0.0f);
+            if (bound > maxRadius || done(bound * bound))
+            {
+                return;
+            }
+
+            previous = visited;
+            visited.minX = visited.minX > 0 ? visited.minX - 1 : 0;
+            visited.minY = visited.minY > 0 ? visited.minY - 1 : 0;
+            visited.maxX = std::min(visited.maxX + 1, lastCol);
+            visited.maxY = std::min(visited.maxY + 1, lastRow);
+        }
+    }
+
+    static constexpr float kBoundSlack = 0.001f;
+
+    static float distanceSq(const Vec2 &a, const Vec2 &b)
+    {
+        const float dx = a.x - b.x;
+        const float dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+};
+
+} // namespace world
@@ -0,0 +1,136 @@
+#include "world/RangeKernel.h"
+
+#if defined(KUSOZAKO_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+namespace world::range
+{
+namespace
+{
+
+// Writes every lane's id and advances only past the hits, so the output stays compact without a branch per lane.
+// hits never exceeds the lane being written, which keeps every store inside the candidates.count-sized buffer.
+template <int kLanes>
+std::size_t emitHits(const std::uint32_t *ids, unsigned mask, std::uint32_t *out, std::size_t hits)
+{
+    for (int lane = 0; lane < kLanes; ++lane)
+    {
+        out[hits] = ids[lane];
+        hits += (mask >> lane) & 1u;
+    }
+    return hits;
+}
+
+template <bool kCircles>
+std::size_t testScalar(const Candidates &candidates, std::size_t begin, const Vec2 &centre, float radius,
+                       std::uint32_t *out, std::size_t hits)
+{
+    const float pointReachSq = radius * radius;
+    for (std::size_t i = begin; i < candidates.count; ++i)
+    {
+        const float dx = centre.x - candidates.x[i];
+        const float dy = centre.y - candidates.y[i];
+        const float distSq = dx * dx + dy * dy;
+        float reachSq = pointReachSq;
+        if constexpr (kCircles)
+        {
+            const float reach = radius + candidates.radius[i];
+            reachSq = reach * reach;
+        }
+        out[hits] = candidates.ids[i];
+        hits += distSq <= reachSq ? 1 : 0;
+    }
+    return hits;
+}
+
+#if defined(KUSOZAKO_SIMD_X86)
+
+template <bool kCircles>
+std::size_t testSse2(const Candidates &candidates, const Vec2 &centre, float radius, std::uint32_t *out,
+                     std::size_t &hits)
+{
+    const __m128 cx = _mm_set1_ps(centre.x);
+    const __m128 cy = _mm_set1_ps(centre.y);
+    const __m128 queryRadius = _mm_set1_ps(radius);
+    const __m128 pointReachSq = _mm_mul_ps(queryRadius, queryRadius);
+    std::size_t i = 0;
+    for (; i + 4 <= candidates.count; i += 4)
+    {
+        const __m128 dx = _mm_sub_ps(cx, _mm_loadu_ps(candidates.x + i));
+        const __m128 dy = _mm_sub_ps(cy, _mm_loadu_ps(candidates.y + i));
+        const __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 reachSq = pointReachSq;
+        if constexpr (kCircles)
+        {
+            const __m128 reach = _mm_add_ps(queryRadius, _mm_loadu_ps(candidates.radius + i));
+            reachSq = _mm_mul_ps(reach, reach);
+        }
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(distSq, reachSq)));
+        hits = emitHits<4>(candidates.ids + i, mask, out, hits);
+    }
+    return i;
+}
+
+template <bool kCircles>
+KUSOZAKO_TARGET_AVX2 std::size_t testAvx2(const Candidates &candidates, const Vec2 &centre, float radius,
+                                          std::uint32_t *out, std::size_t &hits)
+{
+    const __m256 cx = _mm256_set1_ps(centre.x);
+    const __m256 cy = _mm256_set1_ps(centre.y);
+    const __m256 queryRadius = _mm256_set1_ps(radius);
+    const __m256 pointReachSq = _mm256_mul_ps(queryRadius, queryRadius);
+    std::size_t i = 0;
+    for (; i + 8 <= candidates.count; i += 8)
+    {
+        const __m256 dx = _mm256_sub_ps(cx, _mm256_loadu_ps(candidates.x + i));
+        const __m256 dy = _mm256_sub_ps(cy, _mm256_loadu_ps(candidates.y + i));
+        const __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 reachSq = pointReachSq;
+        if constexpr (kCircles)
+        {
+            const __m256 reach = _mm256_add_ps(queryRadius, _mm256_loadu_ps(candidates.radius + i));
+            reachSq = _mm256_mul_ps(reach, reach);
+        }
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(distSq, reachSq, _CMP_LE_OQ)));
+        hits = emitHits<8>(candidates.ids + i, mask, out, hits);
+    }
+    return i;
+}
+
+#endif
+
+template <bool kCircles>
+std::size_t test(const Candidates &candidates, const Vec2 &centre, float radius, std::uint32_t *out)
+{
+    std::size_t done = 0;
+    std::size_t hits = 0;
+#if defined(KUSOZAKO_SIMD_X86)
+    switch (simd::activeLevel())
+    {
+    case simd::Level::Avx2:
+        done = testAvx2<kCircles>(candidates, centre, radius, out, hits);
+        break;
+    case simd::Level::Sse2:
+        done = testSse2<kCircles>(candidates, centre, radius, out, hits);
+        break;
+    case simd::Level::Scalar:
+        break;
+    }
+#endif
+    return testScalar<kCircles>(candidates, done, centre, radius, out, hits);
+}
+
+} // namespace
+
+std::size_t overlapping(const Candidates &candidates, const Vec2 &centre, float radius, std::uint32_t *out)
+{
+    return test<true>(candidates, centre, radius, out);
+}
+
+std::size_t within(const Candidates &candidates, const Vec2 &centre, float radius, std::uint32_t *out)
+{
+    return test<false>(candidates, centre, radius, out);
+}
+
+} // namespace world::range
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "world/Simd.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace world
+{
+
+// Batch distance tests against packed candidate arrays, shared by the combat damage, taunt and gate loops. The
+// vector paths test four (SSE2) or eight (AVX2) candidates per step and compact the hits without branching.
+namespace range
+{
+
+// Parallel arrays of count candidates; ids[i] is what a hit on candidate i reports.
+struct Candidates
+{
+    const std::uint32_t *ids = nullptr;
+    const float *x = nullptr;
+    const float *y = nullptr;
+    const float *radius = nullptr;
+    std::size_t count = 0;
+};
+
+// Writes ids[i] of every candidate circle touching the query circle, i.e. with squared centre distance at most
+// (radius + candidates.radius[i])^2, to out in candidate order. Returns how many were written; out needs room for
+// candidates.count entries.
+std::size_t overlapping(const Candidates &candidates, const Vec2 &centre, float radius, std::uint32_t *out);
+
+// As overlapping() for points: squared distance at most radius^2. candidates.radius is not read.
+std::size_t within(const Candidates &candidates, const Vec2 &centre, float radius, std::uint32_t *out);
+
+} // namespace range
+} // namespace world
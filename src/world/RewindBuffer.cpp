@@ -0,0 +1,76 @@
+#include "world/RewindBuffer.h"
+
+#include "world/WorldState.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace world
+{
+
+RewindBuffer::RewindBuffer(std::size_t capacity, float interval)
+    : m_capacity(std::max<std::size_t>(capacity, 1)), m_interval(std::max(interval, 0.0f))
+{
+}
+
+void RewindBuffer::clear()
+{
+    m_entries.clear();
+}
+
+bool RewindBuffer::capture(const WorldState &world)
+{
+    const LegacySimulation &sim = world.legacy();
+    if (!m_entries.empty())
+    {
+        const float newest = m_entries.back().simTime;
+        if (sim.simTime < newest)
+        {
+            m_entries.clear();
+        }
+        else if (sim.simTime - newest < m_interval)
+        {
+            return false;
+        }
+    }
+
+    // Evicted entries hand their buffer to the new snapshot, so a full ring stops allocating.
+    Entry entry;
+    if (m_entries.size() >= m_capacity)
+    {
+        entry = std::move(m_entries.front());
+        m_entries.pop_front();
+    }
+    entry.simTime = sim.simTime;
+    entry.frame = sim.frameCounter;
+    world.saveState(entry.state);
+    m_entries.push_back(std::move(entry));
+    return true;
+}
+
+bool RewindBuffer::rewind(WorldState &world, std::string &error)
+{
+    const float now = world.legacy().simTime;
+    while (m_entries.size() > 1 && now - m_entries.back().simTime < kMinimumRewind)
+    {
+        m_entries.pop_back();
+    }
+    if (m_entries.empty())
+    {
+        error = "no_snapshot";
+        return false;
+    }
+    return world.loadState(m_entries.back().state, error);
+}
+
+std::size_t RewindBuffer::bytes() const
+{
+    std::size_t total = 0;
+    for (const Entry &entry : m_entries)
+    {
+        total += entry.state.size();
+    }
+    return total;
+}
+
+} // namespace world
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace world
+{
+
+class WorldState;
+
+// In-memory ring of periodic WorldState saves, so the debug overlay can jump back to an earlier point of the
+// battle instead of replaying it. The defaults keep the last 15 minutes at 10 s granularity.
+class RewindBuffer
+{
+  public:
+    static constexpr std::size_t kDefaultCapacity = 90;
+    static constexpr float kDefaultInterval = 10.0f;
+    // rewind() skips snapshots taken less than this long before the current sim time, so pressing it right
+    // after a rewind keeps going back rather than landing on the same snapshot.
+    static constexpr float kMinimumRewind = 1.0f;
+
+    struct Entry
+    {
+        float simTime = 0.0f;
+        std::uint64_t frame = 0;
+        std::vector<std::uint8_t> state;
+    };
+
+    explicit RewindBuffer(std::size_t capacity = kDefaultCapacity, float interval = kDefaultInterval);
+
+    void clear();
+    // Saves the world when the newest snapshot is at least interval() of sim time old, or the sim clock went
+    // backwards (a restart). Returns true when a snapshot was taken.
+    bool capture(const WorldState &world);
+    // Restores the newest snapshot at least kMinimumRewind behind the world (or the oldest one left) and drops
+    // every newer one.
+    bool rewind(WorldState &world, std::string &error);
+
+    std::size_t size() const { return m_entries.size(); }
+    std::size_t capacity() const { return m_capacity; }
+    float interval() const { return m_interval; }
+    // 0 is the newest snapshot.
+    const Entry &entry(std::size_t back) const { return m_entries[m_entries.size() - 1 - back]; }
+    std::size_t bytes() const;
+
+  private:
+    std::size_t m_capacity;
+    float m_interval;
+    std::deque<Entry> m_entries;
+};
+
+} // namespace world
@@ -0,0 +1,84 @@
+#include "world/Simd.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(KUSOZAKO_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace world::simd
+{
+namespace
+{
+
+#if defined(KUSOZAKO_SIMD_X86)
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+Level detectLevel()
+{
+#if defined(KUSOZAKO_SIMD_X86)
+    return cpuHasAvx2() ? Level::Avx2 : Level::Sse2;
+#else
+    return Level::Scalar;
+#endif
+}
+
+std::atomic<Level> &activeLevelSlot()
+{
+    static std::atomic<Level> level{supportedLevel()};
+    return level;
+}
+
+} // namespace
+
+const char *levelName(Level level)
+{
+    switch (level)
+    {
+    case Level::Scalar:
+        return "scalar";
+    case Level::Sse2:
+        return "sse2";
+    case Level::Avx2:
+        return "avx2";
+    }
+    return "unknown";
+}
+
+Level supportedLevel()
+{
+    static const Level level = detectLevel();
+    return level;
+}
+
+Level activeLevel()
+{
+    return activeLevelSlot().load(std::memory_order_relaxed);
+}
+
+void setLevel(Level level)
+{
+    activeLevelSlot().store(std::min(level, supportedLevel()), std::memory_order_relaxed);
+}
+
+} // namespace world::simd
@@ -0,0 +1,35 @@
+#pragma once
+
+// Instruction-set selection shared by the batch kernels (MovementKernel, RangeKernel). Each kernel ships a scalar,
+// an SSE2 and an AVX2 build of the same float operations in the same order, so results are bit-identical whichever
+// one runs; the widest level the CPU supports is picked on first use.
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KUSOZAKO_SIMD_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#define KUSOZAKO_TARGET_AVX2
+#else
+#define KUSOZAKO_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace world::simd
+{
+
+enum class Level
+{
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+const char *levelName(Level level);
+
+// Widest level this CPU and build can run.
+Level supportedLevel();
+Level activeLevel();
+// Caps the level used by later kernel calls (tests and the bench compare paths). Levels above supportedLevel()
+// are lowered to it. Not safe to call while a kernel is running on another thread.
+void setLevel(Level level);
+
+} // namespace world::simd
@@ -1,18 +1,64 @@
 #pragma once
 
 #include "core/Vec2.h"
+#include "world/RangeKernel.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace world
 {
 
+// Uniform grid rebuilt from scratch every tick. Each layer is bucketed with a counting sort: one pass counts how
+// many cells every item overlaps, a prefix sum turns the counts into a cell-offset table, and a second pass
+// scatters item indices into a single contiguous array. Cells in a row are adjacent in that array, so a query
+// yields one span per covered row. Every slot also carries a copy of its item's centre and radius, so a row span
+// can go straight to the world::range kernels. All buffers keep their capacity between builds.
 class SpatialGrid
 {
   public:
+    enum class Layer : std::uint8_t
+    {
+        Units,
+        Enemies,
+        Walls,
+        Count
+    };
+
+    struct Bounds
+    {
+        Vec2 pos;
+        float radius = 0.0f;
+    };
+
+    struct CellRect
+    {
+        std::uint32_t minX = 0;
+        std::uint32_t maxX = 0;
+        std::uint32_t minY = 0;
+        std::uint32_t maxY = 0;
+    };
+
+    class IndexSpan
+    {
+      public:
+        IndexSpan() = default;
+        IndexSpan(const std::uint32_t *first, const std::uint32_t *last) : m_first(first), m_last(last) {}
+
+        const std::uint32_t *begin() const { return m_first; }
+        const std::uint32_t *end() const { return m_last; }
+        std::size_t size() const { return static_cast<std::size_t>(m_last - m_first); }
+        bool empty() const { return m_first == m_last; }
+
+      private:
+        const std::uint32_t *m_first = nullptr;
+        const std::uint32_t *m_last = nullptr;
+    };
+
     SpatialGrid() = default;
 
     void configure(const Vec2 &min, const Vec2 &max, float cellSize)
@@ -30,8 +76,10 @@ class SpatialGrid
         }
         const float width = std::max(maxBounds.x - minBounds.x, clampedSize);
         const float height = std::max(maxBounds.y - minBounds.y, clampedSize);
-        const std::size_t cols = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(width / clampedSize)));
-        const std::size_t rows = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(height / clampedSize)));
+        const std::uint32_t cols =
+            std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::ceil(width / clampedSize)));
+        const std::uint32_t rows =
+            std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::ceil(height / clampedSize)));
         const bool sizeChanged = cols != m_cols || rows != m_rows || clampedSize != m_cellSize;
 
         m_min = minBounds;
@@ -40,95 +88,97 @@ class SpatialGrid
         m_cols = cols;
         m_rows = rows;
 
-        if (sizeChanged || m_cells.size() != m_cols * m_rows)
+        if (sizeChanged)
         {
-            m_cells.clear();
-            m_cells.resize(m_cols * m_rows);
+            clear();
         }
     }
 
     void clear()
     {
-        for (Cell &cell : m_cells)
+        for (Buckets &buckets : m_layers)
         {
-            cell.units.clear();
-            cell.enemies.clear();
-            cell.walls.clear();
+            buckets.cellStart.clear();
+            buckets.indices.clear();
+            buckets.xs.clear();
+            buckets.ys.clear();
+            buckets.radii.clear();
         }
     }
 
-    struct Cell
-    {
-        std::vector<std::size_t> units;
-        std::vector<std::size_t> enemies;
-        std::vector<std::size_t> walls;
-    };
-
-    void insertUnit(std::size_t index, const Vec2 &pos, float radius)
-    {
-        insertImpl<&Cell::units>(index, pos, radius);
-    }
-
-    void insertEnemy(std::size_t index, const Vec2 &pos, float radius)
-    {
-        insertImpl<&Cell::enemies>(index, pos, radius);
-    }
-
-    void insertWall(std::size_t index, const Vec2 &pos, float radius)
+    // Replaces the contents of one layer with items [0, count). bounds(i) must return the Bounds of item i.
+    template <typename BoundsFn>
+    void build(Layer layer, std::size_t count, BoundsFn &&bounds)
     {
-        insertImpl<&Cell::walls>(index, pos, radius);
-    }
-
-    void queryCells(const Vec2 &pos, float radius, std::vector<std::size_t> &outCells) const
-    {
-        outCells.clear();
-        if (m_cells.empty())
+        Buckets &buckets = m_layers[static_cast<std::size_t>(layer)];
+        const std::size_t cellCount = static_cast<std::size_t>(m_cols) * m_rows;
+        buckets.cellStart.assign(cellCount + 1, 0);
+        buckets.indices.clear();
+        buckets.xs.clear();
+        buckets.ys.clear();
+        buckets.radii.clear();
+        if (cellCount == 0)
         {
             return;
         }
-        const Range range = computeRange(pos, radius);
-        for (std::size_t y = range.minY; y <= range.maxY; ++y)
+
+        m_itemRects.resize(count);
+        m_itemBounds.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
         {
-            const std::size_t rowOffset = y * m_cols;
-            for (std::size_t x = range.minX; x <= range.maxX; ++x)
+            const Bounds item = bounds(i);
+            const CellRect rect = queryRect(item.pos, item.radius);
+            m_itemRects[i] = rect;
+            m_itemBounds[i] = item;
+            for (std::uint32_t y = rect.minY; y <= rect.maxY; ++y)
             {
-                outCells.push_back(rowOffset + x);
+                std::uint32_t *row = buckets.cellStart.data() + static_cast<std::size_t>(y) * m_cols;
+                for (std::uint32_t x = rect.minX; x <= rect.maxX; ++x)
+                {
+                    ++row[x];
+                }
             }
         }
-    }
 
-    const Cell &cell(std::size_t index) const
-    {
-        return m_cells[index];
-    }
+        std::uint32_t running = 0;
+        for (std::size_t cell = 0; cell < cellCount; ++cell)
+        {
+            const std::uint32_t cellItems = buckets.cellStart[cell];
+            buckets.cellStart[cell] = running;
+            running += cellItems;
+        }
+        buckets.cellStart[cellCount] = running;
 
-    float cellSize() const
-    {
-        return m_cellSize;
+        buckets.indices.resize(running);
+        buckets.xs.resize(running);
+        buckets.ys.resize(running);
+        buckets.radii.resize(running);
+        m_cursor.assign(buckets.cellStart.begin(), buckets.cellStart.end() - 1);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const CellRect &rect = m_itemRects[i];
+            const Bounds &item = m_itemBounds[i];
+            for (std::uint32_t y = rect.minY; y <= rect.maxY; ++y)
+            {
+                std::uint32_t *cursor = m_cursor.data() + static_cast<std::size_t>(y) * m_cols;
+                for (std::uint32_t x = rect.minX; x <= rect.maxX; ++x)
+                {
+                    const std::uint32_t slot = cursor[x]++;
+                    buckets.indices[slot] = static_cast<std::uint32_t>(i);
+                    buckets.xs[slot] = item.pos.x;
+                    buckets.ys[slot] = item.pos.y;
+                    buckets.radii[slot] = item.radius;
+                }
+            }
+        }
     }
 
-  private:
-    struct Range
+    CellRect queryRect(const Vec2 &pos, float radius) const
     {
-        std::size_t minX = 0;
-        std::size_t maxX = 0;
-        std::size_t minY = 0;
-        std::size_t maxY = 0;
-    };
-
-    Vec2 m_min{0.0f, 0.0f};
-    Vec2 m_max{0.0f, 0.0f};
-    float m_cellSize = 1.0f;
-    std::size_t m_cols = 0;
-    std::size_t m_rows = 0;
-    std::vector<Cell> m_cells;
-
-    Range computeRange(const Vec2 &pos, float radius) const
-    {
-        Range range{};
+        CellRect rect{};
         if (m_cols == 0 || m_rows == 0)
         {
-            return range;
+            return rect;
         }
         const float queryRadius = std::max(radius, 0.0f);
         const float minX = pos.x - queryRadius;
@@ -158,31 +208,114 @@ class SpatialGrid
             endY = startY;
         }
 
-        range.minX = static_cast<std::size_t>(startX);
-        range.maxX = static_cast<std::size_t>(endX);
-        range.minY = static_cast<std::size_t>(startY);
-        range.maxY = static_cast<std::size_t>(endY);
-        return range;
+        rect.minX = static_cast<std::uint32_t>(startX);
+        rect.maxX = static_cast<std::uint32_t>(endX);
+        rect.minY = static_cast<std::uint32_t>(startY);
+        rect.maxY = static_cast<std::uint32_t>(endY);
+        return rect;
     }
 
-    template <std::vector<std::size_t> Cell::*Member>
-    void insertImpl(std::size_t index, const Vec2 &pos, float radius)
+    // Items bucketed in cells [rect.minX, rect.maxX] of row y, in cell order. An item spanning several of those
+    // cells appears once per cell.
+    IndexSpan rowSpan(Layer layer, const CellRect &rect, std::uint32_t y) const
     {
-        if (m_cells.empty())
+        const Buckets &buckets = m_layers[static_cast<std::size_t>(layer)];
+        if (buckets.cellStart.empty())
         {
-            return;
+            return {};
         }
-        const Range range = computeRange(pos, radius);
-        for (std::size_t y = range.minY; y <= range.maxY; ++y)
+        const std::size_t rowOffset = static_cast<std::size_t>(y) * m_cols;
+        const std::uint32_t *base = buckets.indices.data();
+        return {base + buckets.cellStart[rowOffset + rect.minX], base + buckets.cellStart[rowOffset + rect.maxX + 1]};
+    }
+
+    // rowSpan() together with the centre and radius each item had at build time, for the world::range kernels.
+    range::Candidates packedRowSpan(Layer layer, const CellRect &rect, std::uint32_t y) const
+    {
+        const Buckets &buckets = m_layers[static_cast<std::size_t>(layer)];
+        if (buckets.cellStart.empty())
         {
-            const std::size_t rowOffset = y * m_cols;
-            for (std::size_t x = range.minX; x <= range.maxX; ++x)
-            {
-                (m_cells[rowOffset + x].*Member).push_back(index);
-            }
+            return {};
+        }
+        const std::size_t rowOffset = static_cast<std::size_t>(y) * m_cols;
+        const std::size_t first = buckets.cellStart[rowOffset + rect.minX];
+        const std::size_t last = buckets.cellStart[rowOffset + rect.maxX + 1];
+        return {buckets.indices.data() + first, buckets.xs.data() + first, buckets.ys.data() + first,
+                buckets.radii.data() + first, last - first};
+    }
+
+    IndexSpan cell(Layer layer, std::size_t index) const
+    {
+        const Buckets &buckets = m_layers[static_cast<std::size_t>(layer)];
+        if (buckets.cellStart.empty())
+        {
+            return {};
         }
+        const std::uint32_t *base = buckets.indices.data();
+        return {base + buckets.cellStart[index], base + buckets.cellStart[index + 1]};
     }
+
+    // Calls fn(span) for every covered row, top to bottom.
+    template <typename Fn>
+    void forEachSpan(Layer layer, const Vec2 &pos, float radius, Fn &&fn) const
+    {
+        const CellRect rect = queryRect(pos, radius);
+        for (std::uint32_t y = rect.minY; y <= rect.maxY && y < m_rows; ++y)
+        {
+            fn(rowSpan(layer, rect, y));
+        }
+    }
+
+    // As forEachSpan(), passing fn(packedRowSpan) instead.
+    template <typename Fn>
+    void forEachPackedSpan(Layer layer, const Vec2 &pos, float radius, Fn &&fn) const
+    {
+        const CellRect rect = queryRect(pos, radius);
+        for (std::uint32_t y = rect.minY; y <= rect.maxY && y < m_rows; ++y)
+        {
+            fn(packedRowSpan(layer, rect, y));
+        }
+    }
+
+    float cellSize() const
+    {
+        return m_cellSize;
+    }
+
+    const Vec2 &origin() const
+    {
+        return m_min;
+    }
+
+    std::uint32_t columns() const
+    {
+        return m_cols;
+    }
+
+    std::uint32_t rows() const
+    {
+        return m_rows;
+    }
+
+  private:
+    struct Buckets
+    {
+        std::vector<std::uint32_t> cellStart;
+        std::vector<std::uint32_t> indices;
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<float> radii;
+    };
+
+    Vec2 m_min{0.0f, 0.0f};
+    Vec2 m_max{0.0f, 0.0f};
+    float m_cellSize = 1.0f;
+    std::uint32_t m_cols = 0;
+    std::uint32_t m_rows = 0;
+    std::array<Buckets, static_cast<std::size_t>(Layer::Count)> m_layers;
+    std::vector<CellRect> m_itemRects;
+    std::vector<Bounds> m_itemBounds;
+    std::vector<std::uint32_t> m_cursor;
 };
 
 } // namespace world
-
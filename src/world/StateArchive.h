@@ -0,0 +1,294 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "world/ByteStream.h"
+#include "world/ComponentPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace world
+{
+
+template <typename T>
+struct StateArchiveUnsupported : std::false_type
+{
+};
+
+// Saved simulation state is written by one templated transfer function per type, run with a StateWriter to save
+// and a StateReader to load, so both directions always agree on field order. Scalars, enums, Vec2, strings and
+// the RNG go through field(); containers go through sequence() with a per-element callback.
+class StateWriter
+{
+  public:
+    static constexpr bool kLoading = false;
+
+    explicit StateWriter(std::vector<std::uint8_t> &out) : m_out(out) {}
+
+    ByteWriter &bytes() { return m_out; }
+
+    template <typename T>
+    void field(const T &value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            m_out.u8(value ? 1 : 0);
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            m_out.f32(value);
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            m_out.f64(value);
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            m_out.zigzag(static_cast<std::int64_t>(value));
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            m_out.zigzag(value);
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            m_out.varint(value);
+        }
+        else if constexpr (std::is_same_v<T, Vec2>)
+        {
+            m_out.f32(value.x);
+            m_out.f32(value.y);
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            m_out.str(value);
+        }
+        else if constexpr (std::is_same_v<T, std::mt19937>)
+        {
+            std::ostringstream state;
+            state << value;
+            m_out.str(state.str());
+        }
+        else
+        {
+            static_assert(StateArchiveUnsupported<T>::value, "StateWriter::field: unsupported type");
+        }
+    }
+
+    template <typename Container, typename Fn>
+    void sequence(const Container &values, Fn &&fn)
+    {
+        m_out.varint(values.size());
+        for (const auto &value : values)
+        {
+            fn(value);
+        }
+    }
+
+    template <typename Container>
+    void sequence(const Container &values)
+    {
+        sequence(values, [this](const auto &value) { field(value); });
+    }
+
+    // Sorted so equal sets always encode to the same bytes.
+    void stringSet(const std::unordered_set<std::string> &values)
+    {
+        std::vector<std::string> sorted(values.begin(), values.end());
+        std::sort(sorted.begin(), sorted.end());
+        sequence(sorted);
+    }
+
+    // Components together with their entity handles and the registry's slot table, so a restored pool hands out
+    // the same handles as the saved one would have.
+    template <typename T, typename Fn>
+    void pool(const ComponentPool<T> &values, Fn &&fn)
+    {
+        sequence(values.registry().generations());
+        sequence(values.registry().freeList());
+        m_out.varint(values.size());
+        values.forEach([&](EntityId entity, const auto &value) {
+            m_out.varint(entity.index);
+            m_out.varint(entity.generation);
+            fn(value);
+        });
+    }
+
+    bool ok() const { return true; }
+    void fail(std::string) {}
+
+  private:
+    ByteWriter m_out;
+};
+
+class StateReader
+{
+  public:
+    static constexpr bool kLoading = true;
+
+    StateReader(const std::vector<std::uint8_t> &data, std::size_t offset) : m_in(data, offset), m_size(data.size())
+    {
+    }
+
+    ByteReader &bytes() { return m_in; }
+
+    bool ok() const { return m_in.ok() && m_error.empty(); }
+    // First decode error; "truncated" when the data ran out.
+    std::string error() const { return !m_error.empty() ? m_error : (m_in.ok() ? std::string() : "truncated"); }
+
+    void fail(std::string error)
+    {
+        if (m_error.empty())
+        {
+            m_error = std::move(error);
+        }
+    }
+
+    template <typename T>
+    void field(T &value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            value = m_in.u8() != 0;
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            value = m_in.f32();
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            value = m_in.f64();
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            value = static_cast<T>(m_in.zigzag());
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            value = static_cast<T>(m_in.zigzag());
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            value = static_cast<T>(m_in.varint());
+        }
+        else if constexpr (std::is_same_v<T, Vec2>)
+        {
+            value.x = m_in.f32();
+            value.y = m_in.f32();
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            value = m_in.str();
+        }
+        else if constexpr (std::is_same_v<T, std::mt19937>)
+        {
+            std::istringstream state(m_in.str());
+            state >> value;
+            if (state.fail())
+            {
+                fail("rng_state_invalid");
+            }
+        }
+        else
+        {
+            static_assert(StateArchiveUnsupported<T>::value, "StateReader::field: unsupported type");
+        }
+    }
+
+    template <typename Container, typename Fn>
+    void sequence(Container &values, Fn &&fn)
+    {
+        const std::size_t size = count();
+        values.clear();
+        values.resize(size);
+        for (auto &value : values)
+        {
+            fn(value);
+        }
+    }
+
+    template <typename Container>
+    void sequence(Container &values)
+    {
+        sequence(values, [this](auto &value) { field(value); });
+    }
+
+    void stringSet(std::unordered_set<std::string> &values)
+    {
+        std::vector<std::string> sorted;
+        sequence(sorted);
+        values.clear();
+        values.insert(sorted.begin(), sorted.end());
+    }
+
+    template <typename T, typename Fn>
+    void pool(ComponentPool<T> &values, Fn &&fn)
+    {
+        std::vector<std::uint32_t> generations;
+        std::vector<std::uint32_t> freeList;
+        sequence(generations);
+        sequence(freeList);
+        const std::size_t size = count();
+        std::vector<EntityId> entities(size);
+        std::vector<T> components(size);
+        for (std::size_t i = 0; i < size && ok(); ++i)
+        {
+            entities[i].index = static_cast<std::uint32_t>(m_in.varint());
+            entities[i].generation = static_cast<std::uint32_t>(m_in.varint());
+            fn(components[i]);
+        }
+        if (!ok())
+        {
+            return;
+        }
+
+        EntityRegistry registry;
+        registry.restore(std::move(generations), std::move(freeList));
+        std::vector<bool> seen(registry.capacity(), false);
+        for (const EntityId &entity : entities)
+        {
+            if (!registry.isAlive(entity) || seen[entity.index])
+            {
+                fail("entity_invalid");
+                return;
+            }
+            seen[entity.index] = true;
+        }
+        for (std::uint32_t slot : registry.freeList())
+        {
+            if (slot >= registry.capacity() || seen[slot])
+            {
+                fail("entity_invalid");
+                return;
+            }
+        }
+        values.restore(std::move(registry), entities, components);
+    }
+
+  private:
+    // Element counts are bounded by the bytes left so a corrupt count cannot trigger a huge allocation.
+    std::size_t count()
+    {
+        const std::uint64_t size = m_in.varint();
+        if (size > m_size - std::min(m_size, m_in.offset()))
+        {
+            fail("count_invalid");
+            return 0;
+        }
+        return static_cast<std::size_t>(size);
+    }
+
+    ByteReader m_in;
+    std::size_t m_size;
+    std::string m_error;
+};
+
+} // namespace world
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "world/systems/SystemContext.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace world
+{
+
+// Rolling window over the most recent samples of one timed section of WorldState::step.
+class TimingSeries
+{
+  public:
+    static constexpr std::size_t kWindow = 120;
+
+    void record(double ms)
+    {
+        m_total += ms - m_window[m_next];
+        m_window[m_next] = ms;
+        m_next = (m_next + 1) % kWindow;
+        m_count = std::min(m_count + 1, kWindow);
+        m_lastMs = ms;
+        m_peakMs = std::max(m_peakMs, ms);
+    }
+
+    double lastMs() const { return m_lastMs; }
+    double averageMs() const { return m_count > 0 ? std::max(0.0, m_total) / static_cast<double>(m_count) : 0.0; }
+    double windowMaxMs() const
+    {
+        return m_count > 0 ? *std::max_element(m_window.begin(), m_window.begin() + m_count) : 0.0;
+    }
+    // Worst sample since construction, unlike windowMaxMs() which forgets after kWindow steps.
+    double peakMs() const { return m_peakMs; }
+    std::size_t samples() const { return m_count; }
+
+  private:
+    std::array<double, kWindow> m_window{};
+    std::size_t m_next = 0;
+    std::size_t m_count = 0;
+    double m_total = 0.0;
+    double m_lastMs = 0.0;
+    double m_peakMs = 0.0;
+};
+
+struct SystemTiming
+{
+    std::string name;
+    systems::SystemStage stage = systems::SystemStage::InputProcessing;
+    TimingSeries series;
+};
+
+struct StepTimings
+{
+    // One entry per registered system, in registration order.
+    std::vector<SystemTiming> systems;
+    // The LegacySimulation and spawner work WorldState runs around the StateUpdate and Spawn systems.
+    SystemTiming legacyState{"LegacyState", systems::SystemStage::StateUpdate, {}};
+    SystemTiming spawnStage{"SpawnStage", systems::SystemStage::Spawn, {}};
+    std::array<TimingSeries, systems::kSystemStageCount> stages{};
+    TimingSeries step;
+
+    // Slowest section of `stage` in the last step, or nullptr when nothing ran in it.
+    const SystemTiming *slowestIn(systems::SystemStage stage) const
+    {
+        const SystemTiming *slowest = nullptr;
+        auto consider = [&](const SystemTiming &timing) {
+            if (timing.stage == stage && timing.series.samples() > 0 &&
+                (!slowest || timing.series.lastMs() > slowest->series.lastMs()))
+            {
+                slowest = &timing;
+            }
+        };
+        for (const SystemTiming &timing : systems)
+        {
+            consider(timing);
+        }
+        consider(legacyState);
+        consider(spawnStage);
+        return slowest;
+    }
+};
+
+} // namespace world
@@ -0,0 +1,382 @@
+#pragma once
+
+#include "config/AppConfig.h"
+#include "core/Vec2.h"
+#include "world/ComponentPool.h"
+#include "world/MoraleTypes.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct TemperamentState
+{
+    const TemperamentDefinition *definition = nullptr;
+    TemperamentBehavior currentBehavior = TemperamentBehavior::Wander;
+    TemperamentBehavior lastBehavior = TemperamentBehavior::Wander;
+    bool mimicActive = false;
+    TemperamentBehavior mimicBehavior = TemperamentBehavior::Wander;
+    float mimicCooldown = 0.0f;
+    float mimicDuration = 0.0f;
+    Vec2 wanderDirection{1.0f, 0.0f};
+    float wanderTimer = 0.0f;
+    float sleepTimer = 0.0f;
+    float sleepRemaining = 0.0f;
+    bool sleeping = false;
+    float catchupTimer = 0.0f;
+    float cryTimer = 0.0f;
+    float cryPauseTimer = 0.0f;
+    bool crying = false;
+    float panicTimer = 0.0f;
+    float chargeDashTimer = 0.0f;
+};
+
+struct WarriorJobRuntime
+{
+    float stumbleTimer = 0.0f;
+};
+
+struct ArcherJobRuntime
+{
+    bool focusReady = false;
+    float holdTimer = 0.0f;
+};
+
+struct ShieldJobRuntime
+{
+    float tauntTimer = 0.0f;
+    float selfSlowTimer = 0.0f;
+};
+
+struct JobRuntimeState
+{
+    UnitJob job = UnitJob::Warrior;
+    float cooldown = 0.0f;
+    float endlag = 0.0f;
+    WarriorJobRuntime warrior{};
+    ArcherJobRuntime archer{};
+    ShieldJobRuntime shield{};
+};
+
+// Every Unit field, in declaration order. The pool keeps one column per entry so hot loops can walk contiguous
+// arrays; Unit itself is the by-value form used for spawning and copies.
+#define KUSOZAKO_UNIT_FIELDS(X)                                                                                        \
+    X(Vec2, pos, {})                                                                                                   \
+    X(float, hp, 0.0f)                                                                                                 \
+    X(float, radius, 4.0f)                                                                                             \
+    X(bool, followBySkill, false)                                                                                      \
+    X(bool, followByStance, false)                                                                                     \
+    X(bool, effectiveFollower, false)                                                                                  \
+    X(Vec2, formationOffset, {})                                                                                       \
+    X(Vec2, desiredVelocity, {})                                                                                       \
+    X(bool, hasDesiredVelocity, false)                                                                                 \
+    X(TemperamentState, temperament, {})                                                                               \
+    X(MoraleState, moraleState, MoraleState::Stable)                                                                   \
+    X(float, moraleTimer, 0.0f)                                                                                        \
+    X(float, moraleImmunityTimer, 0.0f)                                                                                \
+    X(bool, moraleComfortShield, false)                                                                                \
+    X(bool, moraleBarrierActive, false)                                                                                \
+    X(float, moraleSpeedMultiplier, 1.0f)                                                                              \
+    X(float, moraleAccuracyMultiplier, 1.0f)                                                                           \
+    X(float, moraleDefenseMultiplier, 1.0f)                                                                            \
+    X(float, moraleAttackIntervalMultiplier, 1.0f)                                                                     \
+    X(float, moraleIgnoreOrdersChance, 0.0f)                                                                           \
+    X(float, moraleDetectionRadiusMultiplier, 1.0f)                                                                    \
+    X(float, moraleSpawnDelayMultiplier, 1.0f)                                                                         \
+    X(float, moraleRetargetCooldownMultiplier, 1.0f)                                                                   \
+    X(float, moraleCommandObeyBonus, 0.0f)                                                                             \
+    X(bool, moraleRetreatActive, false)                                                                                \
+    X(float, moraleRetreatTimer, 0.0f)                                                                                 \
+    X(float, moraleRetreatSpeedMultiplier, 1.0f)                                                                       \
+    X(float, moraleRetreatHomewardBias, 1.0f)                                                                          \
+    X(float, moraleRetreatDuration, 0.0f)                                                                              \
+    X(float, moraleRetreatCheckInterval, 0.0f)                                                                         \
+    X(float, moraleRetreatCheckChance, 0.0f)                                                                           \
+    X(float, moraleRetreatCheckTimer, 0.0f)                                                                            \
+    X(float, moraleBarrierLingerTimer, 0.0f)                                                                           \
+    X(float, moraleIgnoreOrdersTimer, 0.0f)                                                                            \
+    X(bool, moraleIgnoringOrders, false)                                                                               \
+    X(bool, moraleLightMesomesoPending, false)                                                                         \
+    X(JobRuntimeState, job, {})
+
+struct Unit
+{
+#define KUSOZAKO_UNIT_MEMBER(FieldType, name, init) FieldType name = init;
+    KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_MEMBER)
+#undef KUSOZAKO_UNIT_MEMBER
+};
+
+namespace world
+{
+
+class UnitColumns;
+
+// std::vector<bool> packs bits and cannot hand out bool&, so flag columns store one byte-sized slot per unit.
+struct BoolColumnSlot
+{
+    bool value = false;
+
+    BoolColumnSlot() = default;
+    BoolColumnSlot(bool flag) : value(flag) {}
+
+    operator bool() const { return value; }
+
+    BoolColumnSlot &operator=(bool flag)
+    {
+        value = flag;
+        return *this;
+    }
+};
+
+template <typename T>
+struct UnitColumn
+{
+    using type = std::vector<T>;
+
+    static T &at(type &column, std::size_t index) { return column[index]; }
+    static const T &at(const type &column, std::size_t index) { return column[index]; }
+};
+
+template <>
+struct UnitColumn<bool>
+{
+    using type = std::vector<BoolColumnSlot>;
+
+    static bool &at(type &column, std::size_t index) { return column[index].value; }
+    static const bool &at(const type &column, std::size_t index) { return column[index].value; }
+};
+
+// Reference to one unit inside UnitColumns: the columns pointer plus the unit's index, so taking one is two words
+// however many fields Unit grows. Each field has an accessor returning a reference into its column, so
+// `unit.pos().x += 1` writes straight into the pool; converting to Unit takes a copy.
+template <bool Const>
+class BasicUnitRef
+{
+  public:
+    using ColumnsPtr = std::conditional_t<Const, const UnitColumns *, UnitColumns *>;
+
+    BasicUnitRef(ColumnsPtr columns, std::size_t index) : m_columns(columns), m_index(index) {}
+    BasicUnitRef(const BasicUnitRef &) = default;
+    // Assigning one ref to another would only rebind it; copy the unit through Unit instead.
+    BasicUnitRef &operator=(const BasicUnitRef &) = delete;
+
+#define KUSOZAKO_UNIT_REF_ACCESSOR(FieldType, name, init)                                                              \
+    std::conditional_t<Const, const FieldType, FieldType> &name() const;
+    KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_REF_ACCESSOR)
+#undef KUSOZAKO_UNIT_REF_ACCESSOR
+
+    operator Unit() const;
+
+    operator BasicUnitRef<true>() const
+    {
+        return BasicUnitRef<true>{m_columns, m_index};
+    }
+
+    const BasicUnitRef &operator=(const Unit &unit) const;
+
+    ColumnsPtr columns() const { return m_columns; }
+    std::size_t index() const { return m_index; }
+
+  private:
+    ColumnsPtr m_columns;
+    std::size_t m_index;
+};
+
+using UnitRef = BasicUnitRef<false>;
+using ConstUnitRef = BasicUnitRef<true>;
+
+template <bool Const>
+class UnitColumnIterator
+{
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Unit;
+    using difference_type = std::ptrdiff_t;
+    using reference = BasicUnitRef<Const>;
+    using pointer = void;
+    using ColumnsPtr = std::conditional_t<Const, const UnitColumns *, UnitColumns *>;
+
+    UnitColumnIterator() = default;
+    UnitColumnIterator(ColumnsPtr columns, std::ptrdiff_t index) : m_columns(columns), m_index(index) {}
+
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    UnitColumnIterator(const UnitColumnIterator<OtherConst> &other)
+        : m_columns(other.columns()), m_index(other.index())
+    {
+    }
+
+    reference operator*() const;
+    reference operator[](difference_type offset) const { return *(*this + offset); }
+
+    UnitColumnIterator &operator++()
+    {
+        ++m_index;
+        return *this;
+    }
+    UnitColumnIterator operator++(int)
+    {
+        UnitColumnIterator copy = *this;
+        ++m_index;
+        return copy;
+    }
+    UnitColumnIterator &operator--()
+    {
+        --m_index;
+        return *this;
+    }
+    UnitColumnIterator operator--(int)
+    {
+        UnitColumnIterator copy = *this;
+        --m_index;
+        return copy;
+    }
+    UnitColumnIterator &operator+=(difference_type offset)
+    {
+        m_index += offset;
+        return *this;
+    }
+    UnitColumnIterator &operator-=(difference_type offset)
+    {
+        m_index -= offset;
+        return *this;
+    }
+    UnitColumnIterator operator+(difference_type offset) const { return {m_columns, m_index + offset}; }
+    UnitColumnIterator operator-(difference_type offset) const { return {m_columns, m_index - offset}; }
+    difference_type operator-(const UnitColumnIterator &other) const { return m_index - other.m_index; }
+
+    bool operator==(const UnitColumnIterator &other) const { return m_index == other.m_index; }
+    bool operator!=(const UnitColumnIterator &other) const { return m_index != other.m_index; }
+    bool operator<(const UnitColumnIterator &other) const { return m_index < other.m_index; }
+    bool operator>(const UnitColumnIterator &other) const { return m_index > other.m_index; }
+    bool operator<=(const UnitColumnIterator &other) const { return m_index <= other.m_index; }
+    bool operator>=(const UnitColumnIterator &other) const { return m_index >= other.m_index; }
+
+    ColumnsPtr columns() const { return m_columns; }
+    std::ptrdiff_t index() const { return m_index; }
+
+  private:
+    ColumnsPtr m_columns = nullptr;
+    std::ptrdiff_t m_index = 0;
+};
+
+// Structure-of-arrays storage for ComponentPool<Unit>: one contiguous column per Unit field. Systems that only
+// need a few fields (movement, range checks) read the columns directly through the *Column() accessors; the
+// accessors must not be used to resize a column.
+class UnitColumns
+{
+  public:
+    using value_type = Unit;
+    using reference = UnitRef;
+    using const_reference = ConstUnitRef;
+    using iterator = UnitColumnIterator<false>;
+    using const_iterator = UnitColumnIterator<true>;
+
+    std::size_t size() const { return m_size; }
+
+    void reserve(std::size_t count)
+    {
+#define KUSOZAKO_UNIT_RESERVE(FieldType, name, init) m_##name.reserve(count);
+        KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_RESERVE)
+#undef KUSOZAKO_UNIT_RESERVE
+    }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, static_cast<std::ptrdiff_t>(m_size)}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, static_cast<std::ptrdiff_t>(m_size)}; }
+
+    reference operator[](std::size_t index) { return reference{this, index}; }
+    const_reference operator[](std::size_t index) const { return const_reference{this, index}; }
+
+    reference emplace_back() { return emplace_back(Unit{}); }
+
+    reference emplace_back(const Unit &unit)
+    {
+#define KUSOZAKO_UNIT_PUSH(FieldType, name, init) m_##name.push_back(unit.name);
+        KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_PUSH)
+#undef KUSOZAKO_UNIT_PUSH
+        ++m_size;
+        return (*this)[m_size - 1];
+    }
+
+    void moveElement(std::size_t from, std::size_t to)
+    {
+#define KUSOZAKO_UNIT_MOVE(FieldType, name, init) m_##name[to] = std::move(m_##name[from]);
+        KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_MOVE)
+#undef KUSOZAKO_UNIT_MOVE
+    }
+
+    void eraseRange(std::size_t from, std::size_t to)
+    {
+        const auto first = static_cast<std::ptrdiff_t>(from);
+        const auto last = static_cast<std::ptrdiff_t>(to);
+#define KUSOZAKO_UNIT_ERASE(FieldType, name, init) m_##name.erase(m_##name.begin() + first, m_##name.begin() + last);
+        KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_ERASE)
+#undef KUSOZAKO_UNIT_ERASE
+        m_size -= to - from;
+    }
+
+    void clear()
+    {
+#define KUSOZAKO_UNIT_CLEAR(FieldType, name, init) m_##name.clear();
+        KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_CLEAR)
+#undef KUSOZAKO_UNIT_CLEAR
+        m_size = 0;
+    }
+
+#define KUSOZAKO_UNIT_COLUMN_ACCESSOR(FieldType, name, init)                                                           \
+    UnitColumn<FieldType>::type &name##Column() { return m_##name; }                                                   \
+    const UnitColumn<FieldType>::type &name##Column() const { return m_##name; }
+    KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_COLUMN_ACCESSOR)
+#undef KUSOZAKO_UNIT_COLUMN_ACCESSOR
+
+  private:
+    std::size_t m_size = 0;
+#define KUSOZAKO_UNIT_COLUMN(FieldType, name, init) UnitColumn<FieldType>::type m_##name;
+    KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_COLUMN)
+#undef KUSOZAKO_UNIT_COLUMN
+};
+
+template <bool Const>
+typename UnitColumnIterator<Const>::reference UnitColumnIterator<Const>::operator*() const
+{
+    return (*m_columns)[static_cast<std::size_t>(m_index)];
+}
+
+#define KUSOZAKO_UNIT_REF_ACCESSOR(FieldType, name, init)                                                              \
+    template <bool Const>                                                                                              \
+    std::conditional_t<Const, const FieldType, FieldType> &BasicUnitRef<Const>::name() const                           \
+    {                                                                                                                  \
+        return UnitColumn<FieldType>::at(m_columns->name##Column(), m_index);                                          \
+    }
+KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_REF_ACCESSOR)
+#undef KUSOZAKO_UNIT_REF_ACCESSOR
+
+template <bool Const>
+BasicUnitRef<Const>::operator Unit() const
+{
+    Unit copy;
+#define KUSOZAKO_UNIT_COPY_OUT(FieldType, name, init) copy.name = name();
+    KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_COPY_OUT)
+#undef KUSOZAKO_UNIT_COPY_OUT
+    return copy;
+}
+
+template <bool Const>
+const BasicUnitRef<Const> &BasicUnitRef<Const>::operator=(const Unit &unit) const
+{
+#define KUSOZAKO_UNIT_COPY_IN(FieldType, name, init) name() = unit.name;
+    KUSOZAKO_UNIT_FIELDS(KUSOZAKO_UNIT_COPY_IN)
+#undef KUSOZAKO_UNIT_COPY_IN
+    return *this;
+}
+
+template <>
+struct ComponentStorage<Unit>
+{
+    using type = UnitColumns;
+};
+
+} // namespace world
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "core/Vec2.h"
+#include "world/Entity.h"
+#include "world/SpatialGrid.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace world
+{
+
+// Persistent point index for walls. Walls never move and change a few times per battle, so unlike SpatialGrid this
+// is not rebuilt every tick: each wall is bucketed by its centre cell when it spawns and dropped again when it
+// dies. Entries are keyed by EntityId, so compacting the wall pool does not invalidate them. generation() changes
+// whenever the indexed wall set does, so wall-derived caches can check staleness without rescanning the walls.
+class WallIndex
+{
+  public:
+    static constexpr std::uint32_t None = std::numeric_limits<std::uint32_t>::max();
+
+    // Returns true when the cell layout changed, which empties the index; the caller must re-insert every wall.
+    bool configure(const Vec2 &min, const Vec2 &max, float cellSize)
+    {
+        const std::uint32_t columns = m_grid.columns();
+        const std::uint32_t rows = m_grid.rows();
+        const float previousSize = m_grid.cellSize();
+        const Vec2 previousOrigin = m_grid.origin();
+        m_grid.configure(min, max, cellSize);
+        if (columns == m_grid.columns() && rows == m_grid.rows() && previousSize == m_grid.cellSize() &&
+            previousOrigin.x == m_grid.origin().x && previousOrigin.y == m_grid.origin().y)
+        {
+            return false;
+        }
+        m_cells.assign(static_cast<std::size_t>(m_grid.columns()) * m_grid.rows(), {});
+        std::fill(m_cellOf.begin(), m_cellOf.end(), None);
+        m_count = 0;
+        ++m_generation;
+        return true;
+    }
+
+    void clear()
+    {
+        for (std::vector<Entry> &cell : m_cells)
+        {
+            cell.clear();
+        }
+        std::fill(m_cellOf.begin(), m_cellOf.end(), None);
+        m_count = 0;
+        ++m_generation;
+    }
+
+    void insert(EntityId id, const Vec2 &pos)
+    {
+        if (m_cells.empty())
+        {
+            return;
+        }
+        erase(id);
+        const SpatialGrid::CellRect rect = m_grid.queryRect(pos, 0.0f);
+        const std::uint32_t cell = rect.minY * m_grid.columns() + rect.minX;
+        if (m_cellOf.size() <= id.index)
+        {
+            m_cellOf.resize(static_cast<std::size_t>(id.index) + 1, None);
+        }
+        m_cellOf[id.index] = cell;
+        m_cells[cell].push_back({id, pos});
+        ++m_count;
+        ++m_generation;
+    }
+
+    void erase(EntityId id)
+    {
+        if (id.index >= m_cellOf.size() || m_cellOf[id.index] == None)
+        {
+            return;
+        }
+        std::vector<Entry> &cell = m_cells[m_cellOf[id.index]];
+        const auto found =
+            std::find_if(cell.begin(), cell.end(), [&](const Entry &entry) { return entry.id.index == id.index; });
+        if (found != cell.end())
+        {
+            *found = cell.back();
+            cell.pop_back();
+            --m_count;
+            ++m_generation;
+        }
+        m_cellOf[id.index] = None;
+    }
+
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    std::uint64_t generation() const
+    {
+        return m_generation;
+    }
+
+    // Dense index of the wall whose centre is strictly closer than radius to from, keeping the lowest dense index
+    // on distance ties, or None. denseIndexOf(id) maps an entry to its dense index, or None to skip it.
+    template <typename IndexFn>
+    std::uint32_t nearest(const Vec2 &from, float radius, IndexFn &&denseIndexOf) const
+    {
+        std::uint32_t best = None;
+        float bestDistSq = radius * radius;
+        if (m_cells.empty() || m_count == 0 || radius <= 0.0f)
+        {
+            return best;
+        }
+        const SpatialGrid::CellRect rect = m_grid.queryRect(from, radius);
+        for (std::uint32_t y = rect.minY; y <= rect.maxY; ++y)
+        {
+            const std::size_t row = static_cast<std::size_t>(y) * m_grid.columns();
+            for (std::uint32_t x = rect.minX; x <= rect.maxX; ++x)
+            {
+                for (const Entry &entry : m_cells[row + x])
+                {
+                    const float dx = entry.pos.x - from.x;
+                    const float dy = entry.pos.y - from.y;
+                    const float distSq = dx * dx + dy * dy;
+                    if (distSq > bestDistSq)
+                    {
+                        continue;
+                    }
+                    const std::uint32_t index = denseIndexOf(entry.id);
+                    if (index == None)
+                    {
+                        continue;
+                    }
+                    if (distSq < bestDistSq || (best != None && index < best))
+                    {
+                        bestDistSq = distSq;
+                        best = index;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+  private:
+    struct Entry
+    {
+        EntityId id;
+        Vec2 pos;
+    };
+
+    SpatialGrid m_grid;
+    std::vector<std::vector<Entry>> m_cells;
+    std::vector<std::uint32_t> m_cellOf;
+    std::size_t m_count = 0;
+    std::uint64_t m_generation = 0;
+};
+
+} // namespace world
@@ -0,0 +1,570 @@
+#include "world/WorldSnapshot.h"
+
+#include "world/ByteStream.h"
+#include "world/LegacySimulation.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace world
+{
+
+namespace
+{
+
+constexpr std::array<char, 4> kMagic{'K', 'Z', 'W', 'S'};
+constexpr std::uint16_t kFormatVersion = 1;
+
+std::string_view enemyTypeLabel(EnemyArchetype type)
+{
+    switch (type)
+    {
+    case EnemyArchetype::Wallbreaker: return "wallbreaker";
+    case EnemyArchetype::Boss: return "boss";
+    case EnemyArchetype::Slime:
+    default: return "slime";
+    }
+}
+
+std::string_view resultLabel(GameResult result)
+{
+    switch (result)
+    {
+    case GameResult::Victory: return "victory";
+    case GameResult::Defeat: return "defeat";
+    case GameResult::Playing:
+    default: return "playing";
+    }
+}
+
+std::string_view missionModeLabel(MissionMode mode)
+{
+    switch (mode)
+    {
+    case MissionMode::Boss: return "boss";
+    case MissionMode::Capture: return "capture";
+    case MissionMode::Survival: return "survival";
+    case MissionMode::None:
+    default: return "none";
+    }
+}
+
+const char *boolString(bool value)
+{
+    return value ? "true" : "false";
+}
+
+// JSON string body; gate and zone ids come from mission data and may contain anything.
+std::string escapeJson(std::string_view value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char ch : value)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            escaped.push_back('\\');
+        }
+        if (static_cast<unsigned char>(ch) >= 0x20)
+        {
+            escaped.push_back(ch);
+        }
+    }
+    return escaped;
+}
+
+void writeVec2(ByteWriter &writer, const Vec2 &value)
+{
+    writer.f32(value.x);
+    writer.f32(value.y);
+}
+
+Vec2 readVec2(ByteReader &reader)
+{
+    Vec2 value;
+    value.x = reader.f32();
+    value.y = reader.f32();
+    return value;
+}
+
+// Decoded counts are bounded by the bytes left so a corrupt count cannot trigger a huge allocation.
+bool plausibleCount(std::uint64_t count, const ByteReader &reader, std::size_t size)
+{
+    return reader.ok() && count <= size - reader.offset();
+}
+
+} // namespace
+
+WorldSnapshot captureWorldSnapshot(const LegacySimulation &sim)
+{
+    WorldSnapshot snapshot;
+    snapshot.batch = sim.frameCaptureBatch;
+    snapshot.index = sim.frameCaptureIndex;
+    snapshot.frame = sim.frameCounter;
+    snapshot.simTime = sim.simTime;
+    snapshot.baseHp = sim.baseHp;
+    snapshot.result = sim.result;
+    snapshot.commander = {sim.commander.pos, sim.commander.hp, sim.commander.alive};
+
+    snapshot.yunas.reserve(sim.yunas.size());
+    for (ConstUnitRef yuna : sim.yunas)
+    {
+        snapshot.yunas.push_back({yuna.pos(), yuna.hp(), yuna.radius(), yuna.job().job, yuna.moraleState(),
+                                  yuna.followBySkill(), yuna.followByStance()});
+    }
+    snapshot.enemies.reserve(sim.enemies.size());
+    for (const EnemyUnit &enemy : sim.enemies)
+    {
+        snapshot.enemies.push_back({enemy.pos, enemy.hp, enemy.radius, enemy.type});
+    }
+    snapshot.walls.reserve(sim.walls.size());
+    for (const WallSegment &wall : sim.walls)
+    {
+        snapshot.walls.push_back({wall.pos, wall.hp, wall.life, wall.radius});
+    }
+    snapshot.gates.reserve(sim.gates.size());
+    for (const GateRuntime &gate : sim.gates)
+    {
+        snapshot.gates.push_back({gate.id, gate.pos, gate.radius, gate.hp, gate.maxHp, gate.destroyed});
+    }
+
+    WorldSnapshot::Mission &mission = snapshot.mission;
+    mission.mode = sim.missionMode;
+    mission.timer = sim.missionTimer;
+    mission.victoryCountdown = sim.missionVictoryCountdown;
+    mission.bossActive = sim.boss.active;
+    mission.bossHp = sim.boss.hp;
+    mission.bossMaxHp = sim.boss.maxHp;
+    mission.capturedZones = sim.capturedZones;
+    mission.captureGoal = sim.captureGoal;
+    mission.zones.reserve(sim.captureZones.size());
+    for (const LegacySimulation::CaptureRuntime &zone : sim.captureZones)
+    {
+        mission.zones.push_back({zone.config.id, zone.worldPos, zone.progress, zone.captured});
+    }
+    mission.survivalElapsed = sim.survival.elapsed;
+    mission.survivalDuration = sim.survival.duration;
+    snapshot.rng = sim.rng;
+    return snapshot;
+}
+
+void encodeWorldSnapshot(const WorldSnapshot &snapshot, std::vector<std::uint8_t> &out)
+{
+    out.clear();
+    ByteWriter writer(out);
+    for (char ch : kMagic)
+    {
+        writer.u8(static_cast<std::uint8_t>(ch));
+    }
+    writer.little(kFormatVersion);
+    writer.varint(snapshot.batch);
+    writer.varint(snapshot.index);
+    writer.varint(snapshot.frame);
+    writer.f32(snapshot.simTime);
+    writer.f32(snapshot.baseHp);
+    writer.u8(static_cast<std::uint8_t>(snapshot.result));
+
+    writeVec2(writer, snapshot.commander.pos);
+    writer.f32(snapshot.commander.hp);
+    writer.u8(snapshot.commander.alive ? 1 : 0);
+
+    writer.varint(snapshot.yunas.size());
+    for (const WorldSnapshot::Yuna &yuna : snapshot.yunas)
+    {
+        writeVec2(writer, yuna.pos);
+        writer.f32(yuna.hp);
+        writer.f32(yuna.radius);
+        writer.u8(static_cast<std::uint8_t>(yuna.job));
+        writer.u8(static_cast<std::uint8_t>(yuna.morale));
+        writer.u8(static_cast<std::uint8_t>((yuna.followBySkill ? 1 : 0) | (yuna.followByStance ? 2 : 0)));
+    }
+    writer.varint(snapshot.enemies.size());
+    for (const WorldSnapshot::Enemy &enemy : snapshot.enemies)
+    {
+        writeVec2(writer, enemy.pos);
+        writer.f32(enemy.hp);
+        writer.f32(enemy.radius);
+        writer.u8(static_cast<std::uint8_t>(enemy.type));
+    }
+    writer.varint(snapshot.walls.size());
+    for (const WorldSnapshot::Wall &wall : snapshot.walls)
+    {
+        writeVec2(writer, wall.pos);
+        writer.f32(wall.hp);
+        writer.f32(wall.life);
+        writer.f32(wall.radius);
+    }
+    writer.varint(snapshot.gates.size());
+    for (const WorldSnapshot::Gate &gate : snapshot.gates)
+    {
+        writer.str(gate.id);
+        writeVec2(writer, gate.pos);
+        writer.f32(gate.radius);
+        writer.f32(gate.hp);
+        writer.f32(gate.maxHp);
+        writer.u8(gate.destroyed ? 1 : 0);
+    }
+
+    const WorldSnapshot::Mission &mission = snapshot.mission;
+    writer.u8(static_cast<std::uint8_t>(mission.mode));
+    writer.f32(mission.timer);
+    writer.f32(mission.victoryCountdown);
+    writer.u8(mission.bossActive ? 1 : 0);
+    writer.f32(mission.bossHp);
+    writer.f32(mission.bossMaxHp);
+    writer.zigzag(mission.capturedZones);
+    writer.zigzag(mission.captureGoal);
+    writer.varint(mission.zones.size());
+    for (const WorldSnapshot::CaptureZone &zone : mission.zones)
+    {
+        writer.str(zone.id);
+        writeVec2(writer, zone.pos);
+        writer.f32(zone.progress);
+        writer.u8(zone.captured ? 1 : 0);
+    }
+    writer.f32(mission.survivalElapsed);
+    writer.f32(mission.survivalDuration);
+
+    // The standard only guarantees the textual state of an engine, so that is what gets stored.
+    std::ostringstream rngState;
+    rngState << snapshot.rng;
+    writer.str(rngState.str());
+}
+
+bool decodeWorldSnapshot(const std::vector<std::uint8_t> &data, WorldSnapshot &snapshot, std::string &error)
+{
+    if (data.size() < kMagic.size() + 2 || !std::equal(kMagic.begin(), kMagic.end(), data.begin()))
+    {
+        error = "not a world snapshot";
+        return false;
+    }
+    ByteReader reader(data, kMagic.size());
+    if (reader.little<std::uint16_t>() != kFormatVersion)
+    {
+        error = "unsupported version";
+        return false;
+    }
+
+    snapshot = {};
+    snapshot.batch = reader.varint();
+    snapshot.index = reader.varint();
+    snapshot.frame = reader.varint();
+    snapshot.simTime = reader.f32();
+    snapshot.baseHp = reader.f32();
+    const std::uint8_t result = reader.u8();
+    snapshot.result = result <= static_cast<std::uint8_t>(GameResult::Defeat) ? static_cast<GameResult>(result)
+                                                                                : GameResult::Playing;
+
+    snapshot.commander.pos = readVec2(reader);
+    snapshot.commander.hp = reader.f32();
+    snapshot.commander.alive = reader.u8() != 0;
+
+    std::uint64_t count = reader.varint();
+    if (!plausibleCount(count, reader, data.size()))
+    {
+        error = "corrupt yuna count";
+        return false;
+    }
+    snapshot.yunas.resize(static_cast<std::size_t>(count));
+    for (WorldSnapshot::Yuna &yuna : snapshot.yunas)
+    {
+        yuna.pos = readVec2(reader);
+        yuna.hp = reader.f32();
+        yuna.radius = reader.f32();
+        const std::uint8_t job = reader.u8();
+        const std::uint8_t morale = reader.u8();
+        const std::uint8_t follow = reader.u8();
+        if (job >= UnitJobCount || morale > static_cast<std::uint8_t>(MoraleState::Shielded))
+        {
+            error = "invalid yuna state";
+            return false;
+        }
+        yuna.job = static_cast<UnitJob>(job);
+        yuna.morale = static_cast<MoraleState>(morale);
+        yuna.followBySkill = (follow & 1) != 0;
+        yuna.followByStance = (follow & 2) != 0;
+    }
+
+    count = reader.varint();
+    if (!plausibleCount(count, reader, data.size()))
+    {
+        error = "corrupt enemy count";
+        return false;
+    }
+    snapshot.enemies.resize(static_cast<std::size_t>(count));
+    for (WorldSnapshot::Enemy &enemy : snapshot.enemies)
+    {
+        enemy.pos = readVec2(reader);
+        enemy.hp = reader.f32();
+        enemy.radius = reader.f32();
+        const std::uint8_t type = reader.u8();
+        if (type > static_cast<std::uint8_t>(EnemyArchetype::Boss))
+        {
+            error = "invalid enemy type";
+            return false;
+        }
+        enemy.type = static_cast<EnemyArchetype>(type);
+    }
+
+    count = reader.varint();
+    if (!plausibleCount(count, reader, data.size()))
+    {
+        error = "corrupt wall count";
+        return false;
+    }
+    snapshot.walls.resize(static_cast<std::size_t>(count));
+    for (WorldSnapshot::Wall &wall : snapshot.walls)
+    {
+        wall.pos = readVec2(reader);
+        wall.hp = reader.f32();
+        wall.life = reader.f32();
+        wall.radius = reader.f32();
+    }
+
+    count = reader.varint();
+    if (!plausibleCount(count, reader, data.size()))
+    {
+        error = "corrupt gate count";
+        return false;
+    }
+    snapshot.gates.resize(static_cast<std::size_t>(count));
+    for (WorldSnapshot::Gate &gate : snapshot.gates)
+    {
+        gate.id = reader.str();
+        gate.pos = readVec2(reader);
+        gate.radius = reader.f32();
+        gate.hp = reader.f32();
+        gate.maxHp = reader.f32();
+        gate.destroyed = reader.u8() != 0;
+    }
+
+    WorldSnapshot::Mission &mission = snapshot.mission;
+    const std::uint8_t mode = reader.u8();
+    mission.mode = mode <= static_cast<std::uint8_t>(MissionMode::Survival) ? static_cast<MissionMode>(mode)
+                                                                             : MissionMode::None;
+    mission.timer = reader.f32();
+    mission.victoryCountdown = reader.f32();
+    mission.bossActive = reader.u8() != 0;
+    mission.bossHp = reader.f32();
+    mission.bossMaxHp = reader.f32();
+    mission.capturedZones = static_cast<int>(reader.zigzag());
+    mission.captureGoal = static_cast<int>(reader.zigzag());
+    count = reader.varint();
+    if (!plausibleCount(count, reader, data.size()))
+    {
+        error = "corrupt capture zone count";
+        return false;
+    }
+    mission.zones.resize(static_cast<std::size_t>(count));
+    for (WorldSnapshot::CaptureZone &zone : mission.zones)
+    {
+        zone.id = reader.str();
+        zone.pos = readVec2(reader);
+        zone.progress = reader.f32();
+        zone.captured = reader.u8() != 0;
+    }
+    mission.survivalElapsed = reader.f32();
+    mission.survivalDuration = reader.f32();
+
+    std::istringstream rngState(reader.str());
+    rngState >> snapshot.rng;
+    if (!reader.ok() || rngState.fail())
+    {
+        error = "truncated snapshot";
+        return false;
+    }
+    return true;
+}
+
+void writeWorldSnapshotJson(const WorldSnapshot &snapshot, std::ostream &out)
+{
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\n";
+    out << "  \"batch\": " << snapshot.batch << ",\n";
+    out << "  \"index\": " << snapshot.index << ",\n";
+    out << "  \"frame\": " << snapshot.frame << ",\n";
+    out << "  \"sim_time\": " << snapshot.simTime << ",\n";
+    out << "  \"commander\": {\n";
+    out << "    \"alive\": " << boolString(snapshot.commander.alive) << ",\n";
+    out << "    \"hp\": " << snapshot.commander.hp << ",\n";
+    out << "    \"pos\": {\"x\": " << snapshot.commander.pos.x << ", \"y\": " << snapshot.commander.pos.y << "}\n";
+    out << "  },\n";
+
+    out << "  \"yunas\": [\n";
+    for (std::size_t i = 0; i < snapshot.yunas.size(); ++i)
+    {
+        const WorldSnapshot::Yuna &yuna = snapshot.yunas[i];
+        out << (i > 0 ? ",\n" : "") << "    {\"index\": " << i << ", \"job\": \"" << unitJobToString(yuna.job)
+            << "\", \"hp\": " << yuna.hp << ", \"morale\": \"" << moraleStateLabel(yuna.morale)
+            << "\", \"pos\": {\"x\": " << yuna.pos.x << ", \"y\": " << yuna.pos.y
+            << "}, \"follow_skill\": " << boolString(yuna.followBySkill)
+            << ", \"follow_stance\": " << boolString(yuna.followByStance) << "}";
+    }
+    out << (snapshot.yunas.empty() ? "" : "\n") << "  ],\n";
+
+    out << "  \"enemies\": [\n";
+    for (std::size_t i = 0; i < snapshot.enemies.size(); ++i)
+    {
+        const WorldSnapshot::Enemy &enemy = snapshot.enemies[i];
+        out << (i > 0 ? ",\n" : "") << "    {\"index\": " << i << ", \"type\": \"" << enemyTypeLabel(enemy.type)
+            << "\", \"hp\": " << enemy.hp << ", \"pos\": {\"x\": " << enemy.pos.x << ", \"y\": " << enemy.pos.y
+            << "}, \"radius\": " << enemy.radius << "}";
+    }
+    out << (snapshot.enemies.empty() ? "" : "\n") << "  ],\n";
+
+    out << "  \"walls\": [\n";
+    for (std::size_t i = 0; i < snapshot.walls.size(); ++i)
+    {
+        const WorldSnapshot::Wall &wall = snapshot.walls[i];
+        out << (i > 0 ? ",\n" : "") << "    {\"index\": " << i << ", \"hp\": " << wall.hp << ", \"life\": "
+            << wall.life << ", \"pos\": {\"x\": " << wall.pos.x << ", \"y\": " << wall.pos.y
+            << "}, \"radius\": " << wall.radius << "}";
+    }
+    out << (snapshot.walls.empty() ? "" : "\n") << "  ],\n";
+
+    out << "  \"base\": {\"hp\": " << snapshot.baseHp << ", \"result\": \"" << resultLabel(snapshot.result)
+        << "\"},\n";
+    out << "  \"gates\": [\n";
+    for (std::size_t i = 0; i < snapshot.gates.size(); ++i)
+    {
+        const WorldSnapshot::Gate &gate = snapshot.gates[i];
+        out << (i > 0 ? ",\n" : "") << "    {\"id\": \"" << escapeJson(gate.id) << "\", \"hp\": " << gate.hp
+            << ", \"max_hp\": " << gate.maxHp << ", \"destroyed\": " << boolString(gate.destroyed)
+            << ", \"pos\": {\"x\": " << gate.pos.x << ", \"y\": " << gate.pos.y << "}, \"radius\": " << gate.radius
+            << "}";
+    }
+    out << (snapshot.gates.empty() ? "" : "\n") << "  ],\n";
+
+    const WorldSnapshot::Mission &mission = snapshot.mission;
+    out << "  \"mission\": {\n";
+    out << "    \"mode\": \"" << missionModeLabel(mission.mode) << "\",\n";
+    out << "    \"timer\": " << mission.timer << ",\n";
+    out << "    \"victory_countdown\": " << mission.victoryCountdown << ",\n";
+    out << "    \"boss\": {\"active\": " << boolString(mission.bossActive) << ", \"hp\": " << mission.bossHp
+        << ", \"max_hp\": " << mission.bossMaxHp << "},\n";
+    out << "    \"captured_zones\": " << mission.capturedZones << ",\n";
+    out << "    \"capture_goal\": " << mission.captureGoal << ",\n";
+    out << "    \"zones\": [";
+    for (std::size_t i = 0; i < mission.zones.size(); ++i)
+    {
+        const WorldSnapshot::CaptureZone &zone = mission.zones[i];
+        out << (i > 0 ? ", " : "") << "{\"id\": \"" << escapeJson(zone.id) << "\", \"progress\": " << zone.progress
+            << ", \"captured\": " << boolString(zone.captured) << ", \"pos\": {\"x\": " << zone.pos.x
+            << ", \"y\": " << zone.pos.y << "}}";
+    }
+    out << "],\n";
+    out << "    \"survival\": {\"elapsed\": " << mission.survivalElapsed << ", \"duration\": "
+        << mission.survivalDuration << "}\n";
+    out << "  },\n";
+
+    std::ostringstream rngState;
+    rngState << snapshot.rng;
+    out << "  \"rng\": \"" << rngState.str() << "\"\n";
+    out << "}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void SnapshotWriter::submit(std::filesystem::path path, WorldSnapshot snapshot)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(Job{std::move(path), std::move(snapshot)});
+        if (!m_thread.joinable())
+        {
+            m_thread = std::thread([this]() { run(); });
+        }
+    }
+    m_wake.notify_one();
+}
+
+std::vector<SnapshotWriter::Result> SnapshotWriter::drainResults()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::exchange(m_results, {});
+}
+
+void SnapshotWriter::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_jobs.empty() && !m_busy; });
+}
+
+void SnapshotWriter::run()
+{
+    std::vector<std::uint8_t> buffer;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        // Pending snapshots are still written on shutdown so a capture taken just before exit is not lost.
+        m_wake.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty())
+        {
+            return;
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_busy = true;
+        lock.unlock();
+        Result result = write(job, buffer);
+        lock.lock();
+        m_results.push_back(std::move(result));
+        m_busy = false;
+        if (m_jobs.empty())
+        {
+            m_idle.notify_all();
+        }
+    }
+}
+
+SnapshotWriter::Result SnapshotWriter::write(const Job &job, std::vector<std::uint8_t> &buffer)
+{
+    Result result;
+    result.path = job.path;
+    result.frame = job.snapshot.frame;
+    result.batch = job.snapshot.batch;
+    result.index = job.snapshot.index;
+    result.yunas = job.snapshot.yunas.size();
+    result.enemies = job.snapshot.enemies.size();
+
+    encodeWorldSnapshot(job.snapshot, buffer);
+    std::ofstream stream(job.path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+        result.error = "open_failed";
+        return result;
+    }
+    stream.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    stream.close();
+    if (!stream)
+    {
+        result.error = "write_failed";
+        return result;
+    }
+    result.success = true;
+    result.bytes = buffer.size();
+    return result;
+}
+
+} // namespace world
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "config/AppConfig.h"
+#include "core/Vec2.h"
+#include "world/LegacyTypes.h"
+#include "world/MoraleTypes.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace world
+{
+
+struct LegacySimulation;
+
+// Debug capture of the simulation state: every actor, the gates, mission progress and the RNG. The sim thread
+// only copies into this struct; encoding and file I/O happen on SnapshotWriter's thread.
+struct WorldSnapshot
+{
+    struct Commander
+    {
+        Vec2 pos;
+        float hp = 0.0f;
+        bool alive = false;
+    };
+
+    struct Yuna
+    {
+        Vec2 pos;
+        float hp = 0.0f;
+        float radius = 0.0f;
+        UnitJob job = UnitJob::Warrior;
+        MoraleState morale = MoraleState::Stable;
+        bool followBySkill = false;
+        bool followByStance = false;
+    };
+
+    struct Enemy
+    {
+        Vec2 pos;
+        float hp = 0.0f;
+        float radius = 0.0f;
+        EnemyArchetype type = EnemyArchetype::Slime;
+    };
+
+    struct Wall
+    {
+        Vec2 pos;
+        float hp = 0.0f;
+        float life = 0.0f;
+        float radius = 0.0f;
+    };
+
+    struct Gate
+    {
+        std::string id;
+        Vec2 pos;
+        float radius = 0.0f;
+        float hp = 0.0f;
+        float maxHp = 0.0f;
+        bool destroyed = false;
+    };
+
+    struct CaptureZone
+    {
+        std::string id;
+        Vec2 pos;
+        float progress = 0.0f;
+        bool captured = false;
+    };
+
+    struct Mission
+    {
+        MissionMode mode = MissionMode::None;
+        float timer = 0.0f;
+        float victoryCountdown = -1.0f;
+        bool bossActive = false;
+        float bossHp = 0.0f;
+        float bossMaxHp = 0.0f;
+        int capturedZones = 0;
+        int captureGoal = 0;
+        std::vector<CaptureZone> zones;
+        float survivalElapsed = 0.0f;
+        float survivalDuration = 0.0f;
+    };
+
+    std::uint64_t batch = 0;
+    std::uint64_t index = 0;
+    std::uint64_t frame = 0;
+    float simTime = 0.0f;
+    float baseHp = 0.0f;
+    GameResult result = GameResult::Playing;
+    Commander commander;
+    std::vector<Yuna> yunas;
+    std::vector<Enemy> enemies;
+    std::vector<Wall> walls;
+    std::vector<Gate> gates;
+    Mission mission;
+    std::mt19937 rng;
+};
+
+WorldSnapshot captureWorldSnapshot(const LegacySimulation &sim);
+
+// Versioned binary form (.kzs): "KZWS", u16 version, then the fields of WorldSnapshot in declaration order with
+// varint counts and little-endian floats.
+void encodeWorldSnapshot(const WorldSnapshot &snapshot, std::vector<std::uint8_t> &out);
+bool decodeWorldSnapshot(const std::vector<std::uint8_t> &data, WorldSnapshot &snapshot, std::string &error);
+
+// Writes the frame_capture JSON schema (batch, index, frame, sim_time, commander, yunas, enemies, walls) followed by
+// the sections only the binary format carries: base, gates, mission and rng.
+void writeWorldSnapshotJson(const WorldSnapshot &snapshot, std::ostream &out);
+
+// Encodes and writes snapshots on a background thread so a capture costs the sim thread one copy. Finished writes
+// are collected by the owner with drainResults() and reported from its own thread.
+class SnapshotWriter
+{
+  public:
+    struct Result
+    {
+        std::filesystem::path path;
+        bool success = false;
+        std::string error;
+        std::uintmax_t bytes = 0;
+        std::uint64_t frame = 0;
+        std::uint64_t batch = 0;
+        std::uint64_t index = 0;
+        std::size_t yunas = 0;
+        std::size_t enemies = 0;
+    };
+
+    SnapshotWriter() = default;
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    void submit(std::filesystem::path path, WorldSnapshot snapshot);
+    std::vector<Result> drainResults();
+    // Blocks until every submitted snapshot has been written.
+    void waitIdle();
+
+  private:
+    struct Job
+    {
+        std::filesystem::path path;
+        WorldSnapshot snapshot;
+    };
+
+    void run();
+    static Result write(const Job &job, std::vector<std::uint8_t> &buffer);
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<Job> m_jobs;
+    std::vector<Result> m_results;
+    bool m_busy = false;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+} // namespace world
@@ -0,0 +1,879 @@
+#include "world/WorldState.h"
+
+#include "config/AppConfig.h"
+#include "events/EventBus.h"
+#include "telemetry/TelemetrySink.h"
+#include "telemetry/TraceProfiler.h"
+#include "world/JobScheduler.h"
+#include "world/StateArchive.h"
+#include "world/spawn/Spawner.h"
+#include "world/spawn/WaveController.h"
+#include "world/systems/BehaviorSystem.h"
+#include "world/systems/CombatSystem.h"
+#include "world/systems/CommanderInputSystem.h"
+#include "world/systems/FormationSystem.h"
+#include "world/systems/JobAbilitySystem.h"
+#include "world/systems/MoraleSystem.h"
+#include "world/systems/MovementSystem.h"
+#include "world/systems/RenderingPrepSystem.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace world::systems
+{
+
+class SpawnSystem : public ISystem
+{
+  public:
+    void update(float, SystemContext &) override {}
+
+    const char *name() const override
+    {
+        return "SpawnSystem";
+    }
+};
+
+} // namespace world::systems
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::array<char, 4> kStateMagic{'K', 'Z', 'S', 'T'};
+constexpr std::uint16_t kStateVersion = 2;
+
+template <typename Fn>
+void timeSection(world::SystemTiming &timing, const char *zone, Fn &&fn)
+{
+    KUSOZAKO_TRACE_ZONE(zone);
+    const Clock::time_point started = Clock::now();
+    fn();
+    timing.series.record(std::chrono::duration<double, std::milli>(Clock::now() - started).count());
+}
+
+} // namespace
+
+namespace world
+{
+
+WorldState::WorldState()
+    : m_sim(std::make_unique<LegacySimulation>()),
+      m_captureZones(std::make_unique<ComponentPool<CaptureRuntime>>()),
+      m_waveController(std::make_unique<spawn::WaveController>()),
+      m_spawner(std::make_unique<spawn::Spawner>()),
+      m_frameAllocator()
+{
+    m_waveController->setSpawner(m_spawner.get());
+    m_spawner->setGateChecks(
+        [this](const std::string &gate) {
+            return m_sim->disabledGates.find(gate) != m_sim->disabledGates.end();
+        },
+        [this](const std::string &gate) {
+            if (const GateRuntime *runtime = m_sim->findGate(gate))
+            {
+                return runtime->destroyed;
+            }
+            return false;
+        });
+    initializeSystems();
+}
+
+WorldState::WorldState(WorldState &&other) noexcept = default;
+
+WorldState &WorldState::operator=(WorldState &&other) noexcept = default;
+
+WorldState::~WorldState() = default;
+
+LegacySimulation &WorldState::legacy()
+{
+    return *m_sim;
+}
+
+const LegacySimulation &WorldState::legacy() const
+{
+    return *m_sim;
+}
+
+void WorldState::configure(const AppConfig &appConfig)
+{
+    LegacySimulation &sim = *m_sim;
+    sim = {};
+    sim.config = appConfig.game;
+    sim.temperamentConfig = appConfig.temperament;
+    sim.yunaStats = appConfig.entityCatalog.yuna;
+    sim.slimeStats = appConfig.entityCatalog.slime;
+    sim.wallbreakerStats = appConfig.entityCatalog.wallbreaker;
+    sim.commanderStats = appConfig.entityCatalog.commander;
+    sim.mapDefs = appConfig.mapDefs;
+    sim.spawnScript = appConfig.spawnScript;
+    sim.formationDefaults = appConfig.game.formationDefaults;
+    sim.hasMission = appConfig.mission && appConfig.mission->mode != MissionMode::None;
+    if (sim.hasMission)
+    {
+        sim.missionConfig = *appConfig.mission;
+    }
+    configureSkills(appConfig.skills.empty() ? buildDefaultSkills() : appConfig.skills);
+}
+
+void WorldState::setWorldBounds(float width, float height)
+{
+    m_sim->setWorldBounds(width, height);
+    markComponentsDirty();
+}
+
+void WorldState::configureSkills(const std::vector<SkillDef> &defs)
+{
+    systems::JobAbilitySystem::installDefaultHandlers(defs);
+    m_sim->configureSkills(defs);
+    markComponentsDirty();
+}
+
+void WorldState::reset()
+{
+    m_sim->reset();
+    if (m_spawner)
+    {
+        m_spawner->clear();
+        spawn::SpawnBudget budget;
+        budget.maxPerFrame = m_sim->config.spawnBudget.maxPerFrame;
+        m_spawner->setBudget(budget);
+        m_baseSpawnBudgetMax = budget.maxPerFrame;
+        if (m_enemySpawnMultiplier != 1.0f)
+        {
+            setEnemySpawnMultiplier(m_enemySpawnMultiplier);
+        }
+    }
+    if (m_waveController)
+    {
+        m_waveController->setSpawnScript(m_sim->spawnScript, m_sim->mapDefs);
+    }
+    m_sim->reserveEnemyPool(
+        spawn::estimatePeakEnemies(m_sim->spawnScript, m_sim->config.spawnBudget.enemyLifetime));
+    m_sim->waveScriptComplete = false;
+    m_sim->spawnerIdle = true;
+    if (auto *formation = formationSystem())
+    {
+        formation->reset(*m_sim);
+    }
+    markComponentsDirty();
+}
+
+systems::SystemContext WorldState::makeSystemContext(const ActionBuffer &actions)
+{
+    systems::MissionContext missionContext{
+        m_sim->hasMission,
+        m_sim->missionConfig,
+        m_sim->missionMode,
+        m_sim->missionUI,
+        m_sim->missionFail,
+        m_sim->missionTimer,
+        m_sim->missionVictoryCountdown};
+
+    systems::SystemContext context{
+        *m_sim,
+        m_sim->yunas,
+        m_sim->enemies,
+        m_sim->walls,
+        *m_captureZones,
+        m_sim->commander,
+        m_sim->hud,
+        m_sim->baseHp,
+        m_sim->orderActive,
+        m_sim->orderTimer,
+        m_sim->waveScriptComplete,
+        m_sim->spawnerIdle,
+        m_sim->timeSinceLastEnemySpawn,
+        m_sim->skills,
+        m_sim->selectedSkill,
+        m_sim->rallyState,
+        m_sim->spawnRateMultiplier,
+        m_sim->spawnSlowMultiplier,
+        m_sim->spawnSlowTimer,
+        m_sim->gates,
+        m_sim->yunaRespawns,
+        m_sim->commanderRespawnTimer,
+        m_sim->commanderInvulnTimer,
+        m_frameAllocator,
+        missionContext,
+        actions,
+        m_eventBus,
+        m_telemetry,
+        m_jobScheduler.get()};
+    return context;
+}
+
+void WorldState::initializeSystems()
+{
+    clearSystems();
+
+    auto commanderInput = std::make_unique<systems::CommanderInputSystem>();
+    auto formation = std::make_unique<systems::FormationSystem>();
+    formation->reset(*m_sim);
+    if (m_eventBus)
+    {
+        formation->setEventBus(std::weak_ptr<EventBus>(m_eventBus));
+    }
+    if (m_telemetry)
+    {
+        formation->setTelemetrySink(std::weak_ptr<TelemetrySink>(m_telemetry));
+    }
+
+    auto morale = std::make_unique<systems::MoraleSystem>();
+    auto behavior = std::make_unique<systems::BehaviorSystem>();
+    auto movement = std::make_unique<systems::MovementSystem>();
+    auto combat = std::make_unique<systems::CombatSystem>();
+    auto jobAbility = std::make_unique<systems::JobAbilitySystem>();
+    auto spawn = std::make_unique<systems::SpawnSystem>();
+    auto rendering = std::make_unique<systems::RenderingPrepSystem>();
+
+    registerSystem(systems::SystemStage::InputProcessing, std::move(commanderInput));
+    registerSystem(systems::SystemStage::CommandAndMorale, std::move(formation));
+    registerSystem(systems::SystemStage::CommandAndMorale, std::move(morale));
+    registerSystem(systems::SystemStage::AiDecision, std::move(behavior));
+    registerSystem(systems::SystemStage::Movement, std::move(movement));
+    registerSystem(systems::SystemStage::Combat, std::move(combat));
+    registerSystem(systems::SystemStage::StateUpdate, std::move(jobAbility));
+    registerSystem(systems::SystemStage::Spawn, std::move(spawn));
+    registerSystem(systems::SystemStage::RenderingPrep, std::move(rendering));
+}
+
+void WorldState::clearSystems()
+{
+    m_systems.clear();
+    m_systemStageOrder.clear();
+    m_stepTimings = {};
+    m_cachedFormationSystem = nullptr;
+    m_cachedJobAbilitySystem = nullptr;
+}
+
+void WorldState::registerSystem(systems::SystemStage stage, std::unique_ptr<systems::ISystem> system)
+{
+    if (!system)
+    {
+        return;
+    }
+    if (!m_systemStageOrder.empty())
+    {
+        const systems::SystemStage lastStage = m_systemStageOrder.back();
+        if (static_cast<std::uint8_t>(stage) < static_cast<std::uint8_t>(lastStage))
+        {
+            throw std::logic_error("WorldState::registerSystem stage order violation");
+        }
+    }
+    if (auto *formation = dynamic_cast<systems::FormationSystem *>(system.get()))
+    {
+        m_cachedFormationSystem = formation;
+    }
+    if (auto *jobAbility = dynamic_cast<systems::JobAbilitySystem *>(system.get()))
+    {
+        m_cachedJobAbilitySystem = jobAbility;
+    }
+    m_systemStageOrder.push_back(stage);
+    m_stepTimings.systems.push_back(SystemTiming{system->name(), stage, {}});
+    m_systems.push_back(std::move(system));
+}
+
+const std::vector<systems::SystemStage> &WorldState::systemStageOrder() const
+{
+    return m_systemStageOrder;
+}
+
+const StepTimings &WorldState::stepTimings() const
+{
+    return m_stepTimings;
+}
+
+void WorldState::advanceLegacyState(float dt)
+{
+    if (!m_sim)
+    {
+        return;
+    }
+
+    m_sim->simTime += dt;
+    if (m_sim->timeSinceLastEnemySpawn < 10000.0f)
+    {
+        m_sim->timeSinceLastEnemySpawn += dt;
+    }
+    if (m_sim->restartCooldown > 0.0f)
+    {
+        m_sim->restartCooldown = std::max(0.0f, m_sim->restartCooldown - dt);
+    }
+
+    m_sim->updateYunaSpawn(dt);
+    m_sim->updateCommanderRespawn(dt);
+    m_sim->updateWalls(dt);
+    m_sim->updateMission(dt);
+}
+
+void WorldState::runSpawnStage(float dt)
+{
+    if (!m_sim)
+    {
+        return;
+    }
+
+    if (m_sim->spawnEnabled)
+    {
+        if (m_waveController)
+        {
+            std::vector<std::string> announcements = m_waveController->advance(m_sim->simTime);
+            for (const std::string &text : announcements)
+            {
+                if (!text.empty())
+                {
+                    m_sim->pushTelemetry(text);
+                }
+            }
+        }
+
+        if (m_spawner)
+        {
+            const float survivalMult = (m_sim->missionMode == MissionMode::Survival && m_sim->survival.spawnMultiplier > 0.0f)
+                                           ? std::max(m_sim->survival.spawnMultiplier, 0.1f)
+                                           : 1.0f;
+            const float debugMult = std::max(m_enemySpawnMultiplier, 0.1f);
+            const float combinedMult = std::max(survivalMult * debugMult, 0.1f);
+            if (std::fabs(combinedMult - 1.0f) > 0.0001f)
+            {
+                m_spawner->setIntervalModifier([combinedMult](float base) {
+                    if (combinedMult <= 0.0f)
+                    {
+                        return base;
+                    }
+                    return base / combinedMult;
+                });
+            }
+            else
+            {
+                m_spawner->setIntervalModifier({});
+            }
+
+            const auto emitResult = m_spawner->emit(dt, [this](const spawn::SpawnPayload &payload) {
+                m_sim->spawnOneEnemy(payload.position, payload.type);
+            });
+            if (emitResult.deferred > 0)
+            {
+                m_sim->handleSpawnDeferral(emitResult.deferred);
+            }
+        }
+    }
+
+    if (m_waveController)
+    {
+        m_sim->waveScriptComplete = m_waveController->isComplete();
+    }
+    if (m_spawner)
+    {
+        m_sim->spawnerIdle = m_spawner->empty();
+    }
+}
+
+void WorldState::runSystem(std::size_t index, float dt, systems::SystemContext &context)
+{
+    systems::SystemStage stage = systems::SystemStage::InputProcessing;
+    if (index < m_systemStageOrder.size())
+    {
+        stage = m_systemStageOrder[index];
+    }
+
+    SystemTiming &timing = m_stepTimings.systems[index];
+    switch (stage)
+    {
+    case systems::SystemStage::StateUpdate:
+        timeSection(m_stepTimings.legacyState, "LegacyState", [&]() { advanceLegacyState(dt); });
+        timeSection(timing, m_systems[index]->name(), [&]() { m_systems[index]->update(dt, context); });
+        // Combat, boss slams and wall conversions only tombstone allies; this is where they leave the pool.
+        m_sim->reapYunas();
+        break;
+    case systems::SystemStage::Spawn:
+    {
+        timeSection(timing, m_systems[index]->name(), [&]() { m_systems[index]->update(dt, context); });
+        timeSection(m_stepTimings.spawnStage, "SpawnStage", [&]() { runSpawnStage(dt); });
+        break;
+    }
+    default:
+        timeSection(timing, m_systems[index]->name(), [&]() { m_systems[index]->update(dt, context); });
+        break;
+    }
+}
+
+std::size_t WorldState::concurrentRunEnd(std::size_t begin) const
+{
+    auto runsAlone = [this](std::size_t index) {
+        if (!m_systems[index] || index >= m_systemStageOrder.size())
+        {
+            return true;
+        }
+        // These stages also advance LegacySimulation and the spawner around the system itself.
+        const systems::SystemStage stage = m_systemStageOrder[index];
+        return stage == systems::SystemStage::StateUpdate || stage == systems::SystemStage::Spawn;
+    };
+
+    if (!m_jobScheduler || runsAlone(begin))
+    {
+        return begin + 1;
+    }
+    systems::SystemAccess combined = m_systems[begin]->access();
+    std::size_t end = begin + 1;
+    while (end < m_systems.size() && !runsAlone(end))
+    {
+        const systems::SystemAccess access = m_systems[end]->access();
+        if (access.conflictsWith(combined))
+        {
+            break;
+        }
+        combined.merge(access);
+        ++end;
+    }
+    return end;
+}
+
+void WorldState::step(float dt, const ActionBuffer &actions)
+{
+    KUSOZAKO_TRACE_ZONE("WorldState::step");
+    const Clock::time_point stepStarted = Clock::now();
+    m_frameAllocator.reset();
+    systems::SystemContext context = makeSystemContext(actions);
+
+    std::size_t i = 0;
+    while (i < m_systems.size())
+    {
+        // Consecutive systems whose declared data does not overlap run side by side; anything that conflicts
+        // with an earlier system in the run starts the next one, so registration order still decides the result.
+        const std::size_t end = concurrentRunEnd(i);
+        if (end - i == 1)
+        {
+            if (m_systems[i])
+            {
+                runSystem(i, dt, context);
+            }
+        }
+        else
+        {
+            std::vector<systems::SystemContext> contexts(end - i, context);
+            std::vector<JobScheduler::Task> tasks;
+            tasks.reserve(end - i);
+            for (std::size_t j = i; j < end; ++j)
+            {
+                tasks.emplace_back([this, j, dt, &contexts, i]() { runSystem(j, dt, contexts[j - i]); });
+            }
+            m_jobScheduler->run(tasks);
+        }
+        i = end;
+    }
+
+    std::array<double, systems::kSystemStageCount> stageMs{};
+    for (const SystemTiming *timing : {&m_stepTimings.legacyState, &m_stepTimings.spawnStage})
+    {
+        stageMs[static_cast<std::size_t>(timing->stage)] += timing->series.lastMs();
+    }
+    for (const SystemTiming &timing : m_stepTimings.systems)
+    {
+        stageMs[static_cast<std::size_t>(timing.stage)] += timing.series.lastMs();
+    }
+    for (std::size_t stage = 0; stage < stageMs.size(); ++stage)
+    {
+        m_stepTimings.stages[stage].record(stageMs[stage]);
+    }
+    m_sim->serviceFrameCapture();
+    m_stepTimings.step.record(std::chrono::duration<double, std::milli>(Clock::now() - stepStarted).count());
+}
+
+std::size_t WorldState::frameAllocatorCapacity() const
+{
+    return m_frameAllocator.capacity();
+}
+
+std::size_t WorldState::frameAllocatorUsage() const
+{
+    return m_frameAllocator.used();
+}
+
+void WorldState::setWorkerThreads(std::size_t count)
+{
+    if (count == 0)
+    {
+        m_jobScheduler.reset();
+        return;
+    }
+    if (!m_jobScheduler || m_jobScheduler->workerCount() != count)
+    {
+        m_jobScheduler = std::make_unique<JobScheduler>(count);
+    }
+}
+
+std::size_t WorldState::workerThreads() const
+{
+    return m_jobScheduler ? m_jobScheduler->workerCount() : 0;
+}
+
+void WorldState::issueOrder(ArmyStance stance)
+{
+    if (auto *formation = formationSystem())
+    {
+        formation->issueOrder(stance, *m_sim);
+    }
+    markComponentsDirty();
+}
+
+void WorldState::cycleFormation(int direction)
+{
+    if (auto *formation = formationSystem())
+    {
+        formation->cycleFormation(direction, *m_sim);
+    }
+    markComponentsDirty();
+}
+
+void WorldState::selectSkillByHotkey(int hotkey)
+{
+    m_sim->selectSkillByHotkey(hotkey);
+    markComponentsDirty();
+}
+
+void WorldState::activateSelectedSkill(const Vec2 &worldPos)
+{
+    if (m_cachedJobAbilitySystem)
+    {
+        ActionBuffer emptyActions;
+        systems::SystemContext context = makeSystemContext(emptyActions);
+        systems::SkillCommand command{m_sim->selectedSkill, worldPos};
+        m_cachedJobAbilitySystem->triggerSkill(context, command);
+        m_sim->reapYunas();
+    }
+}
+
+bool WorldState::applyAction(const ActionEvent &event, const Vec2 &cameraOffset)
+{
+    if (!event.pressed && event.id != ActionId::ActivateSkill)
+    {
+        return false;
+    }
+    switch (event.id)
+    {
+    case ActionId::CommanderOrderRushNearest:
+        issueOrder(ArmyStance::RushNearest);
+        break;
+    case ActionId::CommanderOrderPushForward:
+        issueOrder(ArmyStance::PushForward);
+        break;
+    case ActionId::CommanderOrderFollowLeader:
+        issueOrder(ArmyStance::FollowLeader);
+        break;
+    case ActionId::CommanderOrderDefendBase:
+        issueOrder(ArmyStance::DefendBase);
+        break;
+    case ActionId::CycleFormationPrevious:
+        cycleFormation(-1);
+        break;
+    case ActionId::CycleFormationNext:
+        cycleFormation(1);
+        break;
+    case ActionId::RestartScenario:
+        if (m_sim->result != GameResult::Playing && canRestart())
+        {
+            reset();
+            return true;
+        }
+        break;
+    case ActionId::SelectSkill1:
+    case ActionId::SelectSkill2:
+    case ActionId::SelectSkill3:
+    case ActionId::SelectSkill4:
+    case ActionId::SelectSkill5:
+    case ActionId::SelectSkill6:
+    case ActionId::SelectSkill7:
+    case ActionId::SelectSkill8:
+        selectSkillByHotkey(static_cast<int>(event.id) - static_cast<int>(ActionId::SelectSkill1) + 1);
+        break;
+    case ActionId::ActivateSkill:
+        if (event.pointer && event.pointer->pressed)
+        {
+            activateSelectedSkill({static_cast<float>(event.pointer->x) + cameraOffset.x,
+                                   static_cast<float>(event.pointer->y) + cameraOffset.y});
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
+void WorldState::setEventBus(std::shared_ptr<EventBus> bus)
+{
+    m_eventBus = std::move(bus);
+    if (m_waveController)
+    {
+        m_waveController->setEventBus(m_eventBus);
+    }
+    if (auto *formation = formationSystem())
+    {
+        formation->setEventBus(std::weak_ptr<EventBus>(m_eventBus));
+    }
+}
+
+void WorldState::setTelemetrySink(std::shared_ptr<TelemetrySink> sink)
+{
+    m_telemetry = std::move(sink);
+    if (m_sim)
+    {
+        m_sim->setTelemetrySink(std::weak_ptr<TelemetrySink>(m_telemetry));
+    }
+    if (m_waveController)
+    {
+        m_waveController->setTelemetrySink(m_telemetry);
+    }
+    if (auto *formation = formationSystem())
+    {
+        formation->setTelemetrySink(std::weak_ptr<TelemetrySink>(m_telemetry));
+    }
+}
+
+LegacySimulation::SpawnHistoryDumpResult WorldState::dumpSpawnHistory() const
+{
+    if (!m_sim || !m_waveController)
+    {
+        return {};
+    }
+    return m_sim->dumpSpawnHistory(*m_waveController);
+}
+
+void WorldState::saveState(std::vector<std::uint8_t> &out) const
+{
+    out.clear();
+    StateWriter writer(out);
+    for (char ch : kStateMagic)
+    {
+        writer.bytes().u8(static_cast<std::uint8_t>(ch));
+    }
+    writer.bytes().little(kStateVersion);
+    m_sim->saveState(writer);
+    m_spawner->saveState(writer);
+    m_waveController->saveState(writer);
+    writer.bytes().varint(m_systems.size());
+    for (const auto &system : m_systems)
+    {
+        writer.bytes().str(system->name());
+        system->saveState(writer);
+    }
+}
+
+bool WorldState::loadState(const std::vector<std::uint8_t> &data, std::string &error)
+{
+    std::vector<std::uint8_t> previous;
+    saveState(previous);
+    if (restoreState(data, error))
+    {
+        return true;
+    }
+    std::string ignored;
+    restoreState(previous, ignored);
+    return false;
+}
+
+bool WorldState::restoreState(const std::vector<std::uint8_t> &data, std::string &error)
+{
+    if (data.size() < kStateMagic.size() + sizeof(kStateVersion) ||
+        !std::equal(kStateMagic.begin(), kStateMagic.end(), data.begin(),
+                    [](char expected, std::uint8_t actual) { return static_cast<std::uint8_t>(expected) == actual; }))
+    {
+        error = "bad_magic";
+        return false;
+    }
+    StateReader reader(data, kStateMagic.size());
+    if (reader.bytes().little<std::uint16_t>() != kStateVersion)
+    {
+        error = "unsupported_version";
+        return false;
+    }
+
+    m_sim->loadState(reader);
+    m_spawner->loadState(reader);
+    m_waveController->loadState(reader);
+    if (reader.ok() && reader.bytes().varint() != m_systems.size())
+    {
+        reader.fail("systems_mismatch");
+    }
+    for (const auto &system : m_systems)
+    {
+        if (!reader.ok())
+        {
+            break;
+        }
+        if (reader.bytes().str() != system->name())
+        {
+            reader.fail("systems_mismatch");
+            break;
+        }
+        system->loadState(reader);
+    }
+    markComponentsDirty();
+    if (reader.ok() && !reader.bytes().atEnd())
+    {
+        reader.fail("trailing_data");
+    }
+    error = reader.error();
+    return reader.ok();
+}
+
+bool WorldState::canRestart() const
+{
+    return m_sim->canRestart();
+}
+
+ComponentPool<Unit> &WorldState::allies()
+{
+    return m_sim->yunas;
+}
+
+const ComponentPool<Unit> &WorldState::allies() const
+{
+    return m_sim->yunas;
+}
+
+ComponentPool<EnemyUnit> &WorldState::enemies()
+{
+    return m_sim->enemies;
+}
+
+const ComponentPool<EnemyUnit> &WorldState::enemies() const
+{
+    return m_sim->enemies;
+}
+
+ComponentPool<WallSegment> &WorldState::walls()
+{
+    return m_sim->walls;
+}
+
+const ComponentPool<WallSegment> &WorldState::walls() const
+{
+    return m_sim->walls;
+}
+
+ComponentPool<CaptureRuntime> &WorldState::missionZones()
+{
+    syncComponents();
+    return *m_captureZones;
+}
+
+const ComponentPool<CaptureRuntime> &WorldState::missionZones() const
+{
+    return const_cast<WorldState *>(this)->missionZones();
+}
+
+void WorldState::markComponentsDirty()
+{
+    m_componentsDirty = true;
+}
+
+void WorldState::setEnemySpawnMultiplier(float multiplier)
+{
+    const float clamped = std::clamp(multiplier, 0.1f, 5.0f);
+    m_enemySpawnMultiplier = clamped;
+    if (m_spawner)
+    {
+        const int baseBudget = m_baseSpawnBudgetMax > 0 ? m_baseSpawnBudgetMax : m_sim->config.spawnBudget.maxPerFrame;
+        const float effective = std::max(clamped, 0.1f);
+        const int adjustedBudget = std::max(1, static_cast<int>(std::round(static_cast<float>(baseBudget) * effective)));
+        spawn::SpawnBudget budget;
+        budget.maxPerFrame = adjustedBudget;
+        m_spawner->setBudget(budget);
+    }
+    markComponentsDirty();
+}
+
+float WorldState::enemySpawnMultiplier() const
+{
+    return m_enemySpawnMultiplier;
+}
+
+bool WorldState::skipNextWave()
+{
+    if (!m_waveController)
+    {
+        return false;
+    }
+    std::vector<std::string> announcements;
+    const bool triggered = m_waveController->triggerNextWave(m_sim->simTime, announcements);
+    if (!triggered)
+    {
+        return false;
+    }
+    for (const std::string &text : announcements)
+    {
+        if (!text.empty())
+        {
+            m_sim->pushTelemetry(text);
+        }
+    }
+    markComponentsDirty();
+    return true;
+}
+
+void WorldState::syncMissionComponents() const
+{
+    std::vector<CaptureRuntime> &zones = m_sim->captureZones;
+    std::vector<std::uint32_t> &changed = m_sim->changedCaptureZones;
+    if (m_componentsDirty || m_sim->captureZonesRebuilt || m_captureZones->size() != zones.size())
+    {
+        if (m_captureZones->size() > zones.size())
+        {
+            m_captureZones->resize(zones.size());
+        }
+        for (std::size_t i = 0; i < zones.size(); ++i)
+        {
+            if (i < m_captureZones->size())
+            {
+                (*m_captureZones)[i] = zones[i];
+            }
+            else
+            {
+                m_captureZones->push_back(zones[i]);
+            }
+        }
+    }
+    else
+    {
+        // Only the zones the simulation reported as changed; the rest of the mirror is already current.
+        for (std::uint32_t index : changed)
+        {
+            (*m_captureZones)[index] = zones[index];
+        }
+    }
+    for (std::uint32_t index : changed)
+    {
+        m_sim->captureZoneChanged[index] = 0;
+    }
+    changed.clear();
+    m_sim->captureZonesRebuilt = false;
+}
+
+void WorldState::syncComponents() const
+{
+    if (!m_captureZones)
+    {
+        m_captureZones = std::make_unique<ComponentPool<CaptureRuntime>>();
+    }
+
+    syncMissionComponents();
+
+    m_componentsDirty = false;
+}
+
+systems::FormationSystem *WorldState::formationSystem() const
+{
+    return m_cachedFormationSystem;
+}
+
+} // namespace world
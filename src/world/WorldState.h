@@ -4,11 +4,15 @@
 #include "world/Entity.h"
 #include "world/FrameAllocator.h"
 #include "world/LegacySimulation.h"
+#include "world/StepTimings.h"
 #include "world/systems/SystemContext.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
+struct AppConfig;
 struct GameConfig;
 struct SkillDef;
 struct Vec2;
@@ -34,8 +38,7 @@ class TelemetrySink;
 namespace world
 {
 
-template <typename T>
-class ComponentPool;
+class JobScheduler;
 
 using CaptureRuntime = LegacySimulation::CaptureRuntime;
 
@@ -67,6 +70,9 @@ class WorldState
     LegacySimulation &legacy();
     const LegacySimulation &legacy() const;
 
+    // Replaces the simulation with a fresh one built from appConfig: game settings, unit stats, maps, spawn script,
+    // mission and skills. World bounds, worker threads and the final reset() are left to the caller.
+    void configure(const AppConfig &appConfig);
     void setWorldBounds(float width, float height);
     void configureSkills(const std::vector<SkillDef> &defs);
     void reset();
@@ -75,12 +81,22 @@ class WorldState
     void cycleFormation(int direction);
     void selectSkillByHotkey(int hotkey);
     void activateSelectedSkill(const Vec2 &worldPos);
+    // Applies one simulation-affecting action event: orders, formation cycling, skill selection, pointer skill
+    // activation (screen position + cameraOffset) and restarting a finished scenario. UI-only events are ignored.
+    // Returns true when the event restarted the scenario.
+    bool applyAction(const ActionEvent &event, const Vec2 &cameraOffset);
 
     void setEventBus(std::shared_ptr<EventBus> bus);
     void setTelemetrySink(std::shared_ptr<TelemetrySink> sink);
 
     LegacySimulation::SpawnHistoryDumpResult dumpSpawnHistory() const;
 
+    // Mid-battle save/restore: the simulation, spawner queues, wave cursor and history, and per-system state, in a
+    // versioned binary form ("KZST"). Configuration is not included; a state only loads into a world configured
+    // the same way. A failed load leaves the world as it was and reports why in error.
+    void saveState(std::vector<std::uint8_t> &out) const;
+    bool loadState(const std::vector<std::uint8_t> &data, std::string &error);
+
     bool canRestart() const;
 
     ComponentPool<Unit> &allies();
@@ -92,6 +108,8 @@ class WorldState
     ComponentPool<CaptureRuntime> &missionZones();
     const ComponentPool<CaptureRuntime> &missionZones() const;
 
+    // missionZones() mirrors LegacySimulation::captureZones, patching only the zones the simulation reported as
+    // changed. markComponentsDirty() forces a full recopy after captureZones was edited behind its back.
     void markComponentsDirty();
     void syncComponents() const;
 
@@ -102,16 +120,18 @@ class WorldState
     void clearSystems();
     void registerSystem(systems::SystemStage stage, std::unique_ptr<systems::ISystem> system);
     const std::vector<systems::SystemStage> &systemStageOrder() const;
+    // Rolling wall-clock timings of every system, stage and the whole step, updated by step().
+    const StepTimings &stepTimings() const;
 
     std::size_t frameAllocatorCapacity() const;
     std::size_t frameAllocatorUsage() const;
 
+    // Worker threads used by step(); 0 runs every system and unit loop on the calling thread.
+    void setWorkerThreads(std::size_t count);
+    std::size_t workerThreads() const;
+
   private:
     std::unique_ptr<LegacySimulation> m_sim;
-    mutable EntityRegistry m_registry;
-    mutable std::unique_ptr<ComponentPool<Unit>> m_allies;
-    mutable std::unique_ptr<ComponentPool<EnemyUnit>> m_enemies;
-    mutable std::unique_ptr<ComponentPool<WallSegment>> m_walls;
     mutable std::unique_ptr<ComponentPool<CaptureRuntime>> m_captureZones;
     mutable bool m_componentsDirty = true;
 
@@ -121,17 +141,22 @@ class WorldState
     std::unique_ptr<spawn::Spawner> m_spawner;
     std::vector<std::unique_ptr<systems::ISystem>> m_systems;
     std::vector<systems::SystemStage> m_systemStageOrder;
+    StepTimings m_stepTimings;
     systems::FormationSystem *m_cachedFormationSystem = nullptr;
     systems::JobAbilitySystem *m_cachedJobAbilitySystem = nullptr;
     FrameAllocator m_frameAllocator;
+    std::unique_ptr<JobScheduler> m_jobScheduler;
     float m_enemySpawnMultiplier = 1.0f;
     int m_baseSpawnBudgetMax = 0;
 
-    void rebuildMissionComponents() const;
+    void syncMissionComponents() const;
+    bool restoreState(const std::vector<std::uint8_t> &data, std::string &error);
     systems::SystemContext makeSystemContext(const ActionBuffer &actions);
     void initializeSystems();
     void advanceLegacyState(float dt);
-    void runSpawnStage(float dt, systems::SystemContext &context);
+    void runSpawnStage(float dt);
+    void runSystem(std::size_t index, float dt, systems::SystemContext &context);
+    std::size_t concurrentRunEnd(std::size_t begin) const;
     systems::FormationSystem *formationSystem() const;
 };
 
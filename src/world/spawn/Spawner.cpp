@@ -1,5 +1,7 @@
 #include "world/spawn/Spawner.h"
 
+#include "world/StateArchive.h"
+
 #include <algorithm>
 #include <utility>
 
@@ -204,5 +206,35 @@ Spawner::EmitResult Spawner::emit(float dt, const SpawnCallback &callback)
     return result;
 }
 
+template <typename Archive, typename Self>
+void Spawner::transferState(Archive &archive, Self &self)
+{
+    archive.sequence(self.m_queues, [&](auto &queue) {
+        archive.field(queue.gateId);
+        archive.sequence(queue.spawns, [&](auto &spawn) {
+            archive.field(spawn.position);
+            archive.field(spawn.type);
+            archive.field(spawn.remaining);
+            archive.field(spawn.interval);
+            archive.field(spawn.timer);
+        });
+    });
+}
+
+void Spawner::saveState(StateWriter &out) const
+{
+    transferState(out, *this);
+}
+
+void Spawner::loadState(StateReader &in)
+{
+    transferState(in, *this);
+    m_indexByGate.clear();
+    for (std::size_t i = 0; i < m_queues.size(); ++i)
+    {
+        m_indexByGate[m_queues[i].gateId] = i;
+    }
+}
+
 } // namespace world::spawn
 
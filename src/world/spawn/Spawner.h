@@ -8,6 +8,12 @@
 #include "config/AppConfig.h"
 #include "core/Vec2.h"
 
+namespace world
+{
+class StateReader;
+class StateWriter;
+} // namespace world
+
 namespace world::spawn
 {
 
@@ -57,7 +63,14 @@ class Spawner
 
     bool empty() const;
 
+    // Pending spawns per gate. The budget, gate checks and interval modifier are configuration and are kept.
+    void saveState(StateWriter &out) const;
+    void loadState(StateReader &in);
+
   private:
+    template <typename Archive, typename Self>
+    static void transferState(Archive &archive, Self &self);
+
     struct ActiveSpawn
     {
         Vec2 position{};
@@ -1,9 +1,11 @@
 #include "world/spawn/WaveController.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "events/EventBus.h"
 #include "telemetry/TelemetrySink.h"
+#include "world/StateArchive.h"
 
 namespace world::spawn
 {
@@ -15,6 +17,40 @@ Vec2 tileToWorld(const Vec2 &tile, int tileSize)
 }
 } // namespace
 
+std::size_t estimatePeakEnemies(const SpawnScript &script, float enemyLifetime)
+{
+    std::vector<float> spawnTimes;
+    for (const Wave &wave : script.waves)
+    {
+        for (const SpawnSet &set : wave.sets)
+        {
+            const float interval = std::max(set.interval, 0.0f);
+            for (int k = 0; k < set.count; ++k)
+            {
+                spawnTimes.push_back(wave.time + static_cast<float>(k) * interval);
+            }
+        }
+    }
+    if (enemyLifetime <= 0.0f)
+    {
+        return spawnTimes.size();
+    }
+
+    // An enemy spawned at t is counted as alive over [t, t + enemyLifetime).
+    std::sort(spawnTimes.begin(), spawnTimes.end());
+    std::size_t peak = 0;
+    std::size_t oldest = 0;
+    for (std::size_t newest = 0; newest < spawnTimes.size(); ++newest)
+    {
+        while (spawnTimes[newest] - spawnTimes[oldest] >= enemyLifetime)
+        {
+            ++oldest;
+        }
+        peak = std::max(peak, newest - oldest + 1);
+    }
+    return peak;
+}
+
 WaveController::WaveController() = default;
 
 void WaveController::setSpawner(Spawner *spawner)
@@ -204,4 +240,43 @@ void WaveController::recordHistory(std::size_t index, const Wave &wave, float tr
     }
 }
 
+template <typename Archive, typename Self>
+void WaveController::transferState(Archive &archive, Self &self)
+{
+    archive.field(self.m_nextWave);
+    archive.sequence(self.m_history, [&](auto &entry) {
+        archive.field(entry.index);
+        archive.field(entry.scheduledTime);
+        archive.field(entry.triggerTime);
+        std::int64_t ticks = entry.wallClock.time_since_epoch().count();
+        archive.field(ticks);
+        if constexpr (Archive::kLoading)
+        {
+            entry.wallClock = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(ticks));
+        }
+        archive.field(entry.telemetry);
+        archive.sequence(entry.sets, [&](auto &set) {
+            archive.field(set.gate);
+            archive.field(set.count);
+            archive.field(set.interval);
+            archive.field(set.typeId);
+            archive.field(set.type);
+        });
+    });
+}
+
+void WaveController::saveState(StateWriter &out) const
+{
+    transferState(out, *this);
+}
+
+void WaveController::loadState(StateReader &in)
+{
+    transferState(in, *this);
+    if (m_nextWave > m_script.waves.size())
+    {
+        in.fail("wave_cursor_invalid");
+    }
+}
+
 } // namespace world::spawn
@@ -25,6 +25,12 @@ struct WaveEvent
     std::string telemetry;
 };
 
+// Most enemies alive at once while script plays out, assuming each lives enemyLifetime seconds: every scripted
+// spawn is placed on the timeline (a set's k-th enemy at wave time + k * interval) and the busiest window of that
+// length is counted. A non-positive lifetime assumes none die and counts every spawn. Sets with a non-positive
+// count spawn nothing.
+std::size_t estimatePeakEnemies(const SpawnScript &script, float enemyLifetime);
+
 class WaveController
 {
   public:
@@ -55,7 +61,14 @@ class WaveController
     std::vector<WaveHistoryEntry> historySnapshot() const;
     void setHistoryLimit(std::size_t limit);
 
+    // Script cursor and history. The script itself is configuration and must match the one saved with.
+    void saveState(StateWriter &out) const;
+    void loadState(StateReader &in);
+
   private:
+    template <typename Archive, typename Self>
+    static void transferState(Archive &archive, Self &self);
+
     std::optional<Vec2> resolveGateWorld(const std::string &gateId) const;
     void notifyWave(std::size_t index, const Wave &wave) const;
     void recordHistory(std::size_t index, const Wave &wave, float triggerTime);
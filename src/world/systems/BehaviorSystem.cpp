@@ -1,13 +1,17 @@
 #include "world/systems/BehaviorSystem.h"
 
 #include "core/Vec2.h"
+#include "world/FrameAllocator.h"
+#include "world/JobScheduler.h"
 #include "world/LegacySimulation.h"
+#include "world/StateArchive.h"
 
 #include <algorithm>
 #include <cmath>
-#include <functional>
+#include <cstdint>
 #include <limits>
 #include <random>
+#include <string>
 #include <vector>
 #include <type_traits>
 
@@ -18,32 +22,191 @@ namespace
 {
 
 constexpr float kMoraleIgnoreDecisionInterval = 0.6f;
+constexpr std::size_t kUnitsPerJob = 256;
 
-template <typename Container>
-Vec2 computeTemperamentVelocity(LegacySimulation &sim,
-                                Unit &yuna,
-                                float dt,
-                                float baseSpeed,
-                                const std::function<EnemyUnit *(const Vec2 &)> &nearestEnemy,
-                                const std::function<EnemyUnit *(const Vec2 &)> &nearestEnemyUnbounded,
-                                const Container &raidTargets)
+// Nearest-enemy lookups for the unit currently deciding. The kernels below take it as a template parameter, so
+// the ProximityIndex query inlines into each of them instead of going through std::function. nearest() honours
+// the deciding unit's morale detection radius; nearestUnbounded() ignores it.
+class EnemyQuery
 {
-    static_assert(std::is_same_v<typename Container::value_type, Vec2>,
-                  "raidTargets container must hold Vec2 values");
-    TemperamentState &state = yuna.temperament;
-    if (!state.definition)
+  public:
+    EnemyQuery(const ProximityIndex &index, ComponentPool<EnemyUnit> &enemies, float baseDetectionRadius)
+        : m_index(index), m_enemies(enemies), m_baseDetectionRadius(baseDetectionRadius)
     {
-        return {0.0f, 0.0f};
     }
-    const TemperamentDefinition &def = *state.definition;
 
-    const float moraleMultiplier = std::max(0.01f, yuna.moraleSpeedMultiplier);
-    const float effectiveBaseSpeed = baseSpeed * moraleMultiplier;
+    void setDetectionUnit(const UnitRef *unit)
+    {
+        m_detectionUnit = unit;
+    }
 
-    TemperamentConfig &temperamentConfig = sim.temperamentConfig;
-    CommanderUnit &commander = sim.commander;
-    const Vec2 &basePos = sim.basePos;
+    const ProximityIndex &index() const
+    {
+        return m_index;
+    }
+
+    EnemyUnit *nearest(const Vec2 &pos) const
+    {
+        if (m_detectionUnit && m_baseDetectionRadius > 0.0f)
+        {
+            const float mul = std::max(0.0f, m_detectionUnit->moraleDetectionRadiusMultiplier());
+            float limitSq = 0.0f;
+            if (mul > 0.0f)
+            {
+                const float radius = m_baseDetectionRadius * mul;
+                limitSq = radius * radius;
+            }
+            const Vec2 detectionPos = m_detectionUnit->pos();
+            if (mul <= 0.0f || lengthSq(pos - detectionPos) <= limitSq + 0.0001f)
+            {
+                auto detected = [&](std::uint32_t index) {
+                    return alive(index) && lengthSq(m_enemies[index].pos - detectionPos) <= limitSq + 0.0001f;
+                };
+                // Querying from the detecting unit itself lets the detection radius prune the search.
+                const std::uint32_t best =
+                    pos.x == detectionPos.x && pos.y == detectionPos.y
+                        ? m_index.nearest(pos, std::sqrt(limitSq + 0.0001f) * 1.001f, detected)
+                        : m_index.nearest(pos, detected);
+                return best == ProximityIndex::None ? nullptr : &m_enemies[best];
+            }
+        }
+        return nearestUnbounded(pos);
+    }
+
+    EnemyUnit *nearestUnbounded(const Vec2 &pos) const
+    {
+        const std::uint32_t best = m_index.nearest(pos, [&](std::uint32_t index) { return alive(index); });
+        return best == ProximityIndex::None ? nullptr : &m_enemies[best];
+    }
+
+    EnemyUnit *tagged(LegacySimulation &sim, const Vec2 &pos, const std::vector<std::string> &tags) const
+    {
+        return sim.findTargetByTags(pos, tags, m_index);
+    }
+
+  private:
+    const ProximityIndex &m_index;
+    ComponentPool<EnemyUnit> &m_enemies;
+    float m_baseDetectionRadius = 0.0f;
+    const UnitRef *m_detectionUnit = nullptr;
+
+    bool alive(std::uint32_t index) const
+    {
+        return m_enemies[index].hp > 0.0f;
+    }
+};
+
+// Which EnemyChoice target a lookup reads and refreshes. Lookups from anywhere but the unit itself are all made
+// from the base.
+enum class EnemyChoiceSlot : std::uint8_t
+{
+    Self,
+    Base,
+    Unbounded,
+    Tagged,
+};
+
+// EnemyQuery behind the decision schedule. A unit that decides this tick searches as usual and records what it
+// found in its EnemyChoice; any other unit gets the enemies it found last time, at their current positions, and
+// only searches again when one of them has died or the lookup is new to it. Without a schedule every lookup
+// searches, exactly like EnemyQuery.
+class ScheduledEnemyQuery
+{
+  public:
+    ScheduledEnemyQuery(const EnemyQuery &live,
+                        ComponentPool<EnemyUnit> &enemies,
+                        EnemyChoice *const *choices,
+                        const std::uint8_t *deciding)
+        : m_live(live), m_enemies(enemies), m_choices(choices), m_deciding(deciding)
+    {
+    }
+
+    // unit is the ally at dense index index, or nullptr between units.
+    void setUnit(const UnitRef *unit, std::size_t index)
+    {
+        m_live.setDetectionUnit(unit);
+        m_unit = unit;
+        m_choice = unit && m_choices ? m_choices[index] : nullptr;
+        m_decidingNow = !m_choice || m_deciding[index] != 0;
+    }
+
+    const ProximityIndex &index() const
+    {
+        return m_live.index();
+    }
 
+    EnemyUnit *nearest(const Vec2 &pos) const
+    {
+        const bool fromSelf = m_unit && pos.x == m_unit->pos().x && pos.y == m_unit->pos().y;
+        return lookup(fromSelf ? EnemyChoiceSlot::Self : EnemyChoiceSlot::Base, [&] { return m_live.nearest(pos); });
+    }
+
+    EnemyUnit *nearestUnbounded(const Vec2 &pos) const
+    {
+        return lookup(EnemyChoiceSlot::Unbounded, [&] { return m_live.nearestUnbounded(pos); });
+    }
+
+    EnemyUnit *tagged(LegacySimulation &sim, const Vec2 &pos, const std::vector<std::string> &tags) const
+    {
+        return lookup(EnemyChoiceSlot::Tagged, [&] { return m_live.tagged(sim, pos, tags); });
+    }
+
+  private:
+    EnemyQuery m_live;
+    ComponentPool<EnemyUnit> &m_enemies;
+    EnemyChoice *const *m_choices = nullptr;
+    const std::uint8_t *m_deciding = nullptr;
+    const UnitRef *m_unit = nullptr;
+    EnemyChoice *m_choice = nullptr;
+    bool m_decidingNow = true;
+
+    template <typename Search>
+    EnemyUnit *lookup(EnemyChoiceSlot slot, Search &&search) const
+    {
+        if (!m_choice)
+        {
+            return search();
+        }
+        const std::size_t s = static_cast<std::size_t>(slot);
+        const std::uint8_t bit = static_cast<std::uint8_t>(1u << s);
+        EntityId &target = m_choice->targets[s];
+        if (!m_decidingNow && (m_choice->known & bit) != 0)
+        {
+            if (target.generation == 0)
+            {
+                return nullptr;
+            }
+            if (m_enemies.has(target))
+            {
+                EnemyUnit &enemy = m_enemies[m_enemies.indexOf(target)];
+                if (enemy.hp > 0.0f)
+                {
+                    return &enemy;
+                }
+            }
+        }
+        EnemyUnit *found = search();
+        target = found ? m_enemies.entityAt(static_cast<std::size_t>(found - &m_enemies.front())) : EntityId{};
+        m_choice->known = static_cast<std::uint8_t>(m_choice->known | bit);
+        return found;
+    }
+};
+
+// Timers the behaviour kernels read, sampled before this tick's decrement.
+struct TemperamentTick
+{
+    float dashTime = 0.0f;
+    float catchupTime = 0.0f;
+    bool panicking = false;
+    // Asleep or crying: the unit stands still this tick.
+    bool idle = false;
+};
+
+// Resolves this tick's behaviour (rolling Mimic over to its next pick) and advances the temperament timers.
+TemperamentTick advanceTemperament(LegacySimulation &sim, TemperamentState &state, const TemperamentDefinition &def,
+                                   float dt)
+{
+    TemperamentConfig &temperamentConfig = sim.temperamentConfig;
     if (def.behavior == TemperamentBehavior::Mimic)
     {
         if (state.mimicActive)
@@ -101,17 +264,18 @@ Vec2 computeTemperamentVelocity(LegacySimulation &sim,
         state.lastBehavior = state.currentBehavior;
     }
 
-    float dashTime = state.chargeDashTimer;
+    TemperamentTick tick;
+    tick.dashTime = state.chargeDashTimer;
     if (state.chargeDashTimer > 0.0f)
     {
         state.chargeDashTimer = std::max(0.0f, state.chargeDashTimer - dt);
     }
-    float catchupTime = state.catchupTimer;
+    tick.catchupTime = state.catchupTimer;
     if (state.catchupTimer > 0.0f)
     {
         state.catchupTimer = std::max(0.0f, state.catchupTimer - dt);
     }
-    bool panicking = state.panicTimer > 0.0f;
+    tick.panicking = state.panicTimer > 0.0f;
     if (state.panicTimer > 0.0f)
     {
         state.panicTimer = std::max(0.0f, state.panicTimer - dt);
@@ -171,353 +335,498 @@ Vec2 computeTemperamentVelocity(LegacySimulation &sim,
         state.crying = false;
     }
 
-    if (state.sleeping || state.crying)
+    tick.idle = state.sleeping || state.crying;
+    return tick;
+}
+
+void ensureWander(LegacySimulation &sim, TemperamentState &state)
+{
+    if (state.wanderTimer <= 0.0f || lengthSq(state.wanderDirection) < 0.0001f)
     {
-        return {0.0f, 0.0f};
+        state.wanderDirection = sim.randomUnitVector();
+        state.wanderTimer = sim.randomRange(sim.temperamentConfig.wanderTurnInterval);
     }
+}
 
-    if (panicking)
+// Closest raid target to pos, left in target. Returns false (target untouched) when there is none.
+template <typename Container>
+bool nearestRaidTarget(const Container &raidTargets, const Vec2 &pos, Vec2 &target)
+{
+    static_assert(std::is_same_v<typename Container::value_type, Vec2>,
+                  "raidTargets container must hold Vec2 values");
+    float best = std::numeric_limits<float>::max();
+    for (const Vec2 &candidate : raidTargets)
     {
-        if (EnemyUnit *threat = nearestEnemy(yuna.pos))
+        const float distSq = lengthSq(candidate - pos);
+        if (distSq < best)
         {
-            Vec2 dir = normalize(yuna.pos - threat->pos);
-            if (lengthSq(dir) > 0.0f)
-            {
-                return dir * effectiveBaseSpeed;
-            }
+            best = distSq;
+            target = candidate;
         }
     }
+    return best != std::numeric_limits<float>::max();
+}
 
-    float speed = effectiveBaseSpeed;
-    auto ensureWander = [&]() {
-        if (state.wanderTimer <= 0.0f || lengthSq(state.wanderDirection) < 0.0001f)
-        {
-            state.wanderDirection = sim.randomUnitVector();
-            state.wanderTimer = sim.randomRange(temperamentConfig.wanderTurnInterval);
-        }
-    };
-    if (state.wanderTimer > 0.0f)
+// Behaviour kernels. Each returns the desired velocity for one unit that is awake and not fleeing in panic.
+
+template <typename Query, typename Container>
+Vec2 chargeNearest(const Query &query, const Container &raidTargets, const Vec2 &pos, const Vec2 &basePos,
+                   float speed, float dashSpeed)
+{
+    if (EnemyUnit *target = query.nearestUnbounded(pos))
     {
-        state.wanderTimer = std::max(0.0f, state.wanderTimer - dt);
+        return normalize(target->pos - pos) * dashSpeed;
     }
-
-    switch (state.currentBehavior)
+    Vec2 fallback = basePos;
+    nearestRaidTarget(raidTargets, pos, fallback);
+    Vec2 dir = normalize(fallback - pos);
+    if (lengthSq(dir) < 0.0001f)
     {
-    case TemperamentBehavior::ChargeNearest:
+        dir = normalize(basePos - pos);
+    }
+    return dir * speed;
+}
+
+template <typename Query>
+Vec2 fleeNearest(const Query &query, const Vec2 &pos, const Vec2 &basePos, float fearRadius, float speed)
+{
+    if (EnemyUnit *threat = query.nearest(pos))
     {
-        if (EnemyUnit *target = nearestEnemyUnbounded(yuna.pos))
+        if (fearRadius <= 0.0f || lengthSq(threat->pos - pos) <= fearRadius * fearRadius)
         {
-            Vec2 dir = normalize(target->pos - yuna.pos);
-            if (dashTime > 0.0f)
-            {
-                speed *= temperamentConfig.chargeDash.multiplier;
-            }
-            return dir * speed;
-        }
-        Vec2 fallback = basePos;
-        float closest = std::numeric_limits<float>::max();
-        for (const Vec2 &candidate : raidTargets)
-        {
-            const float distSq = lengthSq(candidate - yuna.pos);
-            if (distSq < closest)
+            Vec2 dir = normalize(pos - threat->pos);
+            if (lengthSq(dir) > 0.0f)
             {
-                closest = distSq;
-                fallback = candidate;
+                return dir * speed;
             }
         }
-        Vec2 dir = normalize(fallback - yuna.pos);
-        if (lengthSq(dir) < 0.0001f)
-        {
-            dir = normalize(basePos - yuna.pos);
-        }
-        return dir * speed;
     }
-    case TemperamentBehavior::FleeNearest:
+    return normalize(basePos - pos) * speed;
+}
+
+Vec2 followYuna(const LegacySimulation &sim, TemperamentState &state, const Vec2 &pos, float catchupTime,
+                float speed)
+{
+    const TemperamentConfig &temperamentConfig = sim.temperamentConfig;
+    const CommanderUnit &commander = sim.commander;
+    Vec2 target = commander.alive ? commander.pos : sim.basePos;
+    Vec2 toTarget = target - pos;
+    const float distSq = lengthSq(toTarget);
+    if (commander.alive &&
+        distSq > temperamentConfig.followCatchup.distance * temperamentConfig.followCatchup.distance)
     {
-        if (EnemyUnit *threat = nearestEnemy(yuna.pos))
+        if (state.catchupTimer <= 0.0f)
         {
-            const float fear = temperamentConfig.fearRadius;
-            if (fear <= 0.0f || lengthSq(threat->pos - yuna.pos) <= fear * fear)
-            {
-                Vec2 dir = normalize(yuna.pos - threat->pos);
-                if (lengthSq(dir) > 0.0f)
-                {
-                    return dir * speed;
-                }
-            }
+            state.catchupTimer = temperamentConfig.followCatchup.duration;
         }
-        Vec2 dir = normalize(basePos - yuna.pos);
-        return dir * speed;
+        catchupTime = std::max(catchupTime, state.catchupTimer);
     }
-    case TemperamentBehavior::FollowYuna:
+    if (catchupTime > 0.0f || state.catchupTimer > 0.0f)
     {
-        Vec2 target = commander.alive ? commander.pos : basePos;
-        Vec2 toTarget = target - yuna.pos;
-        const float distSq = lengthSq(toTarget);
-        if (commander.alive &&
-            distSq > temperamentConfig.followCatchup.distance * temperamentConfig.followCatchup.distance)
-        {
-            if (state.catchupTimer <= 0.0f)
-            {
-                state.catchupTimer = temperamentConfig.followCatchup.duration;
-            }
-            catchupTime = std::max(catchupTime, state.catchupTimer);
-        }
-        if (catchupTime > 0.0f || state.catchupTimer > 0.0f)
-        {
-            speed *= temperamentConfig.followCatchup.multiplier;
-        }
-        if (distSq > 1.0f)
-        {
-            return normalize(toTarget) * speed;
-        }
-        return Vec2{0.0f, 0.0f};
+        speed *= temperamentConfig.followCatchup.multiplier;
     }
-    case TemperamentBehavior::RaidGate:
+    if (distSq > 1.0f)
     {
-        Vec2 target = basePos;
-        float best = std::numeric_limits<float>::max();
-        for (const Vec2 &candidate : raidTargets)
-        {
-            const float distSq = lengthSq(candidate - yuna.pos);
-            if (distSq < best)
-            {
-                best = distSq;
-                target = candidate;
-            }
-        }
-        if (best == std::numeric_limits<float>::max())
-        {
-            if (EnemyUnit *enemy = nearestEnemy(yuna.pos))
-            {
-                target = enemy->pos;
-            }
-        }
-        Vec2 dir = normalize(target - yuna.pos);
-        return dir * speed;
+        return normalize(toTarget) * speed;
     }
-    case TemperamentBehavior::Homebound:
+    return Vec2{0.0f, 0.0f};
+}
+
+template <typename Query, typename Container>
+Vec2 raidGate(const Query &query, const Container &raidTargets, const Vec2 &pos, const Vec2 &basePos, float speed)
+{
+    Vec2 target = basePos;
+    if (!nearestRaidTarget(raidTargets, pos, target))
     {
-        const float homeRadius = def.homeRadius > 0.0f ? def.homeRadius : 48.0f;
-        const float avoidRadius = def.avoidEnemyRadius > 0.0f ? def.avoidEnemyRadius : homeRadius * 2.0f;
-        Vec2 toBase = basePos - yuna.pos;
-        if (lengthSq(toBase) > homeRadius * homeRadius)
+        if (EnemyUnit *enemy = query.nearest(pos))
         {
-            return normalize(toBase) * speed;
+            target = enemy->pos;
         }
-        if (EnemyUnit *threat = nearestEnemy(basePos))
+    }
+    return normalize(target - pos) * speed;
+}
+
+template <typename Query>
+Vec2 homebound(LegacySimulation &sim, TemperamentState &state, const TemperamentDefinition &def, const Query &query,
+               const Vec2 &pos, float speed)
+{
+    const Vec2 &basePos = sim.basePos;
+    const float homeRadius = def.homeRadius > 0.0f ? def.homeRadius : 48.0f;
+    const float avoidRadius = def.avoidEnemyRadius > 0.0f ? def.avoidEnemyRadius : homeRadius * 2.0f;
+    Vec2 toBase = basePos - pos;
+    if (lengthSq(toBase) > homeRadius * homeRadius)
+    {
+        return normalize(toBase) * speed;
+    }
+    if (EnemyUnit *threat = query.nearest(basePos))
+    {
+        if (lengthSq(threat->pos - basePos) <= avoidRadius * avoidRadius)
         {
-            if (lengthSq(threat->pos - basePos) <= avoidRadius * avoidRadius)
+            Vec2 away = basePos - threat->pos;
+            if (lengthSq(away) > 0.0f)
             {
-                Vec2 away = basePos - threat->pos;
-                if (lengthSq(away) > 0.0f)
-                {
-                    Vec2 target = basePos + normalize(away) * std::max(homeRadius, 8.0f);
-                    return normalize(target - yuna.pos) * speed;
-                }
+                Vec2 target = basePos + normalize(away) * std::max(homeRadius, 8.0f);
+                return normalize(target - pos) * speed;
             }
         }
-        ensureWander();
-        Vec2 wander = normalize(state.wanderDirection);
-        Vec2 desired = normalize(wander * homeRadius + toBase * 0.3f);
-        if (lengthSq(desired) < 0.0001f)
+    }
+    ensureWander(sim, state);
+    Vec2 wander = normalize(state.wanderDirection);
+    Vec2 desired = normalize(wander * homeRadius + toBase * 0.3f);
+    if (lengthSq(desired) < 0.0001f)
+    {
+        desired = normalize(toBase);
+    }
+    return desired * speed;
+}
+
+Vec2 wander(LegacySimulation &sim, TemperamentState &state, float speed)
+{
+    ensureWander(sim, state);
+    return normalize(state.wanderDirection) * speed;
+}
+
+template <typename Query>
+Vec2 guardBase(LegacySimulation &sim, TemperamentState &state, const Query &query, const Vec2 &pos, float speed)
+{
+    const Vec2 &basePos = sim.basePos;
+    const float guardRadius = sim.mapDefs.tile_size * 22.0f;
+    if (EnemyUnit *target = query.nearest(basePos))
+    {
+        if (lengthSq(target->pos - basePos) <= guardRadius * guardRadius)
         {
-            desired = normalize(toBase);
+            return normalize(target->pos - pos) * speed;
         }
-        return desired * speed;
     }
-    case TemperamentBehavior::Wander:
-    case TemperamentBehavior::Doze:
+    ensureWander(sim, state);
+    Vec2 dir = normalize(state.wanderDirection);
+    Vec2 guardTarget{basePos.x + dir.x * 120.0f, basePos.y + dir.y * 80.0f};
+    return normalize(guardTarget - pos) * speed;
+}
+
+template <typename Query>
+Vec2 targetTag(LegacySimulation &sim, const TemperamentDefinition &def, const Query &query, const Vec2 &pos,
+               float speed)
+{
+    if (EnemyUnit *target = query.tagged(sim, pos, def.targetTags))
     {
-        ensureWander();
-        Vec2 dir = normalize(state.wanderDirection);
-        return dir * speed;
+        return normalize(target->pos - pos) * speed;
     }
-    case TemperamentBehavior::GuardBase:
+    if (EnemyUnit *enemy = query.nearest(pos))
     {
-        const float guardRadius = sim.mapDefs.tile_size * 22.0f;
-        if (EnemyUnit *target = nearestEnemy(basePos))
+        return normalize(enemy->pos - pos) * speed;
+    }
+    return normalize(sim.basePos - pos) * speed;
+}
+
+// Homebound, GuardBase and the wander family may refresh their wander heading from sim.rng, so they have to run
+// in unit order. Every other kernel only reads shared state and writes its own unit.
+constexpr bool drawsRandom(TemperamentBehavior behavior)
+{
+    return behavior == TemperamentBehavior::Homebound || behavior == TemperamentBehavior::Wander ||
+           behavior == TemperamentBehavior::Doze || behavior == TemperamentBehavior::GuardBase ||
+           behavior == TemperamentBehavior::Mimic;
+}
+
+// The temperament velocity of an awake unit whose behaviour resolved to Behavior this tick. speed already
+// includes the morale multiplier.
+template <TemperamentBehavior Behavior, typename Query, typename Container>
+Vec2 steer(LegacySimulation &sim,
+           UnitRef yuna,
+           float dt,
+           float speed,
+           const TemperamentTick &tick,
+           const Query &query,
+           const Container &raidTargets)
+{
+    TemperamentState &state = yuna.temperament();
+    const TemperamentDefinition &def = *state.definition;
+    const Vec2 pos = yuna.pos();
+    if (tick.panicking)
+    {
+        if (EnemyUnit *threat = query.nearest(pos))
         {
-            if (lengthSq(target->pos - basePos) <= guardRadius * guardRadius)
+            Vec2 dir = normalize(pos - threat->pos);
+            if (lengthSq(dir) > 0.0f)
             {
-                return normalize(target->pos - yuna.pos) * speed;
+                return dir * speed;
             }
         }
-        ensureWander();
-        Vec2 dir = normalize(state.wanderDirection);
-        Vec2 guardTarget{basePos.x + dir.x * 120.0f, basePos.y + dir.y * 80.0f};
-        return normalize(guardTarget - yuna.pos) * speed;
     }
-    case TemperamentBehavior::TargetTag:
+
+    if (state.wanderTimer > 0.0f)
     {
-        if (EnemyUnit *target = sim.findTargetByTags(yuna.pos, def.targetTags))
-        {
-            return normalize(target->pos - yuna.pos) * speed;
-        }
-        if (EnemyUnit *enemy = nearestEnemy(yuna.pos))
-        {
-            return normalize(enemy->pos - yuna.pos) * speed;
-        }
-        Vec2 dir = normalize(basePos - yuna.pos);
-        return dir * speed;
+        state.wanderTimer = std::max(0.0f, state.wanderTimer - dt);
     }
-    case TemperamentBehavior::Mimic:
+
+    const TemperamentConfig &temperamentConfig = sim.temperamentConfig;
+    if constexpr (Behavior == TemperamentBehavior::ChargeNearest)
+    {
+        const float dashSpeed = tick.dashTime > 0.0f ? speed * temperamentConfig.chargeDash.multiplier : speed;
+        return chargeNearest(query, raidTargets, pos, sim.basePos, speed, dashSpeed);
+    }
+    else if constexpr (Behavior == TemperamentBehavior::FleeNearest)
     {
-        ensureWander();
-        Vec2 dir = normalize(state.wanderDirection);
-        return dir * speed;
+        return fleeNearest(query, pos, sim.basePos, temperamentConfig.fearRadius, speed);
     }
+    else if constexpr (Behavior == TemperamentBehavior::FollowYuna)
+    {
+        return followYuna(sim, state, pos, tick.catchupTime, speed);
+    }
+    else if constexpr (Behavior == TemperamentBehavior::RaidGate)
+    {
+        return raidGate(query, raidTargets, pos, sim.basePos, speed);
+    }
+    else if constexpr (Behavior == TemperamentBehavior::Homebound)
+    {
+        return homebound(sim, state, def, query, pos, speed);
+    }
+    else if constexpr (Behavior == TemperamentBehavior::GuardBase)
+    {
+        return guardBase(sim, state, query, pos, speed);
+    }
+    else if constexpr (Behavior == TemperamentBehavior::TargetTag)
+    {
+        return targetTag(sim, def, query, pos, speed);
+    }
+    else
+    {
+        return wander(sim, state, speed);
+    }
+}
+
+template <typename Query, typename Container>
+Vec2 steerTemperament(TemperamentBehavior behavior,
+                      LegacySimulation &sim,
+                      UnitRef yuna,
+                      float dt,
+                      float speed,
+                      const TemperamentTick &tick,
+                      const Query &query,
+                      const Container &raidTargets)
+{
+    switch (behavior)
+    {
+    case TemperamentBehavior::ChargeNearest:
+        return steer<TemperamentBehavior::ChargeNearest>(sim, yuna, dt, speed, tick, query, raidTargets);
+    case TemperamentBehavior::FleeNearest:
+        return steer<TemperamentBehavior::FleeNearest>(sim, yuna, dt, speed, tick, query, raidTargets);
+    case TemperamentBehavior::FollowYuna:
+        return steer<TemperamentBehavior::FollowYuna>(sim, yuna, dt, speed, tick, query, raidTargets);
+    case TemperamentBehavior::RaidGate:
+        return steer<TemperamentBehavior::RaidGate>(sim, yuna, dt, speed, tick, query, raidTargets);
+    case TemperamentBehavior::Homebound:
+        return steer<TemperamentBehavior::Homebound>(sim, yuna, dt, speed, tick, query, raidTargets);
+    case TemperamentBehavior::Wander:
+    case TemperamentBehavior::Doze:
+    case TemperamentBehavior::Mimic:
+        return steer<TemperamentBehavior::Wander>(sim, yuna, dt, speed, tick, query, raidTargets);
+    case TemperamentBehavior::GuardBase:
+        return steer<TemperamentBehavior::GuardBase>(sim, yuna, dt, speed, tick, query, raidTargets);
+    case TemperamentBehavior::TargetTag:
+        return steer<TemperamentBehavior::TargetTag>(sim, yuna, dt, speed, tick, query, raidTargets);
     }
     return {0.0f, 0.0f};
 }
 
+// Runs one behaviour bucket over units [begin, end) of indices. Each call gets its own query, since the query
+// tracks the deciding unit.
+template <TemperamentBehavior Behavior, typename Query, typename Container, typename Ticks, typename Velocities>
+void steerBucket(LegacySimulation &sim,
+                 ComponentPool<Unit> &yunas,
+                 const std::uint32_t *indices,
+                 std::size_t count,
+                 float dt,
+                 float baseSpeed,
+                 const Ticks &ticks,
+                 Query query,
+                 const Container &raidTargets,
+                 Velocities &velocities)
+{
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        const std::uint32_t i = indices[n];
+        UnitRef yuna = yunas[i];
+        query.setUnit(&yuna, i);
+        const float speed = baseSpeed * std::max(0.01f, yuna.moraleSpeedMultiplier());
+        velocities[i] = steer<Behavior>(sim, yuna, dt, speed, ticks[i], query, raidTargets);
+    }
+}
+
 } // namespace
 
 void BehaviorSystem::update(float dt, SystemContext &context)
 {
     LegacySimulation &sim = context.simulation;
     CommanderUnit &commander = context.commander;
-    auto &yunas = context.yunaUnits;
-    auto &enemies = context.enemyUnits;
+    auto &yunas = context.allies;
+    auto &enemies = context.enemies;
 
     const float yunaSpeedPx = sim.yunaStats.speed_u_s * sim.config.pixels_per_unit;
     const float followerSnapDistSq = 16.0f;
 
     const std::size_t totalFollowers =
-        std::count_if(yunas.begin(), yunas.end(), [](const Unit &unit) { return unit.effectiveFollower; });
+        std::count_if(yunas.begin(), yunas.end(), [](ConstUnitRef unit) { return unit.effectiveFollower(); });
     const std::size_t totalDefenders = yunas.size() > totalFollowers ? yunas.size() - totalFollowers : 0;
     const std::size_t safeDefenders = totalDefenders > 0 ? totalDefenders : 1;
     std::size_t defendIndex = 0;
     std::size_t supportIndex = 0;
 
-    Unit *detectionUnit = nullptr;
     const float baseDetectionRadius = std::max(sim.config.morale.detectionRadius, 0.0f);
 
-    auto nearestEnemy = [&](const Vec2 &pos) -> EnemyUnit * {
-        EnemyUnit *best = nullptr;
-        float bestDist = std::numeric_limits<float>::max();
-        float limitSq = -1.0f;
-        bool applyLimit = false;
-        if (detectionUnit && baseDetectionRadius > 0.0f)
-        {
-            const float mul = std::max(0.0f, detectionUnit->moraleDetectionRadiusMultiplier);
-            if (mul > 0.0f)
-            {
-                const float radius = baseDetectionRadius * mul;
-                limitSq = radius * radius;
-                applyLimit = lengthSq(pos - detectionUnit->pos) <= limitSq + 0.0001f;
-            }
-            else
-            {
-                limitSq = 0.0f;
-                applyLimit = true;
-            }
-        }
-        for (EnemyUnit &enemy : enemies)
+    m_enemyIndex.build(sim.worldMin, sim.worldMax, enemies.size(), [&](std::size_t i) { return enemies[i].pos; });
+    const std::size_t unitCount = yunas.size();
+    FrameAllocator::Allocator<std::uint8_t> decidingAlloc(context.frameAllocator);
+    FrameVector<std::uint8_t> deciding(decidingAlloc);
+    FrameAllocator::Allocator<EnemyChoice *> choiceAlloc(context.frameAllocator);
+    FrameVector<EnemyChoice *> choices(choiceAlloc);
+    m_lastDecisionCount = scheduleDecisions(context, deciding, choices);
+    ScheduledEnemyQuery query(EnemyQuery(m_enemyIndex, enemies, baseDetectionRadius), enemies,
+                              choices.empty() ? nullptr : choices.data(), deciding.data());
+
+    FrameAllocator::Allocator<Vec2> raidAlloc(context.frameAllocator);
+    std::vector<Vec2, FrameAllocator::Allocator<Vec2>> raidTargets(raidAlloc);
+    sim.collectRaidTargets(raidTargets);
+
+    // Decisions run in three passes. The first walks the units in order and does everything that draws from
+    // sim.rng: it resolves each unit's behaviour (Mimic rollovers included), runs the kernels that may refresh a
+    // wander heading, and rolls order-ignoring, so the rng sequence matches a single loop. The other units are
+    // bucketed by behaviour and each bucket runs as one loop, split across threads. The last pass applies
+    // retreat, formation and stance orders in unit order.
+    FrameAllocator::Allocator<TemperamentTick> tickAlloc(context.frameAllocator);
+    FrameVector<TemperamentTick> ticks(unitCount, TemperamentTick{}, tickAlloc);
+    FrameAllocator::Allocator<Vec2> velocityAlloc(context.frameAllocator);
+    FrameVector<Vec2> temperamentVelocities(unitCount, Vec2{0.0f, 0.0f}, velocityAlloc);
+    for (std::vector<std::uint32_t> &bucket : m_behaviorBuckets)
+    {
+        bucket.clear();
+    }
+
+    for (std::size_t i = 0; i < unitCount; ++i)
+    {
+        UnitRef yuna = yunas[i];
+        yuna.desiredVelocity() = {0.0f, 0.0f};
+        yuna.hasDesiredVelocity() = false;
+        TemperamentState &state = yuna.temperament();
+        if (state.definition)
         {
-            if (enemy.hp <= 0.0f)
-            {
-                continue;
-            }
-            const float dist = lengthSq(enemy.pos - pos);
-            if (applyLimit)
+            ticks[i] = advanceTemperament(sim, state, *state.definition, dt);
+            if (!ticks[i].idle)
             {
-                const float unitDistSq = lengthSq(enemy.pos - detectionUnit->pos);
-                if (unitDistSq > limitSq + 0.0001f)
+                if (drawsRandom(state.currentBehavior))
                 {
-                    continue;
+                    query.setUnit(&yuna, i);
+                    const float speed = yunaSpeedPx * std::max(0.01f, yuna.moraleSpeedMultiplier());
+                    temperamentVelocities[i] =
+                        steerTemperament(state.currentBehavior, sim, yuna, dt, speed, ticks[i], query, raidTargets);
+                }
+                else
+                {
+                    m_behaviorBuckets[static_cast<std::size_t>(state.currentBehavior)].push_back(
+                        static_cast<std::uint32_t>(i));
                 }
-            }
-            if (dist < bestDist)
-            {
-                bestDist = dist;
-                best = &enemy;
             }
         }
-        return best;
-    };
 
-    auto nearestEnemyUnbounded = [&](const Vec2 &pos) -> EnemyUnit * {
-        EnemyUnit *best = nullptr;
-        float bestDist = std::numeric_limits<float>::max();
-        for (EnemyUnit &enemy : enemies)
+        const float effectiveIgnoreChance =
+            std::clamp(yuna.moraleIgnoreOrdersChance() - yuna.moraleCommandObeyBonus(), 0.0f, 1.0f);
+        const float decisionInterval =
+            kMoraleIgnoreDecisionInterval * std::max(0.01f, yuna.moraleRetargetCooldownMultiplier());
+        if (effectiveIgnoreChance > 0.0f)
         {
-            if (enemy.hp <= 0.0f)
+            if (yuna.moraleIgnoreOrdersTimer() <= 0.0f)
             {
-                continue;
+                std::uniform_real_distribution<float> roll(0.0f, 1.0f);
+                yuna.moraleIgnoringOrders() = roll(sim.rng) < effectiveIgnoreChance;
+                yuna.moraleIgnoreOrdersTimer() = decisionInterval;
             }
-            const float dist = lengthSq(enemy.pos - pos);
-            if (dist < bestDist)
+            else
             {
-                bestDist = dist;
-                best = &enemy;
+                yuna.moraleIgnoreOrdersTimer() = std::max(0.0f, yuna.moraleIgnoreOrdersTimer() - dt);
             }
         }
-        return best;
-    };
+        else
+        {
+            yuna.moraleIgnoringOrders() = false;
+            yuna.moraleIgnoreOrdersTimer() = 0.0f;
+        }
+    }
+    query.setUnit(nullptr, 0);
 
-    FrameAllocator::Allocator<Vec2> raidAlloc(context.frameAllocator);
-    std::vector<Vec2, FrameAllocator::Allocator<Vec2>> raidTargets(raidAlloc);
-    sim.collectRaidTargets(raidTargets);
+    for (std::size_t b = 0; b < m_behaviorBuckets.size(); ++b)
+    {
+        const std::vector<std::uint32_t> &bucket = m_behaviorBuckets[b];
+        auto runChunk = [&](std::size_t begin, std::size_t end) {
+            const std::uint32_t *indices = bucket.data() + begin;
+            const std::size_t count = end - begin;
+            switch (static_cast<TemperamentBehavior>(b))
+            {
+            case TemperamentBehavior::ChargeNearest:
+                steerBucket<TemperamentBehavior::ChargeNearest>(sim, yunas, indices, count, dt, yunaSpeedPx, ticks,
+                                                                query, raidTargets, temperamentVelocities);
+                break;
+            case TemperamentBehavior::FleeNearest:
+                steerBucket<TemperamentBehavior::FleeNearest>(sim, yunas, indices, count, dt, yunaSpeedPx, ticks,
+                                                              query, raidTargets, temperamentVelocities);
+                break;
+            case TemperamentBehavior::FollowYuna:
+                steerBucket<TemperamentBehavior::FollowYuna>(sim, yunas, indices, count, dt, yunaSpeedPx, ticks,
+                                                             query, raidTargets, temperamentVelocities);
+                break;
+            case TemperamentBehavior::RaidGate:
+                steerBucket<TemperamentBehavior::RaidGate>(sim, yunas, indices, count, dt, yunaSpeedPx, ticks,
+                                                           query, raidTargets, temperamentVelocities);
+                break;
+            case TemperamentBehavior::TargetTag:
+                steerBucket<TemperamentBehavior::TargetTag>(sim, yunas, indices, count, dt, yunaSpeedPx, ticks,
+                                                            query, raidTargets, temperamentVelocities);
+                break;
+            default:
+                break;
+            }
+        };
+        if (context.jobs)
+        {
+            context.jobs->parallelFor(bucket.size(), kUnitsPerJob, runChunk);
+        }
+        else
+        {
+            runChunk(0, bucket.size());
+        }
+    }
 
-    for (std::size_t i = 0; i < yunas.size(); ++i)
+    for (std::size_t i = 0; i < unitCount; ++i)
     {
-        Unit &yuna = yunas[i];
-        yuna.desiredVelocity = {0.0f, 0.0f};
-        yuna.hasDesiredVelocity = false;
-        const float unitSpeed = yunaSpeedPx * std::max(0.01f, yuna.moraleSpeedMultiplier);
+        UnitRef yuna = yunas[i];
+        const float unitSpeed = yunaSpeedPx * std::max(0.01f, yuna.moraleSpeedMultiplier());
         const bool immobilized =
-            yuna.job.endlag > 0.0f || yuna.job.warrior.stumbleTimer > 0.0f || yuna.job.archer.holdTimer > 0.0f;
+            yuna.job().endlag > 0.0f || yuna.job().warrior.stumbleTimer > 0.0f || yuna.job().archer.holdTimer > 0.0f;
         float jobSpeedMultiplier = 1.0f;
-        if (yuna.job.shield.selfSlowTimer > 0.0f)
+        if (yuna.job().shield.selfSlowTimer > 0.0f)
         {
             jobSpeedMultiplier *= std::clamp(sim.config.shieldJob.selfSlowMultiplier, 0.0f, 1.0f);
         }
-        const float retreatSpeedMultiplier = yuna.moraleRetreatActive
-                                                 ? std::max(yuna.moraleRetreatSpeedMultiplier, 0.0f)
+        const float retreatSpeedMultiplier = yuna.moraleRetreatActive()
+                                                 ? std::max(yuna.moraleRetreatSpeedMultiplier(), 0.0f)
                                                  : 1.0f;
         float effectiveSpeed = immobilized ? 0.0f : unitSpeed * jobSpeedMultiplier * retreatSpeedMultiplier;
-        detectionUnit = &yuna;
-        Vec2 temperamentVelocity =
-            computeTemperamentVelocity(sim, yuna, dt, yunaSpeedPx, nearestEnemy, nearestEnemyUnbounded, raidTargets);
+        query.setUnit(&yuna, i);
+        const Vec2 temperamentVelocity = temperamentVelocities[i];
         Vec2 velocity{0.0f, 0.0f};
-        const bool panicActive = yuna.temperament.panicTimer > 0.0f;
+        const bool panicActive = yuna.temperament().panicTimer > 0.0f;
 
-        const bool retreatActive = yuna.moraleRetreatActive;
-
-        const float effectiveIgnoreChance =
-            std::clamp(yuna.moraleIgnoreOrdersChance - yuna.moraleCommandObeyBonus, 0.0f, 1.0f);
-        const float decisionInterval =
-            kMoraleIgnoreDecisionInterval * std::max(0.01f, yuna.moraleRetargetCooldownMultiplier);
-        if (effectiveIgnoreChance > 0.0f)
-        {
-            if (yuna.moraleIgnoreOrdersTimer <= 0.0f)
-            {
-                std::uniform_real_distribution<float> roll(0.0f, 1.0f);
-                yuna.moraleIgnoringOrders = roll(sim.rng) < effectiveIgnoreChance;
-                yuna.moraleIgnoreOrdersTimer = decisionInterval;
-            }
-            else
-            {
-                yuna.moraleIgnoreOrdersTimer = std::max(0.0f, yuna.moraleIgnoreOrdersTimer - dt);
-            }
-        }
-        else
-        {
-            yuna.moraleIgnoringOrders = false;
-            yuna.moraleIgnoreOrdersTimer = 0.0f;
-        }
+        const bool retreatActive = yuna.moraleRetreatActive();
 
         if (retreatActive)
         {
             Vec2 retreatDir{0.0f, 0.0f};
             Vec2 away{0.0f, 0.0f};
-            if (EnemyUnit *threat = nearestEnemy(yuna.pos))
+            if (EnemyUnit *threat = query.nearest(yuna.pos()))
             {
-                away = normalize(yuna.pos - threat->pos);
+                away = normalize(yuna.pos() - threat->pos);
             }
-            Vec2 toBase = normalize(sim.basePos - yuna.pos);
-            const float bias = std::clamp(yuna.moraleRetreatHomewardBias, 0.0f, 1.0f);
+            Vec2 toBase = normalize(sim.basePos - yuna.pos());
+            const float bias = std::clamp(yuna.moraleRetreatHomewardBias(), 0.0f, 1.0f);
             if (lengthSq(away) > 0.0f && bias < 1.0f)
             {
                 retreatDir += away * (1.0f - bias);
@@ -539,10 +848,10 @@ void BehaviorSystem::update(float dt, SystemContext &context)
         {
             velocity = temperamentVelocity;
         }
-        else if (yuna.effectiveFollower && commander.alive)
+        else if (yuna.effectiveFollower() && commander.alive)
         {
-            Vec2 desiredPos = commander.pos + yuna.formationOffset;
-            Vec2 toTarget = desiredPos - yuna.pos;
+            Vec2 desiredPos = commander.pos + yuna.formationOffset();
+            Vec2 toTarget = desiredPos - yuna.pos();
             if (lengthSq(toTarget) > followerSnapDistSq)
             {
                 velocity = normalize(toTarget) * unitSpeed;
@@ -552,15 +861,15 @@ void BehaviorSystem::update(float dt, SystemContext &context)
                 velocity = temperamentVelocity;
             }
         }
-        else if (context.orderActive && !yuna.moraleIgnoringOrders)
+        else if (context.orderActive && !yuna.moraleIgnoringOrders())
         {
             switch (sim.stance)
             {
             case ArmyStance::RushNearest:
             {
-                if (EnemyUnit *target = nearestEnemy(yuna.pos))
+                if (EnemyUnit *target = query.nearest(yuna.pos()))
                 {
-                    velocity = normalize(target->pos - yuna.pos) * unitSpeed;
+                    velocity = normalize(target->pos - yuna.pos()) * unitSpeed;
                 }
                 else
                 {
@@ -572,7 +881,7 @@ void BehaviorSystem::update(float dt, SystemContext &context)
             {
                 Vec2 target = sim.basePos;
                 target.x += 512.0f;
-                velocity = normalize(target - yuna.pos) * unitSpeed;
+                velocity = normalize(target - yuna.pos()) * unitSpeed;
                 break;
             }
             case ArmyStance::FollowLeader:
@@ -582,7 +891,7 @@ void BehaviorSystem::update(float dt, SystemContext &context)
             }
             case ArmyStance::DefendBase:
             {
-                if (EnemyUnit *target = nearestEnemy(sim.basePos))
+                if (EnemyUnit *target = query.nearest(sim.basePos))
                 {
                     const float dist = lengthSq(target->pos - sim.basePos);
                     if (dist > 0.0f)
@@ -592,11 +901,11 @@ void BehaviorSystem::update(float dt, SystemContext &context)
                         Vec2 ringTarget{sim.basePos.x + std::cos(angle) * 72.0f,
                                         sim.basePos.y + std::sin(angle) * 48.0f};
                         ++supportIndex;
-                        velocity = normalize(ringTarget - yuna.pos) * unitSpeed;
+                        velocity = normalize(ringTarget - yuna.pos()) * unitSpeed;
                     }
                     else
                     {
-                        velocity = normalize(target->pos - yuna.pos) * unitSpeed;
+                        velocity = normalize(target->pos - yuna.pos()) * unitSpeed;
                     }
                 }
                 else
@@ -606,7 +915,7 @@ void BehaviorSystem::update(float dt, SystemContext &context)
                     Vec2 ringTarget{sim.basePos.x + std::cos(angle) * 120.0f,
                                     sim.basePos.y + std::sin(angle) * 80.0f};
                     ++defendIndex;
-                    velocity = normalize(ringTarget - yuna.pos) * unitSpeed;
+                    velocity = normalize(ringTarget - yuna.pos()) * unitSpeed;
                 }
                 break;
             }
@@ -637,12 +946,175 @@ void BehaviorSystem::update(float dt, SystemContext &context)
 
         if (velocity.x != 0.0f || velocity.y != 0.0f)
         {
-            yuna.desiredVelocity = velocity;
-            yuna.hasDesiredVelocity = true;
+            yuna.desiredVelocity() = velocity;
+            yuna.hasDesiredVelocity() = true;
         }
 
-        detectionUnit = nullptr;
+        query.setUnit(nullptr, 0);
+    }
+}
+
+std::size_t BehaviorSystem::scheduleDecisions(SystemContext &context, FrameVector<std::uint8_t> &deciding,
+                                              FrameVector<EnemyChoice *> &choices)
+{
+    const AiSchedulerConfig &config = context.simulation.config.aiScheduler;
+    const CommanderUnit &commander = context.commander;
+    auto &yunas = context.allies;
+    auto &enemies = context.enemies;
+    const std::size_t unitCount = yunas.size();
+    if (config.maxDecisionsPerTick <= 0)
+    {
+        // Nothing is cached without a budget, so turning one on later starts every unit from a fresh decision.
+        m_choices.clear();
+        m_roundRobinCursor = 0;
+        m_priorityCursor = 0;
+        return unitCount;
+    }
+
+    std::size_t slots = m_choices.size();
+    for (std::size_t i = 0; i < unitCount; ++i)
+    {
+        slots = std::max(slots, static_cast<std::size_t>(yunas.entityAt(i).index) + 1);
+    }
+    m_choices.resize(slots);
+    deciding.assign(unitCount, 0);
+    choices.assign(unitCount, nullptr);
+    for (std::size_t i = 0; i < unitCount; ++i)
+    {
+        const EntityId id = yunas.entityAt(i);
+        EnemyChoice &choice = m_choices[id.index];
+        if (choice.owner != id)
+        {
+            choice = EnemyChoice{};
+            choice.owner = id;
+        }
+        choices[i] = &choice;
+    }
+
+    const std::size_t budget = static_cast<std::size_t>(config.maxDecisionsPerTick);
+    if (budget >= unitCount)
+    {
+        std::fill(deciding.begin(), deciding.end(), std::uint8_t{1});
+        for (EnemyChoice *choice : choices)
+        {
+            choice->decided = true;
+        }
+        return unitCount;
     }
+
+    // Units that never decided, that stand close to an enemy they chose, or that are in view around the
+    // commander get up to priorityShare of the budget. Their sweep has its own cursor so a crowd of priority
+    // units takes turns too.
+    const float enemyRadiusSq = config.priorityEnemyRadiusPx * config.priorityEnemyRadiusPx;
+    const float viewRadiusSq = config.priorityViewRadiusPx * config.priorityViewRadiusPx;
+    auto hasPriority = [&](std::size_t i) {
+        const EnemyChoice &choice = *choices[i];
+        if (!choice.decided)
+        {
+            return true;
+        }
+        const Vec2 pos = yunas[i].pos();
+        if (commander.alive && lengthSq(commander.pos - pos) <= viewRadiusSq)
+        {
+            return true;
+        }
+        for (std::size_t s = 0; s < choice.targets.size(); ++s)
+        {
+            const EntityId target = choice.targets[s];
+            if ((choice.known & (1u << s)) != 0 && target.generation != 0 && enemies.has(target) &&
+                lengthSq(enemies[enemies.indexOf(target)].pos - pos) <= enemyRadiusSq)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const std::size_t priorityCap =
+        std::min(budget - 1, static_cast<std::size_t>(static_cast<float>(budget) * config.priorityShare));
+    std::size_t decided = 0;
+    std::size_t scanned = 0;
+    m_priorityCursor %= unitCount;
+    for (; scanned < unitCount && decided < priorityCap; ++scanned)
+    {
+        const std::size_t i = (m_priorityCursor + scanned) % unitCount;
+        if (hasPriority(i))
+        {
+            deciding[i] = 1;
+            ++decided;
+        }
+    }
+    m_priorityCursor = (m_priorityCursor + scanned) % unitCount;
+
+    // The round robin always gets at least budget - priorityCap decisions, so every unit decides at least once
+    // every ceil(unitCount / (budget - priorityCap)) ticks.
+    scanned = 0;
+    m_roundRobinCursor %= unitCount;
+    for (; scanned < unitCount && decided < budget; ++scanned)
+    {
+        const std::size_t i = (m_roundRobinCursor + scanned) % unitCount;
+        if (deciding[i] == 0)
+        {
+            deciding[i] = 1;
+            ++decided;
+        }
+    }
+    m_roundRobinCursor = (m_roundRobinCursor + scanned) % unitCount;
+
+    for (std::size_t i = 0; i < unitCount; ++i)
+    {
+        if (deciding[i] != 0)
+        {
+            choices[i]->decided = true;
+        }
+    }
+    return decided;
+}
+
+template <typename Archive, typename Self>
+void BehaviorSystem::transferState(Archive &archive, Self &self)
+{
+    archive.sequence(self.m_choices, [&](auto &choice) {
+        archive.field(choice.owner.index);
+        archive.field(choice.owner.generation);
+        for (auto &target : choice.targets)
+        {
+            archive.field(target.index);
+            archive.field(target.generation);
+        }
+        archive.field(choice.known);
+        archive.field(choice.decided);
+    });
+    archive.field(self.m_roundRobinCursor);
+    archive.field(self.m_priorityCursor);
+}
+
+void BehaviorSystem::saveState(StateWriter &out) const
+{
+    transferState(out, *this);
+}
+
+void BehaviorSystem::loadState(StateReader &in)
+{
+    transferState(in, *this);
+}
+
+SystemAccess BehaviorSystem::access() const
+{
+    return SystemAccess{}
+        .read(SystemData::Commander)
+        .read(SystemData::Enemies)
+        .read(SystemData::Walls)
+        .read(SystemData::Mission)
+        .read(SystemData::Simulation)
+        .write(SystemData::Allies)
+        .write(SystemData::Rng)
+        .write(SystemData::Scratch);
+}
+
+const char *BehaviorSystem::name() const
+{
+    return "BehaviorSystem";
 }
 
 } // namespace world::systems
@@ -1,16 +1,64 @@
 #pragma once
 
+#include "world/Entity.h"
+#include "world/FrameAllocator.h"
+#include "world/ProximityIndex.h"
 #include "world/systems/SystemContext.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace world::systems
 {
 
+// The enemies a unit settled on at its last AI decision, one per kind of lookup its behaviour makes (see
+// EnemyChoiceSlot in BehaviorSystem.cpp). A target with generation 0 records that the search found nothing.
+struct EnemyChoice
+{
+    EntityId owner{};
+    std::array<EntityId, 4> targets{};
+    // Bit per target that holds a decision.
+    std::uint8_t known = 0;
+    // Whether the unit has had a scheduled decision since it spawned.
+    bool decided = false;
+};
+
 class BehaviorSystem : public ISystem
 {
   public:
     BehaviorSystem() = default;
 
     void update(float dt, SystemContext &context) override;
+    SystemAccess access() const override;
+    const char *name() const override;
+    void saveState(StateWriter &out) const override;
+    void loadState(StateReader &in) override;
+
+    // Units that made a full decision in the last update(); every unit when the decision budget is off.
+    std::size_t lastDecisionCount() const
+    {
+        return m_lastDecisionCount;
+    }
+
+  private:
+    template <typename Archive, typename Self>
+    static void transferState(Archive &archive, Self &self);
+
+    // Picks the units that decide this tick, leaving a flag per unit in deciding and each unit's EnemyChoice in
+    // choices. Returns the number of deciding units.
+    std::size_t scheduleDecisions(SystemContext &context, FrameVector<std::uint8_t> &deciding,
+                                  FrameVector<EnemyChoice *> &choices);
+
+    ProximityIndex m_enemyIndex;
+    // Unit indices per resolved TemperamentBehavior, for the kernels that run outside unit order.
+    std::array<std::vector<std::uint32_t>, static_cast<std::size_t>(TemperamentBehavior::Mimic) + 1> m_behaviorBuckets;
+    // Indexed by the unit's EntityId slot, so compacting the ally pool keeps every unit's choice.
+    std::vector<EnemyChoice> m_choices;
+    std::size_t m_roundRobinCursor = 0;
+    std::size_t m_priorityCursor = 0;
+    std::size_t m_lastDecisionCount = 0;
 };
 
 } // namespace world::systems
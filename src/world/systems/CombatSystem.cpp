@@ -1,5 +1,8 @@
 #include "world/systems/CombatSystem.h"
 
+#include "world/MovementKernel.h"
+#include "world/RangeKernel.h"
+
 #include <algorithm>
 #include <cmath>
 #include <random>
@@ -12,18 +15,18 @@ namespace world::systems
 namespace
 {
 
-float triggerWarriorSwing(Unit &yuna, LegacySimulation &sim)
+float triggerWarriorSwing(UnitRef yuna, LegacySimulation &sim)
 {
-    if (yuna.job.job != UnitJob::Warrior)
+    if (yuna.job().job != UnitJob::Warrior)
     {
         return 0.0f;
     }
-    JobRuntimeState &job = yuna.job;
+    JobRuntimeState &job = yuna.job();
     if (job.cooldown > 0.0f || job.endlag > 0.0f || job.warrior.stumbleTimer > 0.0f)
     {
         return 0.0f;
     }
-    const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier);
+    const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier());
     job.cooldown = std::max(0.0f, sim.config.warriorJob.cooldown * intervalMul);
     job.endlag = std::max(job.endlag, sim.config.jobCommon.endlagSeconds);
     std::uniform_real_distribution<float> dist(0.0f, 1.0f);
@@ -42,18 +45,18 @@ float triggerWarriorSwing(Unit &yuna, LegacySimulation &sim)
     return 0.0f;
 }
 
-void triggerArcherFocus(Unit &yuna, LegacySimulation &sim)
+void triggerArcherFocus(UnitRef yuna, LegacySimulation &sim)
 {
-    if (yuna.job.job != UnitJob::Archer)
+    if (yuna.job().job != UnitJob::Archer)
     {
         return;
     }
-    JobRuntimeState &job = yuna.job;
+    JobRuntimeState &job = yuna.job();
     if (job.cooldown > 0.0f || job.endlag > 0.0f || job.archer.focusReady)
     {
         return;
     }
-    const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier);
+    const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier());
     job.cooldown = std::max(0.0f, sim.config.archerJob.cooldown * intervalMul);
     job.endlag = std::max(job.endlag, sim.config.jobCommon.endlagSeconds);
     std::uniform_real_distribution<float> dist(0.0f, 1.0f);
@@ -69,13 +72,14 @@ void triggerArcherFocus(Unit &yuna, LegacySimulation &sim)
     sim.pushTelemetry("Archer focus");
 }
 
-void triggerShieldTaunt(Unit &yuna, LegacySimulation &sim, std::vector<EnemyUnit> &enemies)
+void triggerShieldTaunt(UnitRef yuna, EntityId yunaId, LegacySimulation &sim, ComponentPool<EnemyUnit> &enemies,
+                        const ProximityIndex &enemyIndex, std::vector<std::uint32_t> &affected)
 {
-    if (yuna.job.job != UnitJob::Shield)
+    if (yuna.job().job != UnitJob::Shield)
     {
         return;
     }
-    JobRuntimeState &job = yuna.job;
+    JobRuntimeState &job = yuna.job();
     if (job.cooldown > 0.0f || job.endlag > 0.0f)
     {
         return;
@@ -86,25 +90,13 @@ void triggerShieldTaunt(Unit &yuna, LegacySimulation &sim, std::vector<EnemyUnit
         return;
     }
     const float radiusPx = radiusUnits * sim.config.pixels_per_unit;
-    const float radiusSq = radiusPx * radiusPx;
-    std::vector<EnemyUnit *> affected;
-    affected.reserve(enemies.size());
-    for (EnemyUnit &enemy : enemies)
-    {
-        if (enemy.hp <= 0.0f)
-        {
-            continue;
-        }
-        if (lengthSq(enemy.pos - yuna.pos) <= radiusSq)
-        {
-            affected.push_back(&enemy);
-        }
-    }
+    enemyIndex.withinRadius(
+        yuna.pos(), radiusPx, [&](std::uint32_t index) { return enemies[index].hp > 0.0f; }, affected);
     if (affected.empty())
     {
         return;
     }
-    const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier);
+    const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier());
     job.cooldown = std::max(0.0f, sim.config.shieldJob.cooldown * intervalMul);
     job.endlag = std::max(job.endlag, sim.config.jobCommon.endlagSeconds);
     std::uniform_real_distribution<float> dist(0.0f, 1.0f);
@@ -116,10 +108,12 @@ void triggerShieldTaunt(Unit &yuna, LegacySimulation &sim, std::vector<EnemyUnit
     const float duration = sim.config.shieldJob.durationSeconds;
     job.shield.tauntTimer = duration;
     job.shield.selfSlowTimer = duration;
-    for (EnemyUnit *enemy : affected)
+    for (std::uint32_t index : affected)
     {
-        enemy->tauntTarget = yuna.pos;
-        enemy->tauntTimer = duration;
+        EnemyUnit &enemy = enemies[index];
+        enemy.tauntTarget = yuna.pos();
+        enemy.tauntSource = yunaId;
+        enemy.tauntTimer = duration;
     }
     sim.pushTelemetry("Shield taunt");
 }
@@ -130,9 +124,9 @@ void CombatSystem::update(float dt, SystemContext &context)
 {
     LegacySimulation &sim = context.simulation;
     CommanderUnit &commander = context.commander;
-    auto &yunas = context.yunaUnits;
-    auto &enemies = context.enemyUnits;
-    auto &walls = context.wallSegments;
+    auto &yunas = context.allies;
+    auto &enemies = context.enemies;
+    auto &walls = context.walls;
     auto &gates = context.gates;
 
     const float defenseMultiplier =
@@ -142,44 +136,49 @@ void CombatSystem::update(float dt, SystemContext &context)
     const int configuredTileSize = sim.mapDefs.tile_size > 0 ? sim.mapDefs.tile_size : 16;
     const float cellSize = std::max(1.0f, static_cast<float>(configuredTileSize));
     m_grid.configure(sim.worldMin, sim.worldMax, cellSize);
+    // The wall index generation tells the field whether the walls changed, so syncing it comes first.
+    sim.syncWallIndex();
+    m_baseField.configure(sim.worldMin, sim.worldMax, cellSize);
+    m_baseField.update(sim.basePos, sim.wallIndex.generation(), walls.size(), [&](std::size_t i) {
+        return SpatialGrid::Bounds{walls[i].pos, walls[i].radius};
+    });
+
+    auto liveWallIndex = [&](EntityId id) {
+        if (!walls.has(id))
+        {
+            return WallIndex::None;
+        }
+        const std::uint32_t index = static_cast<std::uint32_t>(walls.indexOf(id));
+        return walls[index].hp > 0.0f ? index : WallIndex::None;
+    };
 
+    m_enemyPositions.clear();
+    m_enemyVelocities.clear();
     for (EnemyUnit &enemy : enemies)
     {
         bool taunted = enemy.tauntTimer > 0.0f;
         if (taunted)
         {
             enemy.tauntTimer = std::max(0.0f, enemy.tauntTimer - dt);
+            if (yunas.has(enemy.tauntSource))
+            {
+                enemy.tauntTarget = yunas.get(enemy.tauntSource).pos();
+            }
         }
         Vec2 target = taunted ? enemy.tauntTarget : sim.basePos;
+        bool followField = !taunted;
         if (!taunted && enemy.type == EnemyArchetype::Wallbreaker)
         {
-            const float preferRadius = sim.wallbreakerStats.preferWallRadiusPx;
-            if (preferRadius > 0.0f)
+            const std::uint32_t bestWall =
+                sim.wallIndex.nearest(enemy.pos, sim.wallbreakerStats.preferWallRadiusPx, liveWallIndex);
+            if (bestWall != WallIndex::None)
             {
-                const float preferRadiusSq = preferRadius * preferRadius;
-                WallSegment *bestWall = nullptr;
-                float bestDistSq = preferRadiusSq;
-                for (WallSegment &wall : walls)
-                {
-                    if (wall.hp <= 0.0f)
-                    {
-                        continue;
-                    }
-                    const float distSq = lengthSq(wall.pos - enemy.pos);
-                    if (distSq < bestDistSq)
-                    {
-                        bestDistSq = distSq;
-                        bestWall = &wall;
-                    }
-                }
-                if (bestWall)
-                {
-                    target = bestWall->pos;
-                }
+                target = walls[bestWall].pos;
+                followField = false;
             }
         }
 
-        Vec2 dir = normalize(target - enemy.pos);
+        const Vec2 dir = followField ? m_baseField.direction(enemy.pos) : normalize(target - enemy.pos);
         float speedPx = enemy.speedPx;
         if (speedPx <= 0.0f)
         {
@@ -187,10 +186,14 @@ void CombatSystem::update(float dt, SystemContext &context)
                                                                                : sim.slimeStats.speed_u_s;
             speedPx = speedUnits * sim.config.pixels_per_unit;
         }
-        enemy.pos += dir * (speedPx * dt);
+        m_enemyPositions.push_back(enemy.pos);
+        m_enemyVelocities.push_back(dir * speedPx);
+    }
+    movement::integrate(m_enemyPositions.data(), m_enemyVelocities.data(), m_enemyPositions.size(), dt);
+    for (std::size_t i = 0; i < enemies.size(); ++i)
+    {
+        enemies[i].pos = m_enemyPositions[i];
     }
-
-    m_grid.clear();
 
     auto ensureMarkerSize = [](std::vector<std::uint32_t> &marker, std::size_t size) {
         if (marker.size() < size)
@@ -202,13 +205,9 @@ void CombatSystem::update(float dt, SystemContext &context)
     ensureMarkerSize(m_wallVisit, walls.size());
     ensureMarkerSize(m_enemyVisit, enemies.size());
 
-    if (!walls.empty())
-    {
-        for (std::size_t i = 0; i < walls.size(); ++i)
-        {
-            m_grid.insertWall(i, walls[i].pos, walls[i].radius);
-        }
-    }
+    m_grid.build(SpatialGrid::Layer::Walls, walls.size(), [&](std::size_t i) {
+        return SpatialGrid::Bounds{walls[i].pos, walls[i].radius};
+    });
 
     auto nextStamp = [](std::uint32_t &stamp, std::vector<std::uint32_t> &markers) {
         ++stamp;
@@ -225,12 +224,9 @@ void CombatSystem::update(float dt, SystemContext &context)
         {
             return;
         }
-        m_grid.queryCells(pos, radius, m_cellScratch);
         nextStamp(m_wallStamp, m_wallVisit);
-        for (std::size_t cellIndex : m_cellScratch)
-        {
-            const auto &cell = m_grid.cell(cellIndex);
-            for (std::size_t idx : cell.walls)
+        m_grid.forEachSpan(SpatialGrid::Layer::Walls, pos, radius, [&](SpatialGrid::IndexSpan span) {
+            for (std::uint32_t idx : span)
             {
                 if (idx >= walls.size())
                 {
@@ -242,7 +238,7 @@ void CombatSystem::update(float dt, SystemContext &context)
                     out.push_back(idx);
                 }
             }
-        }
+        });
     };
 
     for (std::size_t enemyIndex = 0; enemyIndex < enemies.size(); ++enemyIndex)
@@ -277,35 +273,32 @@ void CombatSystem::update(float dt, SystemContext &context)
         }
     }
 
-    if (!enemies.empty())
-    {
-        for (std::size_t i = 0; i < enemies.size(); ++i)
-        {
-            m_grid.insertEnemy(i, enemies[i].pos, enemies[i].radius);
-        }
-    }
+    m_grid.build(SpatialGrid::Layer::Enemies, enemies.size(), [&](std::size_t i) {
+        return SpatialGrid::Bounds{enemies[i].pos, enemies[i].radius};
+    });
+    m_enemyIndex.build(sim.worldMin, sim.worldMax, enemies.size(), [&](std::size_t i) { return enemies[i].pos; });
 
-    if (!yunas.empty())
-    {
-        for (std::size_t i = 0; i < yunas.size(); ++i)
-        {
-            m_grid.insertUnit(i, yunas[i].pos, yunas[i].radius);
-        }
-    }
+    const auto &yunaPositions = yunas.storage().posColumn();
+    const auto &yunaRadii = yunas.storage().radiusColumn();
+    m_grid.build(SpatialGrid::Layer::Units, yunaPositions.size(), [&](std::size_t i) {
+        return SpatialGrid::Bounds{yunaPositions[i], yunaRadii[i]};
+    });
 
-    auto gatherEnemiesNear = [&](const Vec2 &pos, float radius, std::vector<std::size_t> &out) {
+    // Enemies whose circle touches the query circle, each once, in grid order. The distance test runs in the
+    // range kernels over the packed row spans; only hits are deduplicated.
+    auto gatherEnemiesTouching = [&](const Vec2 &pos, float radius, std::vector<std::uint32_t> &out) {
         out.clear();
         if (enemies.empty())
         {
             return;
         }
-        m_grid.queryCells(pos, radius, m_cellScratch);
         nextStamp(m_enemyStamp, m_enemyVisit);
-        for (std::size_t cellIndex : m_cellScratch)
-        {
-            const auto &cell = m_grid.cell(cellIndex);
-            for (std::size_t idx : cell.enemies)
+        m_grid.forEachPackedSpan(SpatialGrid::Layer::Enemies, pos, radius, [&](const range::Candidates &span) {
+            m_hitScratch.resize(std::max(m_hitScratch.size(), span.count));
+            const std::size_t hits = range::overlapping(span, pos, radius, m_hitScratch.data());
+            for (std::size_t h = 0; h < hits; ++h)
             {
+                const std::uint32_t idx = m_hitScratch[h];
                 if (idx >= enemies.size())
                 {
                     continue;
@@ -316,114 +309,120 @@ void CombatSystem::update(float dt, SystemContext &context)
                     out.push_back(idx);
                 }
             }
-        }
+        });
     };
 
+    // Gates never move and are never erased mid-tick, so one packed copy serves every attacker this tick.
+    m_gateIds.clear();
+    m_gateXs.clear();
+    m_gateYs.clear();
+    m_gateRadii.clear();
+    for (std::size_t g = 0; g < gates.size(); ++g)
+    {
+        m_gateIds.push_back(static_cast<std::uint32_t>(g));
+        m_gateXs.push_back(gates[g].pos.x);
+        m_gateYs.push_back(gates[g].pos.y);
+        m_gateRadii.push_back(gates[g].radius);
+    }
+    const range::Candidates gateCandidates{m_gateIds.data(), m_gateXs.data(), m_gateYs.data(), m_gateRadii.data(),
+                                           m_gateIds.size()};
+    m_gateHits.resize(gateCandidates.count);
+
     FrameAllocator::Allocator<float> damageAlloc(context.frameAllocator);
     std::vector<float, FrameAllocator::Allocator<float>> yunaDamage(yunas.size(), 0.0f, damageAlloc);
     float commanderDamage = 0.0f;
 
     if (commander.alive)
     {
-        gatherEnemiesNear(commander.pos, commander.radius, m_enemyScratch);
-        for (std::size_t enemyIndex : m_enemyScratch)
+        gatherEnemiesTouching(commander.pos, commander.radius, m_enemyScratch);
+        for (std::uint32_t enemyIndex : m_enemyScratch)
         {
             EnemyUnit &enemy = enemies[enemyIndex];
             if (enemy.hp <= 0.0f)
             {
                 continue;
             }
-            const float combined = commander.radius + enemy.radius;
-            if (lengthSq(commander.pos - enemy.pos) <= combined * combined)
+            enemy.hp -= sim.commanderStats.dps * dt;
+            if (context.commanderInvulnTimer <= 0.0f)
             {
-                enemy.hp -= sim.commanderStats.dps * dt;
-                if (context.commanderInvulnTimer <= 0.0f)
-                {
-                    commanderDamage += enemy.dpsUnit * dt * formationDamageScale;
-                }
+                commanderDamage += enemy.dpsUnit * dt * formationDamageScale;
             }
         }
-        for (GateRuntime &gate : gates)
+        const std::size_t gateHits =
+            range::overlapping(gateCandidates, commander.pos, commander.radius, m_gateHits.data());
+        for (std::size_t h = 0; h < gateHits; ++h)
         {
+            GateRuntime &gate = gates[m_gateHits[h]];
             if (gate.destroyed)
             {
                 continue;
             }
-            const float combined = commander.radius + gate.radius;
-            if (lengthSq(commander.pos - gate.pos) <= combined * combined)
+            gate.hp = std::max(0.0f, gate.hp - sim.commanderStats.dps * dt);
+            if (gate.hp <= 0.0f)
             {
-                gate.hp = std::max(0.0f, gate.hp - sim.commanderStats.dps * dt);
-                if (gate.hp <= 0.0f)
-                {
-                    sim.destroyGate(gate);
-                }
+                sim.destroyGate(gate);
             }
         }
     }
 
     for (std::size_t i = 0; i < yunas.size(); ++i)
     {
-        Unit &yuna = yunas[i];
-        if (yuna.job.job == UnitJob::Shield)
+        UnitRef yuna = yunas[i];
+        if (yuna.job().job == UnitJob::Shield)
         {
-            triggerShieldTaunt(yuna, sim, enemies);
+            triggerShieldTaunt(yuna, yunas.entityAt(i), sim, enemies, m_enemyIndex, m_tauntScratch);
         }
-        gatherEnemiesNear(yuna.pos, yuna.radius, m_enemyScratch);
-        for (std::size_t enemyIndex : m_enemyScratch)
+        const Vec2 yunaPos = yunaPositions[i];
+        const float yunaRadius = yunaRadii[i];
+        gatherEnemiesTouching(yunaPos, yunaRadius, m_enemyScratch);
+        for (std::uint32_t enemyIndex : m_enemyScratch)
         {
             EnemyUnit &enemy = enemies[enemyIndex];
             if (enemy.hp <= 0.0f)
             {
                 continue;
             }
-            const float combined = yuna.radius + enemy.radius;
-            if (lengthSq(yuna.pos - enemy.pos) <= combined * combined)
+            const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier());
+            float attackDps = (sim.yunaStats.dps * std::max(0.01f, yuna.moraleAccuracyMultiplier())) / intervalMul;
+            float burstDamage = 0.0f;
+            if (yuna.job().job == UnitJob::Warrior)
             {
-                const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier);
-                float attackDps =
-                    (sim.yunaStats.dps * std::max(0.01f, yuna.moraleAccuracyMultiplier)) / intervalMul;
-                float burstDamage = 0.0f;
-                if (yuna.job.job == UnitJob::Warrior)
-                {
-                    burstDamage = triggerWarriorSwing(yuna, sim);
-                }
-                if (yuna.job.job == UnitJob::Archer)
+                burstDamage = triggerWarriorSwing(yuna, sim);
+            }
+            if (yuna.job().job == UnitJob::Archer)
+            {
+                triggerArcherFocus(yuna, sim);
+                if (yuna.job().archer.focusReady)
                 {
-                    triggerArcherFocus(yuna, sim);
-                    if (yuna.job.archer.focusReady)
-                    {
-                        attackDps *= 1.0f + sim.config.archerJob.critBonus;
-                        yuna.job.archer.focusReady = false;
-                    }
+                    attackDps *= 1.0f + sim.config.archerJob.critBonus;
+                    yuna.job().archer.focusReady = false;
                 }
+            }
 
-                enemy.hp -= attackDps * dt;
-                if (burstDamage > 0.0f)
-                {
-                    enemy.hp -= burstDamage;
-                }
-                float incoming = enemy.dpsUnit * dt * formationDamageScale;
-                incoming /= std::max(0.01f, yuna.moraleDefenseMultiplier);
-                yunaDamage[i] += incoming;
+            enemy.hp -= attackDps * dt;
+            if (burstDamage > 0.0f)
+            {
+                enemy.hp -= burstDamage;
             }
+            float incoming = enemy.dpsUnit * dt * formationDamageScale;
+            incoming /= std::max(0.01f, yuna.moraleDefenseMultiplier());
+            yunaDamage[i] += incoming;
         }
-        for (GateRuntime &gate : gates)
+        const std::size_t gateHits = range::overlapping(gateCandidates, yunaPos, yunaRadius, m_gateHits.data());
+        for (std::size_t h = 0; h < gateHits; ++h)
         {
+            GateRuntime &gate = gates[m_gateHits[h]];
             if (gate.destroyed)
             {
                 continue;
             }
-            const float combined = yuna.radius + gate.radius;
-            if (lengthSq(yuna.pos - gate.pos) <= combined * combined)
+            const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier());
+            const float attackDps =
+                (sim.yunaStats.dps * std::max(0.01f, yuna.moraleAccuracyMultiplier())) / intervalMul;
+            gate.hp = std::max(0.0f, gate.hp - attackDps * dt);
+            if (gate.hp <= 0.0f)
             {
-                const float intervalMul = std::max(0.01f, yuna.moraleAttackIntervalMultiplier);
-                const float attackDps =
-                    (sim.yunaStats.dps * std::max(0.01f, yuna.moraleAccuracyMultiplier)) / intervalMul;
-                gate.hp = std::max(0.0f, gate.hp - attackDps * dt);
-                if (gate.hp <= 0.0f)
-                {
-                    sim.destroyGate(gate);
-                }
+                sim.destroyGate(gate);
             }
         }
     }
@@ -440,74 +439,80 @@ void CombatSystem::update(float dt, SystemContext &context)
         }
     }
 
-    if (!yunaDamage.empty())
+    // Deaths are only tombstoned here; WorldState reaps them once the StateUpdate stage has also run.
+    for (std::size_t i = 0; i < yunaDamage.size(); ++i)
     {
-        std::vector<Unit> survivors;
-        survivors.reserve(yunas.size());
-        for (std::size_t i = 0; i < yunas.size(); ++i)
+        if (yunas.markedForRemoval(i))
         {
-            Unit &yuna = yunas[i];
-            if (yuna.hp <= 0.0f)
+            continue;
+        }
+        UnitRef yuna = yunas[i];
+        const float damage = yunaDamage[i];
+        if (yuna.hp() <= 0.0f)
+        {
+            sim.markYunaDead(i, 0.0f);
+            continue;
+        }
+        if (damage > 0.0f)
+        {
+            const float hpBefore = yuna.hp();
+            yuna.hp() -= damage;
+            if (yuna.hp() <= 0.0f)
             {
-                sim.enqueueYunaRespawn(0.0f);
+                const float overkill = std::max(0.0f, damage - std::max(hpBefore, 0.0f));
+                sim.markYunaDead(i, sim.clampOverkillRatio(overkill, sim.yunaStats.hp));
                 continue;
             }
-            if (yunaDamage[i] > 0.0f)
+            if (yuna.temperament().definition && yuna.temperament().definition->panicOnHit > 0.0f)
             {
-                const float hpBefore = yuna.hp;
-                yuna.hp -= yunaDamage[i];
-                if (yuna.hp <= 0.0f)
-                {
-                    const float overkill = std::max(0.0f, yunaDamage[i] - std::max(hpBefore, 0.0f));
-                    const float ratio = sim.clampOverkillRatio(overkill, sim.yunaStats.hp);
-                    sim.enqueueYunaRespawn(ratio);
-                    continue;
-                }
-                if (yuna.temperament.definition && yuna.temperament.definition->panicOnHit > 0.0f)
-                {
-                    yuna.temperament.panicTimer = std::max(
-                        yuna.temperament.panicTimer, yuna.temperament.definition->panicOnHit);
-                }
+                yuna.temperament().panicTimer =
+                    std::max(yuna.temperament().panicTimer, yuna.temperament().definition->panicOnHit);
             }
-            survivors.push_back(yuna);
         }
-        yunas.swap(survivors);
     }
 
     const float baseRadius = std::max(sim.config.base_aabb.x, sim.config.base_aabb.y) * 0.5f;
-    gatherEnemiesNear(sim.basePos, baseRadius, m_enemyScratch);
-    for (std::size_t enemyIndex : m_enemyScratch)
+    gatherEnemiesTouching(sim.basePos, baseRadius, m_enemyScratch);
+    for (std::uint32_t enemyIndex : m_enemyScratch)
     {
         EnemyUnit &enemy = enemies[enemyIndex];
         if (enemy.hp <= 0.0f)
         {
             continue;
         }
-        const float combined = baseRadius + enemy.radius;
-        if (lengthSq(enemy.pos - sim.basePos) <= combined * combined)
+        context.baseHp -= enemy.dpsBase * dt;
+        if (context.baseHp <= 0.0f)
         {
-            context.baseHp -= enemy.dpsBase * dt;
-            if (context.baseHp <= 0.0f)
+            context.baseHp = 0.0f;
+            if (!context.mission.hasMission || context.mission.fail.baseHpZero)
             {
-                context.baseHp = 0.0f;
-                if (!context.mission.hasMission || context.mission.fail.baseHpZero)
-                {
-                    sim.setResult(GameResult::Defeat, "Defeat");
-                }
-                break;
+                sim.setResult(GameResult::Defeat, "Defeat");
             }
+            break;
         }
     }
 
-    enemies.erase(std::remove_if(enemies.begin(), enemies.end(), [](const EnemyUnit &e) {
-        return e.hp <= 0.0f;
-    }), enemies.end());
+    enemies.eraseIf([](const EnemyUnit &e) { return e.hp <= 0.0f; });
+    sim.eraseWallsIf([](const WallSegment &wall) { return wall.hp <= 0.0f; });
+}
 
-    walls.erase(std::remove_if(walls.begin(), walls.end(), [](const WallSegment &wall) {
-        return wall.hp <= 0.0f;
-    }), walls.end());
+SystemAccess CombatSystem::access() const
+{
+    return SystemAccess{}
+        .write(SystemData::Allies)
+        .write(SystemData::Enemies)
+        .write(SystemData::Walls)
+        .write(SystemData::Commander)
+        .write(SystemData::Mission)
+        .write(SystemData::Rng)
+        .write(SystemData::Simulation)
+        .write(SystemData::Events)
+        .write(SystemData::Scratch);
+}
 
-    context.requestComponentSync();
+const char *CombatSystem::name() const
+{
+    return "CombatSystem";
 }
 
 } // namespace world::systems
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "world/FlowField.h"
+#include "world/ProximityIndex.h"
 #include "world/SpatialGrid.h"
 #include "world/systems/SystemContext.h"
 
@@ -15,16 +17,31 @@ class CombatSystem : public ISystem
     CombatSystem() = default;
 
     void update(float dt, SystemContext &context) override;
+    SystemAccess access() const override;
+    const char *name() const override;
 
   private:
     SpatialGrid m_grid;
+    ProximityIndex m_enemyIndex;
+    // Paths toward the base around live walls, shared by every enemy that is not taunted or chasing a wall.
+    FlowField m_baseField;
     std::vector<std::uint32_t> m_enemyVisit;
     std::vector<std::uint32_t> m_wallVisit;
     std::uint32_t m_enemyStamp = 1;
     std::uint32_t m_wallStamp = 1;
-    std::vector<std::size_t> m_cellScratch;
-    std::vector<std::size_t> m_enemyScratch;
+    std::vector<std::uint32_t> m_enemyScratch;
     std::vector<std::size_t> m_wallScratch;
+    std::vector<std::uint32_t> m_hitScratch;
+    std::vector<std::uint32_t> m_tauntScratch;
+    // Packed enemy positions and velocities for the batch movement kernel.
+    std::vector<Vec2> m_enemyPositions;
+    std::vector<Vec2> m_enemyVelocities;
+    // Gate circles packed once per tick for the range kernels.
+    std::vector<std::uint32_t> m_gateIds;
+    std::vector<float> m_gateXs;
+    std::vector<float> m_gateYs;
+    std::vector<float> m_gateRadii;
+    std::vector<std::uint32_t> m_gateHits;
 };
 
 } // namespace world::systems
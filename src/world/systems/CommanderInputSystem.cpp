@@ -32,5 +32,17 @@ void CommanderInputSystem::update(float, SystemContext &context)
     commander.hasMoveIntent = true;
 }
 
+SystemAccess CommanderInputSystem::access() const
+{
+    return SystemAccess{}
+        .read(SystemData::Input)
+        .write(SystemData::Commander);
+}
+
+const char *CommanderInputSystem::name() const
+{
+    return "CommanderInputSystem";
+}
+
 } // namespace world::systems
 
@@ -3,6 +3,7 @@
 #include "events/EventBus.h"
 #include "telemetry/TelemetrySink.h"
 #include "world/FormationUtils.h"
+#include "world/StateArchive.h"
 
 #include <algorithm>
 #include <any>
@@ -24,10 +25,11 @@ constexpr std::size_t kFollowLimit = 30;
 constexpr float kFollowerSnapDistSq = 16.0f;
 
 template <typename Container>
-float computeAlignmentProgress(const CommanderUnit &commander, const Container &followers)
+float computeAlignmentProgress(const CommanderUnit &commander, const ComponentPool<Unit> &yunas,
+                               const Container &followers)
 {
-    static_assert(std::is_same_v<typename Container::value_type, Unit *>,
-                  "followers container must hold Unit pointers");
+    static_assert(std::is_same_v<typename Container::value_type, std::size_t>,
+                  "followers container must hold ally indices");
     if (!commander.alive || followers.empty())
     {
         return 0.0f;
@@ -38,14 +40,11 @@ float computeAlignmentProgress(const CommanderUnit &commander, const Container &
         return 0.0f;
     }
     float total = 0.0f;
-    for (const Unit *unit : followers)
+    for (std::size_t index : followers)
     {
-        if (!unit)
-        {
-            continue;
-        }
-        const Vec2 desired = commander.pos + unit->formationOffset;
-        const float dist = length(desired - unit->pos);
+        ConstUnitRef unit = yunas[index];
+        const Vec2 desired = commander.pos + unit.formationOffset();
+        const float dist = length(desired - unit.pos());
         const float normalized = std::clamp(1.0f - dist / snapDist, 0.0f, 1.0f);
         total += normalized;
     }
@@ -164,7 +163,7 @@ void FormationSystem::update(float dt, SystemContext &context)
 {
     LegacySimulation &sim = context.simulation;
     CommanderUnit &commander = context.commander;
-    auto &yunas = context.yunaUnits;
+    auto &yunas = context.allies;
 
     if (sim.formationAlignTimer > 0.0f)
     {
@@ -176,43 +175,44 @@ void FormationSystem::update(float dt, SystemContext &context)
     }
     const float secondsRemaining = std::max(sim.formationAlignTimer, 0.0f);
 
-    FrameAllocator::Allocator<Unit *> followerAlloc(context.frameAllocator);
-    std::vector<Unit *, FrameAllocator::Allocator<Unit *>> followers(followerAlloc);
+    FrameAllocator::Allocator<std::size_t> followerAlloc(context.frameAllocator);
+    std::vector<std::size_t, FrameAllocator::Allocator<std::size_t>> followers(followerAlloc);
     followers.reserve(kFollowLimit);
 
-    for (Unit &unit : yunas)
+    for (UnitRef unit : yunas)
     {
-        unit.followByStance = false;
-        unit.effectiveFollower = false;
+        unit.followByStance() = false;
+        unit.effectiveFollower() = false;
     }
 
     if (context.orderActive && sim.stance == ArmyStance::FollowLeader && commander.alive)
     {
-        using DistanceEntry = std::pair<float, Unit *>;
+        using DistanceEntry = std::pair<float, std::size_t>;
         FrameAllocator::Allocator<DistanceEntry> distanceAlloc(context.frameAllocator);
         std::vector<DistanceEntry, FrameAllocator::Allocator<DistanceEntry>> distances(distanceAlloc);
         distances.reserve(yunas.size());
-        for (Unit &unit : yunas)
+        for (std::size_t i = 0; i < yunas.size(); ++i)
         {
-            distances.emplace_back(lengthSq(unit.pos - commander.pos), &unit);
+            distances.emplace_back(lengthSq(yunas[i].pos() - commander.pos), i);
         }
         std::sort(distances.begin(), distances.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
         const std::size_t take = std::min<std::size_t>(kFollowLimit, distances.size());
         for (std::size_t i = 0; i < take; ++i)
         {
-            distances[i].second->followByStance = true;
+            yunas[distances[i].second].followByStance() = true;
         }
     }
 
-    FrameAllocator::Allocator<std::pair<float, Unit *>> skillAlloc(context.frameAllocator);
-    std::vector<std::pair<float, Unit *>, FrameAllocator::Allocator<std::pair<float, Unit *>>> skillFollowers(
-        skillAlloc);
+    FrameAllocator::Allocator<std::pair<float, std::size_t>> skillAlloc(context.frameAllocator);
+    std::vector<std::pair<float, std::size_t>, FrameAllocator::Allocator<std::pair<float, std::size_t>>>
+        skillFollowers(skillAlloc);
     skillFollowers.reserve(yunas.size());
-    for (Unit &unit : yunas)
+    for (std::size_t i = 0; i < yunas.size(); ++i)
     {
-        if (unit.followBySkill)
+        ConstUnitRef unit = yunas[i];
+        if (unit.followBySkill())
         {
-            skillFollowers.emplace_back(lengthSq(unit.pos - commander.pos), &unit);
+            skillFollowers.emplace_back(lengthSq(unit.pos() - commander.pos), i);
         }
     }
     std::sort(skillFollowers.begin(), skillFollowers.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
@@ -223,21 +223,22 @@ void FormationSystem::update(float dt, SystemContext &context)
         {
             break;
         }
-        entry.second->effectiveFollower = true;
+        yunas[entry.second].effectiveFollower() = true;
         followers.push_back(entry.second);
     }
     if (followers.size() < kFollowLimit)
     {
-        for (Unit &unit : yunas)
+        for (std::size_t i = 0; i < yunas.size(); ++i)
         {
             if (followers.size() >= kFollowLimit)
             {
                 break;
             }
-            if (!unit.followBySkill && unit.followByStance)
+            UnitRef unit = yunas[i];
+            if (!unit.followBySkill() && unit.followByStance())
             {
-                unit.effectiveFollower = true;
-                followers.push_back(&unit);
+                unit.effectiveFollower() = true;
+                followers.push_back(i);
             }
         }
     }
@@ -245,7 +246,7 @@ void FormationSystem::update(float dt, SystemContext &context)
     const auto formationOffsets = computeFormationOffsets(sim.formation, followers.size());
     for (std::size_t i = 0; i < followers.size(); ++i)
     {
-        followers[i]->formationOffset = formationOffsets[i];
+        yunas[followers[i]].formationOffset() = formationOffsets[i];
     }
 
     if (!commander.alive || followers.empty())
@@ -255,7 +256,7 @@ void FormationSystem::update(float dt, SystemContext &context)
     }
     else
     {
-        m_progress = computeAlignmentProgress(commander, followers);
+        m_progress = computeAlignmentProgress(commander, yunas, followers);
         if (secondsRemaining > 0.0f)
         {
             m_state = FormationAlignmentState::Aligning;
@@ -284,8 +285,6 @@ void FormationSystem::update(float dt, SystemContext &context)
         m_lastFollowerCount = followers.size();
         m_lastSecondsRemaining = secondsRemaining;
     }
-
-    context.requestComponentSync();
 }
 
 void FormationSystem::emitFormationChanged(Formation formation)
@@ -386,4 +385,47 @@ void FormationSystem::emitFormationCountdown(Formation formation, bool active, f
     }
 }
 
+SystemAccess FormationSystem::access() const
+{
+    return SystemAccess{}
+        .read(SystemData::Commander)
+        .write(SystemData::Allies)
+        .write(SystemData::Hud)
+        .write(SystemData::Simulation)
+        .write(SystemData::Events)
+        .write(SystemData::Scratch);
+}
+
+const char *FormationSystem::name() const
+{
+    return "FormationSystem";
+}
+
+template <typename Archive, typename Self>
+void FormationSystem::transferState(Archive &archive, Self &self)
+{
+    archive.field(self.m_state);
+    archive.field(self.m_progress);
+    archive.field(self.m_lastFormation);
+    archive.field(self.m_lastProgressSent);
+    archive.field(self.m_lastStateSent);
+    archive.field(self.m_lastFollowerCount);
+    archive.field(self.m_lastSecondsRemaining);
+    archive.field(self.m_lastCountdownActive);
+    archive.field(self.m_lastCountdownSeconds);
+    archive.field(self.m_lastCountdownProgress);
+    archive.field(self.m_lastCountdownFollowers);
+    archive.field(self.m_lastCountdownLabel);
+}
+
+void FormationSystem::saveState(StateWriter &out) const
+{
+    transferState(out, *this);
+}
+
+void FormationSystem::loadState(StateReader &in)
+{
+    transferState(in, *this);
+}
+
 } // namespace world::systems
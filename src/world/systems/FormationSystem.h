@@ -17,6 +17,10 @@ class FormationSystem : public ISystem
     FormationSystem();
 
     void update(float dt, SystemContext &context) override;
+    SystemAccess access() const override;
+    const char *name() const override;
+    void saveState(StateWriter &out) const override;
+    void loadState(StateReader &in) override;
 
     void setEventBus(std::weak_ptr<EventBus> bus);
     void setTelemetrySink(std::weak_ptr<TelemetrySink> sink);
@@ -26,6 +30,9 @@ class FormationSystem : public ISystem
     void reset(const LegacySimulation &simulation);
 
   private:
+    template <typename Archive, typename Self>
+    static void transferState(Archive &archive, Self &self);
+
     std::weak_ptr<EventBus> m_eventBus;
     std::weak_ptr<TelemetrySink> m_telemetry;
     FormationAlignmentState m_state;
@@ -44,7 +44,6 @@ const std::unordered_map<std::string, JobAbilitySystem::SkillHandler> &defaultSk
                    const SkillCommand &command) {
                     context.simulation.spawnWallSegments(skill.def, command.worldTarget);
                     skill.cooldownRemaining = skill.def.cooldown;
-                    context.requestComponentSync();
                 }});
         map.emplace(
             SurgeSkillId,
@@ -59,7 +58,6 @@ const std::unordered_map<std::string, JobAbilitySystem::SkillHandler> &defaultSk
                 [](JobAbilitySystem &, SystemContext &context, RuntimeSkill &skill, const SkillCommand &) {
                     context.simulation.detonateCommander(skill.def);
                     skill.cooldownRemaining = skill.def.cooldown;
-                    context.requestComponentSync();
                 }});
         return map;
     }();
@@ -135,8 +133,6 @@ void JobAbilitySystem::installDefaultHandlers(const std::vector<SkillDef> &defs)
 
 void JobAbilitySystem::update(float dt, SystemContext &context)
 {
-    bool changed = false;
-
     std::array<std::size_t, UnitJobCount> totals{};
     std::array<std::size_t, UnitJobCount> ready{};
     std::array<float, UnitJobCount> maxCooldown{};
@@ -148,70 +144,47 @@ void JobAbilitySystem::update(float dt, SystemContext &context)
     {
         if (skill.cooldownRemaining > 0.0f)
         {
-            const float before = skill.cooldownRemaining;
             skill.cooldownRemaining = std::max(0.0f, skill.cooldownRemaining - dt);
-            if (skill.cooldownRemaining != before)
-            {
-                changed = true;
-            }
         }
         if (skill.activeTimer > 0.0f)
         {
-            const float before = skill.activeTimer;
             skill.activeTimer = std::max(0.0f, skill.activeTimer - dt);
             if (skill.activeTimer <= 0.0f && skill.def.type == SkillType::SpawnRate)
             {
                 context.spawnRateMultiplier = 1.0f;
-                changed = true;
-            }
-            if (skill.activeTimer != before)
-            {
-                changed = true;
             }
         }
     }
 
     if (context.spawnSlowTimer > 0.0f)
     {
-        const float before = context.spawnSlowTimer;
         context.spawnSlowTimer = std::max(0.0f, context.spawnSlowTimer - dt);
         if (context.spawnSlowTimer <= 0.0f)
         {
             context.spawnSlowMultiplier = 1.0f;
-            changed = true;
-        }
-        if (context.spawnSlowTimer != before)
-        {
-            changed = true;
         }
     }
 
     if (context.commanderInvulnTimer > 0.0f && context.commander.alive)
     {
-        const float before = context.commanderInvulnTimer;
         context.commanderInvulnTimer = std::max(0.0f, context.commanderInvulnTimer - dt);
-        if (context.commanderInvulnTimer != before)
-        {
-            changed = true;
-        }
     }
 
     if (context.rallyState && context.simulation.moraleSummary.rallySuppressed)
     {
         context.rallyState = false;
-        changed = true;
     }
 
-    for (Unit &unit : context.yunaUnits)
+    auto &allies = context.allies;
+    for (std::size_t i = 0; i < allies.size(); ++i)
     {
-        JobRuntimeState &job = unit.job;
-        const float beforeCooldown = job.cooldown;
-        const float beforeEndlag = job.endlag;
-        const float beforeStumble = job.warrior.stumbleTimer;
-        const float beforeHold = job.archer.holdTimer;
-        const bool beforeFocusReady = job.archer.focusReady;
-        const float beforeTaunt = job.shield.tauntTimer;
-        const float beforeSlow = job.shield.selfSlowTimer;
+        // Allies killed in Combat this tick are still tombstoned here; they neither tick nor count in the HUD.
+        if (allies.markedForRemoval(i))
+        {
+            continue;
+        }
+        UnitRef unit = allies[i];
+        JobRuntimeState &job = unit.job();
         if (job.cooldown > 0.0f)
         {
             job.cooldown = std::max(0.0f, job.cooldown - dt);
@@ -273,13 +246,6 @@ void JobAbilitySystem::update(float dt, SystemContext &context)
             }
             specialTimer[jobIndex] = std::max(specialTimer[jobIndex], jobSpecialTimer);
         }
-        if (job.cooldown != beforeCooldown || job.endlag != beforeEndlag ||
-            job.warrior.stumbleTimer != beforeStumble || job.archer.holdTimer != beforeHold ||
-            job.archer.focusReady != beforeFocusReady ||
-            job.shield.tauntTimer != beforeTaunt || job.shield.selfSlowTimer != beforeSlow)
-        {
-            changed = true;
-        }
     }
 
     FrameAllocator::Allocator<JobHudSnapshot::Skill> skillAlloc(context.frameAllocator);
@@ -416,11 +382,6 @@ void JobAbilitySystem::update(float dt, SystemContext &context)
         }
         m_hudInitialized = true;
     }
-
-    if (changed)
-    {
-        context.requestComponentSync();
-    }
 }
 
 void JobAbilitySystem::triggerSkill(SystemContext &context, const SkillCommand &command)
@@ -457,7 +418,6 @@ void JobAbilitySystem::toggleRally(SystemContext &context, RuntimeSkill &skill,
     context.simulation.applyRallyState(newState, skill.def, command.worldTarget);
     context.rallyState = newState;
     skill.cooldownRemaining = skill.def.cooldown;
-    context.requestComponentSync();
 }
 
 void JobAbilitySystem::activateSpawnRate(SystemContext &context, RuntimeSkill &skill)
@@ -466,7 +426,32 @@ void JobAbilitySystem::activateSpawnRate(SystemContext &context, RuntimeSkill &s
     skill.activeTimer = skill.def.duration;
     skill.cooldownRemaining = skill.def.cooldown;
     context.simulation.pushTelemetry("Spawn surge");
-    context.requestComponentSync();
+}
+
+SystemAccess JobAbilitySystem::access() const
+{
+    return SystemAccess{}
+        .read(SystemData::Enemies)
+        .read(SystemData::Mission)
+        .write(SystemData::Allies)
+        .write(SystemData::Commander)
+        .write(SystemData::Hud)
+        .write(SystemData::Skills)
+        .write(SystemData::Spawning)
+        .write(SystemData::Simulation)
+        .write(SystemData::Events)
+        .write(SystemData::Scratch);
+}
+
+const char *JobAbilitySystem::name() const
+{
+    return "JobAbilitySystem";
+}
+
+void JobAbilitySystem::loadState(StateReader &)
+{
+    // The HUD snapshot only tracks what was last pushed to the HUD; pushing it again after a restore is cheap.
+    m_hudInitialized = false;
 }
 
 } // namespace world::systems
@@ -26,6 +26,9 @@ class JobAbilitySystem : public ISystem
     JobAbilitySystem() = default;
 
     void update(float dt, SystemContext &context) override;
+    SystemAccess access() const override;
+    const char *name() const override;
+    void loadState(StateReader &in) override;
     void triggerSkill(SystemContext &context, const SkillCommand &command);
 
     using SkillHandler = std::function<void(JobAbilitySystem &, SystemContext &, RuntimeSkill &, const SkillCommand &)>;
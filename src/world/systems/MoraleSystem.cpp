@@ -3,8 +3,10 @@
 #include "config/AppConfig.h"
 #include "events/EventBus.h"
 #include "events/MoraleEvents.h"
+#include "world/JobScheduler.h"
 #include "world/LegacySimulation.h"
 #include "world/LegacyTypes.h"
+#include "world/StateArchive.h"
 
 #include <algorithm>
 #include <cmath>
@@ -17,6 +19,9 @@ namespace world::systems
 {
 namespace
 {
+
+constexpr std::size_t kUnitsPerJob = 256;
+
 MoraleModifiers clampModifiers(const MoraleModifiers &mods)
 {
     MoraleModifiers clamped = mods;
@@ -74,55 +79,32 @@ void MoraleSystem::update(float dt, SystemContext &context)
         return before != timer;
     };
 
-    bool requestSync = false;
-    if (tickTimer(hud.telemetryTimer))
-    {
-        requestSync = true;
-    }
-    if (tickTimer(hud.resultTimer))
+    tickTimer(hud.telemetryTimer);
+    tickTimer(hud.resultTimer);
+    if (tickTimer(hud.performance.timer) && hud.performance.timer <= 0.0f)
     {
-        requestSync = true;
+        hud.performance.active = false;
+        hud.performance.message.clear();
     }
-    if (tickTimer(hud.performance.timer))
+    if (tickTimer(hud.spawnBudget.timer) && hud.spawnBudget.timer <= 0.0f)
     {
-        if (hud.performance.timer <= 0.0f)
-        {
-            hud.performance.active = false;
-            hud.performance.message.clear();
-        }
-        requestSync = true;
-    }
-    if (tickTimer(hud.spawnBudget.timer))
-    {
-        if (hud.spawnBudget.timer <= 0.0f)
-        {
-            hud.spawnBudget.active = false;
-            hud.spawnBudget.message.clear();
-            hud.spawnBudget.lastDeferred = 0;
-        }
-        requestSync = true;
+        hud.spawnBudget.active = false;
+        hud.spawnBudget.message.clear();
+        hud.spawnBudget.lastDeferred = 0;
     }
 
     if (context.orderActive)
     {
-        if (tickTimer(context.orderTimer))
-        {
-            requestSync = true;
-        }
+        tickTimer(context.orderTimer);
         if (context.orderTimer <= 0.0f)
         {
             context.orderActive = false;
             sim.stance = sim.defaultStance;
-            requestSync = true;
         }
     }
 
     if (sim.result != GameResult::Playing)
     {
-        if (requestSync)
-        {
-            context.requestComponentSync();
-        }
         return;
     }
 
@@ -133,11 +115,10 @@ void MoraleSystem::update(float dt, SystemContext &context)
         if (wavesFinished && noEnemies && context.timeSinceLastEnemySpawn >= sim.config.victory_grace)
         {
             sim.setResult(GameResult::Victory, "Victory");
-            requestSync = true;
         }
     }
 
-    std::vector<Unit> &yunas = context.yunaUnits;
+    ComponentPool<Unit> &yunas = context.allies;
     bool moraleChanged = false;
     if (m_lastStates.size() != yunas.size())
     {
@@ -153,25 +134,25 @@ void MoraleSystem::update(float dt, SystemContext &context)
     MoraleUpdateEvent moraleEvent;
 
     const MoraleConfig &moraleCfg = sim.config.morale;
-    auto applyEffects = [&](Unit &unit, const MoraleModifiers &mods, const MoraleBehaviorConfig &behavior,
+    auto applyEffects = [&](UnitRef unit, const MoraleModifiers &mods, const MoraleBehaviorConfig &behavior,
                             const MoraleStateConfig *stateConfig, bool stateChanged) {
         MoraleModifiers clamped = clampModifiers(mods);
-        unit.moraleSpeedMultiplier = clamped.speed;
-        unit.moraleAccuracyMultiplier = clamped.accuracy;
-        unit.moraleDefenseMultiplier = clamped.defense;
-        unit.moraleAttackIntervalMultiplier = clamped.attackInterval;
-        unit.moraleIgnoreOrdersChance = std::clamp(behavior.ignoreOrdersChance, 0.0f, 1.0f);
-        unit.moraleDetectionRadiusMultiplier =
+        unit.moraleSpeedMultiplier() = clamped.speed;
+        unit.moraleAccuracyMultiplier() = clamped.accuracy;
+        unit.moraleDefenseMultiplier() = clamped.defense;
+        unit.moraleAttackIntervalMultiplier() = clamped.attackInterval;
+        unit.moraleIgnoreOrdersChance() = std::clamp(behavior.ignoreOrdersChance, 0.0f, 1.0f);
+        unit.moraleDetectionRadiusMultiplier() =
             std::max(0.0f, std::isfinite(behavior.detectionRadiusMultiplier) ? behavior.detectionRadiusMultiplier : 1.0f);
-        unit.moraleSpawnDelayMultiplier =
+        unit.moraleSpawnDelayMultiplier() =
             behavior.spawnDelayMultiplier > 0.0f ? behavior.spawnDelayMultiplier : 1.0f;
         float retargetMul = std::isfinite(behavior.retargetCooldownMultiplier) ? behavior.retargetCooldownMultiplier : 1.0f;
         if (retargetMul <= 0.0f)
         {
             retargetMul = 0.01f;
         }
-        unit.moraleRetargetCooldownMultiplier = retargetMul;
-        unit.moraleCommandObeyBonus = std::clamp(behavior.commandObeyBonus, 0.0f, 1.0f);
+        unit.moraleRetargetCooldownMultiplier() = retargetMul;
+        unit.moraleCommandObeyBonus() = std::clamp(behavior.commandObeyBonus, 0.0f, 1.0f);
 
         const bool hasRetreat = behavior.retreat.enabled && behavior.retreat.duration > 0.0f &&
                                 behavior.retreat.speedMultiplier > 0.0f;
@@ -179,30 +160,30 @@ void MoraleSystem::update(float dt, SystemContext &context)
                                      stateConfig->retreatCheck.chance > 0.0f;
         if (hasRetreat)
         {
-            unit.moraleRetreatDuration = behavior.retreat.duration;
-            unit.moraleRetreatSpeedMultiplier = std::max(behavior.retreat.speedMultiplier, 0.0f);
-            unit.moraleRetreatHomewardBias = std::clamp(behavior.retreat.homewardBias, 0.0f, 1.0f);
+            unit.moraleRetreatDuration() = behavior.retreat.duration;
+            unit.moraleRetreatSpeedMultiplier() = std::max(behavior.retreat.speedMultiplier, 0.0f);
+            unit.moraleRetreatHomewardBias() = std::clamp(behavior.retreat.homewardBias, 0.0f, 1.0f);
             if (!hasRetreatCheck)
             {
-                if (stateChanged || !unit.moraleRetreatActive)
+                if (stateChanged || !unit.moraleRetreatActive())
                 {
-                    unit.moraleRetreatActive = true;
-                    unit.moraleRetreatTimer = behavior.retreat.duration;
+                    unit.moraleRetreatActive() = true;
+                    unit.moraleRetreatTimer() = behavior.retreat.duration;
                 }
             }
             else if (stateChanged)
             {
-                unit.moraleRetreatActive = false;
-                unit.moraleRetreatTimer = 0.0f;
+                unit.moraleRetreatActive() = false;
+                unit.moraleRetreatTimer() = 0.0f;
             }
         }
         else
         {
-            unit.moraleRetreatActive = false;
-            unit.moraleRetreatTimer = 0.0f;
-            unit.moraleRetreatSpeedMultiplier = 1.0f;
-            unit.moraleRetreatHomewardBias = 1.0f;
-            unit.moraleRetreatDuration = 0.0f;
+            unit.moraleRetreatActive() = false;
+            unit.moraleRetreatTimer() = 0.0f;
+            unit.moraleRetreatSpeedMultiplier() = 1.0f;
+            unit.moraleRetreatHomewardBias() = 1.0f;
+            unit.moraleRetreatDuration() = 0.0f;
         }
 
         float retreatInterval = 0.0f;
@@ -211,36 +192,36 @@ void MoraleSystem::update(float dt, SystemContext &context)
         {
             retreatInterval = std::max(0.0f, stateConfig->retreatCheck.interval);
             retreatChance = std::clamp(stateConfig->retreatCheck.chance, 0.0f, 1.0f);
-            if (unit.moraleRetreatDuration <= 0.0f)
+            if (unit.moraleRetreatDuration() <= 0.0f)
             {
                 retreatInterval = 0.0f;
                 retreatChance = 0.0f;
             }
         }
-        unit.moraleRetreatCheckInterval = retreatInterval;
-        unit.moraleRetreatCheckChance = retreatChance;
+        unit.moraleRetreatCheckInterval() = retreatInterval;
+        unit.moraleRetreatCheckChance() = retreatChance;
         if (stateChanged)
         {
-            unit.moraleRetreatCheckTimer = retreatInterval;
+            unit.moraleRetreatCheckTimer() = retreatInterval;
         }
 
         if (stateChanged)
         {
-            unit.moraleIgnoreOrdersTimer = 0.0f;
-            unit.moraleIgnoringOrders = false;
+            unit.moraleIgnoreOrdersTimer() = 0.0f;
+            unit.moraleIgnoringOrders() = false;
         }
     };
 
-    auto setState = [&](Unit &unit, MoraleState state, float overrideDuration, bool comfortShield,
+    auto setState = [&](UnitRef unit, MoraleState state, float overrideDuration, bool comfortShield,
                         const MoraleStateConfig *overrideState = nullptr) {
-        bool changed = unit.moraleState != state || unit.moraleComfortShield != comfortShield;
-        unit.moraleState = state;
-        unit.moraleComfortShield = comfortShield;
+        bool changed = unit.moraleState() != state || unit.moraleComfortShield() != comfortShield;
+        unit.moraleState() = state;
+        unit.moraleComfortShield() = comfortShield;
         if (comfortShield)
         {
-            unit.moraleImmunityTimer = 0.0f;
-            unit.moraleBarrierActive = false;
-            unit.moraleBarrierLingerTimer = 0.0f;
+            unit.moraleImmunityTimer() = 0.0f;
+            unit.moraleBarrierActive() = false;
+            unit.moraleBarrierLingerTimer() = 0.0f;
         }
 
         const MoraleStateConfig *configState = overrideState ? overrideState : lookupStateConfig(moraleCfg, state);
@@ -286,9 +267,10 @@ void MoraleSystem::update(float dt, SystemContext &context)
             }
             else if (moraleCfg.reviveBarrier > 0.0f)
             {
-                unit.moraleImmunityTimer = std::max(unit.moraleImmunityTimer, moraleCfg.reviveBarrier);
-                unit.moraleBarrierActive = true;
-                unit.moraleBarrierLingerTimer = std::max(unit.moraleBarrierLingerTimer, moraleCfg.reviveBarrierLinger);
+                unit.moraleImmunityTimer() = std::max(unit.moraleImmunityTimer(), moraleCfg.reviveBarrier);
+                unit.moraleBarrierActive() = true;
+                unit.moraleBarrierLingerTimer() =
+                    std::max(unit.moraleBarrierLingerTimer(), moraleCfg.reviveBarrierLinger);
                 if (desiredDuration <= 0.0f)
                 {
                     desiredDuration = std::max(moraleCfg.reviveBarrier, moraleCfg.shielded.duration);
@@ -297,14 +279,14 @@ void MoraleSystem::update(float dt, SystemContext &context)
         }
 
         bool effectsChanged = changed;
-        if (std::fabs(unit.moraleTimer - desiredDuration) > 0.0001f)
+        if (std::fabs(unit.moraleTimer() - desiredDuration) > 0.0001f)
         {
-            unit.moraleTimer = desiredDuration;
+            unit.moraleTimer() = desiredDuration;
             effectsChanged = true;
         }
         else if (state == MoraleState::Shielded && comfortShield)
         {
-            unit.moraleTimer = 0.0f;
+            unit.moraleTimer() = 0.0f;
         }
 
         applyEffects(unit, modifiers, behavior, configState, effectsChanged);
@@ -403,285 +385,339 @@ void MoraleSystem::update(float dt, SystemContext &context)
     std::size_t mesomesoCount = 0;
     float spawnMultiplier = 1.0f;
 
-    for (std::size_t i = 0; i < yunas.size(); ++i)
-    {
-        Unit &unit = yunas[i];
-        const bool isNewUnit = i >= m_knownUnits;
-        if (isNewUnit)
+    // The per-unit update runs in three passes so the unit loops can be split across threads. Retreat checks
+    // are counted in the first pass and rolled in unit order in the second, which keeps the rng sequence of a
+    // single loop; totals are summed in unit order afterwards.
+    const std::size_t unitCount = yunas.size();
+    m_unitChanged.assign(unitCount, 0);
+    m_retreatChecks.assign(unitCount, 0);
+    auto forEachUnitChunk = [&](auto &&fn) {
+        if (context.jobs)
         {
-            sim.resetUnitMorale(unit);
-            moraleChanged = true;
-            bool appliedSpawnEffect = false;
-            const bool leaderDownEligible = !commanderAlive && moraleCfg.spawnWhileLeaderDown.applyLightMesomeso &&
-                                             moraleCfg.spawnLightInjury.duration > 0.0f;
-            if ((leaderDownEligible && (m_leaderDownSpawnTimer > 0.0f || unit.moraleLightMesomesoPending)))
+            context.jobs->parallelFor(unitCount, kUnitsPerJob, fn);
+        }
+        else
+        {
+            fn(std::size_t{0}, unitCount);
+        }
+    };
+
+    forEachUnitChunk([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            UnitRef unit = yunas[i];
+            bool changed = false;
+            const bool isNewUnit = i >= m_knownUnits;
+            if (isNewUnit)
             {
-                if (setState(unit, MoraleState::Mesomeso, moraleCfg.spawnLightInjury.duration, false,
-                              &moraleCfg.spawnLightInjury))
+                sim.resetUnitMorale(unit);
+                changed = true;
+                bool appliedSpawnEffect = false;
+                const bool leaderDownEligible = !commanderAlive && moraleCfg.spawnWhileLeaderDown.applyLightMesomeso &&
+                                                 moraleCfg.spawnLightInjury.duration > 0.0f;
+                if ((leaderDownEligible && (m_leaderDownSpawnTimer > 0.0f || unit.moraleLightMesomesoPending())))
+                {
+                    if (setState(unit, MoraleState::Mesomeso, moraleCfg.spawnLightInjury.duration, false,
+                                  &moraleCfg.spawnLightInjury))
+                    {
+                        changed = true;
+                    }
+                    appliedSpawnEffect = true;
+                }
+                if (!appliedSpawnEffect && moraleCfg.spawnLightInjury.duration > 0.0f)
                 {
-                    moraleChanged = true;
+                    if (setState(unit, MoraleState::Recovering, moraleCfg.spawnLightInjury.duration, false,
+                                  &moraleCfg.spawnLightInjury))
+                    {
+                        changed = true;
+                    }
                 }
-                appliedSpawnEffect = true;
+                unit.moraleLightMesomesoPending() = false;
             }
-            if (!appliedSpawnEffect && moraleCfg.spawnLightInjury.duration > 0.0f)
+
+            if (unit.moraleImmunityTimer() > 0.0f)
             {
-                if (setState(unit, MoraleState::Recovering, moraleCfg.spawnLightInjury.duration, false,
-                              &moraleCfg.spawnLightInjury))
+                float before = unit.moraleImmunityTimer();
+                unit.moraleImmunityTimer() = std::max(0.0f, unit.moraleImmunityTimer() - dt);
+                if (before != unit.moraleImmunityTimer())
+                {
+                    changed = true;
+                }
+                if (unit.moraleImmunityTimer() <= 0.0f)
                 {
-                    moraleChanged = true;
+                    unit.moraleBarrierLingerTimer() =
+                    std::max(unit.moraleBarrierLingerTimer(), moraleCfg.reviveBarrierLinger);
                 }
             }
-            unit.moraleLightMesomesoPending = false;
-        }
 
-        if (unit.moraleImmunityTimer > 0.0f)
-        {
-            float before = unit.moraleImmunityTimer;
-            unit.moraleImmunityTimer = std::max(0.0f, unit.moraleImmunityTimer - dt);
-            if (before != unit.moraleImmunityTimer)
+            if (unit.moraleBarrierActive() && unit.moraleImmunityTimer() <= 0.0f)
             {
-                moraleChanged = true;
+                if (unit.moraleBarrierLingerTimer() > 0.0f)
+                {
+                    float before = unit.moraleBarrierLingerTimer();
+                    unit.moraleBarrierLingerTimer() = std::max(0.0f, unit.moraleBarrierLingerTimer() - dt);
+                    if (before != unit.moraleBarrierLingerTimer())
+                    {
+                        changed = true;
+                    }
+                    if (unit.moraleBarrierLingerTimer() <= 0.0f)
+                    {
+                        unit.moraleBarrierActive() = false;
+                        unit.moraleBarrierLingerTimer() = 0.0f;
+                    }
+                }
+                else if (unit.moraleBarrierActive())
+                {
+                    unit.moraleBarrierActive() = false;
+                    unit.moraleBarrierLingerTimer() = 0.0f;
+                    changed = true;
+                }
             }
-            if (unit.moraleImmunityTimer <= 0.0f)
+
+            if (unit.moraleRetreatActive())
             {
-                unit.moraleBarrierLingerTimer = std::max(unit.moraleBarrierLingerTimer, moraleCfg.reviveBarrierLinger);
+                float before = unit.moraleRetreatTimer();
+                unit.moraleRetreatTimer() = std::max(0.0f, unit.moraleRetreatTimer() - dt);
+                if (before != unit.moraleRetreatTimer())
+                {
+                    changed = true;
+                }
+                if (unit.moraleRetreatTimer() <= 0.0f)
+                {
+                    unit.moraleRetreatActive() = false;
+                }
             }
-        }
-
-        if (unit.moraleBarrierActive && unit.moraleImmunityTimer <= 0.0f)
-        {
-            if (unit.moraleBarrierLingerTimer > 0.0f)
+            else if (unit.moraleRetreatCheckInterval() > 0.0f && unit.moraleRetreatCheckChance() > 0.0f)
             {
-                float before = unit.moraleBarrierLingerTimer;
-                unit.moraleBarrierLingerTimer = std::max(0.0f, unit.moraleBarrierLingerTimer - dt);
-                if (before != unit.moraleBarrierLingerTimer)
+                unit.moraleRetreatCheckTimer() -= dt;
+                std::uint32_t checks = 0;
+                while (unit.moraleRetreatCheckTimer() <= 0.0f && unit.moraleRetreatCheckInterval() > 0.0f)
+                {
+                    unit.moraleRetreatCheckTimer() += unit.moraleRetreatCheckInterval();
+                    ++checks;
+                }
+                if (unit.moraleRetreatDuration() > 0.0f)
                 {
-                    moraleChanged = true;
+                    m_retreatChecks[i] = checks;
                 }
-                if (unit.moraleBarrierLingerTimer <= 0.0f)
+                if (unit.moraleRetreatCheckTimer() < 0.0f)
                 {
-                    unit.moraleBarrierActive = false;
-                    unit.moraleBarrierLingerTimer = 0.0f;
+                    unit.moraleRetreatCheckTimer() = 0.0f;
                 }
             }
-            else if (unit.moraleBarrierActive)
+            else
             {
-                unit.moraleBarrierActive = false;
-                unit.moraleBarrierLingerTimer = 0.0f;
-                moraleChanged = true;
+                unit.moraleRetreatCheckTimer() = 0.0f;
             }
+
+            m_unitChanged[i] = changed ? 1 : 0;
         }
+    });
 
-        if (unit.moraleRetreatActive)
+    for (std::size_t i = 0; i < unitCount; ++i)
+    {
+        UnitRef unit = yunas[i];
+        for (std::uint32_t check = 0; check < m_retreatChecks[i]; ++check)
         {
-            float before = unit.moraleRetreatTimer;
-            unit.moraleRetreatTimer = std::max(0.0f, unit.moraleRetreatTimer - dt);
-            if (before != unit.moraleRetreatTimer)
-            {
-                moraleChanged = true;
-            }
-            if (unit.moraleRetreatTimer <= 0.0f)
+            std::uniform_real_distribution<float> roll(0.0f, 1.0f);
+            if (roll(sim.rng) < unit.moraleRetreatCheckChance())
             {
-                unit.moraleRetreatActive = false;
+                unit.moraleRetreatActive() = true;
+                unit.moraleRetreatTimer() = unit.moraleRetreatDuration();
+                m_unitChanged[i] = 1;
+                break;
             }
         }
-        else if (unit.moraleRetreatCheckInterval > 0.0f && unit.moraleRetreatCheckChance > 0.0f)
+    }
+
+    forEachUnitChunk([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
         {
-            unit.moraleRetreatCheckTimer -= dt;
-            bool triggered = false;
-            while (unit.moraleRetreatCheckTimer <= 0.0f && unit.moraleRetreatCheckInterval > 0.0f)
+            UnitRef unit = yunas[i];
+            bool changed = false;
+            if (m_applyReviveBarrier && moraleCfg.reviveBarrier > 0.0f && !unit.moraleComfortShield())
             {
-                unit.moraleRetreatCheckTimer += unit.moraleRetreatCheckInterval;
-                if (!triggered && unit.moraleRetreatDuration > 0.0f)
+                if (setState(unit, MoraleState::Shielded,
+                             std::max(moraleCfg.reviveBarrier, moraleCfg.shielded.duration), false))
                 {
-                    std::uniform_real_distribution<float> roll(0.0f, 1.0f);
-                    if (roll(sim.rng) < unit.moraleRetreatCheckChance)
-                    {
-                        unit.moraleRetreatActive = true;
-                        unit.moraleRetreatTimer = unit.moraleRetreatDuration;
-                        moraleChanged = true;
-                        triggered = true;
-                    }
+                    changed = true;
                 }
             }
-            if (unit.moraleRetreatCheckTimer < 0.0f)
+
+            bool inComfort = false;
+            if (comfortRadiusSq >= 0.0f)
             {
-                unit.moraleRetreatCheckTimer = 0.0f;
+                const float distSq = lengthSq(unit.pos() - sim.basePos);
+                inComfort = distSq <= comfortRadiusSq;
             }
-        }
-        else
-        {
-            unit.moraleRetreatCheckTimer = 0.0f;
-        }
 
-        if (m_applyReviveBarrier && moraleCfg.reviveBarrier > 0.0f && !unit.moraleComfortShield)
-        {
-            if (setState(unit, MoraleState::Shielded,
-                         std::max(moraleCfg.reviveBarrier, moraleCfg.shielded.duration), false))
+            if (inComfort)
             {
-                moraleChanged = true;
+                if (setState(unit, MoraleState::Shielded, 0.0f, true))
+                {
+                    changed = true;
+                }
             }
-        }
-
-        bool inComfort = false;
-        if (comfortRadiusSq >= 0.0f)
-        {
-            const float distSq = lengthSq(unit.pos - sim.basePos);
-            inComfort = distSq <= comfortRadiusSq;
-        }
-
-        if (inComfort)
-        {
-            if (setState(unit, MoraleState::Shielded, 0.0f, true))
+            else if (unit.moraleComfortShield())
             {
-                moraleChanged = true;
+                unit.moraleComfortShield() = false;
+                changed = true;
             }
-        }
-        else if (unit.moraleComfortShield)
-        {
-            unit.moraleComfortShield = false;
-            moraleChanged = true;
-        }
 
-        const bool immune = unit.moraleComfortShield || unit.moraleImmunityTimer > 0.0f;
+            const bool immune = unit.moraleComfortShield() || unit.moraleImmunityTimer() > 0.0f;
 
-        if (!commanderAlive && !immune)
-        {
-            if (m_leaderDownTimer > 0.0f)
+            if (!commanderAlive && !immune)
             {
-                if (unit.moraleState != MoraleState::LeaderDown)
+                if (m_leaderDownTimer > 0.0f)
                 {
-                    if (setState(unit, MoraleState::LeaderDown, m_leaderDownTimer, false))
+                    if (unit.moraleState() != MoraleState::LeaderDown)
                     {
-                        moraleChanged = true;
+                        if (setState(unit, MoraleState::LeaderDown, m_leaderDownTimer, false))
+                        {
+                            changed = true;
+                        }
                     }
                 }
-            }
-            else
-            {
-                MoraleState target = unit.effectiveFollower ? MoraleState::Panic : MoraleState::Mesomeso;
-                if (unit.moraleState != target)
+                else
                 {
-                    if (setState(unit, target, -1.0f, false))
+                    MoraleState target = unit.effectiveFollower() ? MoraleState::Panic : MoraleState::Mesomeso;
+                    if (unit.moraleState() != target)
                     {
-                        moraleChanged = true;
+                        if (setState(unit, target, -1.0f, false))
+                        {
+                            changed = true;
+                        }
                     }
                 }
             }
-        }
-        else if (commanderAlive && !immune)
-        {
-            if (unit.moraleState == MoraleState::LeaderDown)
+            else if (commanderAlive && !immune)
             {
-                if (setState(unit, MoraleState::Recovering, moraleCfg.recovering.duration, false))
+                if (unit.moraleState() == MoraleState::LeaderDown)
                 {
-                    moraleChanged = true;
+                    if (setState(unit, MoraleState::Recovering, moraleCfg.recovering.duration, false))
+                    {
+                        changed = true;
+                    }
                 }
             }
-        }
 
-        if (unit.moraleTimer > 0.0f)
-        {
-            float before = unit.moraleTimer;
-            unit.moraleTimer = std::max(0.0f, unit.moraleTimer - dt);
-            if (before != unit.moraleTimer)
+            if (unit.moraleTimer() > 0.0f)
             {
-                moraleChanged = true;
+                float before = unit.moraleTimer();
+                unit.moraleTimer() = std::max(0.0f, unit.moraleTimer() - dt);
+                if (before != unit.moraleTimer())
+                {
+                    changed = true;
+                }
             }
-        }
 
-        if (unit.moraleTimer <= 0.0f && !immune)
-        {
-            switch (unit.moraleState)
+            if (unit.moraleTimer() <= 0.0f && !immune)
             {
-            case MoraleState::LeaderDown:
-                if (!commanderAlive)
+                switch (unit.moraleState())
                 {
+                case MoraleState::LeaderDown:
+                    if (!commanderAlive)
                     {
-                        MoraleState target = unit.effectiveFollower ? MoraleState::Panic : MoraleState::Mesomeso;
-                        if (setState(unit, target, -1.0f, false))
                         {
-                            moraleChanged = true;
+                            MoraleState target = unit.effectiveFollower() ? MoraleState::Panic : MoraleState::Mesomeso;
+                            if (setState(unit, target, -1.0f, false))
+                            {
+                                changed = true;
+                            }
                         }
                     }
-                }
-                else
-                {
+                    else
+                    {
+                        if (setState(unit, MoraleState::Recovering, moraleCfg.recovering.duration, false))
+                        {
+                            changed = true;
+                        }
+                    }
+                    break;
+                case MoraleState::Panic:
+                case MoraleState::Mesomeso:
                     if (setState(unit, MoraleState::Recovering, moraleCfg.recovering.duration, false))
                     {
-                        moraleChanged = true;
+                        changed = true;
                     }
-                }
-                break;
-            case MoraleState::Panic:
-            case MoraleState::Mesomeso:
-                if (setState(unit, MoraleState::Recovering, moraleCfg.recovering.duration, false))
-                {
-                    moraleChanged = true;
-                }
-                break;
-            case MoraleState::Recovering:
-                if (setState(unit, MoraleState::Stable, 0.0f, false))
-                {
-                    moraleChanged = true;
-                }
-                break;
-            case MoraleState::Shielded:
-                if (!commanderAlive)
-                {
-                    if (m_leaderDownTimer > 0.0f)
+                    break;
+                case MoraleState::Recovering:
+                    if (setState(unit, MoraleState::Stable, 0.0f, false))
                     {
-                        if (setState(unit, MoraleState::LeaderDown, m_leaderDownTimer, false))
+                        changed = true;
+                    }
+                    break;
+                case MoraleState::Shielded:
+                    if (!commanderAlive)
+                    {
+                        if (m_leaderDownTimer > 0.0f)
                         {
-                            moraleChanged = true;
+                            if (setState(unit, MoraleState::LeaderDown, m_leaderDownTimer, false))
+                            {
+                                changed = true;
+                            }
+                        }
+                        else
+                        {
+                            MoraleState target = unit.effectiveFollower() ? MoraleState::Panic : MoraleState::Mesomeso;
+                            if (setState(unit, target, -1.0f, false))
+                            {
+                                changed = true;
+                            }
                         }
                     }
                     else
                     {
-                        MoraleState target = unit.effectiveFollower ? MoraleState::Panic : MoraleState::Mesomeso;
-                        if (setState(unit, target, -1.0f, false))
+                        if (setState(unit, MoraleState::Recovering, moraleCfg.recovering.duration, false))
                         {
-                            moraleChanged = true;
+                            changed = true;
                         }
                     }
+                    break;
+                default:
+                    break;
                 }
-                else
-                {
-                    if (setState(unit, MoraleState::Recovering, moraleCfg.recovering.duration, false))
-                    {
-                        moraleChanged = true;
-                    }
-                }
-                break;
-            default:
-                break;
             }
+
+            if (changed)
+            {
+                m_unitChanged[i] = 1;
+            }
+        }
+    });
+
+    for (std::size_t i = 0; i < unitCount; ++i)
+    {
+        ConstUnitRef unit = yunas[i];
+        if (m_unitChanged[i])
+        {
+            moraleChanged = true;
         }
 
-        totalSpeed += unit.moraleSpeedMultiplier;
-        totalAccuracy += unit.moraleAccuracyMultiplier;
-        totalDefense += unit.moraleDefenseMultiplier;
+        totalSpeed += unit.moraleSpeedMultiplier();
+        totalAccuracy += unit.moraleAccuracyMultiplier();
+        totalDefense += unit.moraleDefenseMultiplier();
 
-        if (unit.moraleState == MoraleState::Panic)
+        if (unit.moraleState() == MoraleState::Panic)
         {
             ++panicCount;
         }
-        else if (unit.moraleState == MoraleState::Mesomeso)
+        else if (unit.moraleState() == MoraleState::Mesomeso)
         {
             ++mesomesoCount;
         }
 
-        if (unit.moraleState != MoraleState::Stable)
+        if (unit.moraleState() != MoraleState::Stable)
         {
-            moraleEvent.icons.push_back(MoraleHudIcon{false, i, unit.moraleState});
+            moraleEvent.icons.push_back(MoraleHudIcon{false, i, unit.moraleState()});
         }
 
-        spawnMultiplier = std::max(spawnMultiplier, unit.moraleSpawnDelayMultiplier);
+        spawnMultiplier = std::max(spawnMultiplier, unit.moraleSpawnDelayMultiplier());
 
-        if (m_lastStates[i] != unit.moraleState)
+        if (m_lastStates[i] != unit.moraleState())
         {
             moraleChanged = true;
-            m_lastStates[i] = unit.moraleState;
+            m_lastStates[i] = unit.moraleState();
         }
     }
 
@@ -809,22 +845,63 @@ void MoraleSystem::update(float dt, SystemContext &context)
         }
     }
 
-    if (moraleChanged)
-    {
-        requestSync = true;
-    }
-
     if (context.eventBus && (moraleChanged || !moraleEvent.icons.empty() || !moraleEvent.telemetry.empty()))
     {
         EventContext eventContext;
         eventContext.payload = std::move(moraleEvent);
         context.eventBus->dispatch(MoraleUpdateEventName, eventContext);
     }
+}
 
-    if (requestSync)
-    {
-        context.requestComponentSync();
-    }
+SystemAccess MoraleSystem::access() const
+{
+    return SystemAccess{}
+        .read(SystemData::Commander)
+        .read(SystemData::Enemies)
+        .read(SystemData::Mission)
+        .read(SystemData::Spawning)
+        .write(SystemData::Allies)
+        .write(SystemData::Hud)
+        .write(SystemData::Rng)
+        .write(SystemData::Simulation)
+        .write(SystemData::Events);
+}
+
+const char *MoraleSystem::name() const
+{
+    return "MoraleSystem";
+}
+
+template <typename Archive, typename Self>
+void MoraleSystem::transferState(Archive &archive, Self &self)
+{
+    archive.field(self.m_commanderAlive);
+    archive.field(self.m_leaderDownTimer);
+    archive.field(self.m_commanderBarrierTimer);
+    archive.field(self.m_leaderDownSpawnTimer);
+    archive.field(self.m_knownUnits);
+    archive.sequence(self.m_lastStates);
+    archive.field(self.m_lastCommanderState);
+    archive.field(self.m_announcedLeaderDown);
+    archive.field(self.m_announcedPanic);
+    archive.field(self.m_announcedRecovery);
+    archive.field(self.m_applyReviveBarrier);
+    archive.field(self.m_lastHudLeaderDownTimer);
+    archive.field(self.m_lastHudBarrierTimer);
+    archive.field(self.m_lastHudPanic);
+    archive.field(self.m_lastHudMesomeso);
+    archive.field(self.m_lastHudCommanderState);
+    archive.field(self.m_lastMoraleSpawnMultiplier);
+}
+
+void MoraleSystem::saveState(StateWriter &out) const
+{
+    transferState(out, *this);
+}
+
+void MoraleSystem::loadState(StateReader &in)
+{
+    transferState(in, *this);
 }
 
 } // namespace world::systems
@@ -3,8 +3,9 @@
 #include "world/MoraleTypes.h"
 #include "world/systems/SystemContext.h"
 
-#include <vector>
+#include <cstdint>
 #include <limits>
+#include <vector>
 
 namespace world::systems
 {
@@ -15,14 +16,23 @@ class MoraleSystem : public ISystem
     MoraleSystem() = default;
 
     void update(float dt, SystemContext &context) override;
+    SystemAccess access() const override;
+    const char *name() const override;
+    void saveState(StateWriter &out) const override;
+    void loadState(StateReader &in) override;
 
   private:
+    template <typename Archive, typename Self>
+    static void transferState(Archive &archive, Self &self);
+
     bool m_commanderAlive = true;
     float m_leaderDownTimer = 0.0f;
     float m_commanderBarrierTimer = 0.0f;
     float m_leaderDownSpawnTimer = 0.0f;
     std::size_t m_knownUnits = 0;
     std::vector<MoraleState> m_lastStates;
+    std::vector<std::uint8_t> m_unitChanged;
+    std::vector<std::uint32_t> m_retreatChecks;
     MoraleState m_lastCommanderState = MoraleState::Stable;
     bool m_announcedLeaderDown = false;
     bool m_announcedPanic = false;
@@ -1,46 +1,67 @@
 #include "world/systems/MovementSystem.h"
 
 #include "core/Vec2.h"
+#include "world/JobScheduler.h"
 #include "world/LegacySimulation.h"
+#include "world/MovementKernel.h"
+
+#include <cstddef>
 
 namespace world::systems
 {
+namespace
+{
+
+constexpr std::size_t kUnitsPerJob = 1024;
+
+} // namespace
 
 void MovementSystem::update(float dt, SystemContext &context)
 {
     LegacySimulation &sim = context.simulation;
     CommanderUnit &commander = context.commander;
-    bool anyMovement = false;
 
     if (commander.alive && commander.hasMoveIntent)
     {
         const float speedPx = sim.commanderStats.speed_u_s * sim.config.pixels_per_unit;
         commander.pos += commander.moveIntent * (speedPx * dt);
         sim.clampToWorld(commander.pos, commander.radius);
-        anyMovement = true;
     }
 
     commander.moveIntent = {0.0f, 0.0f};
     commander.hasMoveIntent = false;
 
-    auto &yunas = context.yunaUnits;
-    for (Unit &yuna : yunas)
+    UnitColumns &yunas = context.allies.storage();
+    Vec2 *positions = yunas.posColumn().data();
+    Vec2 *velocities = yunas.desiredVelocityColumn().data();
+    BoolColumnSlot *hasVelocity = yunas.hasDesiredVelocityColumn().data();
+    const float *radii = yunas.radiusColumn().data();
+    auto integrate = [&](std::size_t begin, std::size_t end) {
+        movement::integrateAndClamp(positions + begin, velocities + begin, hasVelocity + begin, radii + begin,
+                                    end - begin, dt, sim.worldMin, sim.worldMax);
+    };
+    if (context.jobs)
     {
-        if (yuna.hasDesiredVelocity)
-        {
-            yuna.pos += yuna.desiredVelocity * dt;
-            sim.clampToWorld(yuna.pos, yuna.radius);
-            anyMovement = true;
-        }
-        yuna.desiredVelocity = {0.0f, 0.0f};
-        yuna.hasDesiredVelocity = false;
+        context.jobs->parallelFor(yunas.size(), kUnitsPerJob, integrate);
     }
-
-    if (anyMovement)
+    else
     {
-        context.requestComponentSync();
+        integrate(0, yunas.size());
     }
 }
 
+SystemAccess MovementSystem::access() const
+{
+    return SystemAccess{}
+        .read(SystemData::Simulation)
+        .write(SystemData::Commander)
+        .write(SystemData::Allies);
+}
+
+const char *MovementSystem::name() const
+{
+    return "MovementSystem";
+}
+
 } // namespace world::systems
 
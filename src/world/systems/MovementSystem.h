@@ -11,6 +11,8 @@ class MovementSystem : public ISystem
     MovementSystem() = default;
 
     void update(float dt, SystemContext &context) override;
+    SystemAccess access() const override;
+    const char *name() const override;
 };
 
 } // namespace world::systems
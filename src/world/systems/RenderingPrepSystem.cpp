@@ -11,9 +11,12 @@ namespace world::systems
 namespace
 {
 
+constexpr float kCrowdRadius = 32.0f;
+constexpr std::uint32_t kCrowdNeighborLimit = 4;
+
 std::uint8_t crowdAlphaForNeighborCount(int neighbors)
 {
-    if (neighbors >= 4)
+    if (neighbors >= static_cast<int>(kCrowdNeighborLimit))
     {
         return static_cast<std::uint8_t>(255 * 0.3f);
     }
@@ -95,61 +98,49 @@ void RenderingPrepSystem::update(float, SystemContext &context)
         queue.moraleIcons.push_back(commanderIcon);
     }
 
+    const auto &allyPositions = sim.yunas.storage().posColumn();
+    sim.allyDensity.build(sim.worldMin, sim.worldMax, kCrowdRadius, allyCount,
+                          [&](std::size_t i) { return allyPositions[i]; });
+
     FrameAllocator::Allocator<std::uint8_t> alphaAlloc(context.frameAllocator);
     std::vector<std::uint8_t, FrameAllocator::Allocator<std::uint8_t>> yunaAlpha(allyCount, 255, alphaAlloc);
     if (allyCount > 1)
     {
-        const float crowdRadiusSq = 32.0f * 32.0f;
         for (std::size_t i = 0; i < allyCount; ++i)
         {
-            int neighbors = 0;
-            for (std::size_t j = 0; j < allyCount; ++j)
-            {
-                if (i == j)
-                {
-                    continue;
-                }
-                if (lengthSq(sim.yunas[i].pos - sim.yunas[j].pos) <= crowdRadiusSq)
-                {
-                    ++neighbors;
-                    if (neighbors >= 4)
-                    {
-                        break;
-                    }
-                }
-            }
-            yunaAlpha[i] = crowdAlphaForNeighborCount(neighbors);
+            const std::uint32_t neighbors = sim.allyDensity.countNeighbors(i, kCrowdRadius, kCrowdNeighborLimit);
+            yunaAlpha[i] = crowdAlphaForNeighborCount(static_cast<int>(neighbors));
         }
     }
 
     std::size_t followerCount = 0;
     for (std::size_t i = 0; i < allyCount; ++i)
     {
-        const Unit &yuna = sim.yunas[i];
-        if (yuna.effectiveFollower)
+        ConstUnitRef yuna = sim.yunas[i];
+        if (yuna.effectiveFollower())
         {
             ++followerCount;
         }
 
         LegacySimulation::RenderQueue::AllySprite allySprite;
-        allySprite.position = yuna.pos;
-        allySprite.radius = yuna.radius;
+        allySprite.position = yuna.pos();
+        allySprite.radius = yuna.radius();
         allySprite.commander = false;
-        allySprite.job = yuna.job.job;
+        allySprite.job = yuna.job().job;
         allySprite.alpha = yunaAlpha[i];
-        allySprite.morale = yuna.moraleState;
-        allySprite.temperamentDefinition = yuna.temperament.definition;
-        allySprite.temperamentBehavior = yuna.temperament.currentBehavior;
-        allySprite.temperamentMimicActive = yuna.temperament.mimicActive;
-        allySprite.temperamentMimicBehavior = yuna.temperament.mimicBehavior;
+        allySprite.morale = yuna.moraleState();
+        allySprite.temperamentDefinition = yuna.temperament().definition;
+        allySprite.temperamentBehavior = yuna.temperament().currentBehavior;
+        allySprite.temperamentMimicActive = yuna.temperament().mimicActive;
+        allySprite.temperamentMimicBehavior = yuna.temperament().mimicBehavior;
         allySprite.unitIndex = i;
         allySprite.hasUnitIndex = true;
         queue.allies.push_back(allySprite);
 
         LegacySimulation::RenderQueue::MoraleIcon icon;
-        icon.position = yuna.pos;
-        icon.radius = yuna.radius;
-        icon.state = yuna.moraleState;
+        icon.position = yuna.pos();
+        icon.radius = yuna.radius();
+        icon.state = yuna.moraleState();
         icon.commander = false;
         icon.unitIndex = i;
         queue.moraleIcons.push_back(icon);
@@ -217,5 +208,24 @@ void RenderingPrepSystem::update(float, SystemContext &context)
     }
 }
 
+SystemAccess RenderingPrepSystem::access() const
+{
+    return SystemAccess{}
+        .read(SystemData::Allies)
+        .read(SystemData::Enemies)
+        .read(SystemData::Walls)
+        .read(SystemData::Commander)
+        .read(SystemData::Mission)
+        .read(SystemData::Simulation)
+        .write(SystemData::Hud)
+        .write(SystemData::RenderQueue)
+        .write(SystemData::Scratch);
+}
+
+const char *RenderingPrepSystem::name() const
+{
+    return "RenderingPrepSystem";
+}
+
 } // namespace world::systems
 
@@ -10,6 +10,8 @@ class RenderingPrepSystem : public ISystem
   public:
     RenderingPrepSystem() = default;
     void update(float, SystemContext &) override;
+    SystemAccess access() const override;
+    const char *name() const override;
 };
 
 } // namespace world::systems
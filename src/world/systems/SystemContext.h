@@ -5,6 +5,8 @@
 #include "world/FrameAllocator.h"
 #include "world/LegacySimulation.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 struct CommanderUnit;
@@ -20,6 +22,10 @@ class TelemetrySink;
 namespace world
 {
 
+class JobScheduler;
+class StateReader;
+class StateWriter;
+
 using CaptureRuntime = LegacySimulation::CaptureRuntime;
 
 namespace systems
@@ -37,6 +43,87 @@ enum class SystemStage : std::uint8_t
     RenderingPrep,
 };
 
+constexpr std::size_t kSystemStageCount = static_cast<std::size_t>(SystemStage::RenderingPrep) + 1;
+
+// Stable id used for stage budgets in game.json and in telemetry payloads.
+inline const char *systemStageId(SystemStage stage)
+{
+    switch (stage)
+    {
+    case SystemStage::InputProcessing: return "input_processing";
+    case SystemStage::CommandAndMorale: return "command_and_morale";
+    case SystemStage::AiDecision: return "ai_decision";
+    case SystemStage::Movement: return "movement";
+    case SystemStage::Combat: return "combat";
+    case SystemStage::StateUpdate: return "state_update";
+    case SystemStage::Spawn: return "spawn";
+    case SystemStage::RenderingPrep: return "rendering_prep";
+    }
+    return "unknown";
+}
+
+// Coarse slices of world state used to decide which systems may run side by side.
+enum class SystemData : std::uint8_t
+{
+    Input = 0,
+    Allies,
+    Enemies,
+    Walls,
+    Commander,
+    Hud,
+    Rng,
+    Mission,
+    Spawning,
+    Skills,
+    Simulation, // LegacySimulation state not covered by a narrower slice
+    RenderQueue, // render queue and the ally density field
+    Events,     // event bus, telemetry sink and the simulation telemetry queue
+    Scratch,    // frame allocator
+    Count
+};
+
+struct SystemAccess
+{
+    std::uint32_t readMask = 0;
+    std::uint32_t writeMask = 0;
+
+    constexpr SystemAccess &read(SystemData data)
+    {
+        readMask |= bit(data);
+        return *this;
+    }
+
+    constexpr SystemAccess &write(SystemData data)
+    {
+        writeMask |= bit(data);
+        return *this;
+    }
+
+    static constexpr SystemAccess everything()
+    {
+        constexpr std::uint32_t all = (1u << static_cast<std::uint32_t>(SystemData::Count)) - 1u;
+        return SystemAccess{all, all};
+    }
+
+    // Two systems conflict when one writes anything the other reads or writes.
+    constexpr bool conflictsWith(const SystemAccess &other) const
+    {
+        return (writeMask & (other.readMask | other.writeMask)) != 0 || (other.writeMask & readMask) != 0;
+    }
+
+    constexpr SystemAccess &merge(const SystemAccess &other)
+    {
+        readMask |= other.readMask;
+        writeMask |= other.writeMask;
+        return *this;
+    }
+
+    static constexpr std::uint32_t bit(SystemData data)
+    {
+        return 1u << static_cast<std::uint32_t>(data);
+    }
+};
+
 struct MissionContext
 {
     bool &hasMission;
@@ -51,7 +138,6 @@ struct MissionContext
 struct SystemContext
 {
     LegacySimulation &simulation;
-    EntityRegistry &registry;
     ComponentPool<Unit> &allies;
     ComponentPool<EnemyUnit> &enemies;
     ComponentPool<WallSegment> &walls;
@@ -72,9 +158,6 @@ struct SystemContext
     float &spawnSlowMultiplier;
     float &spawnSlowTimer;
 
-    std::vector<Unit> &yunaUnits;
-    std::vector<EnemyUnit> &enemyUnits;
-    std::vector<WallSegment> &wallSegments;
     std::vector<GateRuntime> &gates;
     std::vector<LegacySimulation::PendingRespawn> &yunaRespawnQueue;
     float &commanderRespawnTimer;
@@ -85,12 +168,7 @@ struct SystemContext
     const ActionBuffer &actions;
     std::shared_ptr<EventBus> eventBus;
     std::shared_ptr<TelemetrySink> telemetry;
-    bool componentsDirty = false;
-
-    void requestComponentSync()
-    {
-        componentsDirty = true;
-    }
+    JobScheduler *jobs = nullptr;
 };
 
 class ISystem
@@ -98,6 +176,23 @@ class ISystem
   public:
     virtual ~ISystem() = default;
     virtual void update(float dt, SystemContext &context) = 0;
+
+    // Label used by step timings and budget violations.
+    virtual const char *name() const
+    {
+        return "System";
+    }
+
+    // Data the system touches during update(). Systems that do not override this are never run concurrently.
+    virtual SystemAccess access() const
+    {
+        return SystemAccess::everything();
+    }
+
+    // State the system carries from one update to the next, captured by WorldState::saveState. Scratch data that
+    // update() rebuilds every frame does not belong here.
+    virtual void saveState(StateWriter &) const {}
+    virtual void loadState(StateReader &) {}
 };
 
 } // namespace systems
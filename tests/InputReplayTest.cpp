@@ -0,0 +1,186 @@
+#include "world/InputRecording.h"
+
+#include "assets/AssetManager.h"
+#include "config/AppConfig.h"
+#include "config/AppConfigLoader.h"
+#include "input/ActionBuffer.h"
+#include "world/LegacySimulation.h"
+#include "world/WorldState.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+using namespace world;
+
+constexpr int kRecordedFrames = 900;
+
+ActionEvent pressedEvent(ActionId id)
+{
+    ActionEvent event;
+    event.id = id;
+    event.pressed = true;
+    return event;
+}
+
+// Drives the world the way BattleScene does: one sampled frame per fixed step, with the occasional render frame
+// that samples input without stepping.
+void playSession(WorldState &world, InputRecorder &recorder, float dt)
+{
+    ActionBuffer actions;
+    std::uint64_t sequence = 0;
+    for (int i = 0; i < kRecordedFrames; ++i)
+    {
+        std::array<float, static_cast<std::size_t>(AxisId::Count)> axes{};
+        axes[0] = std::sin(static_cast<float>(i) * 0.05f);
+        axes[1] = (i / 120) % 2 == 0 ? 0.5f : -0.25f;
+        PointerState pointer;
+        pointer.hasPosition = true;
+        pointer.x = 200 + i % 400;
+        pointer.y = 300 - i % 200;
+
+        std::vector<ActionEvent> events;
+        if (i == 30)
+        {
+            events.push_back(pressedEvent(ActionId::CommanderOrderPushForward));
+        }
+        if (i == 240)
+        {
+            events.push_back(pressedEvent(ActionId::CycleFormationNext));
+            events.push_back(pressedEvent(ActionId::SelectSkill2));
+        }
+        if (i == 300)
+        {
+            ActionEvent activate;
+            activate.id = ActionId::ActivateSkill;
+            activate.pointer = PointerPayload{pointer.x, pointer.y, true, false};
+            events.push_back(activate);
+        }
+        if (i == 600)
+        {
+            events.push_back(pressedEvent(ActionId::CommanderOrderFollowLeader));
+        }
+
+        actions.pushFrame(sequence++, 1000.0 + static_cast<double>(i) * dt * 1000.0, axes, events, pointer);
+        const ActionBuffer::Frame &frame = *actions.latest();
+        recorder.beginFrame(frame);
+        const Vec2 camera{static_cast<float>(i % 50), 12.0f};
+        for (const ActionEvent &event : frame.events)
+        {
+            recorder.recordEvent(event, camera);
+            world.applyAction(event, camera);
+        }
+        if (i % 7 != 3)
+        {
+            world.step(dt, actions);
+            recorder.recordStep(world);
+        }
+    }
+}
+
+bool testReplayReproducesSession(const AppConfigLoadResult &config)
+{
+    namespace fs = std::filesystem;
+    const fs::path path = fs::temp_directory_path() / "kusozako_input_replay_test.kzir";
+
+    WorldState recorded;
+    recorded.configure(config.config);
+    recorded.setWorldBounds(1280.0f, 720.0f);
+    recorded.reset();
+    const LegacySimulation &sim = recorded.legacy();
+    InputRecordingHeader header;
+    header.seed = static_cast<std::uint32_t>(sim.config.rng_seed);
+    header.configHash = config.contentHash;
+    header.fixedDt = sim.config.fixed_dt;
+    header.worldWidth = sim.worldMax.x;
+    header.worldHeight = sim.worldMax.y;
+
+    InputRecorder recorder;
+    if (!recorder.open(path, header))
+    {
+        std::cerr << "Could not open input recording for writing" << '\n';
+        return false;
+    }
+    playSession(recorded, recorder, header.fixedDt);
+    if (!recorder.finish(recorded))
+    {
+        std::cerr << "Input recording was not written" << '\n';
+        return false;
+    }
+
+    const InputRecordingLoadResult loaded = loadInputRecording(path);
+    if (!loaded.success || loaded.recording.frames.size() != static_cast<std::size_t>(kRecordedFrames) ||
+        loaded.recording.header.configHash != config.contentHash)
+    {
+        std::cerr << "Input recording did not round-trip: " << loaded.error << '\n';
+        return false;
+    }
+
+    WorldState replayed;
+    replayed.configure(config.config);
+    replayed.setWorldBounds(1280.0f, 720.0f);
+    replayed.reset();
+    InputReplayer replayer(loaded.recording);
+    replayer.prepare(replayed);
+    while (replayer.advance(replayed))
+    {
+    }
+    const InputReplayResult &result = replayer.result();
+    const std::uint64_t expectedChecks = loaded.recording.header.steps / InputRecorder::kChecksumInterval + 1;
+    if (result.diverged || result.steps != loaded.recording.header.steps ||
+        result.checksumsVerified != expectedChecks || worldChecksum(replayed) != worldChecksum(recorded))
+    {
+        std::cerr << "Replay diverged from the recorded session at step " << result.divergedStep << '\n';
+        return false;
+    }
+
+    // A changed input must be caught by the periodic checksums rather than silently replayed.
+    InputRecording tampered = loaded.recording;
+    tampered.frames[100].frame.axes[1] = 1.0f;
+    WorldState diverging;
+    diverging.configure(config.config);
+    diverging.setWorldBounds(1280.0f, 720.0f);
+    diverging.reset();
+    InputReplayer tamperedReplayer(tampered);
+    tamperedReplayer.prepare(diverging);
+    while (tamperedReplayer.advance(diverging))
+    {
+    }
+    if (!tamperedReplayer.result().diverged)
+    {
+        std::cerr << "Replay with altered input was not reported as diverged" << '\n';
+        return false;
+    }
+
+    std::error_code ec;
+    fs::remove(path, ec);
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    AssetManager assets;
+    assets.setAssetRoot((std::filesystem::path(PROJECT_SOURCE_DIR) / "assets").string());
+    AppConfigLoader loader(std::filesystem::path(PROJECT_SOURCE_DIR) / "config");
+    const AppConfigLoadResult config = loader.load(assets);
+
+    bool success = true;
+    if (config.contentHash == 0 || loader.load(assets).contentHash != config.contentHash)
+    {
+        std::cerr << "Config content hash is not stable across loads" << '\n';
+        success = false;
+    }
+    if (!testReplayReproducesSession(config))
+    {
+        success = false;
+    }
+    return success ? 0 : 1;
+}
@@ -31,10 +31,6 @@ using world::CaptureRuntime;
 
 struct ContextHarness
 {
-    world::EntityRegistry registry;
-    world::ComponentPool<Unit> allies;
-    world::ComponentPool<EnemyUnit> enemies;
-    world::ComponentPool<WallSegment> walls;
     world::ComponentPool<CaptureRuntime> missionZones;
     HUDState hud{};
     world::FrameAllocator frameAllocator{};
@@ -50,10 +46,9 @@ struct ContextHarness
                   sim.missionTimer,
                   sim.missionVictoryCountdown},
           context{sim,
-                  registry,
-                  allies,
-                  enemies,
-                  walls,
+                  sim.yunas,
+                  sim.enemies,
+                  sim.walls,
                   missionZones,
                   sim.commander,
                   hud,
@@ -69,9 +64,6 @@ struct ContextHarness
                   sim.spawnRateMultiplier,
                   sim.spawnSlowMultiplier,
                   sim.spawnSlowTimer,
-                  sim.yunas,
-                  sim.enemies,
-                  sim.walls,
                   sim.gates,
                   sim.yunaRespawns,
                   sim.commanderRespawnTimer,
@@ -132,7 +124,6 @@ bool testUpdateTimersAndFlags()
     ActionBuffer actions;
     ContextHarness harness(sim, actions);
     auto &context = harness.context;
-    context.componentsDirty = false;
 
     system.update(0.5f, context);
 
@@ -168,13 +159,12 @@ bool testUpdateTimersAndFlags()
         std::cerr << "Rally state not suppressed" << '\n';
         success = false;
     }
-    if (!context.componentsDirty)
+    if (!almostEqual(sim.spawnRateMultiplier, 3.0f))
     {
-        std::cerr << "Update did not mark components dirty" << '\n';
+        std::cerr << "Spawn rate multiplier restored before the skill expired" << '\n';
         success = false;
     }
 
-    context.componentsDirty = false;
     system.update(0.5f, context);
     const RuntimeSkill &afterSecond = sim.skills[0];
     if (!almostEqual(afterSecond.cooldownRemaining, 3.0f))
@@ -192,9 +182,9 @@ bool testUpdateTimersAndFlags()
         std::cerr << "Spawn rate multiplier not restored" << '\n';
         success = false;
     }
-    if (!context.componentsDirty)
+    if (!almostEqual(sim.commanderInvulnTimer, 0.0f))
     {
-        std::cerr << "Second update did not mark components dirty" << '\n';
+        std::cerr << "Commander invulnerability did not expire" << '\n';
         success = false;
     }
 
@@ -218,7 +208,6 @@ bool testToggleRallySkill()
     ActionBuffer actions;
     ContextHarness harness(sim, actions);
     auto &context = harness.context;
-    context.componentsDirty = false;
 
     world::systems::SkillCommand command{0, sim.commander.pos + Vec2{16.0f, 0.0f}};
 
@@ -234,14 +223,13 @@ bool testToggleRallySkill()
         std::cerr << "Suppressed rally altered cooldown" << '\n';
         return false;
     }
-    if (context.componentsDirty)
+    if (sim.hud.telemetryText != world::normalizeTelemetry("Allies are panicking! Rally unavailable."))
     {
-        std::cerr << "Suppressed rally marked components dirty" << '\n';
+        std::cerr << "Suppressed rally did not report the suppression" << '\n';
         return false;
     }
 
     sim.moraleSummary.rallySuppressed = false;
-    context.componentsDirty = false;
     system.triggerSkill(context, command);
     if (!sim.rallyState)
     {
@@ -253,9 +241,9 @@ bool testToggleRallySkill()
         std::cerr << "Rally cooldown not applied" << '\n';
         return false;
     }
-    if (!context.componentsDirty)
+    if (sim.hud.telemetryText != world::normalizeTelemetry("Rally!"))
     {
-        std::cerr << "Rally activation did not mark components dirty" << '\n';
+        std::cerr << "Rally activation did not report the rally" << '\n';
         return false;
     }
 
@@ -279,7 +267,6 @@ bool testSpawnRateTrigger()
     ActionBuffer actions;
     ContextHarness harness(sim, actions);
     auto &context = harness.context;
-    context.componentsDirty = false;
 
     world::systems::SkillCommand command{0, sim.commander.pos};
     system.triggerSkill(context, command);
@@ -301,9 +288,9 @@ bool testSpawnRateTrigger()
         std::cerr << "Spawn rate multiplier not applied" << '\n';
         success = false;
     }
-    if (!context.componentsDirty)
+    if (sim.hud.telemetryText != world::normalizeTelemetry("Spawn surge"))
     {
-        std::cerr << "Spawn rate activation did not mark components dirty" << '\n';
+        std::cerr << "Spawn rate activation did not report the surge" << '\n';
         success = false;
     }
 
@@ -326,18 +313,16 @@ bool testRegisteredHandlerDispatch()
     JobAbilitySystem::clearSkillHandlers();
     JobAbilitySystem::registerSkillHandler(
         customSkill.def.id,
-        [&handlerInvoked](JobAbilitySystem &, world::systems::SystemContext &context, RuntimeSkill &skill,
+        [&handlerInvoked](JobAbilitySystem &, world::systems::SystemContext &, RuntimeSkill &skill,
                           const world::systems::SkillCommand &) {
             handlerInvoked = true;
             skill.cooldownRemaining = 1.5f;
-            context.requestComponentSync();
         });
 
     world::systems::JobAbilitySystem system;
     ActionBuffer actions;
     ContextHarness harness(sim, actions);
     auto &context = harness.context;
-    context.componentsDirty = false;
 
     world::systems::SkillCommand command{0, sim.commander.pos};
     system.triggerSkill(context, command);
@@ -353,25 +338,14 @@ bool testRegisteredHandlerDispatch()
         std::cerr << "Registered handler did not update cooldown" << '\n';
         success = false;
     }
-    if (!context.componentsDirty)
-    {
-        std::cerr << "Registered handler did not mark components dirty" << '\n';
-        success = false;
-    }
 
     handlerInvoked = false;
-    context.componentsDirty = false;
     system.triggerSkill(context, command);
     if (handlerInvoked)
     {
         std::cerr << "Handler invoked despite cooldown" << '\n';
         success = false;
     }
-    if (context.componentsDirty)
-    {
-        std::cerr << "Cooldown prevented trigger but still marked components dirty" << '\n';
-        success = false;
-    }
 
     JobAbilitySystem::clearSkillHandlers();
     return success;
@@ -379,6 +353,34 @@ bool testRegisteredHandlerDispatch()
 
 } // namespace
 
+bool testTombstonedAlliesSkipped()
+{
+    world::WorldState world;
+    world.reset();
+    auto &sim = world.legacy();
+    sim.yunas.clear();
+    for (int i = 0; i < 2; ++i)
+    {
+        Unit unit;
+        unit.hp = 5.0f;
+        unit.job.cooldown = 1.0f;
+        sim.yunas.push_back(unit);
+    }
+    sim.markYunaDead(1, 0.0f);
+
+    world::systems::JobAbilitySystem system;
+    ActionBuffer actions;
+    ContextHarness harness(sim, actions);
+    system.update(0.5f, harness.context);
+
+    if (!almostEqual(sim.yunas[0].job().cooldown, 0.5f) || !almostEqual(sim.yunas[1].job().cooldown, 1.0f))
+    {
+        std::cerr << "Job timers ticked for an ally tombstoned earlier in the tick" << '\n';
+        return false;
+    }
+    return true;
+}
+
 int main()
 {
     bool success = true;
@@ -398,5 +400,9 @@ int main()
     {
         success = false;
     }
+    if (!testTombstonedAlliesSkipped())
+    {
+        success = false;
+    }
     return success ? 0 : 1;
 }
@@ -0,0 +1,146 @@
+#include "world/MovementKernel.h"
+
+#include "world/Unit.h"
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using namespace world;
+
+constexpr Vec2 kWorldMin{0.0f, 0.0f};
+constexpr Vec2 kWorldMax{640.0f, 360.0f};
+
+struct Batch
+{
+    std::vector<Vec2> positions;
+    std::vector<Vec2> velocities;
+    std::vector<BoolColumnSlot> moving;
+    std::vector<float> radii;
+};
+
+// Positions straddle the world edges and some radii exceed half the world height, so every clamp branch runs.
+Batch makeBatch(std::size_t count)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> x(-40.0f, 680.0f);
+    std::uniform_real_distribution<float> y(-40.0f, 400.0f);
+    std::uniform_real_distribution<float> speed(-300.0f, 300.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 200.0f);
+    Batch batch;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        batch.positions.push_back({x(rng), y(rng)});
+        batch.velocities.push_back({speed(rng), speed(rng)});
+        batch.moving.emplace_back(rng() % 3 != 0);
+        batch.radii.push_back(i % 7 == 0 ? radius(rng) : 6.0f);
+    }
+    return batch;
+}
+
+bool sameBits(const std::vector<Vec2> &a, const std::vector<Vec2> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Vec2)) == 0;
+}
+
+bool testLevelsMatchScalar()
+{
+    const simd::Level supported = simd::supportedLevel();
+    // Odd sizes leave a scalar tail behind every vector width.
+    for (std::size_t count : {0u, 1u, 3u, 7u, 8u, 13u, 1031u})
+    {
+        simd::setLevel(simd::Level::Scalar);
+        Batch expected = makeBatch(count);
+        const std::vector<Vec2> before = expected.positions;
+        const bool expectedMoved =
+            movement::integrateAndClamp(expected.positions.data(), expected.velocities.data(), expected.moving.data(),
+                                        expected.radii.data(), count, 0.016f, kWorldMin, kWorldMax);
+        std::vector<Vec2> expectedFree = before;
+        const std::vector<Vec2> freeVelocities = makeBatch(count).velocities;
+        movement::integrate(expectedFree.data(), freeVelocities.data(), count, 0.016f);
+
+        for (int level = 0; level <= static_cast<int>(supported); ++level)
+        {
+            simd::setLevel(static_cast<simd::Level>(level));
+            Batch actual = makeBatch(count);
+            const bool moved = movement::integrateAndClamp(actual.positions.data(), actual.velocities.data(),
+                                                           actual.moving.data(), actual.radii.data(), count, 0.016f,
+                                                           kWorldMin, kWorldMax);
+            if (moved != expectedMoved || !sameBits(actual.positions, expected.positions))
+            {
+                std::cerr << "integrateAndClamp differs from scalar at "
+                          << simd::levelName(simd::activeLevel()) << " for " << count << " units\n";
+                return false;
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (actual.moving[i] || actual.velocities[i].x != 0.0f || actual.velocities[i].y != 0.0f)
+                {
+                    std::cerr << "integrateAndClamp left velocity or flag set at unit " << i << '\n';
+                    return false;
+                }
+            }
+
+            std::vector<Vec2> free = before;
+            movement::integrate(free.data(), freeVelocities.data(), count, 0.016f);
+            if (!sameBits(free, expectedFree))
+            {
+                std::cerr << "integrate differs from scalar at "
+                          << simd::levelName(simd::activeLevel()) << " for " << count << " units\n";
+                return false;
+            }
+        }
+    }
+    simd::setLevel(supported);
+    return true;
+}
+
+bool testClampMatchesWorldRules()
+{
+    simd::setLevel(simd::supportedLevel());
+    std::vector<Vec2> positions(8, Vec2{630.0f, -5.0f});
+    std::vector<Vec2> velocities(8, Vec2{100.0f, 0.0f});
+    std::vector<BoolColumnSlot> moving(8, BoolColumnSlot(true));
+    std::vector<float> radii(8, 4.0f);
+    moving[1] = false;
+    radii[2] = 190.0f; // Wider than the world is tall: y is left alone, x is still clamped.
+    movement::integrateAndClamp(positions.data(), velocities.data(), moving.data(), radii.data(), positions.size(),
+                                1.0f, kWorldMin, kWorldMax);
+    if (positions[0].x != 636.0f || positions[0].y != 4.0f)
+    {
+        std::cerr << "Moving unit was not clamped inside the world" << '\n';
+        return false;
+    }
+    if (positions[1].x != 630.0f || positions[1].y != -5.0f)
+    {
+        std::cerr << "Unit without a velocity was moved or clamped" << '\n';
+        return false;
+    }
+    if (positions[2].x != 450.0f || positions[2].y != -5.0f)
+    {
+        std::cerr << "Oversized unit was clamped on an empty range" << '\n';
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    bool success = true;
+    if (!testLevelsMatchScalar())
+    {
+        success = false;
+    }
+    if (!testClampMatchesWorldRules())
+    {
+        success = false;
+    }
+    return success ? 0 : 1;
+}
@@ -73,5 +73,27 @@ int main()
     success &= assertTrue(toleranceMonitor.evaluate(toleranceSample).has_value(),
                           "Timing beyond tolerance should trigger a violation");
 
+    PerformanceBudgetConfig stageConfig;
+    stageConfig.updateMs = 0.01f;
+    stageConfig.toleranceMs = 0.0f;
+    stageConfig.stageMs["combat"] = 1.0f;
+    telemetry::PerformanceBudgetMonitor stageMonitor(stageConfig);
+    telemetry::StageTimingSample stageSample;
+    stageSample.updateMs = 2.0;
+    stageSample.systemStages.push_back({"movement", 0.4, "MovementSystem", 0.4});
+    stageSample.systemStages.push_back({"combat", 1.6, "CombatSystem", 1.5});
+    auto stageViolation = stageMonitor.evaluate(stageSample);
+    success &= assertTrue(stageViolation.has_value(), "Expected combat stage budget violation to be detected");
+    if (stageViolation)
+    {
+        success &= assertTrue(stageViolation->stage == "combat", "Violation should reference the combat stage");
+        success &= assertTrue(stageViolation->system == "CombatSystem",
+                              "Stage violation should name the slowest system");
+    }
+    stageSample.systemStages[1].ms = 0.8;
+    stageViolation = stageMonitor.evaluate(stageSample);
+    success &= assertTrue(stageViolation && stageViolation->stage == "update" && stageViolation->system.empty(),
+                          "Stages within budget should fall back to the coarse update check");
+
     return success ? 0 : 1;
 }
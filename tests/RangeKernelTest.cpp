@@ -0,0 +1,130 @@
+#include "world/RangeKernel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+using namespace world;
+
+struct Packed
+{
+    std::vector<std::uint32_t> ids;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> radius;
+
+    range::Candidates candidates() const
+    {
+        return {ids.data(), x.data(), y.data(), radius.data(), ids.size()};
+    }
+};
+
+// Runs check at every SIMD level this CPU supports, then restores the best one.
+template <typename Check>
+bool atEveryLevel(Check &&check)
+{
+    const simd::Level supported = simd::supportedLevel();
+    bool success = true;
+    for (int level = 0; success && level <= static_cast<int>(supported); ++level)
+    {
+        simd::setLevel(static_cast<simd::Level>(level));
+        success = check();
+    }
+    simd::setLevel(supported);
+    return success;
+}
+
+std::vector<std::uint32_t> run(std::size_t (*kernel)(const range::Candidates &, const Vec2 &, float, std::uint32_t *),
+                               const Packed &packed, float radius)
+{
+    std::vector<std::uint32_t> out(packed.ids.size());
+    out.resize(kernel(packed.candidates(), Vec2{0.0f, 0.0f}, radius, out.data()));
+    return out;
+}
+
+bool testCompactionKeepsOrder()
+{
+    // Group g of eight candidates hits on exactly the lanes set in g, so every four- and eight-lane hit mask gets
+    // compacted. The five candidates after the groups go through the scalar tail. Ids count down, so hits written
+    // out of candidate order show up.
+    constexpr std::size_t kGroups = 256;
+    constexpr std::size_t kCount = kGroups * 8 + 5;
+    Packed packed;
+    std::vector<std::uint32_t> expected;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const bool hit = i < kGroups * 8 ? (((i / 8) >> (i % 8)) & 1u) != 0 : i % 2 == 0;
+        packed.ids.push_back(static_cast<std::uint32_t>(kCount - i));
+        packed.x.push_back(hit ? 1.0f : 100.0f);
+        packed.y.push_back(hit ? -1.0f : 0.0f);
+        packed.radius.push_back(2.0f);
+        if (hit)
+        {
+            expected.push_back(packed.ids.back());
+        }
+    }
+    return atEveryLevel([&]() {
+        if (run(range::overlapping, packed, 10.0f) != expected || run(range::within, packed, 10.0f) != expected)
+        {
+            std::cerr << "Range kernels lost, reordered or invented hits at " << simd::levelName(simd::activeLevel())
+                      << '\n';
+            return false;
+        }
+        return true;
+    });
+}
+
+bool testBoundaryIsInclusive()
+{
+    // Thirteen candidates span a full vector at every width plus a tail. All but every third one touch the query
+    // circle exactly; those sit one unit beyond it.
+    Packed packed;
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t i = 0; i < 13; ++i)
+    {
+        const bool touching = i % 3 != 2;
+        packed.ids.push_back(i);
+        packed.x.push_back(i % 2 == 0 ? (touching ? 14.0f : 15.0f) : 0.0f);
+        packed.y.push_back(i % 2 == 0 ? 0.0f : (touching ? -14.0f : -15.0f));
+        packed.radius.push_back(1.0f);
+        if (touching)
+        {
+            expected.push_back(i);
+        }
+    }
+    return atEveryLevel([&]() {
+        if (run(range::overlapping, packed, 13.0f) != expected)
+        {
+            std::cerr << "overlapping() mishandled touching circles at " << simd::levelName(simd::activeLevel())
+                      << '\n';
+            return false;
+        }
+        if (run(range::within, packed, 14.0f) != expected)
+        {
+            std::cerr << "within() mishandled points on the radius at " << simd::levelName(simd::activeLevel())
+                      << '\n';
+            return false;
+        }
+        return true;
+    });
+}
+
+} // namespace
+
+int main()
+{
+    bool success = true;
+    if (!testCompactionKeepsOrder())
+    {
+        success = false;
+    }
+    if (!testBoundaryIsInclusive())
+    {
+        success = false;
+    }
+    return success ? 0 : 1;
+}
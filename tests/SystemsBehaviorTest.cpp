@@ -1,11 +1,16 @@
 #include "world/WorldState.h"
+#include "world/DensityField.h"
+#include "world/FlowField.h"
 #include "world/FrameAllocator.h"
 #include "world/LegacyTypes.h"
 
 #include "config/AppConfig.h"
 #include "input/ActionBuffer.h"
 #include "world/MoraleTypes.h"
+#include "world/ProximityIndex.h"
 #include "world/SpatialGrid.h"
+#include "world/spawn/WaveController.h"
+#include "world/systems/BehaviorSystem.h"
 #include "world/systems/CombatSystem.h"
 
 #include <algorithm>
@@ -13,8 +18,11 @@
 #include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <new>
 #include <random>
+#include <string>
 
 namespace
 {
@@ -217,22 +225,17 @@ GridMetrics countGridPairs(const LegacySimulation &sim,
     const int configuredTileSize = sim.mapDefs.tile_size > 0 ? sim.mapDefs.tile_size : 16;
     const float cellSize = std::max(1.0f, static_cast<float>(configuredTileSize));
     grid.configure(sim.worldMin, sim.worldMax, cellSize);
-    grid.clear();
 
-    for (std::size_t i = 0; i < walls.size(); ++i)
-    {
-        grid.insertWall(i, walls[i].pos, walls[i].radius);
-    }
-    for (std::size_t i = 0; i < enemies.size(); ++i)
-    {
-        grid.insertEnemy(i, enemies[i].pos, enemies[i].radius);
-    }
-    for (std::size_t i = 0; i < yunas.size(); ++i)
-    {
-        grid.insertUnit(i, yunas[i].pos, yunas[i].radius);
-    }
+    grid.build(world::SpatialGrid::Layer::Walls, walls.size(), [&](std::size_t i) {
+        return world::SpatialGrid::Bounds{walls[i].pos, walls[i].radius};
+    });
+    grid.build(world::SpatialGrid::Layer::Enemies, enemies.size(), [&](std::size_t i) {
+        return world::SpatialGrid::Bounds{enemies[i].pos, enemies[i].radius};
+    });
+    grid.build(world::SpatialGrid::Layer::Units, yunas.size(), [&](std::size_t i) {
+        return world::SpatialGrid::Bounds{yunas[i].pos, yunas[i].radius};
+    });
 
-    std::vector<std::size_t> cellScratch;
     std::vector<std::size_t> indexScratch;
     std::vector<std::size_t> enemyScratch;
     std::vector<std::uint32_t> wallMarks(walls.size(), 0);
@@ -252,13 +255,10 @@ GridMetrics countGridPairs(const LegacySimulation &sim,
     for (std::size_t enemyIndex = 0; enemyIndex < enemies.size(); ++enemyIndex)
     {
         const EnemyUnit &enemy = enemies[enemyIndex];
-        grid.queryCells(enemy.pos, enemy.radius, cellScratch);
         nextStamp(wallStamp, wallMarks);
         indexScratch.clear();
-        for (std::size_t cellIndex : cellScratch)
-        {
-            const auto &cell = grid.cell(cellIndex);
-            for (std::size_t idx : cell.walls)
+        grid.forEachSpan(world::SpatialGrid::Layer::Walls, enemy.pos, enemy.radius, [&](auto span) {
+            for (std::uint32_t idx : span)
             {
                 if (idx >= walls.size())
                 {
@@ -270,7 +270,7 @@ GridMetrics countGridPairs(const LegacySimulation &sim,
                     indexScratch.push_back(idx);
                 }
             }
-        }
+        });
         for (std::size_t wallIndex : indexScratch)
         {
             ++metrics.enemyWallChecks;
@@ -281,13 +281,10 @@ GridMetrics countGridPairs(const LegacySimulation &sim,
 
     for (const Unit &yuna : yunas)
     {
-        grid.queryCells(yuna.pos, yuna.radius, cellScratch);
         nextStamp(enemyStamp, enemyMarks);
         enemyScratch.clear();
-        for (std::size_t cellIndex : cellScratch)
-        {
-            const auto &cell = grid.cell(cellIndex);
-            for (std::size_t idx : cell.enemies)
+        grid.forEachSpan(world::SpatialGrid::Layer::Enemies, yuna.pos, yuna.radius, [&](auto span) {
+            for (std::uint32_t idx : span)
             {
                 if (idx >= enemies.size())
                 {
@@ -299,7 +296,7 @@ GridMetrics countGridPairs(const LegacySimulation &sim,
                     enemyScratch.push_back(idx);
                 }
             }
-        }
+        });
         for (std::size_t enemyIndex : enemyScratch)
         {
             ++metrics.yunaEnemyChecks;
@@ -383,9 +380,9 @@ bool testFormationSwitchAlignment()
     // Ensure we have some followers so alignment logic runs.
     sim.yunas.clear();
     sim.yunas.resize(3);
-    for (Unit &unit : sim.yunas)
+    for (UnitRef unit : sim.yunas)
     {
-        unit.followBySkill = true;
+        unit.followBySkill() = true;
     }
 
     world.cycleFormation(1);
@@ -423,6 +420,160 @@ bool testFormationSwitchAlignment()
     return true;
 }
 
+// Populates a world where every TemperamentBehavior is in play, Mimic included, with enough units per behaviour
+// that BehaviorSystem splits its buckets across workers.
+void populateTemperamentWorld(world::WorldState &world)
+{
+    auto &sim = world.legacy();
+    std::vector<TemperamentDefinition> defs;
+    for (TemperamentBehavior behavior :
+         {TemperamentBehavior::ChargeNearest, TemperamentBehavior::FleeNearest, TemperamentBehavior::FollowYuna,
+          TemperamentBehavior::RaidGate, TemperamentBehavior::Homebound, TemperamentBehavior::Wander,
+          TemperamentBehavior::Doze, TemperamentBehavior::GuardBase, TemperamentBehavior::TargetTag,
+          TemperamentBehavior::Mimic})
+    {
+        TemperamentDefinition def;
+        def.behavior = behavior;
+        def.targetTags = {"elite", "enemy"};
+        def.mimicPool = {TemperamentBehavior::ChargeNearest, TemperamentBehavior::FleeNearest,
+                         TemperamentBehavior::Wander};
+        def.mimicEvery = {0.05f, 0.2f};
+        def.mimicDuration = {0.1f, 0.3f};
+        if (behavior == TemperamentBehavior::Wander)
+        {
+            def.cryPauseEvery = {0.1f, 0.3f};
+            def.cryPauseDuration = 0.05f;
+        }
+        defs.push_back(def);
+    }
+    sim.temperamentConfig.definitions = defs;
+
+    sim.yunas.clear();
+    for (std::size_t i = 0; i < 3000; ++i)
+    {
+        UnitRef unit = sim.yunas.emplace_back();
+        unit.pos() = {40.0f + 9.0f * static_cast<float>(i % 100), 40.0f + 9.0f * static_cast<float>(i / 100)};
+        unit.hp() = 10.0f;
+        unit.temperament().definition = &sim.temperamentConfig.definitions[i % defs.size()];
+        unit.temperament().panicTimer = i % 13 == 0 ? 0.2f : 0.0f;
+    }
+    sim.enemies.clear();
+    for (std::size_t i = 0; i < 80; ++i)
+    {
+        EnemyUnit enemy;
+        enemy.pos = {700.0f + 11.0f * static_cast<float>(i % 10), 100.0f + 23.0f * static_cast<float>(i / 10)};
+        enemy.hp = 1000.0f;
+        enemy.radius = 6.0f;
+        enemy.type = i % 5 == 0 ? EnemyArchetype::Wallbreaker : EnemyArchetype::Slime;
+        sim.enemies.push_back(enemy);
+    }
+    world.markComponentsDirty();
+}
+
+bool testBehaviorBucketsMatchAcrossWorkers()
+{
+    world::WorldState serial;
+    world::WorldState threaded;
+    serial.setWorkerThreads(0);
+    threaded.setWorkerThreads(3);
+    populateTemperamentWorld(serial);
+    populateTemperamentWorld(threaded);
+
+    ActionBuffer actions;
+    for (int step = 0; step < 20; ++step)
+    {
+        serial.step(1.0f / 60.0f, actions);
+        threaded.step(1.0f / 60.0f, actions);
+    }
+
+    const auto &a = serial.legacy();
+    const auto &b = threaded.legacy();
+    if (a.yunas.size() != b.yunas.size() || !(a.rng == b.rng))
+    {
+        std::cerr << "Behaviour buckets changed the rng sequence across worker counts" << '\n';
+        return false;
+    }
+    for (std::size_t i = 0; i < a.yunas.size(); ++i)
+    {
+        const auto ua = a.yunas[i];
+        const auto ub = b.yunas[i];
+        if (ua.pos().x != ub.pos().x || ua.pos().y != ub.pos().y ||
+            ua.temperament().currentBehavior != ub.temperament().currentBehavior ||
+            ua.temperament().wanderTimer != ub.temperament().wanderTimer ||
+            ua.temperament().catchupTimer != ub.temperament().catchupTimer)
+        {
+            std::cerr << "Behaviour buckets diverged across worker counts at ally " << i << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+bool testAiSchedulerBoundsDecisions()
+{
+    constexpr int kBudget = 200;
+    world::WorldState world;
+    populateTemperamentWorld(world);
+    world.legacy().config.aiScheduler.maxDecisionsPerTick = kBudget;
+    world.clearSystems();
+    auto behavior = std::make_unique<world::systems::BehaviorSystem>();
+    world::systems::BehaviorSystem *scheduler = behavior.get();
+    world.registerSystem(world::systems::SystemStage::AiDecision, std::move(behavior));
+
+    ActionBuffer actions;
+    for (int step = 0; step < 20; ++step)
+    {
+        world.step(1.0f / 60.0f, actions);
+        if (scheduler->lastDecisionCount() != static_cast<std::size_t>(kBudget))
+        {
+            std::cerr << "AI scheduler ran " << scheduler->lastDecisionCount() << " decisions with a budget of "
+                      << kBudget << '\n';
+            return false;
+        }
+    }
+
+    // Units between decisions steer at cached enemies, so the cache must survive a save and restore.
+    world::WorldState original;
+    world::WorldState restored;
+    populateTemperamentWorld(original);
+    populateTemperamentWorld(restored);
+    original.legacy().config.aiScheduler.maxDecisionsPerTick = kBudget;
+    restored.legacy().config.aiScheduler.maxDecisionsPerTick = kBudget;
+    for (int step = 0; step < 10; ++step)
+    {
+        original.step(1.0f / 60.0f, actions);
+    }
+    std::vector<std::uint8_t> saved;
+    original.saveState(saved);
+    std::string error;
+    if (!restored.loadState(saved, error))
+    {
+        std::cerr << "AI scheduler state failed to restore: " << error << '\n';
+        return false;
+    }
+    for (int step = 0; step < 10; ++step)
+    {
+        original.step(1.0f / 60.0f, actions);
+        restored.step(1.0f / 60.0f, actions);
+    }
+    const auto &a = original.legacy();
+    const auto &b = restored.legacy();
+    if (a.yunas.size() != b.yunas.size())
+    {
+        std::cerr << "AI scheduler restore changed the ally count" << '\n';
+        return false;
+    }
+    for (std::size_t i = 0; i < a.yunas.size(); ++i)
+    {
+        if (a.yunas[i].pos().x != b.yunas[i].pos().x || a.yunas[i].pos().y != b.yunas[i].pos().y)
+        {
+            std::cerr << "AI scheduler diverged after restore at ally " << i << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
 bool testCommanderDeathMorale()
 {
     world::WorldState world;
@@ -453,8 +604,8 @@ bool testCommanderDeathMorale()
 
     sim.yunas.clear();
     sim.yunas.resize(2);
-    sim.yunas[0].followBySkill = true;
-    sim.yunas[1].followBySkill = false;
+    sim.yunas[0].followBySkill() = true;
+    sim.yunas[1].followBySkill() = false;
 
     ActionBuffer actions;
     world.step(0.1f, actions);
@@ -467,9 +618,9 @@ bool testCommanderDeathMorale()
         std::cerr << "Commander morale icon not updated" << '\n';
         return false;
     }
-    for (const Unit &unit : sim.yunas)
+    for (ConstUnitRef unit : sim.yunas)
     {
-        if (unit.moraleState != MoraleState::LeaderDown)
+        if (unit.moraleState() != MoraleState::LeaderDown)
         {
             std::cerr << "Unit did not enter leader-down state" << '\n';
             return false;
@@ -478,12 +629,12 @@ bool testCommanderDeathMorale()
 
     world.step(1.1f, actions);
 
-    if (sim.yunas[0].moraleState != MoraleState::Panic)
+    if (sim.yunas[0].moraleState() != MoraleState::Panic)
     {
         std::cerr << "Follower did not panic after leader down window" << '\n';
         return false;
     }
-    if (sim.yunas[1].moraleState != MoraleState::Mesomeso)
+    if (sim.yunas[1].moraleState() != MoraleState::Mesomeso)
     {
         std::cerr << "Non-follower did not enter mesomeso state" << '\n';
         return false;
@@ -494,32 +645,32 @@ bool testCommanderDeathMorale()
         return false;
     }
 
-    const Unit &panicUnit = sim.yunas[0];
-    const Unit &mesoUnit = sim.yunas[1];
+    ConstUnitRef panicUnit = sim.yunas[0];
+    ConstUnitRef mesoUnit = sim.yunas[1];
 
-    if (!almostEqual(panicUnit.moraleSpeedMultiplier, sim.config.morale.panic.modifiers.speed))
+    if (!almostEqual(panicUnit.moraleSpeedMultiplier(), sim.config.morale.panic.modifiers.speed))
     {
         std::cerr << "Panic speed multiplier not applied" << '\n';
         return false;
     }
-    if (!almostEqual(panicUnit.moraleAttackIntervalMultiplier, sim.config.morale.panic.modifiers.attackInterval))
+    if (!almostEqual(panicUnit.moraleAttackIntervalMultiplier(), sim.config.morale.panic.modifiers.attackInterval))
     {
         std::cerr << "Panic attack interval multiplier not applied" << '\n';
         return false;
     }
-    if (!almostEqual(panicUnit.moraleRetargetCooldownMultiplier,
+    if (!almostEqual(panicUnit.moraleRetargetCooldownMultiplier(),
                      sim.config.morale.panic.behavior.retargetCooldownMultiplier))
     {
         std::cerr << "Panic retarget cooldown multiplier not applied" << '\n';
         return false;
     }
-    if (!almostEqual(mesoUnit.moraleCommandObeyBonus, sim.config.morale.mesomeso.behavior.commandObeyBonus))
+    if (!almostEqual(mesoUnit.moraleCommandObeyBonus(), sim.config.morale.mesomeso.behavior.commandObeyBonus))
     {
         std::cerr << "Mesomeso obey bonus not applied" << '\n';
         return false;
     }
-    if (!almostEqual(mesoUnit.moraleRetreatCheckInterval, sim.config.morale.mesomeso.retreatCheck.interval) ||
-        !almostEqual(mesoUnit.moraleRetreatCheckChance, sim.config.morale.mesomeso.retreatCheck.chance))
+    if (!almostEqual(mesoUnit.moraleRetreatCheckInterval(), sim.config.morale.mesomeso.retreatCheck.interval) ||
+        !almostEqual(mesoUnit.moraleRetreatCheckChance(), sim.config.morale.mesomeso.retreatCheck.chance))
     {
         std::cerr << "Mesomeso retreat check configuration not applied" << '\n';
         return false;
@@ -528,31 +679,31 @@ bool testCommanderDeathMorale()
     constexpr float kIgnoreDecisionInterval = 0.6f;
     world.step(kIgnoreDecisionInterval, actions);
 
-    const Unit &panicAfter = sim.yunas[0];
-    const Unit &mesoAfter = sim.yunas[1];
+    ConstUnitRef panicAfter = sim.yunas[0];
+    ConstUnitRef mesoAfter = sim.yunas[1];
 
-    if (!almostEqual(panicAfter.moraleIgnoreOrdersTimer,
+    if (!almostEqual(panicAfter.moraleIgnoreOrdersTimer(),
                      kIgnoreDecisionInterval * sim.config.morale.panic.behavior.retargetCooldownMultiplier))
     {
         std::cerr << "Panic ignore-orders timer not scaled" << '\n';
         return false;
     }
-    if (!panicAfter.moraleIgnoringOrders)
+    if (!panicAfter.moraleIgnoringOrders())
     {
         std::cerr << "Panic unit did not ignore orders" << '\n';
         return false;
     }
-    if (mesoAfter.moraleIgnoringOrders)
+    if (mesoAfter.moraleIgnoringOrders())
     {
         std::cerr << "Mesomeso unit ignored orders despite obey bonus" << '\n';
         return false;
     }
-    if (!mesoAfter.moraleRetreatActive)
+    if (!mesoAfter.moraleRetreatActive())
     {
         std::cerr << "Mesomeso unit did not trigger retreat" << '\n';
         return false;
     }
-    if (!(mesoAfter.moraleRetreatTimer > 0.0f))
+    if (!(mesoAfter.moraleRetreatTimer() > 0.0f))
     {
         std::cerr << "Mesomeso retreat timer not started" << '\n';
         return false;
@@ -613,6 +764,316 @@ bool testSpawnPityWeighting()
     return true;
 }
 
+bool testDeferredYunaDeaths()
+{
+    world::LegacySimulation sim;
+    std::vector<EntityId> ids;
+    for (int i = 0; i < 5; ++i)
+    {
+        Unit unit;
+        unit.hp = static_cast<float>(i + 1);
+        ids.push_back(sim.yunas.create(unit).first);
+    }
+
+    if (!sim.markYunaDead(3, 0.5f) || !sim.markYunaDead(1, 0.0f) || sim.markYunaDead(3, 0.5f))
+    {
+        std::cerr << "Tombstoning an ally did not report first marks only" << '\n';
+        return false;
+    }
+    if (sim.yunas.size() != 5 || sim.liveYunaCount() != 3 || !sim.yunas.markedForRemoval(1) ||
+        sim.yunas.markedForRemoval(2) || !sim.yunaRespawns.empty())
+    {
+        std::cerr << "Tombstoned allies were removed or respawned before the reap" << '\n';
+        return false;
+    }
+
+    sim.reapYunas();
+    if (sim.yunas.size() != 3 || sim.yunas.pendingRemovals() != 0 || sim.yunaRespawns.size() != 2)
+    {
+        std::cerr << "Reap did not compact tombstoned allies and queue their respawns" << '\n';
+        return false;
+    }
+    if (sim.yunas.has(ids[1]) || sim.yunas.has(ids[3]) || sim.yunas.get(ids[4]).hp() != 5.0f ||
+        sim.yunas[0].hp() != 1.0f || sim.yunas[1].hp() != 3.0f || sim.yunas[2].hp() != 5.0f)
+    {
+        std::cerr << "Reap did not keep survivors in order under their handles" << '\n';
+        return false;
+    }
+    if (sim.yunaRespawns[0].timer <= sim.yunaRespawns[1].timer)
+    {
+        std::cerr << "Respawns were not queued in death order" << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testWallIndexMatchesLinearScan()
+{
+    world::LegacySimulation sim;
+    sim.setWorldBounds(640.0f, 360.0f);
+    sim.wallbreakerStats.preferWallRadiusPx = 60.0f;
+    sim.syncWallIndex();
+
+    std::mt19937 rng(22);
+    std::uniform_real_distribution<float> coord(-20.0f, 660.0f);
+    for (int i = 0; i < 60; ++i)
+    {
+        WallSegment wall;
+        // Snapped to a coarse lattice so equidistant walls exercise the lowest-index tie rule.
+        wall.pos = {std::round(coord(rng) / 20.0f) * 20.0f, std::round(coord(rng) / 20.0f) * 20.0f};
+        wall.hp = i % 7 == 0 ? 0.0f : 10.0f;
+        wall.life = static_cast<float>(i % 3);
+        wall.radius = 8.0f;
+        sim.addWall(wall);
+    }
+
+    auto liveWallIndex = [&](EntityId id) {
+        if (!sim.walls.has(id))
+        {
+            return world::WallIndex::None;
+        }
+        const std::uint32_t index = static_cast<std::uint32_t>(sim.walls.indexOf(id));
+        return sim.walls[index].hp > 0.0f ? index : world::WallIndex::None;
+    };
+    auto matchesScan = [&](const char *phase) {
+        sim.syncWallIndex();
+        const float radius = sim.wallbreakerStats.preferWallRadiusPx;
+        for (int query = 0; query < 300; ++query)
+        {
+            const Vec2 from{std::round(coord(rng) / 10.0f) * 10.0f, std::round(coord(rng) / 10.0f) * 10.0f};
+            std::uint32_t expected = world::WallIndex::None;
+            float bestDistSq = radius * radius;
+            for (std::size_t i = 0; i < sim.walls.size(); ++i)
+            {
+                const float distSq = lengthSq(sim.walls[i].pos - from);
+                if (sim.walls[i].hp > 0.0f && distSq < bestDistSq)
+                {
+                    bestDistSq = distSq;
+                    expected = static_cast<std::uint32_t>(i);
+                }
+            }
+            if (sim.wallIndex.nearest(from, radius, liveWallIndex) != expected)
+            {
+                std::cerr << "Wall index disagrees with a linear scan " << phase << '\n';
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (!matchesScan("after spawning walls"))
+    {
+        return false;
+    }
+    const std::uint64_t spawnedGeneration = sim.wallIndex.generation();
+    sim.syncWallIndex();
+    if (sim.wallIndex.generation() != spawnedGeneration)
+    {
+        std::cerr << "Wall index generation moved without a wall change" << '\n';
+        return false;
+    }
+    const std::size_t wallsBeforeExpiry = sim.walls.size();
+    sim.updateWalls(0.5f);
+    if (sim.wallIndex.size() != sim.walls.size() || !matchesScan("after walls expired"))
+    {
+        return false;
+    }
+    if (sim.walls.size() == wallsBeforeExpiry || sim.wallIndex.generation() == spawnedGeneration)
+    {
+        std::cerr << "Wall index generation missed expired walls" << '\n';
+        return false;
+    }
+    WallSegment direct;
+    direct.pos = {320.0f, 180.0f};
+    direct.hp = 5.0f;
+    direct.life = 5.0f;
+    sim.walls.push_back(direct);
+    if (!matchesScan("after a wall was added behind its back"))
+    {
+        return false;
+    }
+    sim.wallbreakerStats.preferWallRadiusPx = 140.0f;
+    return matchesScan("after the preference radius grew");
+}
+
+class RecordingTelemetrySink : public TelemetrySink
+{
+  public:
+    void recordEvent(std::string_view eventName, const Payload &payload) override
+    {
+        events.emplace_back(std::string(eventName), payload);
+    }
+
+    std::vector<std::pair<std::string, Payload>> events;
+};
+
+bool testYunaDeathEvents()
+{
+    world::LegacySimulation sim;
+    auto sink = std::make_shared<RecordingTelemetrySink>();
+    sim.setTelemetrySink(sink);
+    const UnitJob jobs[] = {UnitJob::Warrior, UnitJob::Shield, UnitJob::Warrior, UnitJob::Archer};
+    for (UnitJob job : jobs)
+    {
+        Unit unit;
+        unit.hp = 5.0f;
+        unit.job.job = job;
+        sim.yunas.push_back(unit);
+    }
+
+    sim.markYunaDead(3, 0.5f);
+    sim.markYunaDead(1, 0.0f);
+    auto deathEvents = [&]() {
+        std::vector<TelemetrySink::Payload> deaths;
+        for (const auto &event : sink->events)
+        {
+            if (event.first == "world.yuna.death")
+            {
+                deaths.push_back(event.second);
+            }
+        }
+        return deaths;
+    };
+    if (!deathEvents().empty())
+    {
+        std::cerr << "Ally death events were emitted before the reap" << '\n';
+        return false;
+    }
+
+    sim.reapYunas();
+    const std::vector<TelemetrySink::Payload> deaths = deathEvents();
+    if (deaths.size() != 2 || deaths[0].at("job") != unitJobToString(UnitJob::Archer) ||
+        deaths[1].at("job") != unitJobToString(UnitJob::Shield) || deaths[0].at("alive") != "2")
+    {
+        std::cerr << "Reap did not emit one death event per ally in death order" << '\n';
+        return false;
+    }
+    sim.reapYunas();
+    if (deathEvents().size() != 2)
+    {
+        std::cerr << "Reap re-emitted death events for allies already swept" << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testMissionZonesPatchedIncrementally()
+{
+    world::WorldState world;
+    world::LegacySimulation &sim = world.legacy();
+    sim.mapDefs.tile_size = 16;
+    sim.hasMission = true;
+    sim.missionConfig.mode = MissionMode::Capture;
+    for (int i = 0; i < 2; ++i)
+    {
+        MissionCaptureZone zone;
+        zone.id = i == 0 ? "west" : "east";
+        zone.tile = {2.0f + 18.0f * static_cast<float>(i), 2.0f};
+        zone.radius_px = 24.0f;
+        zone.capture_s = 4.0f;
+        sim.missionConfig.captureZones.push_back(zone);
+    }
+    sim.initializeMissionState();
+    sim.commander.alive = false;
+    Unit unit;
+    unit.pos = sim.captureZones[1].worldPos;
+    unit.hp = 10.0f;
+    sim.yunas.push_back(unit);
+
+    auto &mirror = world.missionZones();
+    if (mirror.size() != 2 || mirror[1].config.id != "east")
+    {
+        std::cerr << "Mission zones were not mirrored after the mission started" << '\n';
+        return false;
+    }
+    // Zone 0 sits idle, so a stale value planted in its mirror slot survives a patch that only copies zone 1.
+    mirror[0].progress = 0.5f;
+    sim.updateCaptureMission(1.0f);
+    if (sim.changedCaptureZones.size() != 1 || sim.changedCaptureZones[0] != 1)
+    {
+        std::cerr << "Capture update did not report exactly the zone it advanced" << '\n';
+        return false;
+    }
+    world.syncComponents();
+    if (mirror[1].progress != sim.captureZones[1].progress || mirror[0].progress != 0.5f ||
+        !sim.changedCaptureZones.empty())
+    {
+        std::cerr << "Mission zone sync copied more or less than the changed zone" << '\n';
+        return false;
+    }
+    world.markComponentsDirty();
+    world.syncComponents();
+    if (mirror[0].progress != sim.captureZones[0].progress)
+    {
+        std::cerr << "Forced mission zone sync left a stale slot" << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testEnemyPoolReservation()
+{
+    SpawnScript script;
+    script.waves.resize(2);
+    script.waves[0].sets.push_back({"north", 5, 0.5f, "slime", EnemyArchetype::Slime});
+    script.waves[1].time = 10.0f;
+    script.waves[1].sets.push_back({"south", 3, 0.5f, "slime", EnemyArchetype::Slime});
+    script.waves[1].sets.push_back({"south", -2, 0.3f, "slime", EnemyArchetype::Slime});
+    // The first wave spawns at 0, 0.5, ... 2 and the second at 10, 10.5, 11. A 5 s lifetime keeps the waves
+    // apart, 10.25 s lets the first wave's last four overlap the second's first two, and 0 counts every spawn.
+    const std::size_t estimate = world::spawn::estimatePeakEnemies(script, 0.0f);
+    const std::size_t separate = world::spawn::estimatePeakEnemies(script, 5.0f);
+    const std::size_t overlapping = world::spawn::estimatePeakEnemies(script, 10.25f);
+    const std::size_t everything = world::spawn::estimatePeakEnemies(script, 20.0f);
+    if (estimate != 8 || separate != 5 || overlapping != 6 || everything != 8)
+    {
+        std::cerr << "Spawn script peak estimate mismatch: " << estimate << ' ' << separate << ' ' << overlapping
+                  << ' ' << everything << '\n';
+        return false;
+    }
+
+    world::LegacySimulation sim;
+    auto sink = std::make_shared<RecordingTelemetrySink>();
+    sim.telemetry = sink;
+    sim.reserveEnemyPool(estimate);
+    sim.spawnOneEnemy({0.0f, 0.0f}, EnemyArchetype::Slime);
+    const EnemyUnit *first = &sim.enemies[0];
+    for (int wave = 0; wave < 3; ++wave)
+    {
+        while (sim.enemies.size() < estimate)
+        {
+            sim.spawnOneEnemy({0.0f, 0.0f}, EnemyArchetype::Slime);
+        }
+        std::size_t index = 0;
+        sim.enemies.eraseIf([&](const EnemyUnit &) { return index++ % 2 == 1; });
+    }
+    if (&sim.enemies[0] != first || sim.enemyPool.peak != estimate || !sink->events.empty())
+    {
+        std::cerr << "Enemy pool reallocated or reported within its reservation" << '\n';
+        return false;
+    }
+
+    while (sim.enemies.size() < estimate + 2)
+    {
+        sim.spawnOneEnemy({0.0f, 0.0f}, EnemyArchetype::Slime);
+    }
+    if (sink->events.size() != 1 || sink->events[0].first != "world.enemy_pool.exceeded")
+    {
+        std::cerr << "Outgrowing the enemy pool was not reported once" << '\n';
+        return false;
+    }
+
+    sim.reset();
+    sim.reserveEnemyPool(estimate);
+    if (sink->events.size() != 2 || sink->events[1].first != "world.enemy_pool.peak" ||
+        sink->events[1].second["peak"] != std::to_string(estimate + 2) || sim.enemyPool.reserved != estimate + 2)
+    {
+        std::cerr << "Observed enemy peak did not feed the next reservation" << '\n';
+        return false;
+    }
+    return true;
+}
+
 bool testCombatSpatialGridParity()
 {
     LegacySimulation sim{};
@@ -700,7 +1161,11 @@ bool testCombatSpatialGridParity()
     std::vector<GateRuntime> gates;
 
     LegacySimulation naiveSim = sim;
-    NaiveCombatState naiveState{naiveSim.commander, naiveSim.yunas, naiveSim.enemies, naiveSim.walls, baseHp,
+    NaiveCombatState naiveState{naiveSim.commander,
+                                {naiveSim.yunas.begin(), naiveSim.yunas.end()},
+                                {naiveSim.enemies.begin(), naiveSim.enemies.end()},
+                                {naiveSim.walls.begin(), naiveSim.walls.end()},
+                                baseHp,
                                 commanderInvulnTimer};
     const float defenseMultiplier =
         naiveSim.formationAlignTimer > 0.0f ? std::max(naiveSim.formationDefenseMul, 0.01f) : 1.0f;
@@ -709,10 +1174,6 @@ bool testCombatSpatialGridParity()
 
     naiveState = runNaiveCombatStep(naiveSim, gates, std::move(naiveState), dt, formationDamageScale);
 
-    EntityRegistry registry;
-    ComponentPool<Unit> alliesPool;
-    ComponentPool<EnemyUnit> enemyPool;
-    ComponentPool<WallSegment> wallPool;
     ComponentPool<CaptureRuntime> missionPool;
     HUDState hud;
 
@@ -729,10 +1190,9 @@ bool testCombatSpatialGridParity()
     world::systems::CombatSystem system;
     world::systems::SystemContext context{
         sim,
-        registry,
-        alliesPool,
-        enemyPool,
-        wallPool,
+        sim.yunas,
+        sim.enemies,
+        sim.walls,
         missionPool,
         sim.commander,
         hud,
@@ -748,9 +1208,6 @@ bool testCombatSpatialGridParity()
         spawnRateMultiplier,
         spawnSlowMultiplier,
         spawnSlowTimer,
-        sim.yunas,
-        sim.enemies,
-        sim.walls,
         gates,
         respawns,
         commanderRespawnTimer,
@@ -762,6 +1219,7 @@ bool testCombatSpatialGridParity()
         nullptr};
 
     system.update(dt, context);
+    sim.reapYunas();
 
     bool success = true;
     if (!almostEqual(sim.commander.hp, naiveState.commander.hp))
@@ -783,7 +1241,7 @@ bool testCombatSpatialGridParity()
     {
         for (std::size_t i = 0; i < sim.yunas.size(); ++i)
         {
-            if (!almostEqual(sim.yunas[i].hp, naiveState.yunas[i].hp))
+            if (!almostEqual(sim.yunas[i].hp(), naiveState.yunas[i].hp))
             {
                 std::cerr << "Yuna HP mismatch" << '\n';
                 success = false;
@@ -835,6 +1293,242 @@ bool testCombatSpatialGridParity()
     return success;
 }
 
+bool testSpatialGridBuckets()
+{
+    world::SpatialGrid grid;
+    grid.configure({0.0f, 0.0f}, {40.0f, 20.0f}, 10.0f);
+
+    const std::vector<world::SpatialGrid::Bounds> items{
+        {{5.0f, 5.0f}, 1.0f},   // cell (0, 0)
+        {{10.0f, 5.0f}, 2.0f},  // cells (0, 0) and (1, 0)
+        {{35.0f, 15.0f}, 1.0f}, // cell (3, 1)
+        {{15.0f, 5.0f}, 1.0f},  // cell (1, 0)
+    };
+    auto bounds = [&](std::size_t i) { return items[i]; };
+    grid.build(world::SpatialGrid::Layer::Enemies, items.size(), bounds);
+
+    const std::vector<std::uint32_t> cell0(grid.cell(world::SpatialGrid::Layer::Enemies, 0).begin(),
+                                           grid.cell(world::SpatialGrid::Layer::Enemies, 0).end());
+    const std::vector<std::uint32_t> cell1(grid.cell(world::SpatialGrid::Layer::Enemies, 1).begin(),
+                                           grid.cell(world::SpatialGrid::Layer::Enemies, 1).end());
+    if (cell0 != std::vector<std::uint32_t>{0, 1} || cell1 != std::vector<std::uint32_t>{1, 3} ||
+        grid.cell(world::SpatialGrid::Layer::Enemies, 7).size() != 1 ||
+        !grid.cell(world::SpatialGrid::Layer::Walls, 0).empty())
+    {
+        std::cerr << "Spatial grid buckets mismatch" << '\n';
+        return false;
+    }
+
+    std::vector<std::uint32_t> rowItems;
+    std::size_t spanCount = 0;
+    grid.forEachSpan(world::SpatialGrid::Layer::Enemies, {10.0f, 10.0f}, 6.0f, [&](auto span) {
+        ++spanCount;
+        rowItems.insert(rowItems.end(), span.begin(), span.end());
+    });
+    if (spanCount != 2 || rowItems != std::vector<std::uint32_t>{0, 1, 1, 3})
+    {
+        std::cerr << "Spatial grid row spans mismatch" << '\n';
+        return false;
+    }
+
+    const std::uint32_t *before = grid.cell(world::SpatialGrid::Layer::Enemies, 0).begin();
+    grid.build(world::SpatialGrid::Layer::Enemies, items.size(), bounds);
+    if (grid.cell(world::SpatialGrid::Layer::Enemies, 0).begin() != before)
+    {
+        std::cerr << "Spatial grid reallocated on identical rebuild" << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testProximityIndexMatchesLinearScan()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-100.0f, 1700.0f);
+    std::vector<Vec2> points(400);
+    for (Vec2 &point : points)
+    {
+        point = {std::round(coord(rng) / 8.0f) * 8.0f, std::round(coord(rng) / 8.0f) * 8.0f};
+    }
+    auto accept = [](std::uint32_t index) { return index % 3 != 0; };
+
+    world::ProximityIndex index;
+    index.build({0.0f, 0.0f}, {1600.0f, 900.0f}, points.size(), [&](std::size_t i) { return points[i]; });
+
+    std::vector<std::uint32_t> result;
+    for (int query = 0; query < 200; ++query)
+    {
+        const Vec2 from{coord(rng), coord(rng)};
+        std::vector<std::pair<float, std::uint32_t>> expected;
+        for (std::uint32_t i = 0; i < points.size(); ++i)
+        {
+            if (accept(i))
+            {
+                expected.emplace_back(lengthSq(points[i] - from), i);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+
+        if (index.nearest(from, accept) != expected.front().second)
+        {
+            std::cerr << "Proximity nearest mismatch" << '\n';
+            return false;
+        }
+
+        index.kNearest(from, 5, std::numeric_limits<float>::infinity(), accept, result);
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            if (result.size() != 5 || result[i] != expected[i].second)
+            {
+                std::cerr << "Proximity k-nearest mismatch" << '\n';
+                return false;
+            }
+        }
+
+        const float radius = 120.0f;
+        std::vector<std::uint32_t> inside;
+        for (const auto &entry : expected)
+        {
+            if (entry.first <= radius * radius)
+            {
+                inside.push_back(entry.second);
+            }
+        }
+        std::sort(inside.begin(), inside.end());
+        index.withinRadius(from, radius, accept, result);
+        if (result != inside)
+        {
+            std::cerr << "Proximity radius query mismatch" << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+bool testFlowFieldRoutesAroundWalls()
+{
+    const Vec2 goal{100.0f, 190.0f};
+    world::FlowField field;
+    field.configure({0.0f, 0.0f}, {200.0f, 200.0f}, 10.0f);
+
+    // Without walls every enemy must steer exactly as the straight-line chase did.
+    std::vector<world::SpatialGrid::Bounds> walls;
+    std::uint64_t generation = 0;
+    auto bounds = [&](std::size_t i) { return walls[i]; };
+    field.update(goal, generation, walls.size(), bounds);
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> coord(-20.0f, 220.0f);
+    for (int i = 0; i < 200; ++i)
+    {
+        const Vec2 pos{coord(rng), coord(rng)};
+        const Vec2 expected = normalize(goal - pos);
+        const Vec2 dir = field.direction(pos);
+        if (dir.x != expected.x || dir.y != expected.y)
+        {
+            std::cerr << "Open flow field changed the straight-line heading" << '\n';
+            return false;
+        }
+    }
+
+    // A wall across cells 6-13 of row 10 sits between the spawn point and the goal.
+    for (float x = 70.0f; x <= 130.0f; x += 10.0f)
+    {
+        walls.push_back({{x, 105.0f}, 4.0f});
+    }
+    ++generation;
+    if (!field.update(goal, generation, walls.size(), bounds))
+    {
+        std::cerr << "Flow field ignored new walls" << '\n';
+        return false;
+    }
+    const Vec2 spawn{105.0f, 25.0f};
+    const Vec2 dir = field.direction(spawn);
+    if (std::abs(dir.x) < 0.3f || dir.y <= 0.0f)
+    {
+        std::cerr << "Flow field did not steer around the wall" << '\n';
+        return false;
+    }
+    const float cost = field.cost(spawn);
+    if (!(cost > 16.0f && cost < 16.0f + world::FlowField::kWallCellCost))
+    {
+        std::cerr << "Flow field detour cost out of range: " << cost << '\n';
+        return false;
+    }
+    const Vec2 pastWall{105.0f, 155.0f};
+    const Vec2 direct = field.direction(pastWall);
+    const Vec2 expected = normalize(goal - pastWall);
+    if (direct.x != expected.x || direct.y != expected.y)
+    {
+        std::cerr << "Flow field detoured an enemy with a clear line to the goal" << '\n';
+        return false;
+    }
+
+    const std::size_t rebuilds = field.rebuildCount();
+    if (field.update(goal, generation, walls.size(), bounds) || field.rebuildCount() != rebuilds)
+    {
+        std::cerr << "Flow field rebuilt without a wall change" << '\n';
+        return false;
+    }
+    // A new generation with the same wall cells (an index rebuild) rescans but keeps the field.
+    ++generation;
+    if (field.update(goal, generation, walls.size(), bounds) || field.rebuildCount() != rebuilds)
+    {
+        std::cerr << "Flow field rebuilt for an unchanged wall set" << '\n';
+        return false;
+    }
+    walls.clear();
+    ++generation;
+    if (!field.update(goal, generation, walls.size(), bounds) || field.direction(spawn).x != normalize(goal - spawn).x)
+    {
+        std::cerr << "Flow field kept steering around a removed wall" << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testDensityFieldNeighborCounts()
+{
+    std::mt19937 rng(77);
+    std::uniform_real_distribution<float> coord(-40.0f, 400.0f);
+    std::vector<Vec2> points(300);
+    for (Vec2 &point : points)
+    {
+        point = {coord(rng), coord(rng) * 0.5f};
+    }
+
+    world::DensityField field;
+    field.build({0.0f, 0.0f}, {360.0f, 180.0f}, 32.0f, points.size(), [&](std::size_t i) { return points[i]; });
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        std::uint32_t expected = 0;
+        for (std::size_t j = 0; j < points.size(); ++j)
+        {
+            if (i != j && lengthSq(points[i] - points[j]) <= 32.0f * 32.0f)
+            {
+                ++expected;
+            }
+        }
+        if (field.countNeighbors(i, 32.0f, 1000) != expected ||
+            field.countNeighbors(i, 32.0f, 4) != std::min<std::uint32_t>(expected, 4))
+        {
+            std::cerr << "Density field neighbor count mismatch" << '\n';
+            return false;
+        }
+    }
+
+    world::DensityField cluster;
+    const std::vector<Vec2> packed{{48.0f, 48.0f}, {50.0f, 50.0f}, {52.0f, 46.0f}};
+    cluster.build({0.0f, 0.0f}, {320.0f, 320.0f}, 32.0f, packed.size(), [&](std::size_t i) { return packed[i]; });
+    if (cluster.cellCount({40.0f, 40.0f}) != 3 || !almostEqual(cluster.sample({48.0f, 48.0f}), 3.0f) ||
+        cluster.sample({300.0f, 300.0f}) != 0.0f)
+    {
+        std::cerr << "Density field sampling mismatch" << '\n';
+        return false;
+    }
+    return true;
+}
+
 bool benchmarkCombatSpatialGrid()
 {
     LegacySimulation sim{};
@@ -1033,6 +1727,14 @@ int main()
     {
         success = false;
     }
+    if (!testBehaviorBucketsMatchAcrossWorkers())
+    {
+        success = false;
+    }
+    if (!testAiSchedulerBoundsDecisions())
+    {
+        success = false;
+    }
     if (!testCommanderDeathMorale())
     {
         success = false;
@@ -1041,10 +1743,46 @@ int main()
     {
         success = false;
     }
+    if (!testDeferredYunaDeaths())
+    {
+        success = false;
+    }
+    if (!testYunaDeathEvents())
+    {
+        success = false;
+    }
+    if (!testWallIndexMatchesLinearScan())
+    {
+        success = false;
+    }
+    if (!testMissionZonesPatchedIncrementally())
+    {
+        success = false;
+    }
+    if (!testEnemyPoolReservation())
+    {
+        success = false;
+    }
     if (!testCombatSpatialGridParity())
     {
         success = false;
     }
+    if (!testSpatialGridBuckets())
+    {
+        success = false;
+    }
+    if (!testProximityIndexMatchesLinearScan())
+    {
+        success = false;
+    }
+    if (!testFlowFieldRoutesAroundWalls())
+    {
+        success = false;
+    }
+    if (!testDensityFieldNeighborCounts())
+    {
+        success = false;
+    }
     if (!benchmarkCombatSpatialGrid())
     {
         success = false;
@@ -0,0 +1,101 @@
+#include "telemetry/TraceProfiler.h"
+
+#include "telemetry/TelemetrySink.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+class RecordingTelemetrySink : public TelemetrySink
+{
+  public:
+    void recordEvent(std::string_view eventName, const Payload &payload) override
+    {
+        events.emplace_back(std::string(eventName), payload);
+    }
+
+    std::vector<std::pair<std::string, Payload>> events;
+};
+
+bool testCaptureWritesNestedZones()
+{
+    namespace fs = std::filesystem;
+    const fs::path directory = fs::temp_directory_path() / "kusozako_trace_profiler_test";
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+
+    RecordingTelemetrySink sink;
+    sink.setOutputDirectory(directory);
+    telemetry::TraceProfiler &profiler = telemetry::TraceProfiler::instance();
+
+    {
+        KUSOZAKO_TRACE_ZONE("BeforeCapture");
+    }
+    profiler.requestCapture(2);
+    profiler.markFrame(&sink);
+    if (!profiler.capturing())
+    {
+        std::cerr << "Capture did not start on the next frame boundary" << '\n';
+        return false;
+    }
+
+    {
+        KUSOZAKO_TRACE_ZONE("Outer");
+        {
+            KUSOZAKO_TRACE_ZONE("Inner");
+        }
+        std::thread worker([]() { KUSOZAKO_TRACE_ZONE("Worker"); });
+        worker.join();
+    }
+    profiler.markFrame(&sink);
+    profiler.markFrame(&sink);
+    if (profiler.capturing())
+    {
+        std::cerr << "Capture did not stop after the requested frames" << '\n';
+        return false;
+    }
+
+    if (sink.events.size() != 1 || sink.events[0].first != "telemetry.trace.saved" ||
+        sink.events[0].second["events"] != "3")
+    {
+        std::cerr << "Trace save was not reported with the recorded zones" << '\n';
+        return false;
+    }
+
+    std::ifstream stream(profiler.lastTracePath());
+    const std::string json((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    const bool hasZones = json.find("\"name\":\"Outer\"") != std::string::npos &&
+                          json.find("\"name\":\"Inner\"") != std::string::npos &&
+                          json.find("\"name\":\"Worker\"") != std::string::npos &&
+                          json.find("\"ph\":\"X\"") != std::string::npos;
+    if (json.rfind("{\"displayTimeUnit\"", 0) != 0 || !hasZones ||
+        json.find("BeforeCapture") != std::string::npos)
+    {
+        std::cerr << "Trace file is missing captured zones" << '\n';
+        return false;
+    }
+
+    fs::remove_all(directory, ec);
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    bool success = true;
+    if (!testCaptureWritesNestedZones())
+    {
+        success = false;
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+#include "world/WorldSnapshot.h"
+
+#include "telemetry/TelemetrySink.h"
+#include "world/LegacySimulation.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using namespace world;
+
+class RecordingTelemetrySink : public TelemetrySink
+{
+  public:
+    void recordEvent(std::string_view eventName, const Payload &payload) override
+    {
+        events.emplace_back(std::string(eventName), payload);
+    }
+
+    std::vector<std::pair<std::string, Payload>> events;
+};
+
+void populate(LegacySimulation &sim)
+{
+    sim.frameCounter = 42;
+    sim.simTime = 12.5f;
+    sim.baseHp = 80.0f;
+    sim.commander.pos = {100.0f, 120.0f};
+    sim.commander.hp = 55.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        Unit unit;
+        unit.pos = {10.0f * static_cast<float>(i), 20.0f};
+        unit.hp = 30.0f + static_cast<float>(i);
+        unit.job.job = static_cast<UnitJob>(i);
+        unit.moraleState = i == 1 ? MoraleState::Panic : MoraleState::Stable;
+        unit.followByStance = i == 2;
+        sim.yunas.push_back(unit);
+    }
+    EnemyUnit enemy;
+    enemy.pos = {300.0f, 40.0f};
+    enemy.hp = 9.0f;
+    enemy.radius = 6.0f;
+    enemy.type = EnemyArchetype::Wallbreaker;
+    sim.enemies.push_back(enemy);
+    WallSegment wall;
+    wall.pos = {200.0f, 50.0f};
+    wall.hp = 40.0f;
+    wall.life = 3.0f;
+    wall.radius = 8.0f;
+    sim.walls.push_back(wall);
+    GateRuntime gate;
+    gate.id = "gate_\"north\"";
+    gate.pos = {640.0f, 0.0f};
+    gate.hp = 100.0f;
+    gate.maxHp = 150.0f;
+    sim.gates.push_back(gate);
+    LegacySimulation::CaptureRuntime zone;
+    zone.config.id = "hill";
+    zone.progress = 0.25f;
+    sim.captureZones.push_back(zone);
+    sim.missionMode = MissionMode::Capture;
+    sim.captureGoal = 2;
+    sim.rng.seed(7);
+    sim.rng.discard(100);
+}
+
+bool testBinaryRoundTrip()
+{
+    LegacySimulation sim;
+    populate(sim);
+    const WorldSnapshot captured = captureWorldSnapshot(sim);
+    std::vector<std::uint8_t> bytes;
+    encodeWorldSnapshot(captured, bytes);
+
+    WorldSnapshot decoded;
+    std::string error;
+    if (!decodeWorldSnapshot(bytes, decoded, error))
+    {
+        std::cerr << "Snapshot failed to decode: " << error << '\n';
+        return false;
+    }
+    if (decoded.frame != 42 || decoded.yunas.size() != 3 || decoded.yunas[1].morale != MoraleState::Panic ||
+        decoded.yunas[2].job != UnitJob::Shield || !decoded.yunas[2].followByStance ||
+        decoded.enemies.size() != 1 || decoded.enemies[0].type != EnemyArchetype::Wallbreaker ||
+        decoded.walls.size() != 1 || decoded.walls[0].life != 3.0f || decoded.gates.size() != 1 ||
+        decoded.gates[0].id != "gate_\"north\"" || decoded.mission.mode != MissionMode::Capture ||
+        decoded.mission.zones.size() != 1 || decoded.mission.zones[0].id != "hill" || decoded.rng != sim.rng)
+    {
+        std::cerr << "Decoded snapshot does not match the simulation" << '\n';
+        return false;
+    }
+
+    bytes.resize(bytes.size() / 2);
+    if (decodeWorldSnapshot(bytes, decoded, error))
+    {
+        std::cerr << "Truncated snapshot was accepted" << '\n';
+        return false;
+    }
+
+    std::ostringstream json;
+    writeWorldSnapshotJson(captured, json);
+    const std::string text = json.str();
+    if (text.find("\"frame\": 42") == std::string::npos ||
+        text.find("{\"index\": 1, \"job\": \"archer\", \"hp\": 31.000, \"morale\": \"panic\"") == std::string::npos ||
+        text.find("\"type\": \"wallbreaker\"") == std::string::npos ||
+        text.find("\"id\": \"gate_\\\"north\\\"\"") == std::string::npos ||
+        text.find("\"mode\": \"capture\"") == std::string::npos)
+    {
+        std::cerr << "Snapshot JSON is missing expected fields" << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testFrameCaptureWritesInBackground()
+{
+    namespace fs = std::filesystem;
+    const fs::path directory = fs::temp_directory_path() / "kusozako_world_snapshot_test";
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+
+    auto sink = std::make_shared<RecordingTelemetrySink>();
+    sink->setOutputDirectory(directory);
+    LegacySimulation sim;
+    populate(sim);
+    sim.setTelemetrySink(sink);
+    sink->requestFrameCapture();
+    for (int frame = 0; frame < 6; ++frame)
+    {
+        sim.serviceFrameCapture();
+    }
+    if (!sim.snapshotWriter)
+    {
+        std::cerr << "Frame capture did not start the snapshot writer" << '\n';
+        return false;
+    }
+    sim.snapshotWriter->waitIdle();
+    sim.reportFrameCaptures(*sink);
+
+    std::size_t saved = 0;
+    for (const auto &[name, payload] : sink->events)
+    {
+        if (name == "world.frame_capture.saved")
+        {
+            ++saved;
+        }
+    }
+    const fs::path first = directory / "frame_capture_000001_01.kzs";
+    std::ifstream stream(first, std::ios::binary);
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    WorldSnapshot decoded;
+    std::string error;
+    if (saved != 5 || !decodeWorldSnapshot(data, decoded, error) || decoded.batch != 1 || decoded.index != 1)
+    {
+        std::cerr << "Frame capture batch was not written: " << saved << " saved " << error << '\n';
+        return false;
+    }
+
+    fs::remove_all(directory, ec);
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    bool success = true;
+    if (!testBinaryRoundTrip())
+    {
+        success = false;
+    }
+    if (!testFrameCaptureWritesInBackground())
+    {
+        success = false;
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+#include "world/WorldState.h"
+
+#include "assets/AssetManager.h"
+#include "config/AppConfig.h"
+#include "config/AppConfigLoader.h"
+#include "input/ActionBuffer.h"
+#include "world/InputRecording.h"
+#include "world/LegacySimulation.h"
+#include "world/RewindBuffer.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace world;
+
+constexpr int kSaveFrame = 900;
+constexpr int kEndFrame = 1800;
+
+// Deterministic input for frame i, so a restored world can be driven exactly as the original was.
+void stepFrame(WorldState &world, ActionBuffer &actions, int i, float dt)
+{
+    std::array<float, static_cast<std::size_t>(AxisId::Count)> axes{};
+    axes[0] = std::sin(static_cast<float>(i) * 0.03f);
+    axes[1] = (i / 150) % 2 == 0 ? 0.4f : -0.4f;
+    PointerState pointer;
+    std::vector<ActionEvent> events;
+    ActionEvent event;
+    event.pressed = true;
+    if (i % 400 == 50)
+    {
+        event.id = ActionId::CommanderOrderPushForward;
+        events.push_back(event);
+    }
+    if (i % 500 == 250)
+    {
+        event.id = ActionId::CycleFormationNext;
+        events.push_back(event);
+    }
+    actions.pushFrame(static_cast<std::uint64_t>(i), static_cast<double>(i) * dt * 1000.0, axes, events, pointer);
+    for (const ActionEvent &pending : actions.latest()->events)
+    {
+        world.applyAction(pending, {0.0f, 0.0f});
+    }
+    world.step(dt, actions);
+}
+
+bool testRestoreContinuesIdentically(const AppConfig &config)
+{
+    const float dt = config.game.fixed_dt;
+    WorldState original;
+    original.configure(config);
+    original.setWorldBounds(1280.0f, 720.0f);
+    original.reset();
+    ActionBuffer actions;
+    for (int i = 0; i < kSaveFrame; ++i)
+    {
+        stepFrame(original, actions, i, dt);
+    }
+    std::vector<std::uint8_t> saved;
+    original.saveState(saved);
+    const std::uint64_t checksumAtSave = worldChecksum(original);
+
+    std::vector<std::uint64_t> expected;
+    for (int i = kSaveFrame; i < kEndFrame; ++i)
+    {
+        stepFrame(original, actions, i, dt);
+        expected.push_back(worldChecksum(original));
+    }
+
+    // Restore into the same world (rewinding it) and into a freshly configured one.
+    WorldState fresh;
+    fresh.configure(config);
+    fresh.setWorldBounds(1280.0f, 720.0f);
+    fresh.reset();
+    for (WorldState *world : {&original, &fresh})
+    {
+        std::string error;
+        if (!world->loadState(saved, error) || worldChecksum(*world) != checksumAtSave)
+        {
+            std::cerr << "Saved state did not restore: " << error << '\n';
+            return false;
+        }
+        ActionBuffer replayActions;
+        for (int i = kSaveFrame; i < kEndFrame; ++i)
+        {
+            stepFrame(*world, replayActions, i, dt);
+            if (worldChecksum(*world) != expected[static_cast<std::size_t>(i - kSaveFrame)])
+            {
+                std::cerr << "Restored world diverged at frame " << i << '\n';
+                return false;
+            }
+        }
+    }
+
+    std::vector<std::uint8_t> resaved;
+    original.saveState(resaved);
+    std::vector<std::uint8_t> expectedBytes;
+    fresh.saveState(expectedBytes);
+    if (resaved != expectedBytes)
+    {
+        std::cerr << "Worlds with identical histories saved different state" << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testRejectsInvalidState(const AppConfig &config)
+{
+    WorldState world;
+    world.configure(config);
+    world.setWorldBounds(1280.0f, 720.0f);
+    world.reset();
+    ActionBuffer actions;
+    for (int i = 0; i < 300; ++i)
+    {
+        stepFrame(world, actions, i, config.game.fixed_dt);
+    }
+    std::vector<std::uint8_t> saved;
+    world.saveState(saved);
+    const std::uint64_t before = worldChecksum(world);
+
+    std::vector<std::uint8_t> truncated(saved.begin(), saved.begin() + static_cast<std::ptrdiff_t>(saved.size() / 2));
+    std::vector<std::uint8_t> badMagic = saved;
+    badMagic[0] = 'X';
+    std::string error;
+    if (world.loadState(truncated, error) || world.loadState(badMagic, error) || worldChecksum(world) != before)
+    {
+        std::cerr << "Invalid state was accepted or changed the world: " << error << '\n';
+        return false;
+    }
+
+    // Skill runtime state is matched by id, so a differently configured world must refuse the state.
+    WorldState other;
+    other.configure(config);
+    other.setWorldBounds(1280.0f, 720.0f);
+    other.reset();
+    other.configureSkills({});
+    if (other.loadState(saved, error) || error != "skills_mismatch")
+    {
+        std::cerr << "State loaded into a world with different skills: " << error << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool testRewindBuffer(const AppConfig &config)
+{
+    const float dt = config.game.fixed_dt;
+    WorldState world;
+    world.configure(config);
+    world.setWorldBounds(1280.0f, 720.0f);
+    world.reset();
+    RewindBuffer rewind(3, 2.0f);
+    ActionBuffer actions;
+    int frame = 0;
+    while (world.legacy().simTime < 11.5f)
+    {
+        stepFrame(world, actions, frame++, dt);
+        rewind.capture(world);
+    }
+    // Snapshots roughly every 2 s; only the newest three survive.
+    if (rewind.size() != 3 || rewind.entry(0).simTime < 9.0f || rewind.entry(2).simTime < 5.0f)
+    {
+        std::cerr << "Rewind buffer kept unexpected snapshots: " << rewind.size() << '\n';
+        return false;
+    }
+
+    const float newest = rewind.entry(0).simTime;
+    const float oldest = rewind.entry(2).simTime;
+    std::string error;
+    if (!rewind.rewind(world, error) || world.legacy().simTime != newest)
+    {
+        std::cerr << "Rewind did not restore the newest snapshot: " << error << '\n';
+        return false;
+    }
+    // Rewinding again right away moves further back instead of landing on the same snapshot.
+    if (!rewind.rewind(world, error) || !rewind.rewind(world, error) || world.legacy().simTime != oldest ||
+        rewind.size() != 1)
+    {
+        std::cerr << "Repeated rewind did not walk back through the buffer" << '\n';
+        return false;
+    }
+
+    world.reset();
+    stepFrame(world, actions, frame, dt);
+    if (!rewind.capture(world) || rewind.size() != 1 || rewind.entry(0).simTime != world.legacy().simTime)
+    {
+        std::cerr << "Rewind buffer kept snapshots from before a restart" << '\n';
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    AssetManager assets;
+    assets.setAssetRoot((std::filesystem::path(PROJECT_SOURCE_DIR) / "assets").string());
+    AppConfigLoader loader(std::filesystem::path(PROJECT_SOURCE_DIR) / "config");
+    const AppConfigLoadResult config = loader.load(assets);
+
+    bool success = true;
+    if (!testRestoreContinuesIdentically(config.config))
+    {
+        success = false;
+    }
+    if (!testRejectsInvalidState(config.config))
+    {
+        success = false;
+    }
+    if (!testRewindBuffer(config.config))
+    {
+        success = false;
+    }
+    return success ? 0 : 1;
+}
@@ -1,10 +1,12 @@
 #include "TestSystem.h"
 
 #include "input/ActionBuffer.h"
+#include "world/ComponentPool.h"
 #include "world/WorldState.h"
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -212,12 +214,12 @@ int main()
 
         const float expectedDelta = sim.yunaStats.speed_u_s * sim.config.pixels_per_unit * dt;
         const float expectedPosX = 100.0f - expectedDelta;
-        if (sim.yunas.empty() || std::fabs(sim.yunas.front().pos.x - expectedPosX) > 0.01f)
+        if (sim.yunas.empty() || std::fabs(sim.yunas.front().pos().x - expectedPosX) > 0.01f)
         {
             std::cerr << "Follower movement mismatch" << '\n';
             success = false;
         }
-        if (!sim.yunas.empty() && sim.yunas.front().hasDesiredVelocity)
+        if (!sim.yunas.empty() && sim.yunas.front().hasDesiredVelocity())
         {
             std::cerr << "Follower intent not cleared" << '\n';
             success = false;
@@ -252,6 +254,168 @@ int main()
         }
     }
 
+    {
+        world::WorldState world;
+        world::LegacySimulation &sim = world.legacy();
+        sim.yunas.clear();
+        for (int i = 0; i < 3; ++i)
+        {
+            Unit yuna;
+            yuna.pos = {10.0f * static_cast<float>(i), 0.0f};
+            yuna.hp = 10.0f;
+            sim.yunas.push_back(yuna);
+        }
+        const world::EntityId first = sim.yunas.entityAt(0);
+        const world::EntityId middle = sim.yunas.entityAt(1);
+        const world::EntityId last = sim.yunas.entityAt(2);
+        if (&world.allies() != &sim.yunas || first == last)
+        {
+            std::cerr << "Ally pool is not the simulation storage" << '\n';
+            success = false;
+        }
+
+        sim.yunas.erase(sim.yunas.begin() + 1);
+        sim.yunas[0].hp() = 4.0f;
+        Unit spawned;
+        spawned.pos = {50.0f, 0.0f};
+        sim.yunas.push_back(spawned);
+
+        const world::ComponentPool<Unit> &allies = world.allies();
+        if (allies.size() != 3 || allies.entityAt(0) != first || allies.entityAt(1) != last ||
+            allies.has(middle) || allies.entityAt(2) == middle || !allies.has(first) ||
+            allies.get(first).hp() != 4.0f)
+        {
+            std::cerr << "Ally pool did not preserve entity ids" << '\n';
+            success = false;
+        }
+
+        sim.yunas[1].pos().x += 1.0f;
+        const Unit copy = sim.yunas[1];
+        const auto &positions = allies.storage().posColumn();
+        if (positions.size() != allies.size() || positions[1].x != 21.0f || copy.pos.x != 21.0f ||
+            allies.storage().hpColumn()[0] != 4.0f)
+        {
+            std::cerr << "Ally columns out of sync with unit references" << '\n';
+            success = false;
+        }
+    }
+
+    {
+        struct UnitSnapshot
+        {
+            float x;
+            float y;
+            MoraleState state;
+            float moraleTimer;
+            bool retreating;
+            float retreatTimer;
+        };
+
+        auto runWorld = [](std::size_t workers, std::uint32_t &nextRoll) {
+            world::WorldState world;
+            world.setWorkerThreads(workers);
+            world::LegacySimulation &sim = world.legacy();
+            sim.setWorldBounds(4000.0f, 4000.0f);
+            sim.rng.seed(1234u);
+            sim.commander.alive = false;
+            MoraleConfig &morale = sim.config.morale;
+            morale.leaderDownWindow = 0.05f;
+            for (MoraleStateConfig *state : {&morale.panic, &morale.mesomeso})
+            {
+                state->duration = 0.6f;
+                state->behavior.retreat = {true, 0.3f, 1.5f, 0.5f};
+                state->retreatCheck = {0.1f, 0.4f};
+            }
+
+            sim.yunas.clear();
+            for (int i = 0; i < 3000; ++i)
+            {
+                Unit yuna;
+                yuna.pos = {static_cast<float>(100 + (i * 37) % 3800), static_cast<float>(100 + (i * 53) % 3800)};
+                yuna.radius = 4.0f;
+                yuna.hp = 10.0f;
+                yuna.effectiveFollower = (i % 3) != 0;
+                yuna.desiredVelocity = {static_cast<float>(i % 7) - 3.0f, static_cast<float>(i % 5) - 2.0f};
+                yuna.hasDesiredVelocity = true;
+                sim.yunas.push_back(yuna);
+            }
+            world.markComponentsDirty();
+
+            ActionBuffer actions;
+            for (int frame = 0; frame < 30; ++frame)
+            {
+                world.step(0.05f, actions);
+            }
+
+            std::vector<UnitSnapshot> snapshot;
+            for (std::size_t i = 0; i < sim.yunas.size(); ++i)
+            {
+                world::ConstUnitRef unit = sim.yunas[i];
+                snapshot.push_back({unit.pos().x, unit.pos().y, unit.moraleState(), unit.moraleTimer(),
+                                    unit.moraleRetreatActive(), unit.moraleRetreatTimer()});
+            }
+            nextRoll = sim.rng();
+            return snapshot;
+        };
+
+        std::uint32_t serialRoll = 0;
+        std::uint32_t parallelRoll = 0;
+        const std::vector<UnitSnapshot> serial = runWorld(0, serialRoll);
+        const std::vector<UnitSnapshot> parallel = runWorld(4, parallelRoll);
+        bool identical = serial.size() == parallel.size() && serialRoll == parallelRoll;
+        bool anyRetreat = false;
+        for (std::size_t i = 0; identical && i < serial.size(); ++i)
+        {
+            const UnitSnapshot &a = serial[i];
+            const UnitSnapshot &b = parallel[i];
+            identical = a.x == b.x && a.y == b.y && a.state == b.state && a.moraleTimer == b.moraleTimer &&
+                        a.retreating == b.retreating && a.retreatTimer == b.retreatTimer;
+            anyRetreat = anyRetreat || a.retreating;
+        }
+        if (!identical)
+        {
+            std::cerr << "Parallel step diverged from serial step" << '\n';
+            success = false;
+        }
+        if (!anyRetreat)
+        {
+            std::cerr << "Parallel step scenario never rolled a retreat" << '\n';
+            success = false;
+        }
+    }
+
+    {
+        world::WorldState world;
+        ActionBuffer actions;
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            world.step(0.016f, actions);
+        }
+
+        const world::StepTimings &timings = world.stepTimings();
+        bool recorded = timings.systems.size() == world.systemStageOrder().size() && timings.step.samples() == 3 &&
+                        timings.legacyState.series.samples() == 3 && timings.spawnStage.series.samples() == 3;
+        for (std::size_t i = 0; recorded && i < timings.systems.size(); ++i)
+        {
+            recorded = timings.systems[i].stage == world.systemStageOrder()[i] &&
+                       timings.systems[i].series.samples() == 3 && timings.systems[i].name != "System";
+        }
+        const world::SystemTiming *slowestCombat = timings.slowestIn(Stage::Combat);
+        if (!recorded || !slowestCombat || slowestCombat->name != "CombatSystem")
+        {
+            std::cerr << "Step timings not recorded per system" << '\n';
+            success = false;
+        }
+        const world::SystemTiming *slowestUpdate = timings.slowestIn(Stage::StateUpdate);
+        const double stateUpdateMs = timings.stages[static_cast<std::size_t>(Stage::StateUpdate)].lastMs();
+        if (!slowestUpdate || stateUpdateMs < timings.legacyState.series.lastMs() ||
+            timings.step.lastMs() < stateUpdateMs)
+        {
+            std::cerr << "Stage timings do not include legacy state work" << '\n';
+            success = false;
+        }
+    }
+
     return success ? 0 : 1;
 }
 
@@ -0,0 +1,57 @@
+#include "world/WorldSnapshot.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Converts binary frame captures (frame_capture_*.kzs) into the frame_capture JSON schema. Each input is written
+// next to itself with a .json extension unless a single input is given together with an output path ("-" for
+// stdout).
+int main(int argc, char **argv)
+{
+    namespace fs = std::filesystem;
+    if (argc < 2)
+    {
+        std::cerr << "Usage: kusozako_snapshot_json SNAPSHOT.kzs [OUTPUT.json|-]\n"
+                  << "       kusozako_snapshot_json SNAPSHOT.kzs...\n";
+        return 2;
+    }
+
+    const bool explicitOutput = argc == 3 && fs::path(argv[2]).extension() != ".kzs";
+    const int inputCount = explicitOutput ? 1 : argc - 1;
+    int failures = 0;
+    for (int i = 1; i <= inputCount; ++i)
+    {
+        const fs::path input = argv[i];
+        std::ifstream stream(input, std::ios::binary);
+        const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(stream)),
+                                             std::istreambuf_iterator<char>());
+        world::WorldSnapshot snapshot;
+        std::string error;
+        if (!stream.is_open() || !world::decodeWorldSnapshot(data, snapshot, error))
+        {
+            std::cerr << input.string() << ": " << (stream.is_open() ? error : std::string("open_failed")) << '\n';
+            ++failures;
+            continue;
+        }
+
+        if (explicitOutput && std::string(argv[2]) == "-")
+        {
+            world::writeWorldSnapshotJson(snapshot, std::cout);
+            continue;
+        }
+        const fs::path output = explicitOutput ? fs::path(argv[2]) : fs::path(input).replace_extension(".json");
+        std::ofstream out(output, std::ios::out | std::ios::binary | std::ios::trunc);
+        world::writeWorldSnapshotJson(snapshot, out);
+        out.close();
+        if (!out)
+        {
+            std::cerr << output.string() << ": write_failed\n";
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}